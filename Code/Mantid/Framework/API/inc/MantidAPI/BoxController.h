@@ -357,6 +357,10 @@ namespace API
     /// Returns if current box controller is file backed. Assumes that BC(workspace) is fileBackd if fileIO is defined;
      bool isFileBacked()const
      {return (m_fileIO!=0);}
+     /** Returns true if the boxes are handled as file-backed but the IO keeps their events packed in memory
+      *  (see MDEventFactory::setCompactStorage), so there is no file to copy or to update */
+     bool hasCompactStorage()const
+     {return (m_fileIO!=0) && m_fileIO->isInMemory();}
      /// returns the pointer to the class, responsible for fileIO operations;
      IBoxControllerIO * getFileIO()
      {return m_fileIO.get();}
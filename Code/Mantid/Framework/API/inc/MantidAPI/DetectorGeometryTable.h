@@ -0,0 +1,102 @@
+#ifndef MANTID_API_DETECTORGEOMETRYTABLE_H_
+#define MANTID_API_DETECTORGEOMETRYTABLE_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+#include "MantidGeometry/Instrument.h"
+#include <vector>
+
+namespace Mantid
+{
+namespace API
+{
+  //----------------------------------------------------------------------
+  // Forward Declaration
+  //----------------------------------------------------------------------
+  class MatrixWorkspace;
+
+  /** The geometry of the detector (or detector group) of each spectrum of a MatrixWorkspace,
+      as needed to convert units: L1, L2, 2theta, phi and the Efixed parameter.
+
+      Finding the detectors of the spectra and getting their parameterised positions is slow,
+      so the table is built once for all the spectra and kept by the workspace (see
+      MatrixWorkspace::detectorGeometry()). It remembers what it was built from: the instrument,
+      the modification stamp of its parameters and the stamps of the detector IDs of the spectra
+      (see ISpectrum::getDetectorIDsStamp()). isValidFor() tells whether these are still the same.
+
+      Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+      This file is part of Mantid.
+
+      Mantid is free software; you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation; either version 3 of the License, or
+      (at your option) any later version.
+
+      Mantid is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+      File change history is stored at: <https://github.com/mantidproject/mantid>
+      Code Documentation is available at: <http://doxygen.mantidproject.org>
+  */
+  class MANTID_API_DLL DetectorGeometryTable
+  {
+  public:
+    explicit DetectorGeometryTable(const MatrixWorkspace & workspace);
+
+    bool isValidFor(const MatrixWorkspace & workspace) const;
+
+    /// @return the number of spectra
+    size_t size() const { return m_flags.size(); }
+    /// @return the source-sample distance in metres
+    double l1() const { return m_l1; }
+    /// @return true if a detector was found for the spectrum. The other values are not set otherwise.
+    bool hasDetector(const size_t index) const { return (m_flags[index] & HAS_DETECTOR) != 0; }
+    /// @return true if the detector of the spectrum is a monitor
+    bool isMonitor(const size_t index) const { return (m_flags[index] & MONITOR) != 0; }
+    /// @return true if the detector of the spectrum is masked
+    bool isMasked(const size_t index) const { return (m_flags[index] & MASKED) != 0; }
+    /// @return the ID of the detector (or detector group) of the spectrum
+    detid_t detectorID(const size_t index) const { return m_detectorIDs[index]; }
+    /// @return the sample-detector distance in metres. For a monitor: the source-monitor distance minus L1.
+    double l2(const size_t index) const { return m_l2[index]; }
+    /// @return the scattering angle in radians
+    double twoTheta(const size_t index) const { return m_twoTheta[index]; }
+    /// @return the scattering angle in radians, signed by the side of the beam the detector is on
+    double signedTwoTheta(const size_t index) const { return m_signedTwoTheta[index]; }
+    /// @return the azimuthal angle of the detector in radians
+    double phi(const size_t index) const { return m_phi[index]; }
+    /// @return the "Efixed" parameter of the detector, or EMPTY_DBL() if it has none
+    double efixed(const size_t index) const { return m_efixed[index]; }
+
+  private:
+    /// Bits of m_flags
+    enum Flags { HAS_DETECTOR = 1, MONITOR = 2, MASKED = 4 };
+
+
+    /// The base instrument the table was built from
+    Geometry::Instrument_const_sptr m_baseInstrument;
+    /// The modification stamp of the instrument parameters the table was built from
+    size_t m_parameterStamp;
+    /// The stamps of the detector IDs of the spectra the table was built from
+    std::vector<size_t> m_detectorIDsStamps;
+
+    double m_l1;
+    std::vector<unsigned char> m_flags;
+    std::vector<detid_t> m_detectorIDs;
+    std::vector<double> m_l2;
+    std::vector<double> m_twoTheta;
+    std::vector<double> m_signedTwoTheta;
+    std::vector<double> m_phi;
+    std::vector<double> m_efixed;
+  };
+
+} // namespace API
+} // namespace Mantid
+
+#endif  /* MANTID_API_DETECTORGEOMETRYTABLE_H_ */
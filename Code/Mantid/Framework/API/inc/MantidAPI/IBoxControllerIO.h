@@ -74,6 +74,14 @@ namespace API
        *  by save/load operations     */
       virtual void setDataType(const size_t blockSize, const std::string &typeName) =0;
       virtual void getDataType(size_t &blockSize, std::string &typeName)const =0;
+
+      /** @return the memory (in bytes) taken by the "file" contents, for IO operations which keep them in memory.
+       *  Zero for file-based IO */
+      virtual size_t getMemorySize()const
+      { return 0; }
+      /** @return true if the IO keeps the "file" contents in memory, i.e. there is no file behind it */
+      virtual bool isInMemory()const
+      { return false; }
   };
 }
 }
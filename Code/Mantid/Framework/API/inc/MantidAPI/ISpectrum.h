@@ -113,6 +113,8 @@ namespace API
 
     void clearDetectorIDs();
 
+    size_t getDetectorIDsStamp() const;
+
     // ---------------------------------------------------------
     specid_t getSpectrumNo() const;
 
@@ -130,6 +132,9 @@ namespace API
     /// Set of the detector IDs associated with this spectrum
     std::set<detid_t> detectorIDs;
 
+    /// Changes (to a value no other spectrum had) whenever the detector IDs may change. See getDetectorIDsStamp()
+    size_t m_detectorIDsStamp;
+
     /// Copy-on-write pointer to the X data vector.
     MantidVecPtr refX;
 
@@ -13,6 +13,7 @@
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectraDetectorTypes.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <boost/scoped_ptr.hpp>
 
@@ -29,6 +30,7 @@ namespace Mantid
   }
   namespace API
   {
+    class DetectorGeometryTable;
     class SpectrumDetectorMapping;
 
     //----------------------------------------------------------------------
@@ -83,6 +85,8 @@ namespace Mantid
       double detectorTwoTheta(Geometry::IDetector_const_sptr det) const;
       double detectorSignedTwoTheta(Geometry::IDetector_const_sptr det) const;
       double gravitationalDrop(Geometry::IDetector_const_sptr det, const double waveLength) const;
+      /// The geometry of the detectors of all the spectra, built once for the current instrument and spectra
+      boost::shared_ptr<const DetectorGeometryTable> detectorGeometry() const;
       //@}
 
       virtual void populateInstrumentParameters();
@@ -340,6 +344,11 @@ namespace Mantid
       /// Shared pointer to NearestNeighbours object
       mutable boost::shared_ptr<Mantid::Geometry::INearestNeighbours> m_nearestNeighbours;
 
+      /// The last detector geometry table given out, reused while it is valid
+      mutable boost::shared_ptr<const DetectorGeometryTable> m_detectorGeometry;
+      /// Lock for building the detector geometry table
+      mutable Kernel::Mutex m_detectorGeometryMutex;
+
       /// Getter for the dimension id based on the axis.
       std::string getDimensionIdFromAxis(const int& axisIndex) const;
 
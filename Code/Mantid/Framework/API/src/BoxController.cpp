@@ -162,10 +162,11 @@ namespace API
     return xmlstream.str().c_str();
   }
   /** the function left for compartibility with the previous bc python interface. 
-   @return  -- the file name of the file used for backup if file backup mode is enabled or emtpy sting if the workspace is not file backed   */
+   @return  -- the file name of the file used for backup if file backup mode is enabled or emtpy sting if the workspace is not file backed
+               or keeps its events in memory  */
    std::string BoxController::getFilename()const
    {
-       if(m_fileIO)
+       if(m_fileIO && !m_fileIO->isInMemory())
            return m_fileIO->getFileName();
        else
            return "";
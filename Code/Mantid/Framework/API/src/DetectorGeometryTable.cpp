@@ -0,0 +1,122 @@
+#include "MantidAPI/DetectorGeometryTable.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
+
+namespace Mantid
+{
+namespace API
+{
+  using namespace Geometry;
+
+  /**
+   * Build the table for all the spectra of a workspace.
+   * @param workspace :: the workspace
+   * @throws Exception::InstrumentDefinitionError if the instrument has no source or sample, or they are at the same place
+   */
+  DetectorGeometryTable::DetectorGeometryTable(const MatrixWorkspace & workspace) :
+    m_parameterStamp(workspace.constInstrumentParameters().getModificationStamp()), m_l1(0.0)
+  {
+    Instrument_const_sptr instrument = workspace.getInstrument();
+    m_baseInstrument = instrument->isParametrized() ? instrument->baseInstrument() : instrument;
+
+    IComponent_const_sptr source = instrument->getSource();
+    IComponent_const_sptr sample = instrument->getSample();
+    if ( source == NULL || sample == NULL )
+    {
+      throw Kernel::Exception::InstrumentDefinitionError("Instrument not sufficiently defined: failed to get source and/or sample");
+    }
+    try
+    {
+      m_l1 = source->getDistance(*sample);
+    }
+    catch (Kernel::Exception::NotFoundError &)
+    {
+      throw Kernel::Exception::InstrumentDefinitionError("Unable to calculate source-sample distance", workspace.getTitle());
+    }
+    const Kernel::V3D samplePos = sample->getPos();
+    const Kernel::V3D beamLine  = samplePos - source->getPos();
+    if ( beamLine.nullVector() )
+    {
+      throw Kernel::Exception::InstrumentDefinitionError("Source and sample are at same position!");
+    }
+    const Kernel::V3D instrumentUpAxis = instrument->getReferenceFrame()->vecPointingUp();
+    const ParameterMap & pmap = workspace.constInstrumentParameters();
+
+    const size_t numberOfSpectra = workspace.getNumberHistograms();
+    m_flags.resize(numberOfSpectra, 0);
+    m_detectorIDs.resize(numberOfSpectra, 0);
+    m_l2.resize(numberOfSpectra, 0.0);
+    m_twoTheta.resize(numberOfSpectra, 0.0);
+    m_signedTwoTheta.resize(numberOfSpectra, 0.0);
+    m_phi.resize(numberOfSpectra, 0.0);
+    m_efixed.resize(numberOfSpectra, EMPTY_DBL());
+    m_detectorIDsStamps.resize(numberOfSpectra, 0);
+    for (size_t i = 0; i < numberOfSpectra; ++i)
+    {
+      m_detectorIDsStamps[i] = workspace.getSpectrum(i)->getDetectorIDsStamp();
+    }
+
+    PARALLEL_FOR_IF( workspace.threadSafe() )
+    for (int64_t i = 0; i < int64_t(numberOfSpectra); ++i)
+    {
+      IDetector_const_sptr det;
+      try
+      {
+        det = workspace.getDetector(i);
+      }
+      catch (Kernel::Exception::NotFoundError &)
+      {
+        continue;
+      }
+
+      unsigned char flags = HAS_DETECTOR;
+      if ( det->isMasked() ) flags |= MASKED;
+      m_detectorIDs[i] = det->getID();
+      if ( det->isMonitor() )
+      {
+        flags |= MONITOR;
+        m_l2[i] = det->getDistance(*source) - m_l1;
+      }
+      else
+      {
+        m_l2[i] = det->getDistance(*sample);
+        m_twoTheta[i] = det->getTwoTheta(samplePos, beamLine);
+        m_signedTwoTheta[i] = det->getSignedTwoTheta(samplePos, beamLine, instrumentUpAxis);
+        m_phi[i] = det->getPhi();
+        try
+        {
+          Parameter_sptr par = pmap.getRecursive(det.get(),"Efixed");
+          if (par) m_efixed[i] = par->value<double>();
+        }
+        catch (std::runtime_error&) { /* Throws if a DetectorGroup */ }
+      }
+      m_flags[i] = flags;
+    }
+  }
+
+  /**
+   * @param workspace :: a workspace
+   * @return true if the table holds the geometry of the spectra of the workspace: it has the same instrument,
+   *         with the same parameters, and the detector IDs of its spectra were not changed since the table was built.
+   */
+  bool DetectorGeometryTable::isValidFor(const MatrixWorkspace & workspace) const
+  {
+    if ( workspace.getNumberHistograms() != size() ) return false;
+    if ( workspace.constInstrumentParameters().getModificationStamp() != m_parameterStamp ) return false;
+    Instrument_const_sptr instrument = workspace.getInstrument();
+    Instrument_const_sptr baseInstrument = instrument->isParametrized() ? instrument->baseInstrument() : instrument;
+    if ( baseInstrument != m_baseInstrument ) return false;
+
+    const size_t numberOfSpectra = size();
+    for (size_t i = 0; i < numberOfSpectra; ++i)
+    {
+      if ( workspace.getSpectrum(i)->getDetectorIDsStamp() != m_detectorIDsStamps[i] ) return false;
+    }
+    return true;
+  }
+
+} // namespace API
+} // namespace Mantid
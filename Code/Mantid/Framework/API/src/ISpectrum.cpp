@@ -1,10 +1,22 @@
 #include "MantidAPI/ISpectrum.h"
 #include "MantidKernel/System.h"
+#include <Poco/AtomicCounter.h>
 
 namespace Mantid
 {
 namespace API
 {
+  namespace
+  {
+    /// The last stamp given to the detector IDs of a spectrum
+    Poco::AtomicCounter g_lastDetectorIDsStamp;
+
+    /// @return a stamp that no detector IDs have had
+    size_t newDetectorIDsStamp()
+    {
+      return static_cast<size_t>(static_cast<unsigned int>(++g_lastDetectorIDsStamp));
+    }
+  }
 
 
   //----------------------------------------------------------------------------------------------
@@ -12,7 +24,7 @@ namespace API
    */
   ISpectrum::ISpectrum()
   : m_specNo(0),
-    detectorIDs(), refX(), refDx()
+    detectorIDs(), m_detectorIDsStamp(newDetectorIDsStamp()), refX(), refDx()
   {
   }
 
@@ -21,7 +33,7 @@ namespace API
    */
   ISpectrum::ISpectrum(const specid_t specNo)
   : m_specNo(specNo),
-    detectorIDs(), refX(), refDx()
+    detectorIDs(), m_detectorIDsStamp(newDetectorIDsStamp()), refX(), refDx()
   {
   }
     
@@ -29,7 +41,7 @@ namespace API
   /** Copy constructor
    */
   ISpectrum::ISpectrum(const ISpectrum& other)
-  : m_specNo(other.m_specNo), detectorIDs(other.detectorIDs),
+  : m_specNo(other.m_specNo), detectorIDs(other.detectorIDs), m_detectorIDsStamp(other.m_detectorIDsStamp),
     refX(other.refX), refDx(other.refDx)
   {
   }
@@ -43,6 +55,7 @@ namespace API
   {
     m_specNo = other.m_specNo;
     detectorIDs = other.detectorIDs;
+    m_detectorIDsStamp = other.m_detectorIDsStamp;
   }
 
 
@@ -154,6 +167,7 @@ namespace API
   void ISpectrum::addDetectorID(const detid_t detID)
   {
     this->detectorIDs.insert( detID );
+    m_detectorIDsStamp = newDetectorIDsStamp();
   }
 
   /** Add a set of detector IDs to the set of detector IDs
@@ -164,6 +178,7 @@ namespace API
   {
     if (detIDs.size() == 0) return;
     this->detectorIDs.insert( detIDs.begin(), detIDs.end() );
+    m_detectorIDsStamp = newDetectorIDsStamp();
   }
 
   /** Add a vector of detector IDs to the set of detector IDs
@@ -174,6 +189,7 @@ namespace API
   {
     if (detIDs.size() == 0) return;
     this->detectorIDs.insert( detIDs.begin(), detIDs.end() );
+    m_detectorIDsStamp = newDetectorIDsStamp();
   }
 
   // --------------------------------------------------------------------------
@@ -185,6 +201,7 @@ namespace API
   {
     this->detectorIDs.clear();
     this->detectorIDs.insert( detID );
+    m_detectorIDsStamp = newDetectorIDsStamp();
   }
 
   /** Set the detector IDs to be the set given.
@@ -194,6 +211,7 @@ namespace API
   void ISpectrum::setDetectorIDs(const std::set<detid_t>& detIDs)
   {
     detectorIDs = detIDs;
+    m_detectorIDsStamp = newDetectorIDsStamp();
   }
 
   /** Set the detector IDs to be the set given (move version).
@@ -207,6 +225,7 @@ namespace API
 #else
     detectorIDs = detIDs; // No moving on the Mac :(
 #endif
+    m_detectorIDsStamp = newDetectorIDsStamp();
   }
 
   // --------------------------------------------------------------------------
@@ -230,17 +249,30 @@ namespace API
   void ISpectrum::clearDetectorIDs()
   {
     this->detectorIDs.clear();
+    m_detectorIDsStamp = newDetectorIDsStamp();
     return;
   }
 
   // --------------------------------------------------------------------------
   /** Get a mutable reference to the detector IDs set.
+   *  The IDs may be changed through it, so this gives them a new stamp.
    */
   std::set<detid_t>& ISpectrum::getDetectorIDs()
   {
+    m_detectorIDsStamp = newDetectorIDsStamp();
     return this->detectorIDs;
   }
 
+  // --------------------------------------------------------------------------
+  /** @return a stamp of the detector IDs. It changes to a value no other spectrum had whenever
+   *  the IDs are changed (or may be, through the non-const getDetectorIDs()), and is copied with them.
+   *  Caches built from the detector IDs can compare it to tell whether they are out of date.
+   */
+  size_t ISpectrum::getDetectorIDsStamp() const
+  {
+    return m_detectorIDsStamp;
+  }
+
 
 
   // ---------------------------------------------------------
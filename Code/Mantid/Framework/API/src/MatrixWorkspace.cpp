@@ -3,6 +3,7 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/MatrixWorkspaceMDIterator.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/DetectorGeometryTable.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/NearestNeighboursFactory.h"
@@ -796,6 +797,22 @@ namespace Mantid
       return det->getTwoTheta(samplePos,beamLine);
     }
 
+    /** Returns the geometry of the detectors of all the spectra. The table is built the first time
+     *  and given again as long as the instrument, its parameters and the detector IDs of the spectra
+     *  stay the same. Workspaces created from this one by the WorkspaceFactory start with the same table.
+     *  @return the table, which must not be kept after changing the workspace
+     *  @throws InstrumentDefinitionError if source or sample is missing, or they are in the same place
+     */
+    boost::shared_ptr<const DetectorGeometryTable> MatrixWorkspace::detectorGeometry() const
+    {
+      Kernel::Mutex::ScopedLock lock(m_detectorGeometryMutex);
+      if ( !m_detectorGeometry || !m_detectorGeometry->isValidFor(*this) )
+      {
+        m_detectorGeometry.reset(new DetectorGeometryTable(*this));
+      }
+      return m_detectorGeometry;
+    }
+
     /**Calculates the distance a neutron coming from the sample will have deviated from a
     *  straight tragetory before hitting a detector. If calling this function many times
     *  for the same detector you can call this function once, with waveLength=1, and use
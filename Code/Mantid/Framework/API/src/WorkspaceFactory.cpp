@@ -119,6 +119,9 @@ void WorkspaceFactoryImpl::initializeFromParent(const MatrixWorkspace_const_sptr
       // Copy spectrum number and detector IDs
       childSpec->copyInfoFrom(*parentSpec);
     }
+    // The geometry is the same, as long as the child keeps the parameters and spectra (checked when it is used)
+    Kernel::Mutex::ScopedLock lock(parent->m_detectorGeometryMutex);
+    child->m_detectorGeometry = parent->m_detectorGeometry;
   }
 
   // deal with axis
@@ -187,7 +190,14 @@ MatrixWorkspace_sptr WorkspaceFactoryImpl::create(const std::string& className,
           throw std::runtime_error("There is not enough memory to allocate the workspace");
       }
 
-      if ( !isCompressedOK )
+      int useMapping = 0;
+      Kernel::ConfigService::Instance().getValue("ManagedWorkspace.UseMemoryMapping", useMapping);
+      if ( !isCompressedOK && useMapping > 0 )
+      {
+          ws = boost::dynamic_pointer_cast<MatrixWorkspace>(this->create("MappedWorkspace2D"));
+          g_log.information("Created a MappedWorkspace2D");
+      }
+      else if ( !isCompressedOK )
       {
           ws = boost::dynamic_pointer_cast<MatrixWorkspace>(this->create("ManagedWorkspace2D"));
           g_log.information("Created a ManagedWorkspace2D");
@@ -201,7 +211,8 @@ MatrixWorkspace_sptr WorkspaceFactoryImpl::create(const std::string& className,
   else
   {
       // No need for a Managed Workspace
-      if ( is2D && ( className.substr(0,7) == "Managed" || className.substr(0,10) == "Compressed"))
+      if ( is2D && ( className.substr(0,7) == "Managed" || className.substr(0,10) == "Compressed"
+                     || className.substr(0,6) == "Mapped" ))
           ws = boost::dynamic_pointer_cast<MatrixWorkspace>(this->create("Workspace2D"));
       else
           ws = boost::dynamic_pointer_cast<MatrixWorkspace>(this->create(className));
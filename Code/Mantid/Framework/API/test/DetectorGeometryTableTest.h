@@ -0,0 +1,138 @@
+#ifndef MANTID_API_DETECTORGEOMETRYTABLETEST_H_
+#define MANTID_API_DETECTORGEOMETRYTABLETEST_H_
+
+#include "MantidAPI/DetectorGeometryTable.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ObjComponent.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/Exception.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <cxxtest/TestSuite.h>
+#include <boost/make_shared.hpp>
+#include <cmath>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class DetectorGeometryTableTest : public CxxTest::TestSuite
+{
+  /** 4 spectra: detector 1 at 45 degrees above the beam, detector 2 at 90 degrees below it,
+   *  monitor 3 between the source and the sample, and no detector for the last spectrum */
+  boost::shared_ptr<MatrixWorkspace> makeWorkspace()
+  {
+    boost::shared_ptr<MatrixWorkspace> ws = boost::make_shared<WorkspaceTester>();
+    ws->initialize(4,2,1);
+    Instrument_sptr inst(new Instrument("TestInstrument"));
+
+    ObjComponent * source = new ObjComponent("moderator", inst.get());
+    source->setPos(V3D(0,0,-10));
+    inst->add(source);
+    inst->markAsSource(source);
+    ObjComponent * sample = new ObjComponent("sample", inst.get());
+    inst->add(sample);
+    inst->markAsSamplePos(sample);
+
+    Detector * det = new Detector("pixel", 1, inst.get());
+    det->setPos(V3D(0,1,1));
+    inst->add(det);
+    inst->markAsDetector(det);
+    det = new Detector("pixel", 2, inst.get());
+    det->setPos(V3D(0,-2,0));
+    inst->add(det);
+    inst->markAsDetector(det);
+    det = new Detector("monitor", 3, inst.get());
+    det->setPos(V3D(0,0,-5));
+    inst->add(det);
+    inst->markAsMonitor(det);
+
+    ws->setInstrument(inst);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      ws->getSpectrum(i)->setDetectorID(detid_t(i+1));
+    }
+    ws->getSpectrum(3)->clearDetectorIDs();
+    return ws;
+  }
+
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DetectorGeometryTableTest *createSuite() { return new DetectorGeometryTableTest(); }
+  static void destroySuite( DetectorGeometryTableTest *suite ) { delete suite; }
+
+  void test_geometry()
+  {
+    auto ws = makeWorkspace();
+    IDetector_const_sptr det2 = ws->getDetector(1);
+    ws->instrumentParameters().addDouble(det2.get(), "Efixed", 3.5);
+
+    DetectorGeometryTable table(*ws);
+    TS_ASSERT_EQUALS( table.size(), 4 );
+    TS_ASSERT_DELTA( table.l1(), 10.0, 1e-10 );
+
+    TS_ASSERT( table.hasDetector(0) );
+    TS_ASSERT( !table.isMonitor(0) );
+    TS_ASSERT_EQUALS( table.detectorID(0), 1 );
+    TS_ASSERT_DELTA( table.l2(0), std::sqrt(2.0), 1e-10 );
+    TS_ASSERT_DELTA( table.twoTheta(0), M_PI/4, 1e-10 );
+    TS_ASSERT_DELTA( table.signedTwoTheta(0), M_PI/4, 1e-10 );
+    TS_ASSERT_DELTA( table.phi(0), ws->getDetector(0)->getPhi(), 1e-10 );
+    TS_ASSERT_EQUALS( table.efixed(0), EMPTY_DBL() );
+
+    TS_ASSERT_DELTA( table.l2(1), 2.0, 1e-10 );
+    TS_ASSERT_DELTA( table.twoTheta(1), M_PI/2, 1e-10 );
+    TS_ASSERT_DELTA( table.signedTwoTheta(1), -M_PI/2, 1e-10 );
+    TS_ASSERT_DELTA( table.efixed(1), 3.5, 1e-10 );
+
+    // Monitor: source-monitor distance minus L1
+    TS_ASSERT( table.isMonitor(2) );
+    TS_ASSERT_DELTA( table.l2(2), -5.0, 1e-10 );
+
+    TS_ASSERT( !table.hasDetector(3) );
+  }
+
+  void test_workspace_keeps_the_table_until_it_changes()
+  {
+    auto ws = makeWorkspace();
+    boost::shared_ptr<const DetectorGeometryTable> table = ws->detectorGeometry();
+    TS_ASSERT( table->isValidFor(*ws) );
+    TS_ASSERT_EQUALS( ws->detectorGeometry(), table );
+
+    // A change of the parameters
+    ws->instrumentParameters().addBool(ws->getDetector(0).get(), "masked", true);
+    TS_ASSERT( !table->isValidFor(*ws) );
+    boost::shared_ptr<const DetectorGeometryTable> newTable = ws->detectorGeometry();
+    TS_ASSERT_DIFFERS( newTable, table );
+    TS_ASSERT( newTable->isMasked(0) );
+    TS_ASSERT( !newTable->isMasked(1) );
+    TS_ASSERT_EQUALS( ws->detectorGeometry(), newTable );
+
+    // A change of the detectors of a spectrum
+    ws->getSpectrum(3)->setDetectorID(2);
+    TS_ASSERT( !newTable->isValidFor(*ws) );
+    TS_ASSERT( ws->detectorGeometry()->hasDetector(3) );
+    TS_ASSERT_DELTA( ws->detectorGeometry()->l2(3), 2.0, 1e-10 );
+
+    // Reading the detectors keeps the table
+    newTable = ws->detectorGeometry();
+    const MatrixWorkspace & constWS = *ws;
+    TS_ASSERT_EQUALS( constWS.getSpectrum(3)->getDetectorIDs().size(), 1 );
+    TS_ASSERT( newTable->isValidFor(*ws) );
+  }
+
+  void test_no_source_throws()
+  {
+    boost::shared_ptr<MatrixWorkspace> ws = boost::make_shared<WorkspaceTester>();
+    ws->initialize(1,2,1);
+    TS_ASSERT_THROWS( ws->detectorGeometry(), Kernel::Exception::InstrumentDefinitionError );
+  }
+
+};
+
+
+#endif /* MANTID_API_DETECTORGEOMETRYTABLETEST_H_ */
@@ -94,6 +94,39 @@ public:
     TS_ASSERT( s.getDetectorIDs().empty() );
   }
 
+  void test_detectorIDs_stamp()
+  {
+    SpectrumTester a(1);
+    SpectrumTester b(2);
+    TS_ASSERT_DIFFERS( a.getDetectorIDsStamp(), b.getDetectorIDsStamp() );
+
+    size_t stamp = a.getDetectorIDsStamp();
+    a.addDetectorID(123);
+    TS_ASSERT_DIFFERS( a.getDetectorIDsStamp(), stamp );
+
+    // Reading the IDs keeps the stamp
+    stamp = a.getDetectorIDsStamp();
+    const SpectrumTester & constA = a;
+    TS_ASSERT_EQUALS( constA.getDetectorIDs().size(), 1 );
+    TS_ASSERT( a.hasDetectorID(123) );
+    TS_ASSERT_EQUALS( a.getDetectorIDsStamp(), stamp );
+
+    // ... unless they could be changed
+    a.getDetectorIDs().insert(456);
+    TS_ASSERT_DIFFERS( a.getDetectorIDsStamp(), stamp );
+
+    // The stamp goes with the IDs
+    b.copyInfoFrom(a);
+    TS_ASSERT_EQUALS( b.getDetectorIDsStamp(), a.getDetectorIDsStamp() );
+    SpectrumTester c(a);
+    TS_ASSERT_EQUALS( c.getDetectorIDsStamp(), a.getDetectorIDsStamp() );
+
+    stamp = a.getDetectorIDsStamp();
+    a.clearDetectorIDs();
+    TS_ASSERT_DIFFERS( a.getDetectorIDsStamp(), stamp );
+    TS_ASSERT_DIFFERS( a.getDetectorIDsStamp(), c.getDetectorIDsStamp() );
+  }
+
 
 };
 
@@ -71,6 +71,11 @@ namespace Mantid
       bool getIntersectionRegion(API::MatrixWorkspace_const_sptr outputWS, const std::vector<double> & verticalAxis,
                                  const Geometry::Quadrilateral & inputQ,
                                  size_t &qstart, size_t &qend, size_t &en_start, size_t &en_end) const;
+      /// Create the workspaces the threads accumulate the rebinned data into
+      std::vector<API::MatrixWorkspace_sptr> createPartialOutputs(API::MatrixWorkspace_sptr outputWS, const bool parallel) const;
+      /// Add the data accumulated by the threads to the output workspace
+      void addPartialOutputs(const std::vector<API::MatrixWorkspace_sptr> & partialOutputs,
+                             API::MatrixWorkspace_sptr outputWS) const;
       /// Compute sqrt of errors and put back in bin width division if necessary
       void normaliseOutput(API::MatrixWorkspace_sptr outputWS, API::MatrixWorkspace_const_sptr inputWS);
 
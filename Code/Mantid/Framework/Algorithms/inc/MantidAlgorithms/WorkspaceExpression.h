@@ -0,0 +1,90 @@
+#ifndef MANTID_ALGORITHMS_WORKSPACEEXPRESSION_H_
+#define MANTID_ALGORITHMS_WORKSPACEEXPRESSION_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/MatrixWorkspace.h"
+#include <boost/shared_ptr.hpp>
+
+namespace Mantid
+{
+namespace Algorithms
+{
+  /** An arithmetic expression of workspaces and numbers which is evaluated in a single pass over the data.
+
+      Each of the Plus, Minus, Multiply and Divide algorithms (and the workspace operator overloads running them)
+      reads its inputs and writes a whole new workspace, so a chain of operations goes through memory once per
+      operation. Operations on WorkspaceExpression objects only build the expression; evaluate() then works out
+      all of it spectrum by spectrum, keeping the intermediate results in per-thread buffers of the size of a
+      spectrum, and creates the one output workspace:
+
+      @code
+        MatrixWorkspace_sptr normalised = ((WorkspaceExpression(sample) - background) / vanadium * scale).evaluate();
+      @endcode
+
+      The errors are propagated as the corresponding algorithms do, treating all operands as uncorrelated.
+      The output has the binning, instrument, spectra and logs of the biggest workspace of the expression.
+      The other workspaces must either have the same number of spectra and bins, or one spectrum with the same
+      bins (used for all the spectra) or be single values. Unlike the algorithms, masked bins and Y units are not
+      combined: the output takes those of the biggest workspace.
+
+      Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+      This file is part of Mantid.
+
+      Mantid is free software; you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation; either version 3 of the License, or
+      (at your option) any later version.
+
+      Mantid is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+      File change history is stored at: <https://github.com/mantidproject/mantid>
+      Code Documentation is available at: <http://doxygen.mantidproject.org>
+    */
+  class DLLExport WorkspaceExpression
+  {
+  public:
+    /// The operations of the nodes of an expression
+    enum Operation { VALUE, WORKSPACE, PLUS, MINUS, MULTIPLY, DIVIDE, NEGATE, EXPONENTIAL, LOGARITHM };
+
+    WorkspaceExpression(const API::MatrixWorkspace_const_sptr & workspace);
+    WorkspaceExpression(const API::MatrixWorkspace_sptr & workspace);
+    WorkspaceExpression(const double value, const double error = 0.0);
+
+    API::MatrixWorkspace_sptr evaluate() const;
+
+    WorkspaceExpression operator-() const;
+
+    /// An operation on two expressions, as made by the operators
+    WorkspaceExpression(const Operation operation, const WorkspaceExpression & lhs, const WorkspaceExpression & rhs);
+    /// An operation on one expression
+    WorkspaceExpression(const Operation operation, const WorkspaceExpression & operand);
+
+    struct Node;
+
+  private:
+    /// The root of the expression. Nodes are immutable, so they are shared between expressions.
+    boost::shared_ptr<const Node> m_node;
+  };
+
+  DLLExport WorkspaceExpression operator+(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs);
+  DLLExport WorkspaceExpression operator-(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs);
+  DLLExport WorkspaceExpression operator*(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs);
+  DLLExport WorkspaceExpression operator/(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs);
+  /// The natural exponential of each value, as done by the Exponential algorithm
+  DLLExport WorkspaceExpression exponential(const WorkspaceExpression & operand);
+  /// The natural logarithm of each value, as done by the Logarithm algorithm: 0 for values which are not positive
+  DLLExport WorkspaceExpression logarithm(const WorkspaceExpression & operand);
+
+} // namespace Algorithms
+} // namespace Mantid
+
+#endif /* MANTID_ALGORITHMS_WORKSPACEEXPRESSION_H_ */
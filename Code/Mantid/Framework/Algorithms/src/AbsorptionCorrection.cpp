@@ -335,21 +335,17 @@ void AbsorptionCorrection::calculateDistances(const IDetector_const_sptr& detect
   
   for (size_t i = 0; i < m_numVolumeElements; ++i)
   {
-    // Create track for distance in cylinder between scattering point and detector
+    // Distance in the sample between scattering point and detector
     V3D direction = detectorPos - m_elementPositions[i];
     direction.normalize();
-    Track outgoing(m_elementPositions[i], direction);
-    int temp = m_sampleObject->interceptSurface(outgoing);
-
-    /* Most of the time, the number of hits is 1. Sometime, we have more than one intersection due to
-     * arithmetic imprecision. If it is the case, then selecting the first intersection is valid.
-     * In principle, one could check the consistency of all distances if hits is larger than one by doing:
-     * Mantid::Geometry::Track::LType::const_iterator it=outgoing.begin();
-     * and looping until outgoing.end() checking the distances with it->Dist
+    double distance(0.0);
+
+    /* Sometimes there is more than one intersection due to arithmetic imprecision:
+     * the first point where the track leaves the sample is used.
      */
     // Not hitting the cylinder from inside, usually means detector is badly defined,
     // i.e, position is (0,0,0).
-    if (temp < 1)
+    if ( !m_sampleObject->exitDistance(m_elementPositions[i], direction, distance) )
     {
       // FOR NOW AT LEAST, JUST IGNORE THIS ERROR AND USE A ZERO PATH LENGTH, WHICH I RECKON WILL MAKE A
       // NEGLIGIBLE DIFFERENCE ANYWAY (ALWAYS SEEMS TO HAPPEN WITH ELEMENT RIGHT AT EDGE OF SAMPLE)
@@ -363,7 +359,7 @@ void AbsorptionCorrection::calculateDistances(const IDetector_const_sptr& detect
     }
     else // The normal situation
     {
-      L2s[i] = outgoing.begin()->distFromStart;
+      L2s[i] = distance;
     }
   }
 }
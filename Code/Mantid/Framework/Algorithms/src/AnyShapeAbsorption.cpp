@@ -109,16 +109,16 @@ void AnyShapeAbsorption::initialiseCachedDistances()
         // Check if the current point is within the object. If not, skip.
         if ( integrationVolume.isValid(currentPosition) )
         {
-          // Create track for distance in sample before scattering point
-          Track incoming(currentPosition, m_beamDirection*-1.0);
+          // Distance in sample before scattering point
+          double L1(0.0);
           // We have an issue where occasionally, even though a point is within
           // the object a track segment to the surface isn't correctly created.
           // In the context of this algorithm I think it's safe to just chuck away
           // the element in this case.
           // This will also throw away points that are inside a gauge volume but outside the sample
-          if ( m_sampleObject->interceptSurface(incoming) > 0 )
+          if ( m_sampleObject->exitDistance(currentPosition, m_beamDirection*-1.0, L1) )
           {
-            m_L1s.push_back(incoming.begin()->distFromStart);
+            m_L1s.push_back(L1);
             m_elementPositions.push_back(currentPosition);
             // Also calculate element volume here
             m_elementVolumes.push_back(XSliceThickness*YSliceThickness*ZSliceThickness);
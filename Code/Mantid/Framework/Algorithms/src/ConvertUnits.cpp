@@ -25,12 +25,11 @@ The units currently available to this algorithm are listed [[Unit Factory|here]]
 #include "MantidAlgorithms/ConvertUnits.h"
 #include "MantidAPI/WorkspaceValidators.h"
 #include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/DetectorGeometryTable.h"
 #include "MantidAPI/Run.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/EventWorkspace.h"
-#include <boost/function.hpp>
-#include <boost/bind.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <cfloat>
 #include <iostream>
@@ -56,8 +55,6 @@ void ConvertUnits::initDocs()
 using namespace Kernel;
 using namespace API;
 using namespace DataObjects;
-using boost::function;
-using boost::bind;
 
 /// Default constructor
 ConvertUnits::ConvertUnits() : Algorithm(), m_numberOfSpectra(0), m_inputEvents(false)
@@ -385,32 +382,14 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit, API::MatrixWo
   Progress prog(this,0.2,1.0,m_numberOfSpectra);
   int64_t numberOfSpectra_i = static_cast<int64_t>(m_numberOfSpectra); // cast to make openmp happy
 
-  // Get a pointer to the instrument contained in the workspace
-  Instrument_const_sptr instrument = outputWS->getInstrument();
-  // Get the parameter map
-  const ParameterMap& pmap = outputWS->constInstrumentParameters();
-
   // Get the unit object for each workspace
   Kernel::Unit_const_sptr outputUnit = outputWS->getAxis(0)->unit();
 
+  // The geometry of all the spectra, shared with the input workspace and later conversions if they have not changed
+  boost::shared_ptr<const DetectorGeometryTable> geometry = outputWS->detectorGeometry();
   // Get the distance between the source and the sample (assume in metres)
-  IComponent_const_sptr source = instrument->getSource();
-  IComponent_const_sptr sample = instrument->getSample();
-  if ( source == NULL || sample == NULL )
-  {
-    throw Exception::InstrumentDefinitionError("Instrubment not sufficiently defined: failed to get source and/or sample");
-  }
-  double l1;
-  try
-  {
-    l1 = source->getDistance(*sample);
-    g_log.debug() << "Source-sample distance: " << l1 << std::endl;
-  }
-  catch (Exception::NotFoundError &)
-  {
-    g_log.error("Unable to calculate source-sample distance");
-    throw Exception::InstrumentDefinitionError("Unable to calculate source-sample distance", outputWS->getTitle());
-  }
+  const double l1 = geometry->l1();
+  g_log.debug() << "Source-sample distance: " << l1 << std::endl;
 
   int failedDetectorCount = 0;
 
@@ -463,7 +442,6 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit, API::MatrixWo
 
   std::vector<std::string> parameters = outputWS->getInstrument()->getStringParameter("show-signed-theta");
   bool bUseSignedVersion = (!parameters.empty()) && find(parameters.begin(), parameters.end(), "Always") != parameters.end();
-  function<double(IDetector_const_sptr)> thetaFunction = bUseSignedVersion ? bind(&MatrixWorkspace::detectorSignedTwoTheta, outputWS, _1) : bind(&MatrixWorkspace::detectorTwoTheta, outputWS, _1);
 
   // Loop over the histograms (detector spectra)
   PARALLEL_FOR1(outputWS)
@@ -474,37 +452,32 @@ void ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit, API::MatrixWo
 
     try
     {
-      // Now get the detector object for this histogram
-      IDetector_const_sptr det = outputWS->getDetector(i);
+      // Check that there is a detector for this histogram
+      if ( !geometry->hasDetector(i) )
+        throw Exception::NotFoundError("No detector found for workspace index", i);
       // Get the sample-detector distance for this detector (in metres)
       double l2, twoTheta;
-      if ( ! det->isMonitor() )
+      if ( ! geometry->isMonitor(i) )
       {
-        l2 = det->getDistance(*sample);
+        l2 = geometry->l2(i);
         // The scattering angle for this detector (in radians).
-        twoTheta = thetaFunction(det);
+        twoTheta = bUseSignedVersion ? geometry->signedTwoTheta(i) : geometry->twoTheta(i);
         // If an indirect instrument, try getting Efixed from the geometry
         if (emode==2) // indirect
         {
           if ( efixed == EMPTY_DBL() )
           {
-          try
-          {
-            Parameter_sptr par = pmap.getRecursive(det.get(),"Efixed");
-            if (par) 
-            {
-              efixed = par->value<double>();
-              g_log.debug() << "Detector: " << det->getID() << " EFixed: " << efixed << "\n";
-            }
-          }
-          catch (std::runtime_error&) { /* Throws if a DetectorGroup, use single provided value */ }
+            // EMPTY_DBL() if a DetectorGroup or no parameter, use single provided value
+            efixed = geometry->efixed(i);
+            if ( efixed != EMPTY_DBL() )
+              g_log.debug() << "Detector: " << geometry->detectorID(i) << " EFixed: " << efixed << "\n";
           }
         }
       }
       else  // If this is a monitor then make l1+l2 = source-detector distance and twoTheta=0
       {
-        l2 = det->getDistance(*source);
-        l2 = l2-l1;
+        // Source-detector distance minus l1
+        l2 = geometry->l2(i);
         twoTheta = 0.0;
         efixed = DBL_MIN;
         // Energy transfer is meaningless for a monitor, so set l2 to 0.
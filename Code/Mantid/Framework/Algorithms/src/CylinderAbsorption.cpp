@@ -152,11 +152,10 @@ void CylinderAbsorption::initialiseCachedDistances()
         // Remember that our cylinder has its axis along the y axis
         m_elementPositions[counter](R * sin(phi), z, R * cos(phi));
         assert(m_sampleObject->isValid(m_elementPositions[counter]));
-        // Create track for distance in cylinder before scattering point
-        Track incoming(m_elementPositions[counter], m_beamDirection*-1.0);
-
-        m_sampleObject->interceptSurface(incoming);
-        m_L1s[counter] = incoming.begin()->distFromStart;
+        // Distance in cylinder before scattering point
+        double L1(0.0);
+        m_sampleObject->exitDistance(m_elementPositions[counter], m_beamDirection*-1.0, L1);
+        m_L1s[counter] = L1;
 
         // Also calculate element volumes here
         const double outerR = R + (m_deltaR / 2.0);
@@ -21,6 +21,8 @@ The algorithm can be used with an [[EventWorkspace]] input, and will create an E
 
 The main difference vs. using a Workspace2D is that the event lists from all the incoming pixels are simply appended in the grouped spectra; this means that you can rebin the resulting spectra to finer bins with no loss of data. In fact, it is unnecessary to bin your incoming data at all; binning can be performed as the very last step.
 
+The events of each group are counted first, so that the output event lists are allocated once at their final size, and the events of all the spectra are then copied in parallel. Set SortEvents to get the output sorted by time-of-flight.
+
 ==Previous Versions==
 ===Version 1===
 Version 1 did not support the use of workspaces to carry grouping workspaces and only worked with CalFiles.
@@ -60,6 +62,69 @@ namespace Algorithms
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(DiffractionFocussing2)
 
+namespace
+{
+  /// Size the events of a list, whose type is already set, to hold n events
+  void resizeEvents(EventList & el, const size_t n)
+  {
+    switch (el.getEventType())
+    {
+    case TOF:
+      el.getEvents().resize(n);
+      break;
+    case WEIGHTED:
+      el.getWeightedEvents().resize(n);
+      break;
+    case WEIGHTED_NOTIME:
+      el.getWeightedEventsNoTime().resize(n);
+      break;
+    }
+    el.setSortOrder(UNSORTED);
+  }
+
+  /// Copy events into out, from the index offset, converting them to the type of out
+  template<class T1, class T2>
+  void copyEvents(const std::vector<T1> & in, std::vector<T2> & out, const size_t offset)
+  {
+    typename std::vector<T2>::iterator dest = out.begin() + offset;
+    for (typename std::vector<T1>::const_iterator it = in.begin(); it != in.end(); ++it, ++dest)
+    {
+      *dest = T2(*it);
+    }
+  }
+
+  /** Copy the events of a list into a slice of the events of another one, whose event type must be
+   *  at least as general as the type of the input
+   *  @param in :: The events to copy
+   *  @param out :: The list to copy them into, already sized to hold them
+   *  @param offset :: The index of the first event of the slice in out
+   */
+  void copyEvents(const EventList & in, EventList & out, const size_t offset)
+  {
+    const EventType inType = in.getEventType();
+    switch (out.getEventType())
+    {
+    case TOF:
+      copyEvents(in.getEvents(), out.getEvents(), offset);
+      break;
+    case WEIGHTED:
+      if (inType == TOF)
+        copyEvents(in.getEvents(), out.getWeightedEvents(), offset);
+      else
+        copyEvents(in.getWeightedEvents(), out.getWeightedEvents(), offset);
+      break;
+    case WEIGHTED_NOTIME:
+      if (inType == TOF)
+        copyEvents(in.getEvents(), out.getWeightedEventsNoTime(), offset);
+      else if (inType == WEIGHTED)
+        copyEvents(in.getWeightedEvents(), out.getWeightedEventsNoTime(), offset);
+      else
+        copyEvents(in.getWeightedEventsNoTime(), out.getWeightedEventsNoTime(), offset);
+      break;
+    }
+  }
+}
+
 /// Sets documentation strings for this algorithm
 void DiffractionFocussing2::initDocs()
 {
@@ -102,6 +167,9 @@ void DiffractionFocussing2::init()
 
   declareProperty("PreserveEvents", true, "Keep the output workspace as an EventWorkspace, if the input has events (default).\n"
       "If false, then the workspace gets converted to a Workspace2D histogram.");
+
+  declareProperty("SortEvents", false, "Sort the events of the output by time-of-flight, when events are preserved.\n"
+      "This is faster than sorting the output afterwards.");
 }
 
 
@@ -373,131 +441,90 @@ void DiffractionFocussing2::execEvent()
   g_log.debug() << nGroups << " groups found in .cal file (counting group 0).\n";
 
   EventType eventWtype = m_eventW->getEventType();
+  const bool sortEvents = getProperty("SortEvents");
 
   Progress * prog;
   prog = new Progress(this,0.2,0.25,nGroups);
 
-  // determine precount size
-  vector<size_t> size_required(this->m_validGroups.size(),0);
-  int totalHistProcess = 0;
-  for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++)
+  // ------------- Count the events of each group ----------------------
+  // Each input spectrum is copied into its own slice of the events of its group, starting at offsets[i]
+  const size_t nValidGroups = this->m_validGroups.size();
+  vector<size_t> size_required(nValidGroups,0);
+  vector<size_t> inputIndices;
+  vector<size_t> inputGroups;
+  vector<size_t> offsets;
+  for (size_t iGroup = 0; iGroup < nValidGroups; iGroup++)
   {
     const int group = this->m_validGroups[iGroup];
     const vector<size_t> &indices = this->m_wsIndices[group];
 
-    totalHistProcess += static_cast<int>(indices.size());
     for (vector<size_t>::const_iterator index = indices.begin();
          index != indices.end(); ++index)
     {
+      inputIndices.push_back(*index);
+      inputGroups.push_back(iGroup);
+      offsets.push_back(size_required[iGroup]);
       size_required[iGroup] += m_eventW->getEventList(*index).getNumberEvents();
     }
     prog->report(1, "Pre-counting");
   }
+  const int totalHistProcess = static_cast<int>(inputIndices.size());
 
   // ------------- Pre-allocate Event Lists ----------------------------
-  delete prog; prog = new Progress(this,0.25,0.3,totalHistProcess);
+  delete prog; prog = new Progress(this,0.25,0.3,static_cast<int>(nValidGroups));
 
-  // This creates and reserves the space required
-  for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++)
+  // This creates the lists, sized to hold all the events of their groups
+  for (size_t iGroup = 0; iGroup < nValidGroups; iGroup++)
+  {
+    out->getOrAddEventList(iGroup);
+  }
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int iGroup = 0; iGroup < static_cast<int>(nValidGroups); iGroup++)
   {
     const int group = this->m_validGroups[iGroup];
-    EventList & groupEL = out->getOrAddEventList(iGroup);
+    EventList & groupEL = out->getEventList(iGroup);
     groupEL.switchTo(eventWtype);
-    groupEL.reserve(size_required[iGroup]);
+    resizeEvents(groupEL, size_required[iGroup]);
     groupEL.clearDetectorIDs();
     groupEL.setSpectrumNo(group);
-    prog->reportIncrement(1, "Allocating");
+    const vector<size_t> &indices = this->m_wsIndices[group];
+    for (vector<size_t>::const_iterator index = indices.begin(); index != indices.end(); ++index)
+    {
+      groupEL.addDetectorIDs(m_eventW->getEventList(*index).getDetectorIDs());
+    }
+    prog->report("Allocating");
   }
 
   // ----------- Focus ---------------
-  delete prog; prog = new Progress(this,0.3,0.9,totalHistProcess);
+  delete prog; prog = new Progress(this,0.3,sortEvents ? 0.7 : 0.9,totalHistProcess);
 
-  if (this->m_validGroups.size() == 1)
+  // The slices are disjoint, so all the input spectra can be copied at the same time, whatever their groups
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < totalHistProcess; i++)
   {
-    g_log.information() << "Performing focussing on a single group\n";
-    // Special case of a single group - parallelize differently
-    EventList & groupEL = out->getOrAddEventList(0);
-    const int group = m_validGroups[0];
-    const std::vector<size_t> & indices = this->m_wsIndices[group];
-
-    int chunkSize = 200;
+    PARALLEL_START_INTERUPT_REGION
+    const size_t wi = inputIndices[i];
+    copyEvents(m_eventW->getEventList(wi), out->getEventList(inputGroups[i]), offsets[i]);
 
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int wiChunk=0;wiChunk<(totalHistProcess/chunkSize)+1;wiChunk++)
+    // When focussing in place, you can clear out old memory from the input one!
+    if (inPlace)
     {
-      PARALLEL_START_INTERUPT_REGION
-
-      // Perform in chunks for more efficiency
-      int max = (wiChunk+1)*chunkSize;
-      if (max > totalHistProcess) max = totalHistProcess;
-
-      // precalculate output size
-      /* size_t numEventsInChunk(0);
-      for (int wi=wiChunk*chunkSize; wi < max; wi++)
-      {
-        const int group = groupAtWorkspaceIndex[wi];
-        if (group == 1)
-        {
-          // Accumulate the chunk
-          numEventsInChunk += eventW->getEventList(wi).getNumberEvents();
-        }
-      } */
-
-      // Make a blank EventList that will accumulate the chunk.
-      EventList chunkEL;
-      chunkEL.switchTo(eventWtype);
-      //chunkEL.reserve(numEventsInChunk);
-
-      // process the chunk
-      for (int i=wiChunk*chunkSize; i < max; i++)
-      {
-        // Accumulate the chunk
-        size_t wi = indices[i];
-        chunkEL += m_eventW->getEventList(wi);
-      }
-
-      // Rejoin the chunk with the rest.
-      PARALLEL_CRITICAL( DiffractionFocussing2_JoinChunks )
-      {
-        groupEL += chunkEL;
-      }
-
-      PARALLEL_END_INTERUPT_REGION
+      boost::const_pointer_cast<EventWorkspace>(m_eventW)->getEventList(wi).clear();
     }
-    PARALLEL_CHECK_INTERUPT_REGION
+    prog->report("Appending Lists");
+    PARALLEL_END_INTERUPT_REGION
   }
-  else
+  PARALLEL_CHECK_INTERUPT_REGION
+  if (inPlace)
   {
-    // ------ PARALLELIZE BY GROUPS -------------------------
-
-    int nValidGroups = static_cast<int>(this->m_validGroups.size());
-    PARALLEL_FOR1(m_eventW)
-    for (int iGroup = 0; iGroup < nValidGroups; iGroup++)
-    {
-      PARALLEL_START_INTERUPT_REGION
-      const int group = this->m_validGroups[iGroup];
-      const std::vector<size_t> & indices = this->m_wsIndices[group];
-      for (size_t i=0; i<indices.size(); i++)
-      {
-        size_t wi = indices[i];
-
-        //In workspace index iGroup, put what was in the OLD workspace index wi
-        out->getOrAddEventList(iGroup) += m_eventW->getEventList(wi);
-
-        prog->reportIncrement(1, "Appending Lists");
+    Mantid::API::MemoryManager::Instance().releaseFreeMemory();
+  }
 
-        // When focussing in place, you can clear out old memory from the input one!
-        if (inPlace)
-        {
-          boost::const_pointer_cast<EventWorkspace>(m_eventW)->getEventList(wi).clear();
-          Mantid::API::MemoryManager::Instance().releaseFreeMemory();
-        }
-      }
-      PARALLEL_END_INTERUPT_REGION
-    }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } // (done with parallel by groups)
+  if (sortEvents)
+  {
+    delete prog; prog = new Progress(this,0.7,0.9,static_cast<int>(nValidGroups));
+    out->sortAll(TOF_SORT, prog);
+  }
 
   //Now that the data is cleaned up, go through it and set the X vectors to the input workspace we first talked about.
   delete prog; prog = new Progress(this,0.9,1.0,nGroups);
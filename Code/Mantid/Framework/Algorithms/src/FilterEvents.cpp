@@ -38,6 +38,7 @@ Wiki page [[EventFiltering]] has a detailed introduction on event filtering in M
 #include "MantidKernel/System.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/FileProperty.h"
+#include "MantidAPI/Progress.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/SplittersWorkspace.h"
@@ -505,21 +506,28 @@ namespace Algorithms
     // Loop over the histograms (detector spectra) to do split from 1 event list to N event list
     g_log.debug() << "Number of spectra in input/source EventWorkspace = " << numberOfSpectra << ".\n";
 
-    // FIXME Make it parallel
-    // PARALLEL_FOR_NO_WSP_CHECK()
+    // The splitters are indexed once and shared by all the spectra
+    const Kernel::TimeSplitterIndex splitterIndex(m_splitters);
+    const size_t numberOfOutputs = splitterIndex.getNumberOfOutputs();
+    std::vector<DataObjects::EventWorkspace_sptr> outputWorkspaces(numberOfOutputs);
+    for (size_t output = 0; output < numberOfOutputs; ++output)
+    {
+      wsiter = m_outputWS.find(splitterIndex.getOutputIndex(output));
+      if (wsiter == m_outputWS.end())
+        throw std::runtime_error("There is no output workspace for one of the workspace indexes of the splitters.");
+      outputWorkspaces[output] = wsiter->second;
+    }
+
+    API::Progress prog(this, 0.3, 0.1+progressamount, numberOfSpectra);
+    PARALLEL_FOR_NO_WSP_CHECK()
     for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws)
     {
-      // FIXME Make it parallel
-      // PARALLEL_START_INTERUPT_REGION
+      PARALLEL_START_INTERUPT_REGION
 
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList* > outputs;
-      for (wsiter = m_outputWS.begin(); wsiter != m_outputWS.end(); ++ wsiter)
-      {
-        int index = wsiter->first;
-        DataObjects::EventList* output_el = wsiter->second->getEventListPtr(iws);
-        outputs.insert(std::make_pair(index, output_el));
-      }
+      // Get the output event lists (should be empty), in the order of the outputs of the splitter index
+      std::vector<DataObjects::EventList*> outputs(numberOfOutputs);
+      for (size_t output = 0; output < numberOfOutputs; ++output)
+        outputs[output] = outputWorkspaces[output]->getEventListPtr(iws);
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList& input_el = m_eventWS->getEventList(iws);
@@ -527,25 +535,22 @@ namespace Algorithms
       // Perform the filtering (using the splitting function and just one output)
       if (mFilterByPulseTime)
       {
-        input_el.splitByPulseTime(m_splitters, outputs);
+        input_el.splitByPulseTime(splitterIndex, outputs);
       }
       else if (m_doTOFCorrection)
       {
-        input_el.splitByFullTime(m_splitters, outputs, m_detTofOffsets[iws], m_doTOFCorrection);
+        input_el.splitByFullTime(splitterIndex, outputs, m_detTofOffsets[iws], m_doTOFCorrection);
       }
       else
       {
-        input_el.splitByFullTime(m_splitters, outputs, 1.0, m_doTOFCorrection);
+        input_el.splitByFullTime(splitterIndex, outputs, 1.0, m_doTOFCorrection);
       }
 
-      mProgress = 0.3+(progressamount-0.2)*static_cast<double>(iws)/static_cast<double>(numberOfSpectra);
-      progress(mProgress, "Filtering events");
+      prog.report("Filtering events");
 
-      // FIXME - Turn on parallel
-      // PARALLEL_END_INTERUPT_REGION
+      PARALLEL_END_INTERUPT_REGION
     } // END FOR i = 0
-    // PARALLEL_CHECK_INTERUPT_REGION
-    // FIXME - Turn on parallel
+    PARALLEL_CHECK_INTERUPT_REGION
 
 
     // Finish (1) adding events and splitting the sample logs in each target workspace.
@@ -136,10 +136,10 @@ void FlatPlateAbsorption::initialiseCachedDistances()
         {
           throw Exception::InstrumentDefinitionError("Integration element not located within sample");
         }
-        // Create track for distance in sample before scattering point
-        Track incoming(m_elementPositions[counter], m_beamDirection*-1.0);
-        m_sampleObject->interceptSurface(incoming);
-        m_L1s[counter] = incoming.begin()->distFromStart;
+        // Distance in sample before scattering point
+        double L1(0.0);
+        m_sampleObject->exitDistance(m_elementPositions[counter], m_beamDirection*-1.0, L1);
+        m_L1s[counter] = L1;
 
         // Also calculate element volume here
         m_elementVolumes[counter] = m_XSliceThickness*m_YSliceThickness*m_ZSliceThickness;
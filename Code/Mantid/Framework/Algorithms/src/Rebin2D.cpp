@@ -13,14 +13,14 @@ The algorithms currently requires the second axis on the workspace to be a numer
 #include "MantidAlgorithms/Rebin2D.h"
 #include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/Memory.h"
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/NumericAxis.h"
-#include "MantidGeometry/Math/ConvexPolygon.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
-#include "MantidGeometry/Math/LaszloIntersection.h"
+#include "MantidGeometry/Math/RectangleClipping.h"
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
@@ -34,9 +34,8 @@ namespace Mantid
 
     using namespace API;
     using namespace DataObjects;
-    using Geometry::ConvexPolygon;
     using Geometry::Quadrilateral;
-    using Kernel::V2D;
+    using Geometry::RectangleOverlap;
 
     //--------------------------------------------------------------------------
     // Public methods
@@ -128,36 +127,46 @@ namespace Mantid
       const size_t nreports(static_cast<size_t>(inputWS->getNumberHistograms()*inputWS->blocksize()));
       m_progress = boost::shared_ptr<API::Progress>(new API::Progress(this, 0.0, 1.0, nreports));
 
-      //PARALLEL_FOR2(inputWS, outputWS)
-      for(int64_t i = 0; i < static_cast<int64_t>(numYBins); ++i) // signed for openmp
+      // Each partial output gets every nPartials-th input row, and is filled by one thread at a time
+      const bool parallel = inputWS->threadSafe() && outputWS->threadSafe();
+      std::vector<MatrixWorkspace_sptr> partialOutputs = createPartialOutputs(outputWS, parallel);
+      const int64_t nPartials = static_cast<int64_t>(partialOutputs.size());
+
+      PARALLEL_FOR_IF(nPartials > 1)
+      for(int64_t p = 0; p < nPartials; ++p) // signed for openmp
       {
         PARALLEL_START_INTERUPT_REGION
 
-        const double vlo = oldYEdges[i];
-        const double vhi = oldYEdges[i+1];
-        for(size_t j = 0; j < numXBins; ++j)
+        MatrixWorkspace_sptr threadOutputWS = partialOutputs[p];
+        for(int64_t i = p; i < static_cast<int64_t>(numYBins); i += nPartials)
         {
-          m_progress->report("Computing polygon intersections");
-          // For each input polygon test where it intersects with
-          // the output grid and assign the appropriate weights of Y/E
-          const double x_j = oldXEdges[j];
-          const double x_jp1 = oldXEdges[j+1];
-          Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
-          if (!this->useFractionalArea)
-            {
-              rebinToOutput(inputQ, inputWS, i, j, outputWS, newYBins);
-            }
-          else
-            {
-              rebinToFractionalOutput(inputQ, inputWS, i, j,
-                                      boost::dynamic_pointer_cast<RebinnedOutput>(outputWS),
-                                      newYBins);
-            }
+          const double vlo = oldYEdges[i];
+          const double vhi = oldYEdges[i+1];
+          for(size_t j = 0; j < numXBins; ++j)
+          {
+            m_progress->report("Computing polygon intersections");
+            // For each input polygon test where it intersects with
+            // the output grid and assign the appropriate weights of Y/E
+            const double x_j = oldXEdges[j];
+            const double x_jp1 = oldXEdges[j+1];
+            Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
+            if (!this->useFractionalArea)
+              {
+                rebinToOutput(inputQ, inputWS, i, j, threadOutputWS, newYBins);
+              }
+            else
+              {
+                rebinToFractionalOutput(inputQ, inputWS, i, j,
+                                        boost::static_pointer_cast<RebinnedOutput>(threadOutputWS),
+                                        newYBins);
+              }
+          }
         }
 
         PARALLEL_END_INTERUPT_REGION
       }
       PARALLEL_CHECK_INTERUPT_REGION
+      addPartialOutputs(partialOutputs, outputWS);
       if (this->useFractionalArea)
       {
         boost::dynamic_pointer_cast<RebinnedOutput>(outputWS)->finalize();
@@ -178,7 +187,8 @@ namespace Mantid
     }
 
     /**
-     * Rebin the input quadrilateral to the output grid
+     * Rebin the input quadrilateral to the output grid. The output workspace is not locked:
+     * each thread must have its own, see createPartialOutputs().
      * @param inputQ The input polygon
      * @param inputWS The input workspace containing the input intensity values
      * @param i The index in the vertical axis direction that inputQ references
@@ -194,50 +204,44 @@ namespace Mantid
       size_t qstart(0), qend(verticalAxis.size()-1), en_start(0), en_end(X.size() - 1);
       if( !getIntersectionRegion(outputWS, verticalAxis, inputQ, qstart, qend, en_start, en_end)) return;
 
+      const double inputY = inputWS->readY(i)[j];
+      if (boost::math::isnan(inputY))
+      {
+        return;
+      }
+      const double inputE = inputWS->readE(i)[j];
+      const double inputArea = inputQ.area();
+      RectangleOverlap overlap;
       for( size_t qi = qstart; qi < qend; ++qi )
       {
         const double vlo = verticalAxis[qi];
         const double vhi = verticalAxis[qi+1];
+        MantidVec & outputY = outputWS->dataY(qi);
+        MantidVec & outputE = outputWS->dataE(qi);
         for( size_t ei = en_start; ei < en_end; ++ei )
         {
-          const V2D ll(X[ei], vlo);
-          const V2D lr(X[ei+1], vlo);
-          const V2D ur(X[ei+1], vhi);
-          const V2D ul(X[ei], vhi);
-          const Quadrilateral outputQ(ll, lr, ur, ul);
-
-          double yValue = inputWS->readY(i)[j];
-          if (boost::math::isnan(yValue))
+          if( overlapWithRectangle(inputQ, X[ei], X[ei+1], vlo, vhi, overlap) )
           {
-            continue;
-          }
-          try
-          {
-            ConvexPolygon overlap = intersectionByLaszlo(outputQ, inputQ);
-            const double weight = overlap.area()/inputQ.area();
-            yValue *= weight;
-            double eValue = inputWS->readE(i)[j] * weight;
-            const double overlapWidth = overlap.largestX() - overlap.smallestX();
+            const double weight = overlap.area/inputArea;
+            double yValue = inputY * weight;
+            double eValue = inputE * weight;
+            const double overlapWidth = overlap.largestX - overlap.smallestX;
             if(inputWS->isDistribution())
             {
               yValue *= overlapWidth;
               eValue *= overlapWidth;
             }
             eValue = eValue*eValue;
-            PARALLEL_CRITICAL(overlap)
-            {
-              outputWS->dataY(qi)[ei] += yValue;
-              outputWS->dataE(qi)[ei] += eValue;
-            }
+            outputY[ei] += yValue;
+            outputE[ei] += eValue;
           }
-          catch(Geometry::NoIntersectionException &)
-          {}
         }
       }
     }
 
     /**
-     * Rebin the input quadrilateral to the output grid
+     * Rebin the input quadrilateral to the output grid, tracking the fractions of the bins.
+     * The output workspace is not locked: each thread must have its own, see createPartialOutputs().
      * @param inputQ The input polygon
      * @param inputWS The input workspace containing the input intensity values
      * @param i The index in the vertical axis direction that inputQ references
@@ -255,47 +259,116 @@ namespace Mantid
       size_t qstart(0), qend(verticalAxis.size()-1), en_start(0), en_end(X.size() - 1);
       if( !getIntersectionRegion(outputWS, verticalAxis, inputQ, qstart, qend, en_start, en_end)) return;
 
+      const double inputY = inputWS->readY(i)[j];
+      if (boost::math::isnan(inputY))
+      {
+        return;
+      }
+      const double inputE = inputWS->readE(i)[j];
+      // inputWS->id() is a string comparison, so it is done once
+      const bool removeOverlapWidth = inputWS->isDistribution() && inputWS->id() != "RebinnedOutput";
+      const double inputArea = inputQ.area();
+      RectangleOverlap overlap;
       for( size_t qi = qstart; qi < qend; ++qi )
       {
         const double vlo = verticalAxis[qi];
         const double vhi = verticalAxis[qi+1];
+        MantidVec & outputY = outputWS->dataY(qi);
+        MantidVec & outputE = outputWS->dataE(qi);
+        MantidVec & outputF = outputWS->dataF(qi);
         for( size_t ei = en_start; ei < en_end; ++ei )
         {
-          const V2D ll(X[ei], vlo);
-          const V2D lr(X[ei+1], vlo);
-          const V2D ur(X[ei+1], vhi);
-          const V2D ul(X[ei], vhi);
-          const Quadrilateral outputQ(ll, lr, ur, ul);
-
-          double yValue = inputWS->readY(i)[j];
-          if (boost::math::isnan(yValue))
+          if( overlapWithRectangle(inputQ, X[ei], X[ei+1], vlo, vhi, overlap) )
           {
-            continue;
-          }
-          try
-          {
-            ConvexPolygon overlap = intersectionByLaszlo(outputQ, inputQ);
-            const double weight = overlap.area()/inputQ.area();
-            yValue *=  weight;
-            double eValue = inputWS->readE(i)[j] * weight;
-            const double overlapWidth = overlap.largestX() - overlap.smallestX();
+            const double weight = overlap.area/inputArea;
+            double yValue = inputY * weight;
+            double eValue = inputE * weight;
+            const double overlapWidth = overlap.largestX - overlap.smallestX;
             // Don't do the overlap removal if already RebinnedOutput.
             // This wreaks havoc on the data.
-            if(inputWS->isDistribution() && inputWS->id() != "RebinnedOutput")
+            if(removeOverlapWidth)
             {
               yValue *= overlapWidth;
               eValue *= overlapWidth;
             }
             eValue *= eValue;
-            PARALLEL_CRITICAL(overlap)
+            outputY[ei] += yValue;
+            outputE[ei] += eValue;
+            outputF[ei] += weight;
+          }
+        }
+      }
+    }
+
+    /**
+     * Create the workspaces the rebinned data is accumulated into, so that the threads do not
+     * have to lock the output bins. The first one is the output workspace itself. There is at most
+     * one per thread, and the copies use at most a quarter of the free memory: a large output grid
+     * is filled by fewer threads, down to one.
+     * @param outputWS A pointer to the output workspace
+     * @param parallel True if the rebinning loop may run in several threads
+     * @return The workspaces, each filled by one thread at a time
+     */
+    std::vector<MatrixWorkspace_sptr> Rebin2D::createPartialOutputs(MatrixWorkspace_sptr outputWS, const bool parallel) const
+    {
+      size_t nPartials = parallel ? static_cast<size_t>(PARALLEL_GET_MAX_THREADS) : 1;
+      if( nPartials > 1 )
+      {
+        // Y and E, and F for a RebinnedOutput. The X vectors are shared.
+        const size_t nArrays = boost::dynamic_pointer_cast<RebinnedOutput>(outputWS) ? 3 : 2;
+        const size_t copySize = std::max(size_t(1), nArrays * outputWS->getNumberHistograms() * outputWS->blocksize() * sizeof(double));
+        Kernel::MemoryStats memStats;
+        const size_t budget = memStats.availMem() * 1024 / 4;
+        nPartials = std::min(nPartials, 1 + budget / copySize);
+        g_log.debug() << "Rebinning into " << nPartials << " partial output workspace(s)\n";
+      }
+      std::vector<MatrixWorkspace_sptr> partialOutputs(nPartials, outputWS);
+      for(size_t t = 1; t < nPartials; ++t)
+      {
+        MatrixWorkspace_sptr partial = WorkspaceFactory::Instance().create(outputWS);
+        for(size_t i = 0; i < outputWS->getNumberHistograms(); ++i)
+        {
+          partial->setX(i, outputWS->refX(i));
+        }
+        partialOutputs[t] = partial;
+      }
+      return partialOutputs;
+    }
+
+    /**
+     * Add the data accumulated by the other threads to the output workspace
+     * @param partialOutputs The workspaces made by createPartialOutputs()
+     * @param outputWS A pointer to the output workspace
+     */
+    void Rebin2D::addPartialOutputs(const std::vector<MatrixWorkspace_sptr> & partialOutputs,
+                                    MatrixWorkspace_sptr outputWS) const
+    {
+      if( partialOutputs.size() < 2 ) return;
+      RebinnedOutput_sptr fractionalOutputWS = boost::dynamic_pointer_cast<RebinnedOutput>(outputWS);
+
+      PARALLEL_FOR1(outputWS)
+      for(int64_t i = 0; i < static_cast<int64_t>(outputWS->getNumberHistograms()); ++i) // signed for openmp
+      {
+        MantidVec & outputY = outputWS->dataY(i);
+        MantidVec & outputE = outputWS->dataE(i);
+        for(size_t t = 1; t < partialOutputs.size(); ++t)
+        {
+          const MantidVec & partialY = partialOutputs[t]->readY(i);
+          const MantidVec & partialE = partialOutputs[t]->readE(i);
+          for(size_t j = 0; j < outputY.size(); ++j)
+          {
+            outputY[j] += partialY[j];
+            outputE[j] += partialE[j];
+          }
+          if( fractionalOutputWS )
+          {
+            MantidVec & outputF = fractionalOutputWS->dataF(i);
+            const MantidVec & partialF = boost::static_pointer_cast<const RebinnedOutput>(partialOutputs[t])->dataF(i);
+            for(size_t j = 0; j < outputF.size(); ++j)
             {
-              outputWS->dataY(qi)[ei] += yValue;
-              outputWS->dataE(qi)[ei] += eValue;
-              outputWS->dataF(qi)[ei] += weight;
+              outputF[j] += partialF[j];
             }
           }
-          catch(Geometry::NoIntersectionException &)
-          {}
         }
       }
     }
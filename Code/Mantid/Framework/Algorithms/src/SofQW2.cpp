@@ -92,40 +92,50 @@ namespace Mantid
         qCalculator = &SofQW2::calculateIndirectQ;
       }
 
-      PARALLEL_FOR2(inputWS, outputWS)
-      for(int64_t i = 0; i < static_cast<int64_t>(nTheta); ++i) // signed for openmp
+      // Each partial output gets every nPartials-th spectrum, and is filled by one thread at a time
+      const bool parallel = inputWS->threadSafe() && outputWS->threadSafe();
+      std::vector<MatrixWorkspace_sptr> partialOutputs = createPartialOutputs(outputWS, parallel);
+      const int64_t nPartials = static_cast<int64_t>(partialOutputs.size());
+
+      PARALLEL_FOR_IF(nPartials > 1)
+      for(int64_t p = 0; p < nPartials; ++p) // signed for openmp
       {
         PARALLEL_START_INTERUPT_REGION
 
-        const double theta = m_thetaPts[i];
-        if( theta < 0.0 ) // One to skip
-        {
-          continue;
-        }
-        double halfWidth(0.5*m_thetaWidth);
-        const double thetaLower = theta - halfWidth;
-        const double thetaUpper = theta + halfWidth;
-        const double efixed = m_EmodeProperties.getEFixed(inputWS->getDetector(i));
-        for(size_t j = 0; j < nenergyBins; ++j)
+        MatrixWorkspace_sptr threadOutputWS = partialOutputs[p];
+        for(int64_t i = p; i < static_cast<int64_t>(nTheta); i += nPartials)
         {
-          m_progress->report("Computing polygon intersections");
-          // For each input polygon test where it intersects with
-          // the output grid and assign the appropriate weights of Y/E
-          const double dE_j = X[j];
-          const double dE_jp1 = X[j+1];
-
-          const V2D ll(dE_j, (this->*qCalculator)(efixed, dE_j,thetaLower,0.0));
-          const V2D lr(dE_jp1, (this->*qCalculator)(efixed, dE_jp1,thetaLower,0.0));
-          const V2D ur(dE_jp1, (this->*qCalculator)(efixed, dE_jp1,thetaUpper,0.0));
-          const V2D ul(dE_j, (this->*qCalculator)(efixed, dE_j,thetaUpper,0.0));
-          Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
-
-          rebinToOutput(inputQ, inputWS, i, j, outputWS, m_Qout);
+          const double theta = m_thetaPts[i];
+          if( theta < 0.0 ) // One to skip
+          {
+            continue;
+          }
+          double halfWidth(0.5*m_thetaWidth);
+          const double thetaLower = theta - halfWidth;
+          const double thetaUpper = theta + halfWidth;
+          const double efixed = m_EmodeProperties.getEFixed(inputWS->getDetector(i));
+          for(size_t j = 0; j < nenergyBins; ++j)
+          {
+            m_progress->report("Computing polygon intersections");
+            // For each input polygon test where it intersects with
+            // the output grid and assign the appropriate weights of Y/E
+            const double dE_j = X[j];
+            const double dE_jp1 = X[j+1];
+
+            const V2D ll(dE_j, (this->*qCalculator)(efixed, dE_j,thetaLower,0.0));
+            const V2D lr(dE_jp1, (this->*qCalculator)(efixed, dE_jp1,thetaLower,0.0));
+            const V2D ur(dE_jp1, (this->*qCalculator)(efixed, dE_jp1,thetaUpper,0.0));
+            const V2D ul(dE_j, (this->*qCalculator)(efixed, dE_j,thetaUpper,0.0));
+            Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
+
+            rebinToOutput(inputQ, inputWS, i, j, threadOutputWS, m_Qout);
+          }
         }
 
         PARALLEL_END_INTERUPT_REGION
       }
       PARALLEL_CHECK_INTERUPT_REGION
+      addPartialOutputs(partialOutputs, outputWS);
 
       normaliseOutput(outputWS, inputWS);
     }
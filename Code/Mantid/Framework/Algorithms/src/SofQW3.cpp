@@ -144,61 +144,71 @@ namespace Algorithms
     const MantidVec & X = inputWS->readX(0);
 
     int emode = m_EmodeProperties.m_emode;
-    PARALLEL_FOR2(inputWS, outputWS)
-    for (int64_t i = 0; i < static_cast<int64_t>(nHistos); ++i) // signed for openmp
+    // Each partial output gets every nPartials-th spectrum, and is filled by one thread at a time
+    const bool parallel = inputWS->threadSafe() && outputWS->threadSafe();
+    std::vector<MatrixWorkspace_sptr> partialOutputs = createPartialOutputs(outputWS, parallel);
+    const int64_t nPartials = static_cast<int64_t>(partialOutputs.size());
+
+    PARALLEL_FOR_IF(nPartials > 1)
+    for(int64_t p = 0; p < nPartials; ++p) // signed for openmp
     {
       PARALLEL_START_INTERUPT_REGION
 
-      DetConstPtr detector = inputWS->getDetector(i);
-      if (detector->isMasked() || detector->isMonitor())
+      for(int64_t i = p; i < static_cast<int64_t>(nHistos); i += nPartials)
       {
-        continue;
-      }
+        DetConstPtr detector = inputWS->getDetector(i);
+        if (detector->isMasked() || detector->isMonitor())
+        {
+          continue;
+        }
 
-      double theta = this->m_theta[i];
-      double phi = this->m_phi[i];
-      double thetaWidth = this->m_thetaWidths[i];
-      double phiWidth = this->m_phiWidths[i];
+        double theta = this->m_theta[i];
+        double phi = this->m_phi[i];
+        double thetaWidth = this->m_thetaWidths[i];
+        double phiWidth = this->m_phiWidths[i];
 
-      // Compute polygon points
-      double thetaHalfWidth = 0.5 * thetaWidth;
-      double phiHalfWidth = 0.5 * phiWidth;
+        // Compute polygon points
+        double thetaHalfWidth = 0.5 * thetaWidth;
+        double phiHalfWidth = 0.5 * phiWidth;
 
-      const double thetaLower = theta - thetaHalfWidth;
-      const double thetaUpper = theta + thetaHalfWidth;
+        const double thetaLower = theta - thetaHalfWidth;
+        const double thetaUpper = theta + thetaHalfWidth;
 
-      const double phiLower = phi - phiHalfWidth;
-      const double phiUpper = phi + phiHalfWidth;
+        const double phiLower = phi - phiHalfWidth;
+        const double phiUpper = phi + phiHalfWidth;
 
-      const double efixed = m_EmodeProperties.getEFixed(detector);
-      const specid_t specNo = inputWS->getSpectrum(i)->getSpectrumNo();
-      for(size_t j = 0; j < nEnergyBins; ++j)
-      {
-        m_progress->report("Computing polygon intersections");
-        // For each input polygon test where it intersects with
-        // the output grid and assign the appropriate weights of Y/E
-        const double dE_j = X[j];
-        const double dE_jp1 = X[j+1];
-
-        const V2D ll(dE_j, this->calculateQ(efixed, emode,dE_j, thetaLower, phiLower));
-        const V2D lr(dE_jp1, this->calculateQ(efixed,emode, dE_jp1, thetaLower, phiLower));
-        const V2D ur(dE_jp1, this->calculateQ(efixed,emode, dE_jp1, thetaUpper, phiUpper));
-        const V2D ul(dE_j, this->calculateQ(efixed,emode, dE_j, thetaUpper, phiUpper));
-        if(g_log.is(Logger::Priority::PRIO_DEBUG))
+        RebinnedOutput_sptr threadOutputWS = boost::static_pointer_cast<RebinnedOutput>(partialOutputs[p]);
+        const double efixed = m_EmodeProperties.getEFixed(detector);
+        const specid_t specNo = inputWS->getSpectrum(i)->getSpectrumNo();
+        for(size_t j = 0; j < nEnergyBins; ++j)
         {
-          g_log.debug() << "Spectrum=" << specNo << ", theta=" << theta << ",thetaWidth=" << thetaWidth
-                              << ", phi=" << phi << ", phiWidth=" << phiWidth
-                              << ". QE polygon: ll=" << ll << ", lr=" << lr << ", ur=" << ur << ", ul=" << ul << "\n";
-        }
+          m_progress->report("Computing polygon intersections");
+          // For each input polygon test where it intersects with
+          // the output grid and assign the appropriate weights of Y/E
+          const double dE_j = X[j];
+          const double dE_jp1 = X[j+1];
+
+          const V2D ll(dE_j, this->calculateQ(efixed, emode,dE_j, thetaLower, phiLower));
+          const V2D lr(dE_jp1, this->calculateQ(efixed,emode, dE_jp1, thetaLower, phiLower));
+          const V2D ur(dE_jp1, this->calculateQ(efixed,emode, dE_jp1, thetaUpper, phiUpper));
+          const V2D ul(dE_j, this->calculateQ(efixed,emode, dE_j, thetaUpper, phiUpper));
+          if(g_log.is(Logger::Priority::PRIO_DEBUG))
+          {
+            g_log.debug() << "Spectrum=" << specNo << ", theta=" << theta << ",thetaWidth=" << thetaWidth
+                                << ", phi=" << phi << ", phiWidth=" << phiWidth
+                                << ". QE polygon: ll=" << ll << ", lr=" << lr << ", ur=" << ur << ", ul=" << ul << "\n";
+          }
 
-        Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
+          Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
 
-        this->rebinToFractionalOutput(inputQ, inputWS, i, j, outputWS, m_Qout);
+          this->rebinToFractionalOutput(inputQ, inputWS, i, j, threadOutputWS, m_Qout);
+        }
       }
 
       PARALLEL_END_INTERUPT_REGION
     }
     PARALLEL_CHECK_INTERUPT_REGION
+    addPartialOutputs(partialOutputs, outputWS);
 
     outputWS->finalize();
     this->normaliseOutput(outputWS, inputWS);
@@ -0,0 +1,404 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAlgorithms/WorkspaceExpression.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+namespace Mantid
+{
+namespace Algorithms
+{
+  using namespace API;
+
+  /// A node of an expression: a number, a workspace or an operation on one or two nodes
+  struct WorkspaceExpression::Node
+  {
+    Node(const Operation op) : operation(op), value(0.0), error(0.0) {}
+
+    Operation operation;
+    /// For a WORKSPACE node
+    MatrixWorkspace_const_sptr workspace;
+    /// For a VALUE node
+    double value;
+    double error;
+    /// The operands of an operation
+    boost::shared_ptr<const Node> lhs;
+    boost::shared_ptr<const Node> rhs;
+  };
+
+  namespace
+  {
+    /// The values and errors of a node over the bins of a spectrum. The stride is 0 for a single value.
+    struct Operand
+    {
+      const double * y;
+      const double * e;
+      size_t stride;
+    };
+
+    /// A node of the expression, as evaluated for each spectrum
+    struct Step
+    {
+      WorkspaceExpression::Operation operation;
+      /// Indices of the steps giving the operands
+      size_t lhs;
+      size_t rhs;
+      const WorkspaceExpression::Node * node;
+      /// For a WORKSPACE node: is it a single value, or a single spectrum used for all the spectra?
+      bool singleValue;
+      bool singleSpectrum;
+    };
+
+    /** Add a node and the nodes it depends on to the steps, operands first.
+     *  A node used more than once in the expression is evaluated only once.
+     *  @return the index of the step of the node
+     */
+    size_t addSteps(const WorkspaceExpression::Node * node, std::vector<Step> & steps,
+                    std::map<const WorkspaceExpression::Node *, size_t> & stepIndices)
+    {
+      std::map<const WorkspaceExpression::Node *, size_t>::const_iterator it = stepIndices.find(node);
+      if ( it != stepIndices.end() ) return it->second;
+
+      Step step;
+      step.operation = node->operation;
+      step.lhs = node->lhs ? addSteps(node->lhs.get(), steps, stepIndices) : 0;
+      step.rhs = node->rhs ? addSteps(node->rhs.get(), steps, stepIndices) : 0;
+      step.node = node;
+      step.singleValue = false;
+      step.singleSpectrum = false;
+      steps.push_back(step);
+      stepIndices[node] = steps.size() - 1;
+      return steps.size() - 1;
+    }
+
+    /// Does the workspace hold a single value?
+    bool isSingleValue(const MatrixWorkspace & workspace)
+    {
+      return workspace.getNumberHistograms() == 1 && workspace.blocksize() == 1;
+    }
+
+    /// Do the spectra of the workspace have different numbers of bins?
+    bool isRagged(const MatrixWorkspace & workspace)
+    {
+      const size_t numberOfBins = workspace.blocksize();
+      const size_t numberOfEdges = workspace.readX(0).size();
+      for (size_t i = 0; i < workspace.getNumberHistograms(); ++i)
+      {
+        if ( workspace.readY(i).size() != numberOfBins || workspace.readX(i).size() != numberOfEdges ) return true;
+      }
+      return false;
+    }
+
+    /** Work out one operation for the bins of a spectrum, propagating the errors as the algorithm of the same name.
+     *  @param operation :: the operation
+     *  @param a :: the first (or only) operand
+     *  @param b :: the second operand
+     *  @param numberOfBins :: the number of bins
+     *  @param y :: the output values
+     *  @param e :: the output errors
+     */
+    void evaluateOperation(const WorkspaceExpression::Operation operation, const Operand & a, const Operand & b,
+                           const size_t numberOfBins, double * y, double * e)
+    {
+      switch ( operation )
+      {
+      case WorkspaceExpression::PLUS:
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          const double ea = a.e[j*a.stride], eb = b.e[j*b.stride];
+          y[j] = a.y[j*a.stride] + b.y[j*b.stride];
+          e[j] = std::sqrt(ea*ea + eb*eb);
+        }
+        break;
+      case WorkspaceExpression::MINUS:
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          const double ea = a.e[j*a.stride], eb = b.e[j*b.stride];
+          y[j] = a.y[j*a.stride] - b.y[j*b.stride];
+          e[j] = std::sqrt(ea*ea + eb*eb);
+        }
+        break;
+      case WorkspaceExpression::MULTIPLY:
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          const double ya = a.y[j*a.stride], yb = b.y[j*b.stride];
+          const double eayb = a.e[j*a.stride] * yb, ebya = b.e[j*b.stride] * ya;
+          y[j] = ya * yb;
+          e[j] = std::sqrt(eayb*eayb + ebya*ebya);
+        }
+        break;
+      case WorkspaceExpression::DIVIDE:
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          const double ya = a.y[j*a.stride], yb = b.y[j*b.stride];
+          const double ea = a.e[j*a.stride], ebyab = ya * b.e[j*b.stride] / yb;
+          y[j] = ya / yb;
+          e[j] = std::sqrt(ea*ea + ebyab*ebyab) / std::fabs(yb);
+        }
+        break;
+      case WorkspaceExpression::NEGATE:
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          y[j] = -a.y[j*a.stride];
+          e[j] = a.e[j*a.stride];
+        }
+        break;
+      case WorkspaceExpression::EXPONENTIAL:
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          y[j] = std::exp(a.y[j*a.stride]);
+          e[j] = a.e[j*a.stride] * y[j];
+        }
+        break;
+      case WorkspaceExpression::LOGARITHM:
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          const double ya = a.y[j*a.stride];
+          if ( ya <= 0 )
+          {
+            y[j] = 0.0;
+            e[j] = 0.0;
+          }
+          else
+          {
+            y[j] = std::log(ya);
+            e[j] = a.e[j*a.stride] / ya;
+          }
+        }
+        break;
+      default:
+        throw std::logic_error("WorkspaceExpression: not an operation");
+      }
+    }
+  }
+
+  /** An expression made of one workspace
+   *  @param workspace :: the workspace
+   */
+  WorkspaceExpression::WorkspaceExpression(const API::MatrixWorkspace_const_sptr & workspace)
+  {
+    if ( !workspace ) throw std::invalid_argument("WorkspaceExpression: the workspace is null");
+    boost::shared_ptr<Node> node(new Node(WORKSPACE));
+    node->workspace = workspace;
+    m_node = node;
+  }
+
+  /** An expression made of one workspace
+   *  @param workspace :: the workspace
+   */
+  WorkspaceExpression::WorkspaceExpression(const API::MatrixWorkspace_sptr & workspace)
+  {
+    if ( !workspace ) throw std::invalid_argument("WorkspaceExpression: the workspace is null");
+    boost::shared_ptr<Node> node(new Node(WORKSPACE));
+    node->workspace = workspace;
+    m_node = node;
+  }
+
+  /** An expression made of one number
+   *  @param value :: the value
+   *  @param error :: its error
+   */
+  WorkspaceExpression::WorkspaceExpression(const double value, const double error)
+  {
+    boost::shared_ptr<Node> node(new Node(VALUE));
+    node->value = value;
+    node->error = error;
+    m_node = node;
+  }
+
+  /** An operation on two expressions
+   *  @param operation :: the operation
+   *  @param lhs :: the left hand side
+   *  @param rhs :: the right hand side
+   */
+  WorkspaceExpression::WorkspaceExpression(const Operation operation, const WorkspaceExpression & lhs, const WorkspaceExpression & rhs)
+  {
+    boost::shared_ptr<Node> node(new Node(operation));
+    node->lhs = lhs.m_node;
+    node->rhs = rhs.m_node;
+    m_node = node;
+  }
+
+  /** An operation on one expression
+   *  @param operation :: the operation
+   *  @param operand :: the expression it applies to
+   */
+  WorkspaceExpression::WorkspaceExpression(const Operation operation, const WorkspaceExpression & operand)
+  {
+    boost::shared_ptr<Node> node(new Node(operation));
+    node->lhs = operand.m_node;
+    m_node = node;
+  }
+
+  /** Evaluates the expression.
+   *  @return a new Workspace2D with the result
+   *  @throws std::invalid_argument if the sizes or the binnings of the workspaces do not match
+   */
+  API::MatrixWorkspace_sptr WorkspaceExpression::evaluate() const
+  {
+    std::vector<Step> steps;
+    std::map<const Node *, size_t> stepIndices;
+    addSteps(m_node.get(), steps, stepIndices);
+
+    // The output has the shape of the workspace with the most spectra that is not a single value
+    MatrixWorkspace_const_sptr shape;
+    for (size_t n = 0; n < steps.size(); ++n)
+    {
+      if ( steps[n].operation != WORKSPACE ) continue;
+      const MatrixWorkspace_const_sptr & workspace = steps[n].node->workspace;
+      if ( !shape || ( isSingleValue(*shape) && !isSingleValue(*workspace) ) ||
+           ( !isSingleValue(*workspace) && workspace->getNumberHistograms() > shape->getNumberHistograms() ) )
+      {
+        shape = workspace;
+      }
+    }
+    if ( !shape ) throw std::invalid_argument("WorkspaceExpression: the expression has no workspace");
+    const size_t numberOfSpectra = shape->getNumberHistograms();
+    const size_t numberOfBins = shape->blocksize();
+
+    // Check that the other workspaces fit. The spectra are read numberOfBins at a time, so they must all have that size.
+    bool threadSafe = shape->threadSafe();
+    for (size_t n = 0; n < steps.size(); ++n)
+    {
+      if ( steps[n].operation != WORKSPACE ) continue;
+      const MatrixWorkspace_const_sptr & workspace = steps[n].node->workspace;
+      threadSafe = threadSafe && workspace->threadSafe();
+      if ( isRagged(*workspace) )
+      {
+        throw std::invalid_argument("WorkspaceExpression: the spectra of " + workspace->getName() +
+                                    " do not all have the same number of bins");
+      }
+      if ( workspace == shape ) continue;
+      if ( isSingleValue(*workspace) )
+      {
+        steps[n].singleValue = true;
+        continue;
+      }
+      if ( workspace->blocksize() != numberOfBins ||
+           ( workspace->getNumberHistograms() != numberOfSpectra && workspace->getNumberHistograms() != 1 ) )
+      {
+        throw std::invalid_argument("WorkspaceExpression: the size of " + workspace->getName() +
+                                    " does not match the size of " + shape->getName());
+      }
+      steps[n].singleSpectrum = ( workspace->getNumberHistograms() == 1 && numberOfSpectra != 1 );
+      if ( !WorkspaceHelpers::matchingBins(workspace, shape, steps[n].singleSpectrum) )
+      {
+        throw std::invalid_argument("WorkspaceExpression: the binning of " + workspace->getName() +
+                                    " does not match the binning of " + shape->getName());
+      }
+    }
+
+    MatrixWorkspace_sptr output = WorkspaceFactory::Instance().create("Workspace2D", numberOfSpectra,
+                                                                      shape->readX(0).size(), numberOfBins);
+    WorkspaceFactory::Instance().initializeFromParent(shape, output, false);
+    if ( numberOfBins == 0 ) return output;
+
+    // Intermediate results of each thread: Y then E of each step
+    std::vector<std::vector<double> > buffers(PARALLEL_GET_MAX_THREADS, std::vector<double>(2 * steps.size() * numberOfBins));
+    std::vector<std::vector<Operand> > operands(PARALLEL_GET_MAX_THREADS, std::vector<Operand>(steps.size()));
+
+    PARALLEL_FOR_IF( threadSafe )
+    for (int64_t i = 0; i < int64_t(numberOfSpectra); ++i)
+    {
+      output->setX(i, shape->refX(i));
+      double * buffer = &(buffers[PARALLEL_THREAD_NUMBER][0]);
+      std::vector<Operand> & values = operands[PARALLEL_THREAD_NUMBER];
+
+      for (size_t n = 0; n < steps.size(); ++n)
+      {
+        const Step & step = steps[n];
+        Operand & result = values[n];
+        if ( step.operation == VALUE )
+        {
+          result.y = &(step.node->value);
+          result.e = &(step.node->error);
+          result.stride = 0;
+        }
+        else if ( step.operation == WORKSPACE )
+        {
+          const size_t index = ( step.singleValue || step.singleSpectrum ) ? 0 : size_t(i);
+          result.y = &(step.node->workspace->readY(index)[0]);
+          result.e = &(step.node->workspace->readE(index)[0]);
+          result.stride = step.singleValue ? 0 : 1;
+        }
+        else
+        {
+          // The last step is the whole expression: write it straight into the output
+          const bool last = ( n + 1 == steps.size() );
+          double * y = last ? &(output->dataY(i)[0]) : buffer + 2*n*numberOfBins;
+          double * e = last ? &(output->dataE(i)[0]) : buffer + (2*n+1)*numberOfBins;
+          evaluateOperation(step.operation, values[step.lhs], values[step.rhs], numberOfBins, y, e);
+          result.y = y;
+          result.e = e;
+          result.stride = 1;
+        }
+      }
+
+      // An expression of just one workspace or value: copy it
+      const Step & root = steps.back();
+      if ( root.operation == VALUE || root.operation == WORKSPACE )
+      {
+        const Operand & result = values.back();
+        MantidVec & y = output->dataY(i);
+        MantidVec & e = output->dataE(i);
+        for (size_t j = 0; j < numberOfBins; ++j)
+        {
+          y[j] = result.y[j*result.stride];
+          e[j] = result.e[j*result.stride];
+        }
+      }
+    }
+
+    return output;
+  }
+
+  /// @return the negated expression
+  WorkspaceExpression WorkspaceExpression::operator-() const
+  {
+    return WorkspaceExpression(NEGATE, *this);
+  }
+
+  /// @return the sum of two expressions
+  WorkspaceExpression operator+(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs)
+  {
+    return WorkspaceExpression(WorkspaceExpression::PLUS, lhs, rhs);
+  }
+
+  /// @return the difference of two expressions
+  WorkspaceExpression operator-(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs)
+  {
+    return WorkspaceExpression(WorkspaceExpression::MINUS, lhs, rhs);
+  }
+
+  /// @return the product of two expressions
+  WorkspaceExpression operator*(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs)
+  {
+    return WorkspaceExpression(WorkspaceExpression::MULTIPLY, lhs, rhs);
+  }
+
+  /// @return the ratio of two expressions
+  WorkspaceExpression operator/(const WorkspaceExpression & lhs, const WorkspaceExpression & rhs)
+  {
+    return WorkspaceExpression(WorkspaceExpression::DIVIDE, lhs, rhs);
+  }
+
+  /// @return the natural exponential of the expression
+  WorkspaceExpression exponential(const WorkspaceExpression & operand)
+  {
+    return WorkspaceExpression(WorkspaceExpression::EXPONENTIAL, operand);
+  }
+
+  /// @return the natural logarithm of the expression
+  WorkspaceExpression logarithm(const WorkspaceExpression & operand)
+  {
+    return WorkspaceExpression(WorkspaceExpression::LOGARITHM, operand);
+  }
+
+} // namespace Algorithms
+} // namespace Mantid
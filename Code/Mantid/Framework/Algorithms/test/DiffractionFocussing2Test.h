@@ -116,7 +116,13 @@ public:
   }
 
 
-  void dotestEventWorkspace(bool inplace, size_t numgroups, bool preserveEvents = true, int bankWidthInPixels=16 )
+  void test_EventWorkspace_TwoGroups_sortEvents()
+  {
+    dotestEventWorkspace(false, 2, true, 16, true);
+  }
+
+
+  void dotestEventWorkspace(bool inplace, size_t numgroups, bool preserveEvents = true, int bankWidthInPixels=16, bool sortEvents = false )
   {
     std::string nxsWSname("DiffractionFocussing2Test_ws");
 
@@ -148,6 +154,7 @@ public:
       //Set an X-axis
       inputW->setX(pix, axis);
       inputW->getEventList(pix).addEventQuickly( TofEvent(1000.0) );
+      if (sortEvents) inputW->getEventList(pix).addEventQuickly( TofEvent(10.0 + static_cast<double>(pix % 7)) );
     }
 
     // ------------ Create a grouping workspace by name -------------
@@ -170,6 +177,7 @@ public:
     //This fake calibration file was generated using DiffractionFocussing2Test_helper.py
     TS_ASSERT_THROWS_NOTHING( focus.setPropertyValue("GroupingWorkspace", groupWSName) );
     TS_ASSERT_THROWS_NOTHING( focus.setProperty("PreserveEvents", preserveEvents) );
+    TS_ASSERT_THROWS_NOTHING( focus.setProperty("SortEvents", sortEvents) );
     //OK, run the algorithm
     TS_ASSERT_THROWS_NOTHING( focus.execute(); );
     TS_ASSERT( focus.isExecuted() );
@@ -201,8 +209,23 @@ public:
     TS_ASSERT_EQUALS( output->getSpectrum(0)->getSpectrumNo(), 1);
 
     //Events in these two banks alone
+    const size_t eventsPerPixel = sortEvents ? 2 : 1;
     if (preserveEvents)
-      TS_ASSERT_EQUALS(outputEvent->getNumberEvents(), (numgroups==2) ? (bankWidthInPixels * bankWidthInPixels *2) : bankWidthInPixels*bankWidthInPixels);
+      TS_ASSERT_EQUALS(outputEvent->getNumberEvents(), eventsPerPixel * ((numgroups==2) ? (bankWidthInPixels * bankWidthInPixels *2) : bankWidthInPixels*bankWidthInPixels));
+
+    if (preserveEvents && sortEvents)
+    {
+      for (size_t wi=0; wi< output->getNumberHistograms(); wi++)
+      {
+        const EventList & el = outputEvent->getEventList(wi);
+        TS_ASSERT_EQUALS( el.getSortType(), TOF_SORT );
+        const std::vector<TofEvent> & events = el.getEvents();
+        for (size_t i=1; i < events.size(); i++)
+        {
+          TS_ASSERT_LESS_THAN_EQUALS( events[i-1].tof(), events[i].tof() );
+        }
+      }
+    }
 
     //Now let's test the grouping of detector UDETS to groups
     for (size_t wi=0; wi< output->getNumberHistograms(); wi++)
@@ -237,7 +260,7 @@ public:
           events_after_binning += outputEvent->dataY(workspace_index)[i];
       }
       // The count sums up to the same as the number of events
-      TS_ASSERT_DELTA( events_after_binning, (numgroups==2) ? double(bankWidthInPixels * bankWidthInPixels) * 2.0 :  double(bankWidthInPixels * bankWidthInPixels), 1e-4);
+      TS_ASSERT_DELTA( events_after_binning, double(eventsPerPixel) * ((numgroups==2) ? double(bankWidthInPixels * bankWidthInPixels) * 2.0 :  double(bankWidthInPixels * bankWidthInPixels)), 1e-4);
     }
   }
 
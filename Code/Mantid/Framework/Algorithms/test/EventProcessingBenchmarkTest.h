@@ -0,0 +1,341 @@
+#ifndef MANTID_ALGORITHMS_EVENTPROCESSINGBENCHMARKTEST_H_
+#define MANTID_ALGORITHMS_EVENTPROCESSINGBENCHMARKTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Timer.h"
+#include "MantidKernel/TimeSplitter.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidAlgorithms/ConvertUnits.h"
+#include "MantidAlgorithms/FilterEvents.h"
+#include "MantidAlgorithms/Rebin.h"
+#include "MantidAlgorithms/SortEvents.h"
+#include "MantidDataHandling/CompressEvents.h"
+#include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/SplittersWorkspace.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <iostream>
+#include <sstream>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+
+/** Helpers to build the synthetic event workspaces used by the event processing benchmarks
+ * and to report the results of a run.
+ */
+class EventProcessingBenchmark
+{
+public:
+  /// Time between two pulses, in nanoseconds (60 Hz source)
+  static const int64_t PULSE_DT = 16666667;
+  /// Start of the synthetic run
+  static DateAndTime runStart() { return DateAndTime("2013-11-01T00:00:00"); }
+
+  /** Create an event workspace with a rectangular instrument and random time-of-flight events.
+   * The events of each pixel are spread over the pulses in order and the random numbers are
+   * always seeded the same, so that the same size always gives the same workspace.
+   *
+   * @param numBanks :: number of banks of the instrument
+   * @param numPixels :: number of pixels along each side of a bank
+   * @param eventsPerPixel :: number of events in each spectrum
+   * @param numPulses :: number of pulses the events are spread over
+   * @return the workspace, in TOF
+   */
+  static EventWorkspace_sptr createWorkspace(int numBanks, int numPixels, size_t eventsPerPixel, size_t numPulses)
+  {
+    EventWorkspace_sptr ws = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(numBanks, numPixels, true);
+    ws->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+    ws->mutableRun().addProperty("run_start", runStart().toISO8601String(), true);
+
+    boost::mt19937 generator(12345);
+    boost::uniform_real<double> distribution(1000.0, 20000.0);
+    boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > randomTof(generator, distribution);
+
+    const int64_t start = runStart().totalNanoseconds();
+    for (size_t wi = 0; wi < ws->getNumberHistograms(); wi++)
+    {
+      EventList & el = ws->getEventList(wi);
+      el.reserve(eventsPerPixel);
+      for (size_t i = 0; i < eventsPerPixel; i++)
+      {
+        const int64_t pulse = static_cast<int64_t>((i * numPulses) / eventsPerPixel);
+        el.addEventQuickly(TofEvent(randomTof(), DateAndTime(start + pulse * PULSE_DT)));
+      }
+    }
+
+    MantidVecPtr x;
+    x.access().push_back(0.0);
+    x.access().push_back(25000.0);
+    ws->setAllX(x);
+    return ws;
+  }
+
+  /** Create splitters sending blocks of pulses to a number of output workspaces in turn
+   * @param numPulses :: number of pulses to split
+   * @param pulsesPerSplitter :: number of pulses in each splitter
+   * @param numOutputs :: number of output workspaces
+   */
+  static SplittersWorkspace_sptr createSplitters(size_t numPulses, size_t pulsesPerSplitter, int numOutputs)
+  {
+    SplittersWorkspace_sptr splitters(new SplittersWorkspace);
+    const int64_t start = runStart().totalNanoseconds();
+    int index = 0;
+    for (size_t pulse = 0; pulse < numPulses; pulse += pulsesPerSplitter)
+    {
+      DateAndTime t0(start + static_cast<int64_t>(pulse) * PULSE_DT);
+      DateAndTime t1(start + static_cast<int64_t>(pulse + pulsesPerSplitter) * PULSE_DT);
+      splitters->addSplitter(SplittingInterval(t0, t1, index));
+      index = (index + 1) % numOutputs;
+    }
+    return splitters;
+  }
+
+  /// Make a copy of an event workspace, events included
+  static EventWorkspace_sptr copy(EventWorkspace_const_sptr ws)
+  {
+    EventWorkspace_sptr out = boost::dynamic_pointer_cast<EventWorkspace>(
+        WorkspaceFactory::Instance().create("EventWorkspace", ws->getNumberHistograms(), 2, 1));
+    WorkspaceFactory::Instance().initializeFromParent(ws, out, false);
+    out->copyDataFrom(*ws);
+    return out;
+  }
+
+  /** Format the result of one run as a line of JSON, prefixed with BENCHMARK so it can be picked out of the test output.
+   * @param name :: name of the benchmark
+   * @param threads :: number of threads the run was allowed to use
+   * @param numEvents :: number of events processed
+   * @param seconds :: wall-clock time of the run
+   * @param peakRSS :: peak resident memory of the process after the run, in kiB
+   */
+  static std::string report(const std::string & name, int threads, size_t numEvents, double seconds, size_t peakRSS)
+  {
+    std::ostringstream out;
+    out << "BENCHMARK {\"name\": \"" << name << "\", \"threads\": " << threads
+        << ", \"events\": " << numEvents << ", \"seconds\": " << seconds
+        << ", \"events_per_sec\": " << (seconds > 0 ? double(numEvents) / seconds : 0.0)
+        << ", \"peak_rss_kib\": " << peakRSS << "}";
+    return out.str();
+  }
+};
+
+
+class EventProcessingBenchmarkTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventProcessingBenchmarkTest *createSuite() { return new EventProcessingBenchmarkTest(); }
+  static void destroySuite( EventProcessingBenchmarkTest *suite ) { delete suite; }
+
+  void test_createWorkspace()
+  {
+    EventWorkspace_sptr ws = EventProcessingBenchmark::createWorkspace(1, 3, 50, 10);
+    TS_ASSERT_EQUALS( ws->getNumberHistograms(), 9 );
+    TS_ASSERT_EQUALS( ws->getNumberEvents(), 9*50 );
+    TS_ASSERT_EQUALS( ws->getAxis(0)->unit()->unitID(), "TOF" );
+    TS_ASSERT( ws->getInstrument() );
+
+    const EventList & el = ws->getEventList(4);
+    TS_ASSERT_EQUALS( el.getPulseTimeMin(), EventProcessingBenchmark::runStart() );
+    TS_ASSERT_EQUALS( el.getPulseTimeMax(), EventProcessingBenchmark::runStart() + 9*EventProcessingBenchmark::PULSE_DT );
+    TS_ASSERT_LESS_THAN_EQUALS( 1000.0, el.getTofMin() );
+    TS_ASSERT_LESS_THAN_EQUALS( el.getTofMax(), 20000.0 );
+
+    // Always the same events
+    EventWorkspace_sptr again = EventProcessingBenchmark::createWorkspace(1, 3, 50, 10);
+    TS_ASSERT_EQUALS( again->getEventList(4).getTofMin(), el.getTofMin() );
+
+    EventWorkspace_sptr copy = EventProcessingBenchmark::copy(ws);
+    TS_ASSERT_EQUALS( copy->getNumberEvents(), ws->getNumberEvents() );
+    TS_ASSERT_EQUALS( copy->getInstrument()->getName(), ws->getInstrument()->getName() );
+  }
+
+  void test_createSplitters()
+  {
+    SplittersWorkspace_sptr splitters = EventProcessingBenchmark::createSplitters(100, 10, 3);
+    TS_ASSERT_EQUALS( splitters->getNumberSplitters(), 10 );
+    TS_ASSERT_EQUALS( splitters->getSplitter(3).index(), 0 );
+    TS_ASSERT_EQUALS( splitters->getSplitter(4).index(), 1 );
+  }
+
+  void test_report()
+  {
+    const std::string line = EventProcessingBenchmark::report("Rebin", 4, 1000, 0.5, 1024);
+    TS_ASSERT_EQUALS( line, "BENCHMARK {\"name\": \"Rebin\", \"threads\": 4, \"events\": 1000, \"seconds\": 0.5, "
+                            "\"events_per_sec\": 2000, \"peak_rss_kib\": 1024}" );
+  }
+};
+
+
+/** Throughput of the event processing hot path on synthetic workspaces.
+ *
+ * Every benchmark runs once on a single thread and once on all the threads, and prints a
+ * line of JSON per run (see EventProcessingBenchmark::report). The size of the workspace is taken from the
+ * properties benchmark.events.banks, benchmark.events.pixels (per side of a bank) and
+ * benchmark.events.perpixel, if they are set in the user properties.
+ */
+class EventProcessingBenchmarkTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static EventProcessingBenchmarkTestPerformance *createSuite() { return new EventProcessingBenchmarkTestPerformance(); }
+  static void destroySuite( EventProcessingBenchmarkTestPerformance *suite ) { delete suite; }
+
+  EventProcessingBenchmarkTestPerformance()
+    : numBanks(4), numPixels(50), eventsPerPixel(500), numPulses(10000), maxThreads(PARALLEL_GET_MAX_THREADS)
+  {
+    ConfigService::Instance().getValue("benchmark.events.banks", numBanks);
+    ConfigService::Instance().getValue("benchmark.events.pixels", numPixels);
+    ConfigService::Instance().getValue("benchmark.events.perpixel", eventsPerPixel);
+    input = EventProcessingBenchmark::createWorkspace(numBanks, numPixels, size_t(eventsPerPixel), numPulses);
+    numEvents = input->getNumberEvents();
+  }
+
+  ~EventProcessingBenchmarkTestPerformance()
+  {
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+  }
+
+  void test_LoadEventNexus()
+  {
+    // Reading is measured on the reference data file rather than the synthetic workspace
+    for (int pass = 0; pass < 2; pass++)
+    {
+      const int threads = setThreads(pass);
+      DataHandling::LoadEventNexus alg;
+      alg.initialize();
+      alg.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+      alg.setPropertyValue("OutputWorkspace", "benchmark_loaded");
+      Timer timer;
+      TS_ASSERT( alg.execute() );
+      const double seconds = timer.elapsed();
+      EventWorkspace_sptr loaded = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("benchmark_loaded");
+      print("LoadEventNexus", threads, loaded ? loaded->getNumberEvents() : 0, seconds);
+      AnalysisDataService::Instance().remove("benchmark_loaded");
+    }
+  }
+
+  void test_FilterEvents()
+  {
+    SplittersWorkspace_sptr splitters = EventProcessingBenchmark::createSplitters(numPulses, 100, 10);
+    for (int pass = 0; pass < 2; pass++)
+    {
+      const int threads = setThreads(pass);
+      Algorithms::FilterEvents alg;
+      alg.initialize();
+      alg.setProperty("InputWorkspace", input);
+      alg.setProperty("SplitterWorkspace", splitters);
+      alg.setPropertyValue("OutputWorkspaceBaseName", "benchmark_filtered");
+      Timer timer;
+      TS_ASSERT( alg.execute() );
+      print("FilterEvents", threads, numEvents, timer.elapsed());
+      AnalysisDataService::Instance().clear();
+    }
+  }
+
+  void test_Rebin_preserving_events()
+  {
+    for (int pass = 0; pass < 2; pass++)
+    {
+      const int threads = setThreads(pass);
+      Algorithms::Rebin alg;
+      alg.initialize();
+      alg.setChild(true);
+      alg.setProperty("InputWorkspace", boost::dynamic_pointer_cast<MatrixWorkspace>(input));
+      alg.setPropertyValue("OutputWorkspace", "benchmark_rebinned");
+      alg.setPropertyValue("Params", "1000,-0.001,20000");
+      alg.setProperty("PreserveEvents", true);
+      Timer timer;
+      TS_ASSERT( alg.execute() );
+      print("Rebin", threads, numEvents, timer.elapsed());
+    }
+  }
+
+  void test_ConvertUnits()
+  {
+    for (int pass = 0; pass < 2; pass++)
+    {
+      const int threads = setThreads(pass);
+      Algorithms::ConvertUnits alg;
+      alg.initialize();
+      alg.setChild(true);
+      alg.setProperty("InputWorkspace", boost::dynamic_pointer_cast<MatrixWorkspace>(input));
+      alg.setPropertyValue("OutputWorkspace", "benchmark_dSpacing");
+      alg.setPropertyValue("Target", "dSpacing");
+      Timer timer;
+      TS_ASSERT( alg.execute() );
+      print("ConvertUnits", threads, numEvents, timer.elapsed());
+    }
+  }
+
+  void test_SortEvents()
+  {
+    for (int pass = 0; pass < 2; pass++)
+    {
+      const int threads = setThreads(pass);
+      // Sorted in place, so on a copy every time
+      EventWorkspace_sptr ws = EventProcessingBenchmark::copy(input);
+      Algorithms::SortEvents alg;
+      alg.initialize();
+      alg.setChild(true);
+      alg.setProperty("InputWorkspace", ws);
+      alg.setPropertyValue("SortBy", "X Value");
+      Timer timer;
+      TS_ASSERT( alg.execute() );
+      print("SortEvents", threads, numEvents, timer.elapsed());
+    }
+  }
+
+  void test_CompressEvents()
+  {
+    for (int pass = 0; pass < 2; pass++)
+    {
+      const int threads = setThreads(pass);
+      DataHandling::CompressEvents alg;
+      alg.initialize();
+      alg.setChild(true);
+      alg.setProperty("InputWorkspace", input);
+      alg.setPropertyValue("OutputWorkspace", "benchmark_compressed");
+      alg.setProperty("Tolerance", 1.0);
+      Timer timer;
+      TS_ASSERT( alg.execute() );
+      print("CompressEvents", threads, numEvents, timer.elapsed());
+    }
+  }
+
+private:
+  /// Use one thread on the first pass and all of them on the second one. @return the number of threads
+  int setThreads(int pass)
+  {
+    const int threads = (pass == 0) ? 1 : maxThreads;
+    PARALLEL_SET_NUM_THREADS(threads);
+    return threads;
+  }
+
+  /// Print the result of a run, with the peak memory use so far
+  void print(const std::string & name, int threads, size_t processed, double seconds)
+  {
+    MemoryStats mem(MEMORY_STATS_IGNORE_SYSTEM);
+    std::cout << EventProcessingBenchmark::report(name, threads, processed, seconds, mem.peakResidentMem()) << std::endl;
+  }
+
+  int numBanks;
+  int numPixels;
+  int eventsPerPixel;
+  size_t numPulses;
+  int maxThreads;
+  size_t numEvents;
+  EventWorkspace_sptr input;
+};
+
+
+#endif /* MANTID_ALGORITHMS_EVENTPROCESSINGBENCHMARKTEST_H_ */
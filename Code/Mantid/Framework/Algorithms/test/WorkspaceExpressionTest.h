@@ -0,0 +1,147 @@
+#ifndef MANTID_ALGORITHMS_WORKSPACEEXPRESSIONTEST_H_
+#define MANTID_ALGORITHMS_WORKSPACEEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include <cmath>
+
+#include "MantidAlgorithms/WorkspaceExpression.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+using namespace Mantid::API;
+using namespace Mantid::Algorithms;
+
+class WorkspaceExpressionTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static WorkspaceExpressionTest *createSuite() { return new WorkspaceExpressionTest(); }
+  static void destroySuite( WorkspaceExpressionTest *suite ) { delete suite; }
+
+  /// Check all the values and errors of a workspace
+  void checkValues(const MatrixWorkspace_sptr & ws, const double y, const double e)
+  {
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+    {
+      for (size_t j = 0; j < ws->blocksize(); ++j)
+      {
+        TS_ASSERT_DELTA( ws->readY(i)[j], y, 1e-10 );
+        TS_ASSERT_DELTA( ws->readE(i)[j], e, 1e-10 );
+      }
+    }
+  }
+
+  void test_chain_of_workspaces()
+  {
+    // 5 +- 4 and 2 +- 3
+    MatrixWorkspace_sptr a = WorkspaceCreationHelper::Create2DWorkspace154(3, 4, true);
+    MatrixWorkspace_sptr b = WorkspaceCreationHelper::Create2DWorkspace123(3, 4, true);
+    MatrixWorkspace_sptr c = WorkspaceCreationHelper::Create2DWorkspace154(3, 4, true);
+
+    MatrixWorkspace_sptr result = ((WorkspaceExpression(a) - b) / c * 2.0).evaluate();
+    TS_ASSERT_EQUALS( result->getNumberHistograms(), 3 );
+    TS_ASSERT_EQUALS( result->blocksize(), 4 );
+    // (5-2) +- 5, divided by 5 +- 4, times 2
+    checkValues(result, 1.2, 2.0 * std::sqrt(25.0 + std::pow(3.0*4.0/5.0, 2)) / 5.0);
+
+    // The output has the binning and spectra of the input
+    for (size_t i = 0; i < 3; ++i)
+    {
+      TS_ASSERT_EQUALS( result->readX(i), a->readX(i) );
+      TS_ASSERT_EQUALS( result->getSpectrum(i)->getSpectrumNo(), a->getSpectrum(i)->getSpectrumNo() );
+    }
+    // The inputs are untouched
+    checkValues(a, 5.0, 4.0);
+    checkValues(b, 2.0, 3.0);
+  }
+
+  void test_single_spectrum_and_single_value_are_used_for_all_spectra()
+  {
+    MatrixWorkspace_sptr a = WorkspaceCreationHelper::Create2DWorkspace154(3, 4, true);
+    MatrixWorkspace_sptr spectrum = WorkspaceCreationHelper::Create2DWorkspace123(1, 4, true);
+    MatrixWorkspace_sptr value = WorkspaceCreationHelper::CreateWorkspaceSingleValueWithError(10.0, 1.0);
+
+    // The output has the shape of the biggest workspace, wherever it is in the expression
+    MatrixWorkspace_sptr result = (WorkspaceExpression(spectrum) * a + value).evaluate();
+    TS_ASSERT_EQUALS( result->getNumberHistograms(), 3 );
+    TS_ASSERT_EQUALS( result->blocksize(), 4 );
+    checkValues(result, 20.0, std::sqrt(64.0 + 225.0 + 1.0));
+  }
+
+  void test_unary_operations()
+  {
+    MatrixWorkspace_sptr a = WorkspaceCreationHelper::Create2DWorkspace154(2, 3, true);
+    checkValues((-exponential(logarithm(a))).evaluate(), -5.0, 4.0);
+    checkValues(logarithm(-WorkspaceExpression(a)).evaluate(), 0.0, 0.0);
+  }
+
+  void test_workspace_used_twice()
+  {
+    MatrixWorkspace_sptr a = WorkspaceCreationHelper::Create2DWorkspace154(2, 3, true);
+    WorkspaceExpression square = WorkspaceExpression(a) * a;
+    checkValues(square.evaluate(), 25.0, std::sqrt(2.0) * 20.0);
+    checkValues((square - square).evaluate(), 0.0, std::sqrt(2.0 * 800.0));
+  }
+
+  void test_one_workspace_is_copied()
+  {
+    MatrixWorkspace_sptr a = WorkspaceCreationHelper::Create2DWorkspace154(2, 3, true);
+    MatrixWorkspace_sptr result = WorkspaceExpression(a).evaluate();
+    TS_ASSERT_DIFFERS( result, a );
+    checkValues(result, 5.0, 4.0);
+  }
+
+  void test_mismatched_workspaces_throw()
+  {
+    MatrixWorkspace_sptr a = WorkspaceCreationHelper::Create2DWorkspace154(3, 4, true);
+    MatrixWorkspace_sptr moreBins = WorkspaceCreationHelper::Create2DWorkspace154(3, 5, true);
+    MatrixWorkspace_sptr fewerSpectra = WorkspaceCreationHelper::Create2DWorkspace154(2, 4, true);
+    MatrixWorkspace_sptr shifted = WorkspaceCreationHelper::Create2DWorkspaceBinned(3, 4, 100.0);
+    TS_ASSERT_THROWS( (WorkspaceExpression(a) + moreBins).evaluate(), std::invalid_argument );
+    TS_ASSERT_THROWS( (WorkspaceExpression(a) + fewerSpectra).evaluate(), std::invalid_argument );
+    TS_ASSERT_THROWS( (WorkspaceExpression(a) + shifted).evaluate(), std::invalid_argument );
+    TS_ASSERT_THROWS( (WorkspaceExpression(1.0) + 2.0).evaluate(), std::invalid_argument );
+  }
+
+  void test_ragged_workspaces_throw()
+  {
+    MatrixWorkspace_sptr a = WorkspaceCreationHelper::Create2DWorkspace154(3, 4, true);
+    MatrixWorkspace_sptr ragged = WorkspaceCreationHelper::Create2DWorkspace154(3, 4, true);
+    ragged->dataX(1).resize(3);
+    ragged->dataY(1).resize(2);
+    ragged->dataE(1).resize(2);
+    // Whether or not the ragged workspace gives the shape of the output
+    TS_ASSERT_THROWS( (WorkspaceExpression(a) + ragged).evaluate(), std::invalid_argument );
+    TS_ASSERT_THROWS( (WorkspaceExpression(ragged) + a).evaluate(), std::invalid_argument );
+    TS_ASSERT_THROWS( (WorkspaceExpression(ragged) * 2.0).evaluate(), std::invalid_argument );
+  }
+
+};
+
+
+class WorkspaceExpressionTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static WorkspaceExpressionTestPerformance *createSuite() { return new WorkspaceExpressionTestPerformance(); }
+  static void destroySuite( WorkspaceExpressionTestPerformance *suite ) { delete suite; }
+
+  WorkspaceExpressionTestPerformance()
+  {
+    sample = WorkspaceCreationHelper::Create2DWorkspace154(10000, 1000, true);
+    background = WorkspaceCreationHelper::Create2DWorkspace123(10000, 1000, true);
+    vanadium = WorkspaceCreationHelper::Create2DWorkspace154(10000, 1000, true);
+  }
+
+  void test_normalisation_chain()
+  {
+    MatrixWorkspace_sptr result = ((WorkspaceExpression(sample) - background) / vanadium * 2.0).evaluate();
+    TS_ASSERT_DELTA( result->readY(9999)[999], 1.2, 1e-10 );
+  }
+
+private:
+  MatrixWorkspace_sptr sample;
+  MatrixWorkspace_sptr background;
+  MatrixWorkspace_sptr vanadium;
+};
+
+#endif /* MANTID_ALGORITHMS_WORKSPACEEXPRESSIONTEST_H_ */
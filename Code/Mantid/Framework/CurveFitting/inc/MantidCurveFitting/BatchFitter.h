@@ -0,0 +1,148 @@
+#ifndef MANTID_CURVEFITTING_BATCHFITTER_H_
+#define MANTID_CURVEFITTING_BATCHFITTER_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidCurveFitting/DllConfig.h"
+#include "MantidAPI/IFunction.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid
+{
+namespace Kernel
+{
+  class ProgressBase;
+}
+namespace CurveFitting
+{
+/** Fits the same function to a number of spectra, one fit per spectrum.
+
+    Running the Fit algorithm for each spectrum creates the algorithm, the function (from its string), the
+    domain, the values, the cost function and the minimizer every time. A BatchFitter clones the function, and
+    creates the cost function and the minimizer, once per thread, and reuses them and the buffers of the values
+    for all the spectra it fits. The spectra are shared between the threads when the fits are independent: each
+    of them then starts from the parameters of the function given to the constructor. In sequential mode the
+    spectra are fitted one after the other, each fit starting from the result of the previous one.
+
+    @code
+      BatchFitter fitter(function);
+      for(size_t i = 0; i < ws->getNumberHistograms(); ++i) fitter.addSpectrum(ws, i);
+      fitter.fit();
+      ITableWorkspace_sptr parameters = fitter.createParameterTable();
+    @endcode
+
+    The data is prepared as Fit does with a MatrixWorkspace: histograms are fitted at the bin centres, and the
+    weights are the reciprocal errors. The fitting errors of the parameters are always calculated.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>.
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_CURVEFITTING_DLL BatchFitter
+{
+public:
+  BatchFitter(API::IFunction_const_sptr function);
+  ~BatchFitter();
+
+  /// Set the minimizer, as the Minimizer property of Fit. Default: Levenberg-Marquardt
+  void setMinimizer(const std::string & minimizer) { m_minimizer = minimizer; }
+  /// Set the cost function, as the CostFunction property of Fit. Default: Least squares
+  void setCostFunction(const std::string & costFunction) { m_costFunction = costFunction; }
+  /// Set the maximum number of iterations of each fit. Default: 500
+  void setMaxIterations(const int maxIterations) { m_maxIterations = maxIterations; }
+  /// Ignore infinities, NaNs and data with zero errors instead of failing the fit
+  void setIgnoreInvalidData(const bool ignore) { m_ignoreInvalidData = ignore; }
+  /// Start each fit from the result of the previous one, which fits the spectra one by one
+  void setSequential(const bool sequential) { m_sequential = sequential; }
+  /// Set the WorkspaceIndex attribute of the function (and its members) to the index of each spectrum
+  void setPassWorkspaceIndex(const bool pass) { m_passWorkspaceIndex = pass; }
+  void setFitRange(const double startX, const double endX);
+
+  void addSpectrum(API::MatrixWorkspace_const_sptr workspace, const size_t workspaceIndex);
+  /// The number of spectra to fit
+  size_t size() const { return m_spectra.size(); }
+
+  void fit(Kernel::ProgressBase * progress = NULL);
+
+  /// The number of parameters of the function
+  size_t nParams() const { return m_nParams; }
+  double getParameter(const size_t spectrum, const size_t iParam) const;
+  double getError(const size_t spectrum, const size_t iParam) const;
+  double getChi2(const size_t spectrum) const;
+  const std::string & getStatus(const size_t spectrum) const;
+  bool hasFailed(const size_t spectrum) const;
+
+  API::ITableWorkspace_sptr createParameterTable() const;
+
+  static void setWorkspaceIndexAttribute(API::IFunction_sptr function, const int workspaceIndex);
+
+private:
+  /// A spectrum to fit
+  struct Spectrum
+  {
+    API::MatrixWorkspace_const_sptr workspace;
+    size_t workspaceIndex;
+  };
+  /// The result of the fit of a spectrum
+  struct Result
+  {
+    Result() : chi2(0.0), failed(false) {}
+    std::vector<double> parameters;
+    std::vector<double> errors;
+    /// The cost function per degree of freedom
+    double chi2;
+    /// The status reported by the minimizer, or why the fit could not be done
+    std::string status;
+    /// Whether the fit could not be done
+    bool failed;
+  };
+  /// The objects of a thread doing fits, reused for all its spectra
+  struct FitState;
+
+  void fitSpectrum(FitState & state, const size_t spectrum);
+  const Result & getResult(const size_t spectrum) const;
+
+  /// The function, with the initial parameters
+  API::IFunction_const_sptr m_function;
+  /// The number of parameters of the function
+  size_t m_nParams;
+  std::string m_minimizer;
+  std::string m_costFunction;
+  int m_maxIterations;
+  bool m_ignoreInvalidData;
+  bool m_sequential;
+  bool m_passWorkspaceIndex;
+  /// The fitting range, EMPTY_DBL() for the whole spectra
+  double m_startX;
+  double m_endX;
+  std::vector<Spectrum> m_spectra;
+
+  /// The results of the fits, one per spectrum
+  std::vector<Result> m_results;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /*MANTID_CURVEFITTING_BATCHFITTER_H_*/
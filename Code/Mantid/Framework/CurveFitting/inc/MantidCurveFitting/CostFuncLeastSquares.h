@@ -54,6 +54,10 @@ public:
   /// Get short name of minimizer - useful for say labels in guis
   virtual std::string shortName() const {return "Chi-sq";};
 
+  /// Set fitting function.
+  virtual void setFittingFunction(API::IFunction_sptr function,
+    API::FunctionDomain_sptr domain, API::IFunctionValues_sptr values);
+
   /// Calculate value of cost function
   virtual double val() const;
 
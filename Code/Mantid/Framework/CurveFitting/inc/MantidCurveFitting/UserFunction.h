@@ -7,6 +7,7 @@
 #include "MantidAPI/ParamFunction.h"
 #include "MantidAPI/IFunction1D.h"
 #include <boost/shared_array.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace mu
 {
@@ -74,6 +75,8 @@ namespace Mantid
       void setAttribute(const std::string& attName,const Attribute& value);
       /// Check if attribute attName exists
       bool hasAttribute(const std::string& attName)const{return attName == "Formula";}
+      /// True if the derivatives are calculated from formulas rather than numerically
+      bool hasAnalyticDerivatives()const{return !m_derivatives.empty();}
 
     private:
       /// The formula
@@ -88,6 +91,11 @@ namespace Mantid
       mutable boost::shared_array<double> m_tmp;
       /// Temporary data storage used in functionDeriv
       mutable boost::shared_array<double> m_tmp1;
+      /// The derivatives of the formula with respect to each parameter. Empty if they are not known.
+      std::vector< boost::shared_ptr<mu::Parser> > m_derivatives;
+
+      /// Work out the formulas of the derivatives
+      void setDerivatives();
 
       /// mu::Parser callback function for setting variables.
       static double* AddVariable(const char *varName, void *pufun);
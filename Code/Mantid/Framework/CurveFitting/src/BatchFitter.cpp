@@ -0,0 +1,448 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidCurveFitting/BatchFitter.h"
+#include "MantidCurveFitting/CostFuncFitting.h"
+#include "MantidCurveFitting/GSLMatrix.h"
+#include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidAPI/TableRow.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ProgressBase.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <gsl/gsl_errno.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace Mantid
+{
+namespace CurveFitting
+{
+
+/// The objects of a thread doing fits, reused for all its spectra
+struct BatchFitter::FitState
+{
+  /// The thread's copy of the function
+  API::IFunction_sptr function;
+  boost::shared_ptr<CostFuncFitting> costFunction;
+  API::IFuncMinimizer_sptr minimizer;
+  /// The calculated values, the data and the weights of the spectrum being fitted
+  boost::shared_ptr<API::FunctionValues> values;
+  /// The bin centres of the spectrum being fitted, if it is a histogram
+  std::vector<double> binCentres;
+};
+
+/**
+ * Constructor.
+ * @param function :: The function to fit. It is not changed: the fits are done with copies of it.
+ */
+BatchFitter::BatchFitter(API::IFunction_const_sptr function):
+  m_function(function), m_nParams(0), m_minimizer("Levenberg-Marquardt"), m_costFunction("Least squares"),
+  m_maxIterations(500), m_ignoreInvalidData(false), m_sequential(false), m_passWorkspaceIndex(false),
+  m_startX(EMPTY_DBL()), m_endX(EMPTY_DBL())
+{
+  if (!m_function)
+  {
+    throw std::invalid_argument("BatchFitter needs a function to fit.");
+  }
+  m_nParams = m_function->nParams();
+}
+
+/// Destructor
+BatchFitter::~BatchFitter()
+{
+}
+
+/**
+ * Restrict the fits to a range of X, as the StartX and EndX properties of Fit.
+ * @param startX :: The start of the range
+ * @param endX :: The end of the range
+ * @throw std::invalid_argument if only one of them is EMPTY_DBL()
+ */
+void BatchFitter::setFitRange(const double startX, const double endX)
+{
+  if ( (startX == EMPTY_DBL()) != (endX == EMPTY_DBL()) )
+  {
+    throw std::invalid_argument("Both StartX and EndX must be given to set fitting interval.");
+  }
+  m_startX = startX;
+  m_endX = endX;
+}
+
+/**
+ * Add a spectrum to fit.
+ * @param workspace :: A workspace
+ * @param workspaceIndex :: The workspace index of the spectrum
+ * @throw std::out_of_range if the workspace has no such spectrum
+ */
+void BatchFitter::addSpectrum(API::MatrixWorkspace_const_sptr workspace, const size_t workspaceIndex)
+{
+  if ( !workspace || workspaceIndex >= workspace->getNumberHistograms() )
+  {
+    throw std::out_of_range("BatchFitter: workspace index out of range.");
+  }
+  Spectrum spectrum;
+  spectrum.workspace = workspace;
+  spectrum.workspaceIndex = workspaceIndex;
+  m_spectra.push_back(spectrum);
+}
+
+/**
+ * Fit all the spectra. A failure to fit one of them does not stop the others: it is recorded in
+ * its result, see hasFailed() and getStatus().
+ * @param progress :: Optional progress reporter, called once per spectrum. If it requests a cancellation
+ *   the remaining spectra are not fitted.
+ * @throw std::invalid_argument if the cost function or the minimizer are unknown
+ */
+void BatchFitter::fit(Kernel::ProgressBase * progress)
+{
+  // Don't let GSL abort on an error
+  gsl_set_error_handler_off();
+
+  m_results.assign(m_spectra.size(), Result());
+  const int64_t numberOfSpectra = static_cast<int64_t>(m_spectra.size());
+
+  bool parallel = !m_sequential && numberOfSpectra > 1;
+  for(auto spectrum = m_spectra.begin(); parallel && spectrum != m_spectra.end(); ++spectrum)
+  {
+    parallel = spectrum->workspace->threadSafe();
+  }
+
+  // The states are created up front: the factories are not meant to be used from several threads
+  const size_t numberOfStates = parallel ? static_cast<size_t>(PARALLEL_GET_MAX_THREADS) : 1;
+  std::vector< boost::shared_ptr<FitState> > states(numberOfStates);
+  for(size_t i = 0; i < numberOfStates; ++i)
+  {
+    boost::shared_ptr<FitState> state(new FitState);
+    state->function = m_function->clone();
+    state->costFunction = boost::dynamic_pointer_cast<CostFuncFitting>(
+      API::CostFunctionFactory::Instance().create(m_costFunction));
+    if (!state->costFunction)
+    {
+      throw std::invalid_argument("Cost function " + m_costFunction + " cannot be used for fitting.");
+    }
+    state->minimizer = API::FuncMinimizerFactory::Instance().createMinimizer(m_minimizer);
+    state->values.reset(new API::FunctionValues);
+    states[i] = state;
+  }
+
+  PARALLEL_FOR_IF( parallel )
+  for(int64_t i = 0; i < numberOfSpectra; ++i)
+  {
+    Result & result = m_results[i];
+    if ( progress && progress->hasCancellationBeenRequested() )
+    {
+      result.failed = true;
+      result.status = "Cancelled";
+      continue;
+    }
+    try
+    {
+      fitSpectrum(*states[PARALLEL_THREAD_NUMBER], static_cast<size_t>(i));
+    }
+    catch(std::exception & e)
+    {
+      result.failed = true;
+      result.status = e.what();
+    }
+    if (result.failed)
+    {
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      result.parameters.assign(m_nParams, nan);
+      result.errors.assign(m_nParams, nan);
+      result.chi2 = nan;
+    }
+    if (progress) progress->report();
+  }
+}
+
+/**
+ * Fit one spectrum and store the result.
+ * @param state :: The objects of the thread
+ * @param spectrum :: The index of the spectrum
+ */
+void BatchFitter::fitSpectrum(FitState & state, const size_t spectrum)
+{
+  const API::MatrixWorkspace_const_sptr & workspace = m_spectra[spectrum].workspace;
+  const size_t workspaceIndex = m_spectra[spectrum].workspaceIndex;
+  Result & result = m_results[spectrum];
+
+  // Find the fitting range as FitMW does
+  const MantidVec & X = workspace->readX(workspaceIndex);
+  if (X.empty())
+  {
+    throw std::runtime_error("Workspace contains no data.");
+  }
+  double startX = m_startX;
+  double endX = m_endX;
+  MantidVec::const_iterator from, to;
+  if (startX == EMPTY_DBL())
+  {
+    startX = X.front();
+    endX = X.back();
+    from = X.begin();
+    to = X.end();
+  }
+  else if (X.front() < X.back())
+  {
+    if (startX > endX) std::swap(startX, endX);
+    from = std::lower_bound(X.begin(), X.end(), startX);
+    to = std::upper_bound(from, X.end(), endX);
+  }
+  else
+  {
+    if (startX < endX) std::swap(startX, endX);
+    from = std::lower_bound(X.begin(), X.end(), startX, std::greater<double>());
+    to = std::upper_bound(from, X.end(), endX, std::greater<double>());
+  }
+  const bool isHistogram = workspace->isHistogramData();
+  if ( isHistogram && to == X.end() )
+  {
+    --to;
+  }
+  if ( from >= to )
+  {
+    throw std::runtime_error("No data in the fitting interval.");
+  }
+  const size_t n = static_cast<size_t>(to - from);
+  const size_t startIndex = static_cast<size_t>(from - X.begin());
+
+  // The domain looks at the X values, or at the bin centres of the thread
+  boost::shared_ptr<API::FunctionDomain1DView> domain;
+  if (isHistogram)
+  {
+    state.binCentres.resize(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+      state.binCentres[i] = (X[startIndex + i] + X[startIndex + i + 1]) / 2;
+    }
+    domain.reset(new API::FunctionDomain1DView(&state.binCentres[0], n));
+  }
+  else
+  {
+    domain.reset(new API::FunctionDomain1DView(&X[startIndex], n));
+  }
+
+  API::FunctionValues & values = *state.values;
+  values.reset(*domain);
+  const MantidVec & Y = workspace->readY(workspaceIndex);
+  const MantidVec & E = workspace->readE(workspaceIndex);
+  if (startIndex + n > Y.size())
+  {
+    throw std::runtime_error("BatchFitter: Inconsistent MatrixWorkspace");
+  }
+  for(size_t i = 0; i < n; ++i)
+  {
+    double y = Y[startIndex + i];
+    const double error = E[startIndex + i];
+    double weight = 0.0;
+    if ( !boost::math::isfinite(y) )
+    {
+      if ( !m_ignoreInvalidData ) throw std::runtime_error("Infinte number or NaN found in input data.");
+      y = 0.0;
+    }
+    else if ( !boost::math::isfinite(error) )
+    {
+      if ( !m_ignoreInvalidData ) throw std::runtime_error("Infinte number or NaN found in input data.");
+    }
+    else if ( error <= 0 )
+    {
+      if ( !m_ignoreInvalidData ) weight = 1.0;
+    }
+    else
+    {
+      weight = 1.0 / error;
+    }
+    values.setFitData(i, y);
+    values.setFitWeight(i, weight);
+  }
+
+  API::IFunction_sptr function = state.function;
+  if (!m_sequential)
+  {
+    for(size_t i = 0; i < m_nParams; ++i)
+    {
+      function->setParameter(i, m_function->getParameter(i));
+    }
+  }
+  if (m_passWorkspaceIndex)
+  {
+    setWorkspaceIndexAttribute(function, static_cast<int>(workspaceIndex));
+  }
+  function->setUpForFit();
+  function->setWorkspace(workspace);
+  function->setMatrixWorkspace(workspace, workspaceIndex, startX, endX);
+
+  CostFuncFitting & costFunction = *state.costFunction;
+  API::IFuncMinimizer & minimizer = *state.minimizer;
+  costFunction.setFittingFunction(function, domain, state.values);
+  minimizer.initialize(state.costFunction);
+
+  // Iterate as Fit does
+  int iter = 0;
+  std::string status;
+  while (iter < m_maxIterations)
+  {
+    ++iter;
+    function->iterationStarting();
+    if ( !minimizer.iterate() )
+    {
+      status = minimizer.getError();
+      if ( status.empty() ) status = "success";
+      break;
+    }
+    function->iterationFinished();
+  }
+  if (iter >= m_maxIterations)
+  {
+    if ( !status.empty() ) status += '\n';
+    status += "Failed to converge after " + boost::lexical_cast<std::string>(m_maxIterations) + " iterations.";
+  }
+
+  const size_t nActive = costFunction.nParams();
+  const size_t dof = values.size() > nActive ? values.size() - nActive : 1;
+  result.chi2 = minimizer.costFunctionVal() / static_cast<double>(dof);
+  result.status = status;
+
+  if ( nActive > 0 )
+  {
+    GSLMatrix covar;
+    costFunction.calCovarianceMatrix(covar);
+    costFunction.calFittingErrors(covar);
+  }
+  result.parameters.resize(m_nParams);
+  result.errors.resize(m_nParams);
+  for(size_t i = 0; i < m_nParams; ++i)
+  {
+    result.parameters[i] = function->getParameter(i);
+    result.errors[i] = function->getError(i);
+  }
+}
+
+/**
+  * Set any WorkspaceIndex attributes in the fitting function. If the function is composite
+  * try all its members.
+  * @param function :: The fitting function
+  * @param workspaceIndex :: Value for WorkspaceIndex attributes to set.
+  */
+void BatchFitter::setWorkspaceIndexAttribute(API::IFunction_sptr function, const int workspaceIndex)
+{
+  const std::string attName = "WorkspaceIndex";
+  if ( function->hasAttribute(attName) )
+  {
+    function->setAttributeValue(attName, workspaceIndex);
+  }
+
+  API::CompositeFunction_sptr cf = boost::dynamic_pointer_cast<API::CompositeFunction>( function );
+  if ( cf )
+  {
+    for(size_t i = 0; i < cf->nFunctions(); ++i)
+    {
+      setWorkspaceIndexAttribute( cf->getFunction(i), workspaceIndex );
+    }
+  }
+}
+
+/**
+ * @param spectrum :: The index of a spectrum, in the order they were added
+ * @return The result of its fit
+ * @throw std::out_of_range if there is no such spectrum, or fit() has not been called
+ */
+const BatchFitter::Result & BatchFitter::getResult(const size_t spectrum) const
+{
+  if ( spectrum >= m_results.size() )
+  {
+    throw std::out_of_range("BatchFitter: no fit result for spectrum " + boost::lexical_cast<std::string>(spectrum));
+  }
+  return m_results[spectrum];
+}
+
+/**
+ * @param spectrum :: The index of a spectrum, in the order they were added
+ * @param iParam :: The index of a parameter of the function
+ * @return The fitted value of the parameter
+ */
+double BatchFitter::getParameter(const size_t spectrum, const size_t iParam) const
+{
+  return getResult(spectrum).parameters.at(iParam);
+}
+
+/**
+ * @param spectrum :: The index of a spectrum, in the order they were added
+ * @param iParam :: The index of a parameter of the function
+ * @return The fitting error of the parameter, 0 if it was fixed or tied
+ */
+double BatchFitter::getError(const size_t spectrum, const size_t iParam) const
+{
+  return getResult(spectrum).errors.at(iParam);
+}
+
+/**
+ * @param spectrum :: The index of a spectrum, in the order they were added
+ * @return The value of the cost function per degree of freedom, as the OutputChi2overDoF property of Fit
+ */
+double BatchFitter::getChi2(const size_t spectrum) const
+{
+  return getResult(spectrum).chi2;
+}
+
+/**
+ * @param spectrum :: The index of a spectrum, in the order they were added
+ * @return The status of the fit, as the OutputStatus property of Fit, or why it could not be done
+ */
+const std::string & BatchFitter::getStatus(const size_t spectrum) const
+{
+  return getResult(spectrum).status;
+}
+
+/**
+ * @param spectrum :: The index of a spectrum, in the order they were added
+ * @return true if the fit could not be done. Its parameters and errors are then NaN.
+ */
+bool BatchFitter::hasFailed(const size_t spectrum) const
+{
+  return getResult(spectrum).failed;
+}
+
+/**
+ * Create a table of the results: a row per spectrum, with the name of the workspace, the workspace index,
+ * the pairs of values and errors of the parameters (as PlotPeakByLogValue), the chi squared and the status.
+ */
+API::ITableWorkspace_sptr BatchFitter::createParameterTable() const
+{
+  API::ITableWorkspace_sptr table = API::WorkspaceFactory::Instance().createTable("TableWorkspace");
+  table->addColumn("str","Workspace");
+  table->addColumn("int","WorkspaceIndex");
+  for(size_t iPar = 0; iPar < m_nParams; ++iPar)
+  {
+    table->addColumn("double",m_function->parameterName(iPar));
+    table->addColumn("double",m_function->parameterName(iPar)+"_Err");
+  }
+  table->addColumn("double","Chi_squared");
+  table->addColumn("str","Status");
+
+  for(size_t i = 0; i < m_results.size(); ++i)
+  {
+    const Result & result = m_results[i];
+    API::TableRow row = table->appendRow();
+    row << m_spectra[i].workspace->name() << static_cast<int>(m_spectra[i].workspaceIndex);
+    for(size_t iPar = 0; iPar < m_nParams; ++iPar)
+    {
+      row << result.parameters[iPar] << result.errors[iPar];
+    }
+    row << result.chi2 << result.status;
+  }
+  return table;
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -75,6 +75,8 @@ void CostFuncFitting::setFittingFunction(API::IFunction_sptr function,
   m_function = function;
   m_domain = domain;
   m_values = values;
+  // Anything cached was calculated with the previous function
+  setDirty();
   m_indexMap.clear();
   for(size_t i = 0; i < m_function->nParams(); ++i)
   {
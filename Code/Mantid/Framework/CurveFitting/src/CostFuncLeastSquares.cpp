@@ -36,6 +36,20 @@ CostFuncLeastSquares::CostFuncLeastSquares() : CostFuncFitting(),
  {
  }
 
+/**
+ * Set the function to fit. Forgets any state saved with push(), so that the
+ * cost function can be reused for another fit.
+ * @param function :: The function to fit
+ * @param domain :: The domain of the fit
+ * @param values :: The values to fit to
+ */
+void CostFuncLeastSquares::setFittingFunction(API::IFunction_sptr function,
+  API::FunctionDomain_sptr domain, API::IFunctionValues_sptr values)
+{
+  CostFuncFitting::setFittingFunction(function, domain, values);
+  m_pushed = false;
+}
+
 /** Calculate value of cost function
  * @return :: The value of the function
  */
@@ -44,6 +44,7 @@ void DampingMinimizer::initialize(API::ICostFunction_sptr function)
   {
     throw std::invalid_argument("Damping minimizer works only with least squares. Different function was given.");
   }
+  m_errorString = "";
 }
 
 /// Do one iteration.
@@ -117,7 +117,7 @@ DerivMinimizer::~DerivMinimizer()
 }
 
 /**
- * Initialize the minimizer.
+ * Initialize the minimizer. It can be initialized again with another cost function.
  * @param function :: A cost function to minimize.
  */
 void DerivMinimizer::initialize(API::ICostFunction_sptr function) 
@@ -129,17 +129,29 @@ void DerivMinimizer::initialize(API::ICostFunction_sptr function)
   m_gslMultiminContainer.fdf = &fundfun;
   m_gslMultiminContainer.params = this;
 
-  m_gslSolver = gsl_multimin_fdfminimizer_alloc( getGSLMinimizerType(), m_gslMultiminContainer.n );
-
   size_t nParams = m_costFunction->nParams();
+
+  // Reuse the solver of a previous initialization if it has the same size
+  if ( m_gslSolver != NULL && m_x->size != nParams )
+  {
+    gsl_multimin_fdfminimizer_free(m_gslSolver);
+    gsl_vector_free(m_x);
+    m_gslSolver = NULL;
+  }
+  if ( m_gslSolver == NULL )
+  {
+    m_gslSolver = gsl_multimin_fdfminimizer_alloc( getGSLMinimizerType(), m_gslMultiminContainer.n );
+    m_x = gsl_vector_alloc (nParams);
+  }
+
   // Starting point 
-  m_x = gsl_vector_alloc (nParams);
   for(size_t i = 0; i < nParams; ++i)
   {
     gsl_vector_set (m_x, i, m_costFunction->getParameter(i));
   }
 
   gsl_multimin_fdfminimizer_set (m_gslSolver, &m_gslMultiminContainer, m_x, m_stepSize, m_tolerance);
+  m_errorString = "";
 
 }
 
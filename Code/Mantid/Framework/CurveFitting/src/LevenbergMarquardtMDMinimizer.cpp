@@ -53,6 +53,9 @@ void LevenbergMarquardtMDMinimizer::initialize(API::ICostFunction_sptr function)
   m_mu = 0;
   m_nu = 2.0;
   m_rho = 1.0;
+  // The scaling factors of a previous fit don't apply to this one
+  m_D.clear();
+  m_errorString = "";
 }
 
 /// Do one iteration.
@@ -41,6 +41,8 @@ void LevenbergMarquardtMinimizer::initialize(API::ICostFunction_sptr costFunctio
   auto leastSquares = boost::dynamic_pointer_cast<CostFuncLeastSquares>(costFunction);
   if ( leastSquares )
   {
+    // it can be initialized more than once
+    delete m_data;
     m_data = new GSL_FitData( leastSquares );
   }
   else
@@ -59,8 +61,16 @@ void LevenbergMarquardtMinimizer::initialize(API::ICostFunction_sptr costFunctio
   gslContainer.p = m_data->p;
   gslContainer.params = m_data;
 
-  // setup GSL solver
-  m_gslSolver = gsl_multifit_fdfsolver_alloc(T, m_data->n, m_data->p);
+  // setup GSL solver, reusing the one of a previous initialization if it has the right size
+  if ( m_gslSolver && (m_gslSolver->f->size != m_data->n || m_gslSolver->x->size != m_data->p) )
+  {
+    gsl_multifit_fdfsolver_free(m_gslSolver);
+    m_gslSolver = NULL;
+  }
+  if ( !m_gslSolver )
+  {
+    m_gslSolver = gsl_multifit_fdfsolver_alloc(T, m_data->n, m_data->p);
+  }
   if (!m_gslSolver)
   {
     throw std::runtime_error("Levenberg-Marquardt minimizer failed to initialize. \n"+
@@ -71,6 +81,7 @@ void LevenbergMarquardtMinimizer::initialize(API::ICostFunction_sptr costFunctio
   gsl_multifit_fdfsolver_set(m_gslSolver, &gslContainer, m_data->initFuncParams);
 
   m_function = leastSquares->getFittingFunction();
+  m_errorString = "";
 
 }
 
@@ -34,6 +34,7 @@ In this example a group of three Matrix workspaces were fitted with a [[Gaussian
 #include <boost/lexical_cast.hpp>
 
 #include "MantidCurveFitting/PlotPeakByLogValue.h"
+#include "MantidCurveFitting/BatchFitter.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
 #include "MantidAPI/CostFunctionFactory.h"
@@ -190,6 +191,19 @@ namespace Mantid
       std::vector<std::string> fit_workspaces;
       std::vector<std::string> parameter_workspaces;
 
+      // Without output workspaces for each fit, all the spectra are fitted together, sharing the
+      // function, minimizer and buffers, and in parallel for individual fits
+      BatchFitter fitter(ifun);
+      fitter.setMinimizer(getPropertyValue("Minimizer"));
+      fitter.setCostFunction(getPropertyValue("CostFunction"));
+      const double startX = getProperty("StartX");
+      const double endX = getProperty("EndX");
+      fitter.setFitRange(startX, endX);
+      fitter.setSequential(!individual);
+      fitter.setPassWorkspaceIndex(passWSIndexToFunction);
+      std::vector<std::string> batchSourceNames;
+      std::vector<double> batchLogValues;
+
       double dProg = 1./static_cast<double>(wsNames.size());
       double Prog = 0.;
       for(int i=0;i<static_cast<int>(wsNames.size());++i)
@@ -250,13 +264,21 @@ namespace Mantid
             logValue = logp->lastValue();
           }
 
+          if (!createFitOutput)
+          {
+            fitter.addSpectrum(data.ws, static_cast<size_t>(j));
+            batchSourceNames.push_back(wsNames[i].name);
+            batchLogValues.push_back(logValue);
+            continue;
+          }
+
           double chi2;
 
           try
           {
             if ( passWSIndexToFunction )
             {
-                setWorkspaceIndexAttribute( ifun, j );
+                BatchFitter::setWorkspaceIndexAttribute( ifun, j );
             }
 
             g_log.debug() << "Fitting " << data.ws->name() << " index " << j << " with " << std::endl;
@@ -341,6 +363,35 @@ namespace Mantid
         } // for(;j < jend;++j)
       }
 
+      if (fitter.size() > 0)
+      {
+        API::Progress batchProgress(this, 0.0, 1.0, fitter.size());
+        fitter.fit(&batchProgress);
+        interruption_point();
+
+        for(size_t k = 0; k < fitter.size(); ++k)
+        {
+          if (fitter.hasFailed(k))
+          {
+            throw std::runtime_error("Fit of " + batchSourceNames[k] + " failed: " + fitter.getStatus(k));
+          }
+          TableRow row = result->appendRow();
+          if (isDataName)
+          {
+            row << batchSourceNames[k];
+          }
+          else
+          {
+            row << batchLogValues[k];
+          }
+          for(size_t iPar=0;iPar<fitter.nParams();++iPar)
+          {
+            row << fitter.getParameter(k,iPar) << fitter.getError(k,iPar);
+          }
+          row << fitter.getChi2(k);
+        }
+      }
+
       if(createFitOutput)
       {
         //collect output of fit for each spectrum into workspace groups
@@ -506,30 +557,6 @@ namespace Mantid
       return out;
     }
 
-    /**
-      * Set any WorkspaceIndex attributes in the fitting function. If the function is composite
-      * try all its members.
-      * @param fun :: The fitting function
-      * @param wsIndex :: Value for WorkspaceIndex attributes to set.
-      */
-    void PlotPeakByLogValue::setWorkspaceIndexAttribute(IFunction_sptr fun, int wsIndex) const
-    {
-        const std::string attName = "WorkspaceIndex";
-        if ( fun->hasAttribute(attName) )
-        {
-            fun->setAttributeValue(attName,wsIndex);
-        }
-
-        API::CompositeFunction_sptr cf = boost::dynamic_pointer_cast<API::CompositeFunction>( fun );
-        if ( cf )
-        {
-            for(size_t i = 0; i < cf->nFunctions(); ++i)
-            {
-                setWorkspaceIndexAttribute( cf->getFunction(i), wsIndex );
-            }
-        }
-    }
-
     /// Create a list of input workspace names
     std::vector<PlotPeakByLogValue::InputData> PlotPeakByLogValue::makeNames()const
     {
@@ -59,6 +59,8 @@ m_gslSolver(NULL)
 
 void SimplexMinimizer::initialize(API::ICostFunction_sptr function) 
 {
+  // free the memory of a previous initialization
+  clearMemory();
   m_costFunction = function;
 
   const gsl_multimin_fminimizer_type *T = gsl_multimin_fminimizer_nmsimplex;
@@ -83,6 +85,7 @@ void SimplexMinimizer::initialize(API::ICostFunction_sptr function)
   // setup minimizer
   m_gslSolver = gsl_multimin_fminimizer_alloc(T, np);
   gsl_multimin_fminimizer_set(m_gslSolver, &gslContainer, m_startGuess, m_simplexStepSize);
+  m_errorString = "";
 
 }
 
@@ -127,14 +130,17 @@ void SimplexMinimizer::clearMemory()
   if ( m_simplexStepSize )
   {
     gsl_vector_free(m_simplexStepSize);
+    m_simplexStepSize = NULL;
   }
   if ( m_startGuess )
   {
     gsl_vector_free(m_startGuess);
+    m_startGuess = NULL;
   }
   if ( m_gslSolver )
   {
     gsl_multimin_fminimizer_free(m_gslSolver);
+    m_gslSolver = NULL;
   }
 }
 
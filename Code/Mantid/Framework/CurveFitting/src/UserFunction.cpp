@@ -7,15 +7,23 @@ assigned by setting string attribute Formula:
 Formula must use 'x' for the x-values. The fitting parameters
 become defined only after the Formula attribute is set that is
 why Formula must go first in UserFunction definition.
+
+The derivatives with respect to the parameters are worked out from
+the formula if it uses only the arithmetic operators and muParser
+functions of one argument (except log). Otherwise, or if any of the
+parameters are tied, they are calculated numerically.
  *WIKI*/
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/UserFunction.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/Expression.h"
 #include <boost/tokenizer.hpp>
 #include "MantidGeometry/muParser_Silent.h"
 
+#include <cctype>
+
 namespace Mantid
 {
   namespace CurveFitting
@@ -27,6 +35,161 @@ namespace Mantid
     using namespace Kernel;
     using namespace API;
 
+    namespace
+    {
+      /// Thrown when a formula contains something the derivatives cannot be worked out for
+      class NotDifferentiable : public std::runtime_error
+      {
+      public:
+        NotDifferentiable(const std::string & what) : std::runtime_error(what) {}
+      };
+
+      /// Put brackets around a term
+      std::string bracket(const std::string & s)
+      {
+        return "(" + s + ")";
+      }
+
+      /// The sum (or difference for op == "-") of two terms, dropping zeros
+      std::string sum(const std::string & a, const std::string & b, const std::string & op)
+      {
+        if (b == "0") return a;
+        if (a == "0") return op == "-" ? "-" + bracket(b) : b;
+        return a + op + bracket(b);
+      }
+
+      /// The product of two terms, dropping zeros and ones
+      std::string product(const std::string & a, const std::string & b)
+      {
+        if (a == "0" || b == "0") return "0";
+        if (a == "1") return b;
+        if (b == "1") return a;
+        return bracket(a) + "*" + bracket(b);
+      }
+
+      /// The ratio of two terms
+      std::string ratio(const std::string & a, const std::string & b)
+      {
+        if (a == "0") return "0";
+        if (b == "1") return a;
+        return bracket(a) + "/" + bracket(b);
+      }
+
+      /// Check that a name without arguments is either a number or a variable muParser will accept
+      bool isNumberOrVariable(const std::string & name)
+      {
+        if (name.empty()) return false;
+        const bool isNumber = std::isdigit(name[0]) || name[0] == '.';
+        for(std::string::const_iterator c = name.begin(); c != name.end(); ++c)
+        {
+          const bool ok = isNumber ? (std::isdigit(*c) || *c == '.' || *c == 'e' || *c == 'E' || *c == '-' || *c == '+')
+                                   : (std::isalnum(*c) || *c == '_');
+          if (!ok) return false;
+        }
+        return true;
+      }
+
+      /**
+       * The derivative of a muParser function of one argument with respect to the argument
+       * @param name :: The name of the function
+       * @param u :: The argument
+       */
+      std::string functionDerivative(const std::string & name, const std::string & u)
+      {
+        const std::string arg = bracket(u);
+        if (name == "sin") return "cos" + arg;
+        if (name == "cos") return "-sin" + arg;
+        if (name == "tan") return "1/cos" + arg + "^2";
+        if (name == "asin") return "1/sqrt(1-" + arg + "^2)";
+        if (name == "acos") return "-1/sqrt(1-" + arg + "^2)";
+        if (name == "atan") return "1/(1+" + arg + "^2)";
+        if (name == "sinh") return "cosh" + arg;
+        if (name == "cosh") return "sinh" + arg;
+        if (name == "tanh") return "1/cosh" + arg + "^2";
+        if (name == "exp") return "exp" + arg;
+        if (name == "ln") return "1/" + arg;
+        if (name == "log10") return "1/(" + arg + "*ln(10))";
+        if (name == "log2") return "1/(" + arg + "*ln(2))";
+        if (name == "sqrt") return "0.5/sqrt" + arg;
+        if (name == "abs") return "sign" + arg;
+        // log is log10 or ln depending on the version of muParser, and the others are not smooth
+        throw NotDifferentiable(name);
+      }
+
+      /**
+       * Differentiate a parsed formula. The operator precedence of Expression is that of muParser for
+       * the operators and functions which are supported here; anything else throws NotDifferentiable.
+       * @param expr :: The formula
+       * @param var :: The name of the variable to differentiate with respect to
+       * @return The derivative as a muParser expression
+       */
+      std::string differentiate(const Expression & expr, const std::string & var)
+      {
+        const std::string & name = expr.name();
+        if (expr.size() == 0)
+        {
+          if (!isNumberOrVariable(name)) throw NotDifferentiable(name);
+          return name == var ? "1" : "0";
+        }
+        if (expr.size() == 1)
+        {
+          const Expression & arg = expr[0];
+          if (name.empty()) return differentiate(arg, var); // brackets
+          const std::string darg = differentiate(arg, var);
+          if (name == "+") return darg;
+          if (name == "-") return darg == "0" ? "0" : "-" + bracket(darg);
+          return product(functionDerivative(name, arg.str()), darg);
+        }
+        if (name == "+")
+        {
+          std::string res = "0";
+          for(size_t i = 0; i < expr.size(); ++i)
+          {
+            res = sum(res, differentiate(expr[i], var), expr[i].operator_name() == "-" ? "-" : "+");
+          }
+          return res;
+        }
+        if (name == "*")
+        {
+          // fold from the left, as the terms are evaluated
+          std::string g = expr[0].str();
+          std::string dg = differentiate(expr[0], var);
+          for(size_t i = 1; i < expr.size(); ++i)
+          {
+            const std::string h = expr[i].str();
+            const std::string dh = differentiate(expr[i], var);
+            if (expr[i].operator_name() == "/")
+            {
+              dg = sum(ratio(dg, h), ratio(product(g, dh), bracket(h) + "^2"), "-");
+              g = bracket(g) + "/" + bracket(h);
+            }
+            else
+            {
+              dg = sum(product(dg, h), product(g, dh), "+");
+              g = bracket(g) + "*" + bracket(h);
+            }
+          }
+          return dg;
+        }
+        // muParser applies a sign after the power (-a^2 == -(a^2)) while Expression applies it before,
+        // and the associativity of a^b^c differs between versions of muParser
+        const bool signedBase = expr.size() == 2 && expr[0].size() == 1 && (expr[0].name() == "-" || expr[0].name() == "+");
+        if (name == "^" && expr.size() == 2 && !signedBase)
+        {
+          const std::string a = expr[0].str();
+          const std::string b = expr[1].str();
+          const std::string da = differentiate(expr[0], var);
+          const std::string db = differentiate(expr[1], var);
+          if (db == "0")
+          {
+            return product(product(b, bracket(a) + "^" + bracket(bracket(b) + "-1")), da);
+          }
+          return product(bracket(a) + "^" + bracket(b), sum(product(db, "ln" + bracket(a)), ratio(product(b, da), a), "+"));
+        }
+        throw NotDifferentiable(name);
+      }
+    }
+
     /// Constructor
     UserFunction::UserFunction() : m_parser(new mu::Parser()), m_x_set(false) {}
 
@@ -76,6 +239,7 @@ namespace Mantid
       }
 
       m_x_set = false;
+      m_derivatives.clear();
       clearAllParameters();
 
       try
@@ -111,6 +275,41 @@ namespace Mantid
       }
 
       m_parser->SetExpr(m_formula);
+
+      setDerivatives();
+    }
+
+    /**
+     * Work out the formulas of the derivatives of the function with respect to its parameters.
+     * If it cannot be done for any of them m_derivatives is left empty and the derivatives are
+     * calculated numerically.
+     */
+    void UserFunction::setDerivatives()
+    {
+      std::vector< boost::shared_ptr<mu::Parser> > derivatives;
+      try
+      {
+        Expression expr;
+        expr.parse(m_formula);
+        for(size_t i = 0; i < nParams(); ++i)
+        {
+          boost::shared_ptr<mu::Parser> parser(new mu::Parser());
+          parser->DefineVar("x",&m_x);
+          for(size_t j = 0; j < nParams(); ++j)
+          {
+            parser->DefineVar(parameterName(j),getParameterAddress(j));
+          }
+          parser->SetExpr(differentiate(expr, parameterName(i)));
+          // Eval() parses the expression and throws if muParser does not understand it
+          parser->Eval();
+          derivatives.push_back(parser);
+        }
+      }
+      catch(...)
+      {
+        return;
+      }
+      m_derivatives.swap(derivatives);
     }
 
     /** Calculate the fitting function.
@@ -135,7 +334,32 @@ namespace Mantid
     */
     void UserFunction::functionDeriv(const API::FunctionDomain& domain, API::Jacobian& jacobian)
     {
-      calNumericalDeriv(domain,jacobian);
+      const FunctionDomain1D* d1d = dynamic_cast<const FunctionDomain1D*>(&domain);
+      // A tied parameter changes with the others, which the formulas of the derivatives do not know
+      bool analytic = d1d && hasAnalyticDerivatives();
+      for(size_t iP = 0; analytic && iP < nParams(); ++iP)
+      {
+        if (getTie(iP)) analytic = false;
+      }
+      if (!analytic)
+      {
+        calNumericalDeriv(domain,jacobian);
+        return;
+      }
+
+      std::vector<size_t> active;
+      for(size_t iP = 0; iP < nParams(); ++iP)
+      {
+        if (isActive(iP)) active.push_back(iP);
+      }
+      for(size_t i = 0; i < d1d->size(); ++i)
+      {
+        m_x = (*d1d)[i];
+        for(std::vector<size_t>::const_iterator iP = active.begin(); iP != active.end(); ++iP)
+        {
+          jacobian.set(i, *iP, m_derivatives[*iP]->Eval());
+        }
+      }
     }
 
   } // namespace CurveFitting
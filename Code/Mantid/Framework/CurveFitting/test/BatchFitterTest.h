@@ -0,0 +1,203 @@
+#ifndef MANTID_CURVEFITTING_BATCHFITTERTEST_H_
+#define MANTID_CURVEFITTING_BATCHFITTERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/BatchFitter.h"
+#include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/ProgressBase.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <limits>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::CurveFitting;
+
+namespace
+{
+  /// A straight line with a different intercept in each spectrum
+  struct BatchFitterTestLine
+  {
+    double operator()(double x, int spec)
+    {
+      return 1.0 + spec + 0.5 * x;
+    }
+  };
+
+  /// Requests a cancellation after some reports
+  class BatchFitterTestProgress : public Kernel::ProgressBase
+  {
+  public:
+    BatchFitterTestProgress(int64_t numSteps, int64_t cancelAfter) : Kernel::ProgressBase(0.0, 1.0, numSteps),
+      m_cancelAfter(cancelAfter) {}
+    void doReport(const std::string&) {}
+    bool hasCancellationBeenRequested() const { return m_i >= m_cancelAfter; }
+  private:
+    int64_t m_cancelAfter;
+  };
+}
+
+class BatchFitterTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BatchFitterTest *createSuite() { return new BatchFitterTest(); }
+  static void destroySuite( BatchFitterTest *suite ) { delete suite; }
+
+  BatchFitterTest()
+  {
+    m_line = FunctionFactory::Instance().createInitialized("name=LinearBackground,A0=0,A1=0");
+  }
+
+  void test_individual_fits()
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(BatchFitterTestLine(), 10, 0.0, 10.0, 0.5);
+    BatchFitter fitter(m_line);
+    for(size_t i = 0; i < 10; ++i)
+    {
+      fitter.addSpectrum(ws, i);
+    }
+    TS_ASSERT_EQUALS( fitter.size(), 10 );
+    TS_ASSERT_EQUALS( fitter.nParams(), 2 );
+    fitter.fit();
+
+    for(size_t i = 0; i < 10; ++i)
+    {
+      TS_ASSERT( !fitter.hasFailed(i) );
+      TS_ASSERT_EQUALS( fitter.getStatus(i), "success" );
+      TS_ASSERT_DELTA( fitter.getParameter(i, 0), 1.0 + static_cast<double>(i), 1e-6 );
+      TS_ASSERT_DELTA( fitter.getParameter(i, 1), 0.5, 1e-6 );
+      TS_ASSERT_LESS_THAN( 0.0, fitter.getError(i, 0) );
+      TS_ASSERT_DELTA( fitter.getChi2(i), 0.0, 1e-6 );
+    }
+    // The function itself is not fitted
+    TS_ASSERT_EQUALS( m_line->getParameter(0), 0.0 );
+  }
+
+  void test_sequential_fits_of_histograms_in_a_range()
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(BatchFitterTestLine(), 3, 0.0, 10.0, 0.5, true);
+    BatchFitter fitter(m_line);
+    fitter.setSequential(true);
+    fitter.setFitRange(2.0, 8.0);
+    for(size_t i = 0; i < 3; ++i)
+    {
+      fitter.addSpectrum(ws, 2 - i);
+    }
+    fitter.fit();
+
+    for(size_t i = 0; i < 3; ++i)
+    {
+      // The bin centres are 0.25 above the X values of the function
+      TS_ASSERT_DELTA( fitter.getParameter(i, 0), 3.0 - static_cast<double>(i) - 0.125, 1e-6 );
+      TS_ASSERT_DELTA( fitter.getParameter(i, 1), 0.5, 1e-6 );
+    }
+  }
+
+  void test_a_failed_fit_does_not_stop_the_others()
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(BatchFitterTestLine(), 3, 0.0, 10.0, 0.5);
+    ws->dataY(1)[4] = std::numeric_limits<double>::quiet_NaN();
+    BatchFitter fitter(m_line);
+    for(size_t i = 0; i < 3; ++i)
+    {
+      fitter.addSpectrum(ws, i);
+    }
+    fitter.fit();
+    TS_ASSERT( !fitter.hasFailed(0) );
+    TS_ASSERT( fitter.hasFailed(1) );
+    TS_ASSERT( !fitter.hasFailed(2) );
+    TS_ASSERT_DIFFERS( fitter.getStatus(1).find("NaN"), std::string::npos );
+    TS_ASSERT( fitter.getParameter(1, 0) != fitter.getParameter(1, 0) );
+    TS_ASSERT_DELTA( fitter.getParameter(2, 0), 3.0, 1e-6 );
+
+    fitter.setIgnoreInvalidData(true);
+    fitter.fit();
+    TS_ASSERT( !fitter.hasFailed(1) );
+    TS_ASSERT_DELTA( fitter.getParameter(1, 0), 2.0, 1e-6 );
+  }
+
+  void test_cancellation_stops_the_fits()
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(BatchFitterTestLine(), 5, 0.0, 10.0, 0.5);
+    BatchFitter fitter(m_line);
+    fitter.setSequential(true);
+    for(size_t i = 0; i < 5; ++i)
+    {
+      fitter.addSpectrum(ws, i);
+    }
+    BatchFitterTestProgress progress(5, 2);
+    fitter.fit(&progress);
+    TS_ASSERT( !fitter.hasFailed(1) );
+    TS_ASSERT( fitter.hasFailed(2) );
+    TS_ASSERT_EQUALS( fitter.getStatus(4), "Cancelled" );
+  }
+
+  void test_parameter_table()
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(BatchFitterTestLine(), 2, 0.0, 10.0, 0.5);
+    BatchFitter fitter(m_line);
+    fitter.addSpectrum(ws, 1);
+    fitter.addSpectrum(ws, 0);
+    fitter.fit();
+
+    ITableWorkspace_sptr table = fitter.createParameterTable();
+    TS_ASSERT_EQUALS( table->rowCount(), 2 );
+    TS_ASSERT_EQUALS( table->columnCount(), 8 );
+    TS_ASSERT_EQUALS( table->getColumn(2)->name(), "A0" );
+    TS_ASSERT_EQUALS( table->getColumn(3)->name(), "A0_Err" );
+    TS_ASSERT_EQUALS( table->getColumn(6)->name(), "Chi_squared" );
+    TS_ASSERT_EQUALS( table->Int(0, 1), 1 );
+    TS_ASSERT_DELTA( table->Double(0, 2), 2.0, 1e-6 );
+    TS_ASSERT_EQUALS( table->Int(1, 1), 0 );
+    TS_ASSERT_DELTA( table->Double(1, 2), 1.0, 1e-6 );
+    TS_ASSERT_EQUALS( table->String(1, 7), "success" );
+  }
+
+  void test_bad_input_throws()
+  {
+    MatrixWorkspace_sptr ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(BatchFitterTestLine(), 2, 0.0, 10.0, 0.5);
+    IFunction_sptr noFunction;
+    TS_ASSERT_THROWS( BatchFitter(noFunction).size(), std::invalid_argument );
+    BatchFitter fitter(m_line);
+    TS_ASSERT_THROWS( fitter.addSpectrum(ws, 2), std::out_of_range );
+    TS_ASSERT_THROWS( fitter.setFitRange(1.0, EMPTY_DBL()), std::invalid_argument );
+    TS_ASSERT_THROWS( fitter.getParameter(0, 0), std::out_of_range );
+  }
+
+private:
+  IFunction_sptr m_line;
+};
+
+
+class BatchFitterTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static BatchFitterTestPerformance *createSuite() { return new BatchFitterTestPerformance(); }
+  static void destroySuite( BatchFitterTestPerformance *suite ) { delete suite; }
+
+  BatchFitterTestPerformance()
+  {
+    m_ws = WorkspaceCreationHelper::Create2DWorkspaceFromFunction(BatchFitterTestLine(), 10000, 0.0, 100.0, 0.1);
+  }
+
+  void test_fit_10000_spectra()
+  {
+    BatchFitter fitter(FunctionFactory::Instance().createInitialized("name=LinearBackground,A0=0,A1=0"));
+    for(size_t i = 0; i < m_ws->getNumberHistograms(); ++i)
+    {
+      fitter.addSpectrum(m_ws, i);
+    }
+    fitter.fit();
+    TS_ASSERT_DELTA( fitter.getParameter(9999, 0), 10000.0, 1e-4 );
+  }
+
+private:
+  MatrixWorkspace_sptr m_ws;
+};
+
+#endif /* MANTID_CURVEFITTING_BATCHFITTERTEST_H_ */
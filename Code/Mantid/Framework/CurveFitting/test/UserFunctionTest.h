@@ -91,6 +91,79 @@ public:
     TS_ASSERT( categories[0] == "General" );
 
   }
+
+  void testAnalyticDerivatives()
+  {
+    UserFunction fun;
+    fun.setAttribute("Formula",UserFunction::Attribute("a*exp(-b*x^2)/(1+c*x)+sqrt(x)*cos(d*x)^2-ln(x+c)*atan(a-x)+d^c*abs(b-x)"));
+    TS_ASSERT( fun.hasAnalyticDerivatives() );
+    fun.setParameter("a",1.3);
+    fun.setParameter("b",0.7);
+    fun.setParameter("c",2.1);
+    fun.setParameter("d",0.4);
+    fun.fix(2);
+
+    const size_t nParams = 4;
+    const size_t nData = 10;
+    std::vector<double> x(nData);
+    for(size_t i=0;i<nData;i++)
+    {
+      x[i] = 0.1 + 0.3*static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData,nParams);
+    fun.functionDeriv(domain,J);
+    UserTestJacobian Jnum(nData,nParams);
+    fun.calNumericalDeriv(domain,Jnum);
+
+    for(size_t i=0;i<nData;i++)
+    {
+      TS_ASSERT_DELTA(J.get(i,0),exp(-0.7*x[i]*x[i])/(1+2.1*x[i]),1e-10);
+      for(size_t j=0;j<nParams;j++)
+      {
+        // the fixed parameter is not set
+        if (j == 2) continue;
+        TS_ASSERT_DELTA(J.get(i,j),Jnum.get(i,j),1e-4);
+      }
+    }
+  }
+
+  void testNumericalDerivativesForUnsupportedFormulas()
+  {
+    UserFunction fun;
+    fun.setAttribute("Formula",UserFunction::Attribute("1e-3*a*x^2+b*x"));
+    TS_ASSERT( fun.hasAnalyticDerivatives() );
+    // functions with more than one argument
+    fun.setAttribute("Formula",UserFunction::Attribute("min(a,x)"));
+    TS_ASSERT( !fun.hasAnalyticDerivatives() );
+    // muParser and Expression disagree on the precedence of the sign
+    fun.setAttribute("Formula",UserFunction::Attribute("-a^2*x"));
+    TS_ASSERT( !fun.hasAnalyticDerivatives() );
+    fun.setAttribute("Formula",UserFunction::Attribute("-(a^2)*x"));
+    TS_ASSERT( fun.hasAnalyticDerivatives() );
+    fun.setAttribute("Formula",UserFunction::Attribute("x>a"));
+    TS_ASSERT( !fun.hasAnalyticDerivatives() );
+  }
+
+  void testTiedParametersUseNumericalDerivatives()
+  {
+    UserFunction fun;
+    fun.setAttribute("Formula",UserFunction::Attribute("a*x+b"));
+    fun.setParameter("a",2.0);
+    fun.tie("b","2*a");
+    fun.applyTies();
+
+    std::vector<double> x(3);
+    x[0] = 1.0; x[1] = 2.0; x[2] = 3.0;
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(3,2);
+    fun.functionDeriv(domain,J);
+    for(size_t i=0;i<3;i++)
+    {
+      // the derivative of a*x+2*a
+      TS_ASSERT_DELTA(J.get(i,0),x[i]+2.0,1e-6);
+    }
+  }
 };
 
 #endif /*USERFUNCTIONTEST_H_*/
@@ -129,6 +129,12 @@ namespace Mantid
       size_t bad_tofs;
       /// A count of events discarded because they came from a pixel that's not in the IDF
       size_t discarded_events;
+      /// Bytes read from the event data of the banks
+      size_t m_bytesRead;
+      /// Number of events handed to the ProcessBankData tasks (counted once per bank, even when split)
+      size_t m_eventsProcessed;
+      /// Time spent processing the events, summed over the threads
+      double m_processSeconds;
 
       /// Do we pre-count the # of events in each pixel ID?
       bool precount;
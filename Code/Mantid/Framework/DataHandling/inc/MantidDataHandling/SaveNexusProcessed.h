@@ -62,6 +62,10 @@ namespace Mantid
       /// Algorithm's category for identification overriding a virtual method
       virtual const std::string category() const { return "DataHandling\\Nexus";}
 
+    protected:
+      /// The number of events written to the file at a time
+      size_t m_eventChunkSize;
+
     private:
       /// Sets documentation strings for this algorithm
       virtual void initDocs();
@@ -72,9 +76,6 @@ namespace Mantid
 
       void getSpectrumList(std::vector<int> & spec, Mantid::API::MatrixWorkspace_const_sptr matrixWorkspace);
 
-      template<class T>
-      static void appendEventListData( std::vector<T> events, size_t offset, double * tofs, float * weights, float * errorSquareds, int64_t * pulsetimes);
-
       void execEvent(Mantid::NeXus::NexusFileIO * nexusFile,const bool uniformSpectra,const std::vector<int> spec);
 	    /// sets non workspace properties for the algorithm
       void setOtherProperties(IAlgorithm* alg,const std::string & propertyName,const std::string &propertyValue,int perioidNum);
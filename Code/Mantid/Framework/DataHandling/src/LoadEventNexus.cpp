@@ -36,7 +36,7 @@ Veto pulses can be filtered out in a separate step using [[FilterByLogValue]]:
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/UnitFactory.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 #include "MantidKernel/TimeSeriesProperty.h"
@@ -46,6 +46,10 @@ Veto pulses can be filtered out in a separate step using [[FilterByLogValue]]:
 #include "MantidAPI/RegisterFileLoader.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
 #include "MantidKernel/Timer.h"
+#include <Poco/Condition.h>
+#include <Poco/Runnable.h>
+#include <Poco/Thread.h>
+#include <algorithm>
 
 using std::endl;
 using std::map;
@@ -124,8 +128,107 @@ bool BankPulseTimes::equals(size_t otherNumPulse, std::string otherStartTime)
 
 //===============================================================================================
 //===============================================================================================
-/** This task does the disk IO from loading the NXS file,
- * and so will be on a disk IO mutex */
+/** The arrays of one bank, as read from the file by LoadBankFromDiskTask
+ * and used by ProcessBankData. They are returned to a BankEventBufferPool
+ * afterwards, so that their memory is reused for the next bank.
+ */
+class BankEventBuffer
+{
+public:
+  /// event pixel IDs
+  std::vector<uint32_t> eventId;
+  /// event TOFs
+  std::vector<float> eventTimeOfFlight;
+  /// event weights, for simulated data
+  std::vector<float> eventWeight;
+  /// index of the first event of each pulse
+  std::vector<uint64_t> eventIndex;
+};
+
+//===============================================================================================
+/** A bounded set of BankEventBuffer's, shared by the thread reading the banks
+ * and the ProcessBankData tasks. acquire() waits until a buffer is free, so the
+ * reading can only get a few banks ahead of the processing and the memory used
+ * stays bounded.
+ */
+class BankEventBufferPool
+{
+public:
+  /** Constructor
+   * @param maxBuffers :: the largest number of buffers in use at one time */
+  BankEventBufferPool(size_t maxBuffers)
+  : m_maxBuffers(std::max(maxBuffers, size_t(1))), m_waitSeconds(0.)
+  {}
+
+  /// Destructor. All the buffers must have been released.
+  ~BankEventBufferPool()
+  {
+    for (size_t i=0; i < m_all.size(); i++)
+      delete m_all[i];
+  }
+
+  /** Get a free buffer, waiting for one to be released if they are all in use.
+   * @return the buffer. It goes back to the pool when the last copy of the pointer is gone. */
+  boost::shared_ptr<BankEventBuffer> acquire()
+  {
+    Poco::Mutex::ScopedLock lock(m_mutex);
+    if (m_free.empty() && m_all.size() < m_maxBuffers)
+    {
+      m_all.push_back(new BankEventBuffer());
+      m_free.push_back(m_all.back());
+    }
+    Timer waitTimer;
+    while (m_free.empty())
+      m_released.wait(m_mutex);
+    m_waitSeconds += waitTimer.elapsed();
+
+    BankEventBuffer * buffer = m_free.back();
+    m_free.pop_back();
+    return boost::shared_ptr<BankEventBuffer>(buffer, Releaser(this));
+  }
+
+  /// @return the time spent in acquire() waiting for a buffer to be released
+  double waitSeconds()
+  {
+    Poco::Mutex::ScopedLock lock(m_mutex);
+    return m_waitSeconds;
+  }
+
+private:
+  /// Put a buffer back into the pool
+  void release(BankEventBuffer * buffer)
+  {
+    Poco::Mutex::ScopedLock lock(m_mutex);
+    m_free.push_back(buffer);
+    m_released.signal();
+  }
+
+  /// Deleter of the shared_ptr's given by acquire()
+  struct Releaser
+  {
+    Releaser(BankEventBufferPool * pool) : pool(pool) {}
+    void operator()(BankEventBuffer * buffer) { pool->release(buffer); }
+    BankEventBufferPool * pool;
+  };
+
+  /// Largest number of buffers
+  size_t m_maxBuffers;
+  /// All the buffers created
+  std::vector<BankEventBuffer *> m_all;
+  /// The buffers not in use
+  std::vector<BankEventBuffer *> m_free;
+  /// Protects the lists of buffers
+  Poco::Mutex m_mutex;
+  /// Signalled when a buffer is released
+  Poco::Condition m_released;
+  /// Time spent waiting for a buffer
+  double m_waitSeconds;
+};
+
+//===============================================================================================
+//===============================================================================================
+/** This task fills the event lists from the data of one bank
+ * that was read from the file by LoadBankFromDiskTask. */
 class ProcessBankData : public Task
 {
 public:
@@ -135,34 +238,29 @@ public:
    * @param entry_name :: name of the bank
    * @param prog :: Progress reporter
    * @param scheduler :: ThreadScheduler running this task
-   * @param event_id :: array with event IDs
-   * @param event_time_of_flight :: array with event TOFS
+   * @param buffer :: arrays with the event IDs, TOFs, weights and event index (length of # of pulses)
    * @param numEvents :: how many events in the arrays
    * @param startAt :: index of the first event from event_index
-   * @param event_index :: vector of event index (length of # of pulses)
    * @param thisBankPulseTimes :: ptr to the pulse times for this particular bank.
    * @param have_weight :: flag for handling simulated files
-   * @param event_weight :: array with weights for events
    * @param min_event_id ;: minimum detector ID to load
    * @param max_event_id :: maximum detector ID to load
    * @return
    */
   ProcessBankData(LoadEventNexus * alg, std::string entry_name,
                   Progress * prog, ThreadScheduler * scheduler,
-                  boost::shared_array<uint32_t> event_id,
-                  boost::shared_array<float> event_time_of_flight,
+                  boost::shared_ptr<BankEventBuffer> buffer,
                   size_t numEvents, size_t startAt,
-                  boost::shared_ptr<std::vector<uint64_t> > event_index,
                   BankPulseTimes * thisBankPulseTimes,
-                  bool have_weight, boost::shared_array<float> event_weight,
+                  bool have_weight,
                   detid_t min_event_id, detid_t max_event_id)
   : Task(),
     alg(alg), entry_name(entry_name), pixelID_to_wi_vector(alg->pixelID_to_wi_vector), pixelID_to_wi_offset(alg->pixelID_to_wi_offset),
-    prog(prog), scheduler(scheduler),
-    event_id(event_id), event_time_of_flight(event_time_of_flight), numEvents(numEvents), startAt(startAt),
-    event_index(event_index),
+    prog(prog), scheduler(scheduler), buffer(buffer),
+    event_id(&buffer->eventId[0]), event_time_of_flight(&buffer->eventTimeOfFlight[0]), numEvents(numEvents), startAt(startAt),
+    event_index(&buffer->eventIndex),
     thisBankPulseTimes(thisBankPulseTimes), have_weight(have_weight),
-    event_weight(event_weight), m_min_id(min_event_id), m_max_id(max_event_id)
+    event_weight(have_weight ? &buffer->eventWeight[0] : NULL), m_min_id(min_event_id), m_max_id(max_event_id)
   {
     // Cost is approximately proportional to the number of events to process.
     m_cost = static_cast<double>(numEvents);
@@ -172,6 +270,7 @@ public:
   // Run the data processing
   void run()
   {
+    Timer processTimer;
     //Local tof limits
     double my_shortest_tof = static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
     double my_longest_tof = 0.;
@@ -379,6 +478,7 @@ public:
       if (my_longest_tof > alg->longest_tof ) { alg->longest_tof  = my_longest_tof;}
       alg->bad_tofs += badTofs;
       alg->discarded_events += my_discarded_events;
+      alg->m_processSeconds += processTimer.elapsed_no_reset();
     }
 
 
@@ -405,22 +505,24 @@ private:
   Progress * prog;
   /// ThreadScheduler running this task
   ThreadScheduler * scheduler;
+  /// Holds the arrays below; released to its pool when the task is deleted
+  boost::shared_ptr<BankEventBuffer> buffer;
   /// event pixel ID array
-  boost::shared_array<uint32_t> event_id;
+  const uint32_t * event_id;
   /// event TOF array
-  boost::shared_array<float> event_time_of_flight;
+  const float * event_time_of_flight;
   /// # of events in arrays
   size_t numEvents;
   /// index of the first event from event_index
   size_t startAt;
   /// vector of event index (length of # of pulses)
-  boost::shared_ptr<std::vector<uint64_t> > event_index;
+  const std::vector<uint64_t> * event_index;
   /// Pulse times for this bank
   BankPulseTimes * thisBankPulseTimes;
   /// Flag for simulated data
   bool have_weight;
   /// event weights array
-  boost::shared_array<float> event_weight;
+  const float * event_weight;
   /// Minimum pixel id
   detid_t m_min_id;
   /// Maximum pixel id
@@ -434,8 +536,8 @@ private:
 
 //===============================================================================================
 //===============================================================================================
-/** This task does the disk IO from loading the NXS file,
- * and so will be on a disk IO mutex */
+/** This task does the disk IO from loading the NXS file. The tasks are
+ * all run in turn by the BankReadAhead thread, so no mutex is needed. */
 class LoadBankFromDiskTask : public Task
 {
 
@@ -449,20 +551,19 @@ public:
    * @param numEvents :: The number of events in the bank.
    * @param oldNeXusFileNames :: Identify if file is of old variety.
    * @param prog :: an optional Progress object
-   * @param ioMutex :: a mutex shared for all Disk I-O tasks
-   * @param scheduler :: the ThreadScheduler that runs this task.
+   * @param buffers :: pool of buffers to read the data into
+   * @param scheduler :: the ThreadScheduler that runs the ProcessBankData tasks.
    */
   LoadBankFromDiskTask(LoadEventNexus * alg, const std::string& entry_name, const std::string & entry_type,
                        const std::size_t numEvents, const bool oldNeXusFileNames,
-                       Progress * prog, boost::shared_ptr<Mutex> ioMutex, ThreadScheduler * scheduler)
+                       Progress * prog, BankEventBufferPool & buffers, ThreadScheduler * scheduler)
   : Task(),
     alg(alg), entry_name(entry_name), entry_type(entry_type),
     pixelID_to_wi_vector(alg->pixelID_to_wi_vector), pixelID_to_wi_offset(alg->pixelID_to_wi_offset),
     prog(prog), scheduler(scheduler), thisBankPulseTimes(NULL), m_loadError(false),
-    m_oldNexusFileNames(oldNeXusFileNames), m_loadStart(), m_loadSize(), m_event_id(NULL),
-    m_event_time_of_flight(NULL), m_have_weight(false), m_event_weight(NULL)
+    m_oldNexusFileNames(oldNeXusFileNames), m_loadStart(), m_loadSize(), m_buffers(buffers),
+    m_have_weight(false)
   {
-    setMutex(ioMutex);
     m_cost = static_cast<double>(numEvents);
     m_min_id = std::numeric_limits<uint32_t>::max();
     m_max_id = 0;
@@ -622,8 +723,9 @@ public:
     ::NeXus::Info id_info = file.getInfo();
     int64_t dim0 = recalculateDataSize(id_info.dims[0]);
 
-    // Now we allocate the required arrays
-    m_event_id = new uint32_t[m_loadSize[0]];
+    // Now we size the required array
+    std::vector<uint32_t> & event_id = m_buffer->eventId;
+    event_id.resize(m_loadSize[0]);
 
     // Check that the required space is there in the file.
     if (dim0 < m_loadSize[0]+m_loadStart[0])
@@ -639,7 +741,7 @@ public:
     {
       //Must be uint32
       if (id_info.type == ::NeXus::UINT32)
-        file.getSlab(m_event_id, m_loadStart, m_loadSize);
+        file.getSlab(&event_id[0], m_loadStart, m_loadSize);
       else
       {
         alg->getLogger().warning() << "Entry " << entry_name << "'s event_id field is not UINT32! It will be skipped.\n";
@@ -651,7 +753,7 @@ public:
       uint32_t temp;
       for (auto i = 0; i < m_loadSize[0]; ++i)
       {
-        temp = m_event_id[i];
+        temp = event_id[i];
         if (temp < m_min_id) m_min_id = temp;
         if (temp > m_max_id) m_max_id = temp;
       }
@@ -671,10 +773,9 @@ public:
   /** Open and load the times-of-flight data */
   void loadTof(::NeXus::File & file)
   {
-    // Allocate the array
-    float* temp = new float[m_loadSize[0]];
-    delete [] m_event_time_of_flight;
-    m_event_time_of_flight = temp;
+    // Size the array
+    std::vector<float> & event_time_of_flight = m_buffer->eventTimeOfFlight;
+    event_time_of_flight.resize(m_loadSize[0]);
 
     // Get the list of event_time_of_flight's
     if (!m_oldNexusFileNames)
@@ -693,7 +794,7 @@ public:
 
     //Check that the type is what it is supposed to be
     if (tof_info.type == ::NeXus::FLOAT32)
-      file.getSlab(m_event_time_of_flight, m_loadStart, m_loadSize);
+      file.getSlab(&event_time_of_flight[0], m_loadStart, m_loadSize);
     else
     {
       alg->getLogger().warning() << "Entry " << entry_name << "'s event_time_offset field is not FLOAT32! It will be skipped.\n";
@@ -729,10 +830,9 @@ public:
     // OK, we've got them
     m_have_weight = true;
 
-    // Allocate the array
-    float* temp = new float[m_loadSize[0]];
-    delete [] m_event_weight;
-    m_event_weight = temp;
+    // Size the array
+    std::vector<float> & event_weight = m_buffer->eventWeight;
+    event_weight.resize(m_loadSize[0]);
 
     ::NeXus::Info weight_info = file.getInfo();
     int64_t weight_dim0 = recalculateDataSize(weight_info.dims[0]);
@@ -744,7 +844,7 @@ public:
 
     // Check that the type is what it is supposed to be
     if (weight_info.type == ::NeXus::FLOAT32)
-      file.getSlab(m_event_weight, m_loadStart, m_loadSize);
+      file.getSlab(&event_weight[0], m_loadStart, m_loadSize);
     else
     {
       alg->getLogger().warning() << "Entry " << entry_name << "'s event_weight field is not FLOAT32! It will be skipped.\n";
@@ -760,19 +860,16 @@ public:
   //---------------------------------------------------------------------------------------------------
   void run()
   {
-    //The vectors we will be filling
-    std::vector<uint64_t> * event_index_ptr = new std::vector<uint64_t>();
-    std::vector<uint64_t> & event_index = *event_index_ptr;
+    // Wait for a free buffer to fill. This is what stops the reading from
+    // getting too far ahead of the processing.
+    m_buffer = m_buffers.acquire();
+    std::vector<uint64_t> & event_index = m_buffer->eventIndex;
+    event_index.clear();
 
     // These give the limits in each file as to which events we actually load (when filtering by time).
     m_loadStart.resize(1, 0);
     m_loadSize.resize(1, 0);
 
-    // Data arrays
-    m_event_id = NULL;
-    m_event_time_of_flight = NULL;
-    m_event_weight = NULL;
-
     m_loadError = false;
     m_have_weight = alg->m_haveWeights;
 
@@ -853,13 +950,7 @@ public:
     if (m_loadError)
     {
       prog->reportIncrement(4, entry_name + ": skipping");
-      delete [] m_event_id;
-      delete [] m_event_time_of_flight;
-      if (m_have_weight)
-      {
-        delete [] m_event_weight;
-      }
-      delete event_index_ptr;
+      m_buffer.reset();
       return;
     }
 
@@ -867,30 +958,31 @@ public:
     size_t numEvents = m_loadSize[0];
     size_t startAt = m_loadStart[0];
 
-    // convert things to shared_arrays
-    boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-    boost::shared_array<float> event_time_of_flight_shrd(m_event_time_of_flight);
-    boost::shared_array<float> event_weight_shrd(m_event_weight);
-    boost::shared_ptr<std::vector<uint64_t> > event_index_shrd(event_index_ptr);
+    alg->m_bytesRead += numEvents * (sizeof(uint32_t) + sizeof(float) + (m_have_weight ? sizeof(float) : 0))
+                        + event_index.size() * sizeof(uint64_t);
+    // Counted here rather than in ProcessBankData, which may split the bank in two tasks
+    alg->m_eventsProcessed += numEvents;
 
     // schedule the job to generate the event lists
     auto mid_id = m_max_id;
     if (alg->splitProcessing)
       mid_id = (m_max_id + m_min_id) / 2;
 
-    ProcessBankData * newTask1 = new ProcessBankData(alg, entry_name, prog,scheduler,
-        event_id_shrd, event_time_of_flight_shrd, numEvents, startAt, event_index_shrd,
-        thisBankPulseTimes, m_have_weight, event_weight_shrd,
+    ProcessBankData * newTask1 = new ProcessBankData(alg, entry_name, prog, scheduler,
+        m_buffer, numEvents, startAt,
+        thisBankPulseTimes, m_have_weight,
         m_min_id, mid_id);
     scheduler->push(newTask1);
     if (alg->splitProcessing)
     {
-      ProcessBankData * newTask2 = new ProcessBankData(alg, entry_name, prog,scheduler,
-                                           event_id_shrd, event_time_of_flight_shrd, numEvents, startAt, event_index_shrd,
-                                           thisBankPulseTimes, m_have_weight, event_weight_shrd,
+      ProcessBankData * newTask2 = new ProcessBankData(alg, entry_name, prog, scheduler,
+                                           m_buffer, numEvents, startAt,
+                                           thisBankPulseTimes, m_have_weight,
                                            (mid_id+1), m_max_id);
       scheduler->push(newTask2);
     }
+    // The processing tasks hold the buffer now
+    m_buffer.reset();
   }
 
   //---------------------------------------------------------------------------------------------------
@@ -934,18 +1026,114 @@ private:
   std::vector<int> m_loadStart;
   /// How much to load in the file
   std::vector<int> m_loadSize;
-  /// Event pixel ID data
-  uint32_t * m_event_id;
+  /// Pool of buffers to load into
+  BankEventBufferPool & m_buffers;
+  /// Buffer holding the event pixel IDs, TOFs, weights and event index
+  boost::shared_ptr<BankEventBuffer> m_buffer;
   /// Minimum pixel ID in this data
   uint32_t m_min_id;
   /// Maximum pixel ID in this data
   uint32_t m_max_id;
-  /// TOF data
-  float * m_event_time_of_flight;
   /// Flag for simulated data
   bool m_have_weight;
-  /// Event weights
-  float * m_event_weight;
+};
+
+
+//===============================================================================================
+//===============================================================================================
+/** The reading stage of the loading. Runs in its own thread, reading the banks
+ * one after the other with LoadBankFromDiskTask while the thread pool processes
+ * the banks already read. HDF5 reads are serial anyway, so one thread does them
+ * all, largest bank first.
+ */
+class BankReadAhead : public Poco::Runnable
+{
+public:
+  /** Constructor
+   * @param alg :: Handle to the main algorithm
+   * @param scheduler :: the ThreadScheduler of the processing tasks
+   */
+  BankReadAhead(LoadEventNexus * alg, ThreadScheduler * scheduler)
+  : m_alg(alg), m_scheduler(scheduler), m_seconds(0.)
+  {}
+
+  /// Destructor. Deletes the tasks that did not run.
+  ~BankReadAhead()
+  {
+    for (size_t i=0; i < m_tasks.size(); i++)
+      delete m_tasks[i];
+  }
+
+  /** Add a bank to read
+   * @param task :: the task reading it. Will be deleted by this object. */
+  void addTask(LoadBankFromDiskTask * task)
+  {
+    m_tasks.push_back(task);
+  }
+
+  /** Read all the banks.
+   * This runs in its own thread, so nothing may be thrown from here: an error
+   * aborts the processing tasks and is kept to be rethrown by the algorithm.
+   */
+  void run()
+  {
+    Timer timer;
+    try
+    {
+      std::stable_sort(m_tasks.begin(), m_tasks.end(), compareCost);
+      for (size_t i=0; i < m_tasks.size(); i++)
+      {
+        // Stop reading if the algorithm was cancelled or a processing task failed
+        if (m_alg->getCancel() || m_scheduler->getAborted())
+          break;
+        m_tasks[i]->run();
+        delete m_tasks[i];
+        m_tasks[i] = NULL;
+      }
+    }
+    catch (std::exception & e)
+    {
+      m_error = e.what();
+    }
+    catch (...)
+    {
+      m_error = "Unknown error while reading the banks";
+    }
+    if (failed())
+      m_scheduler->abort(std::runtime_error(m_error));
+    m_seconds = timer.elapsed();
+  }
+
+  /// @return the time taken to read all the banks
+  double seconds() const { return m_seconds; }
+
+  /// @return true if reading the banks threw
+  bool failed() const { return !m_error.empty(); }
+
+  /// Rethrow the error that stopped the reading, if any
+  void rethrowError() const
+  {
+    if (failed())
+      throw std::runtime_error(m_error);
+  }
+
+private:
+  /// Largest cost first
+  static bool compareCost(LoadBankFromDiskTask * lhs, LoadBankFromDiskTask * rhs)
+  {
+    return lhs->cost() > rhs->cost();
+  }
+
+  /// Algorithm being run
+  LoadEventNexus * m_alg;
+  /// Scheduler of the processing tasks
+  ThreadScheduler * m_scheduler;
+  /// The banks to read
+  std::vector<LoadBankFromDiskTask *> m_tasks;
+  /// Time taken to read
+  double m_seconds;
+  /// Message of the error that stopped the reading. Empty if none.
+  std::string m_error;
 };
 
 
@@ -1600,10 +1788,9 @@ void LoadEventNexus::loadEvents(API::Progress * const prog, const bool monitors)
   shortest_tof = static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   longest_tof = 0.;
 
-  // Make the thread pool
-  ThreadScheduler * scheduler = new ThreadSchedulerMutexes();
+  // Make the thread pool that processes the banks
+  ThreadScheduler * scheduler = new ThreadSchedulerWorkStealing();
   ThreadPool pool(scheduler);
-  auto diskIOMutex = boost::make_shared<Mutex>();
   size_t bank0 = 0;
   size_t bankn = bankNames.size();
 
@@ -1668,18 +1855,50 @@ void LoadEventNexus::loadEvents(API::Progress * const prog, const bool monitors)
   if (splitProcessing) numProg += bankNames.size() * 3; // 3 = second proc task
   Progress * prog2 = new Progress(this,0.3,1.0, numProg);
 
+  // The banks are loaded in a pipeline: one thread reads them into a bounded
+  // set of buffers, while the thread pool processes the banks already read.
+  // One buffer more than the number of threads keeps all of them busy.
+  BankEventBufferPool buffers(ThreadPool::getNumPhysicalCores() + 1);
+  BankReadAhead reader(this, scheduler);
   for (size_t i=bank0; i < bankn; i++)
   {
     // We make tasks for loading
     if (bankNumEvents[i] > 0)
-      pool.schedule( new LoadBankFromDiskTask(this, bankNames[i], classType, bankNumEvents[i], oldNeXusFileNames,
-                                              prog2, diskIOMutex, scheduler) );
-  }
-  // Start and end all threads
+      reader.addTask( new LoadBankFromDiskTask(this, bankNames[i], classType, bankNumEvents[i], oldNeXusFileNames,
+                                               prog2, buffers, scheduler) );
+  }
+  m_bytesRead = 0;
+  m_eventsProcessed = 0;
+  m_processSeconds = 0.;
+  Timer loadTimer;
+
+  // The processing threads wait for tasks until joinAll() is called
+  pool.start(std::numeric_limits<double>::max(), true);
+  Poco::Thread readerThread("LoadEventNexusReader");
+  readerThread.start(reader);
+  readerThread.join();
+  if (reader.failed())
+  {
+    // The reader aborted the processing tasks: let the threads exit, then report its own error
+    try { pool.joinAll(); }
+    catch (std::runtime_error &) {}
+    delete prog2;
+    reader.rethrowError();
+  }
+  // All banks read: finish processing them
   pool.joinAll();
-  diskIOMutex.reset();
   delete prog2;
 
+  // Throughput of each stage, for tuning
+  const double loadSeconds = loadTimer.elapsed();
+  const double megabytes = static_cast<double>(m_bytesRead) / (1024. * 1024.);
+  g_log.information() << "Read " << megabytes << " MB in " << reader.seconds() << " sec ("
+      << megabytes / std::max(reader.seconds(), 1e-6) << " MB/sec), of which "
+      << buffers.waitSeconds() << " sec waiting for a free buffer." << std::endl;
+  g_log.information() << "Processed " << m_eventsProcessed << " events in " << m_processSeconds
+      << " thread-sec (" << static_cast<double>(m_eventsProcessed) / std::max(m_processSeconds, 1e-6)
+      << " events/sec/thread); " << loadSeconds << " sec in total." << std::endl;
+
 
   //Info reporting
   const std::size_t eventsLoaded = WS->getNumberEvents();
@@ -194,16 +194,14 @@ void MaskDetectors::exec()
   {
     for (it = detectorList.begin(); it != detectorList.end(); ++it)
     {
-      try
+      // The base detector has the same component ID as the parametrized one, and is much cheaper to get
+      if ( const Geometry::IDetector * det = instrument->getBaseDetector(*it) )
       {
-        if ( const Geometry::ComponentID det = instrument->getDetector(*it)->getComponentID() )
-        {
-          pmap.addBool(det,"masked",true);
-        }
+        pmap.addBool(det->getComponentID(),"masked",true);
       }
-      catch(Kernel::Exception::NotFoundError &e)
+      else
       {
-        g_log.warning() << e.what() << " Found while running MaskDetectors" << std::endl;
+        g_log.warning() << "Instrument: Detector with ID " << *it << " not found. Found while running MaskDetectors" << std::endl;
       }
     }
   }
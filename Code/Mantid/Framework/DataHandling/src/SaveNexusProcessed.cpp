@@ -79,7 +79,8 @@ namespace DataHandling
 
 
   /// Empty default constructor
-  SaveNexusProcessed::SaveNexusProcessed() : Algorithm()
+  SaveNexusProcessed::SaveNexusProcessed() : Algorithm(),
+    m_eventChunkSize(Mantid::NeXus::NexusFileIO::DEFAULT_EVENT_CHUNK_SIZE)
   {
   }
 
@@ -357,51 +358,18 @@ namespace DataHandling
   }
 
 
-  //-------------------------------------------------------------------------------------
-  /** Append out each field of a vector of events to separate array.
-   *
-   * @param events :: vector of TofEvent or WeightedEvent, etc.
-   * @param offset :: where the first event goes in the array
-   * @param tofs, weights, errorSquareds, pulsetimes :: arrays to write to.
-   *        Must be initialized and big enough,
-   *        or NULL if they are not meant to be written to.
-   */
-  template<class T>
-  void SaveNexusProcessed::appendEventListData( std::vector<T> events, size_t offset, double * tofs, float * weights, float * errorSquareds, int64_t * pulsetimes)
-  {
-    // Do nothing if there are no events.
-    if (events.empty())
-      return;
-
-    typename std::vector<T>::const_iterator it;
-    typename std::vector<T>::const_iterator it_end = events.end();
-    size_t i = offset;
-
-    // Fill the C-arrays with the fields from all the events, as requested.
-    for (it = events.begin(); it != it_end; it++)
-    {
-      if (tofs) tofs[i] = it->tof();
-      if (weights) weights[i] = static_cast<float>(it->weight());
-      if (errorSquareds) errorSquareds[i] = static_cast<float>(it->errorSquared());
-      if (pulsetimes) pulsetimes[i] = it->pulseTime().totalNanoseconds();
-      i++;
-    }
-  }
-
-
-
   //-----------------------------------------------------------------------------------------------
   /** Execute the saving of event data.
    * This will make one long event list for all events contained.
    * */
   void SaveNexusProcessed::execEvent(Mantid::NeXus::NexusFileIO * nexusFile,const bool uniformSpectra,const std::vector<int> spec)
   {
-    prog = new Progress(this, m_timeProgInit, 1.0, m_eventWorkspace->getNumberEvents()*2);
+    prog = new Progress(this, m_timeProgInit, 1.0, m_eventWorkspace->getNumberEvents());
 
     // Start by writing out the axes and crap
     nexusFile->writeNexusProcessedData2D(m_eventWorkspace, uniformSpectra, spec, "event_workspace", false);
 
-    // Make a super long list of tofs, weights, etc.
+    // The events of all the spectra go into one long list of tofs, weights, etc.
     std::vector<int64_t> indices;
     indices.reserve( m_eventWorkspace->getNumberHistograms()+1 );
     // First we need to index the events in each spectrum
@@ -414,87 +382,11 @@ namespace DataHandling
     }
     indices.push_back(index);
 
-    // Initialize all the arrays
-    int64_t num = index;
-    double * tofs = NULL;
-    float * weights = NULL;
-    float * errorSquareds = NULL;
-    int64_t * pulsetimes = NULL;
-
-    // overall event type.
-    EventType type = m_eventWorkspace->getEventType();
-    bool writeTOF = true;
-    bool writePulsetime = false;
-    bool writeWeight = false;
-    bool writeError = false;
-
-    switch (type)
-    {
-    case TOF:
-      writePulsetime = true;
-      break;
-    case WEIGHTED:
-      writePulsetime = true;
-      writeWeight = true;
-      writeError = true;
-      break;
-    case WEIGHTED_NOTIME:
-      writeWeight = true;
-      writeError = true;
-      break;
-    }
-
-    // --- Initialize the combined event arrays ----
-    if (writeTOF)
-      tofs = new double[num];
-    if (writeWeight)
-      weights = new float[num];
-    if (writeError)
-      errorSquareds = new float[num];
-    if (writePulsetime)
-      pulsetimes = new int64_t[num];
-
-    // --- Fill in the combined event arrays ----
-    PARALLEL_FOR_NO_WSP_CHECK()
-    for (int wi=0; wi < static_cast<int>(m_eventWorkspace->getNumberHistograms()); wi++)
-    {
-      PARALLEL_START_INTERUPT_REGION
-      const DataObjects::EventList & el = m_eventWorkspace->getEventList(wi);
-
-      // This is where it will land in the output array.
-      // It is okay to write in parallel since none should step on each other.
-      size_t offset = indices[wi];
-
-      switch (el.getEventType())
-      {
-      case TOF:
-        appendEventListData( el.getEvents(), offset, tofs, weights, errorSquareds, pulsetimes);
-        break;
-      case WEIGHTED:
-        appendEventListData( el.getWeightedEvents(), offset, tofs, weights, errorSquareds, pulsetimes);
-        break;
-      case WEIGHTED_NOTIME:
-        appendEventListData( el.getWeightedEventsNoTime(), offset, tofs, weights, errorSquareds, pulsetimes);
-        break;
-      }
-      prog->reportIncrement(el.getNumberEvents(), "Copying EventList");
-
-      PARALLEL_END_INTERUPT_REGION
-    }
-    PARALLEL_CHECK_INTERUPT_REGION
-
     /*Default = DONT compress - much faster*/
     bool CompressNexus = getProperty("CompressNexus");
 
-    // Write out to the NXS file.
-    nexusFile->writeNexusProcessedDataEventCombined(m_eventWorkspace, indices, tofs, weights, errorSquareds, pulsetimes,
-        CompressNexus);
-
-    // Free mem.
-    delete [] tofs;
-    delete [] weights;
-    delete [] errorSquareds;
-    delete [] pulsetimes;
+    // Write out to the NXS file. The events are copied and written a chunk at a time.
+    nexusFile->writeNexusProcessedDataEventCombined(m_eventWorkspace, indices, CompressNexus, prog, m_eventChunkSize);
   }
 
   //-----------------------------------------------------------------------------------------------
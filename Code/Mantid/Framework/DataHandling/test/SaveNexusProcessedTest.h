@@ -15,6 +15,7 @@
 #include "MantidDataHandling/SaveNexusProcessed.h"
 #include "MantidDataHandling/LoadMuonNexus.h"
 #include "MantidDataHandling/LoadNexus.h"
+#include "MantidDataHandling/LoadNexusProcessed.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidDataHandling/LoadRaw3.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
@@ -33,6 +34,16 @@ using namespace Mantid::DataHandling;
 using namespace Mantid::DataObjects;
 using namespace Mantid::NeXus;
 
+/// Saves the events a few at a time, so that the chunks split the event lists
+class SaveNexusProcessedSmallChunks : public SaveNexusProcessed
+{
+public:
+  SaveNexusProcessedSmallChunks(size_t chunkSize) : SaveNexusProcessed()
+  {
+    m_eventChunkSize = chunkSize;
+  }
+};
+
 class SaveNexusProcessedTest : public CxxTest::TestSuite
 {
 public:
@@ -343,6 +354,73 @@ public:
     do_testExec_EventWorkspaces("SaveNexusProcessed_EventTo2D", TOF, outputFile, false, clearfiles, true /* DONT preserve events */, true /* Compress */);
   }
 
+  void testExec_EventWorkspace_SmallChunks()
+  {
+    std::vector< std::vector<int> > groups(5);
+    groups[0].push_back(10);
+    groups[0].push_back(11);
+    groups[0].push_back(12);
+    groups[1].push_back(20);
+    groups[2].push_back(30);
+    groups[2].push_back(31);
+    groups[3].push_back(40);
+    groups[4].push_back(50);
+
+    EventWorkspace_sptr WS = WorkspaceCreationHelper::CreateGroupedEventWorkspace(groups, 100, 1.0);
+    WS->getEventList(3).clear(false);
+    for (size_t wi=0; wi < WS->getNumberHistograms(); wi++)
+    {
+      EventList & el = WS->getEventList(wi);
+      el.switchTo(WEIGHTED);
+      // Give every event its own weight so that an event written to the wrong place shows up
+      std::vector<WeightedEvent> & events = el.getWeightedEvents();
+      for (size_t i=0; i < events.size(); i++)
+        events[i] = WeightedEvent(events[i].tof(), events[i].pulseTime(), double(wi) + 0.001 * double(i), 1.0 + double(i));
+    }
+
+    // 7 does not divide the length of any of the lists, so the slabs start and end in the middle of them
+    SaveNexusProcessedSmallChunks alg(7);
+    alg.initialize();
+    alg.setProperty("InputWorkspace", boost::dynamic_pointer_cast<Workspace>(WS));
+    alg.setPropertyValue("Filename", "SaveNexusProcessed_SmallChunks.nxs");
+    std::string outputFile = alg.getPropertyValue("Filename");
+    if( Poco::File(outputFile).exists() ) Poco::File(outputFile).remove();
+    TS_ASSERT_THROWS_NOTHING( alg.execute() );
+    TS_ASSERT( alg.isExecuted() );
+
+    LoadNexusProcessed load;
+    load.initialize();
+    load.setPropertyValue("Filename", outputFile);
+    load.setPropertyValue("OutputWorkspace", "SaveNexusProcessed_SmallChunks");
+    TS_ASSERT_THROWS_NOTHING( load.execute() );
+    TS_ASSERT( load.isExecuted() );
+
+    EventWorkspace_sptr loaded = boost::dynamic_pointer_cast<EventWorkspace>(
+        AnalysisDataService::Instance().retrieve("SaveNexusProcessed_SmallChunks") );
+    TS_ASSERT( loaded );
+    if (loaded)
+    {
+      TS_ASSERT_EQUALS( loaded->getNumberHistograms(), WS->getNumberHistograms() );
+      for (size_t wi=0; wi < WS->getNumberHistograms(); wi++)
+      {
+        const std::vector<WeightedEvent> & expected = WS->getEventList(wi).getWeightedEvents();
+        const std::vector<WeightedEvent> & actual = loaded->getEventList(wi).getWeightedEvents();
+        TS_ASSERT_EQUALS( actual.size(), expected.size() );
+        if (actual.size() != expected.size()) continue;
+        for (size_t i=0; i < expected.size(); i++)
+        {
+          TS_ASSERT_DELTA( actual[i].tof(), expected[i].tof(), 1e-9 );
+          TS_ASSERT_EQUALS( actual[i].pulseTime().totalNanoseconds(), expected[i].pulseTime().totalNanoseconds() );
+          TS_ASSERT_DELTA( actual[i].weight(), expected[i].weight(), 1e-5 );
+          TS_ASSERT_DELTA( actual[i].errorSquared(), expected[i].errorSquared(), 1e-5 );
+        }
+      }
+    }
+
+    AnalysisDataService::Instance().remove("SaveNexusProcessed_SmallChunks");
+    if(clearfiles) Poco::File(outputFile).remove();
+  }
+
   void testExecSaveLabel()
   {
     SaveNexusProcessed alg;
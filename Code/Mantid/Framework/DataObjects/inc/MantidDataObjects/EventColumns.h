@@ -0,0 +1,119 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+
+#include "MantidAPI/IEventList.h"
+#include "MantidAPI/MatrixWorkspace.h" // get MantidVec declaration
+#include "MantidDataObjects/Events.h"
+#include "MantidKernel/BinIndexer.h"
+#include "MantidKernel/System.h"
+#include <vector>
+
+namespace Mantid
+{
+namespace DataObjects
+{
+
+  /** EventColumns : structure-of-arrays storage for the events of an EventList.
+
+    Instead of one vector of TofEvent/WeightedEvent/WeightedEventNoTime structs,
+    the tof, pulse time, weight and squared error of the events are held in
+    separate contiguous arrays. Operations that only need the TOF (histogramming,
+    TOF conversion, masking, sorting by TOF) therefore only stream the tof column
+    through the cache, and the simple loops can be vectorised by the compiler.
+
+    Which columns are filled depends on the EventType being represented:
+      - TOF: tof and pulse time (weights are implicitly 1.0)
+      - WEIGHTED: all four columns
+      - WEIGHTED_NOTIME: tof, weight and squared error
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+  */
+  class DLLExport EventColumns
+  {
+  public:
+    EventColumns();
+    ~EventColumns();
+
+    void assign(const std::vector<TofEvent> & events);
+    void assign(const std::vector<WeightedEvent> & events);
+    void assign(const std::vector<WeightedEventNoTime> & events);
+
+    void extract(std::vector<TofEvent> & events) const;
+    void extract(std::vector<WeightedEvent> & events) const;
+    void extract(std::vector<WeightedEventNoTime> & events) const;
+
+    /// The type of event held in the columns
+    Mantid::API::EventType getEventType() const { return m_eventType; }
+    /// Number of events held
+    size_t size() const { return m_tofs.size(); }
+    /// Are there no events?
+    bool empty() const { return m_tofs.empty(); }
+
+    void clear();
+    void reserve(size_t num);
+    size_t getMemorySize() const;
+
+    /// Read-only access to the tof column
+    const std::vector<double> & tofs() const { return m_tofs; }
+    /// Read-only access to the pulse time column, in nanoseconds. Empty for WEIGHTED_NOTIME.
+    const std::vector<int64_t> & pulseTimes() const { return m_pulseTimes; }
+    /// Read-only access to the weight column. Empty for TOF.
+    const std::vector<float> & weights() const { return m_weights; }
+    /// Read-only access to the squared-error column. Empty for TOF.
+    const std::vector<float> & errorSquareds() const { return m_errorSquareds; }
+
+    void setTofs(const std::vector<double> & tofs);
+
+    void sortTof();
+    void reverse();
+    void convertTof(const double factor, const double offset);
+    size_t maskTof(const double tofMin, const double tofMax);
+
+    void histogram(const MantidVec & X, MantidVec & Y, MantidVec & E, bool skipError) const;
+    void histogram(const Kernel::BinIndexer & indexer, MantidVec & Y, MantidVec & E, bool skipError) const;
+    void integrate(const double minX, const double maxX, const bool entireRange, double & sum, double & error) const;
+
+    double getTofMin(const bool sorted) const;
+    double getTofMax(const bool sorted) const;
+
+  private:
+    template<class T>
+    void permute(std::vector<T> & column, const std::vector<size_t> & order) const;
+
+    void histogramCounts(const MantidVec & X, MantidVec & Y) const;
+    void histogramWeights(const MantidVec & X, MantidVec & Y, MantidVec & E) const;
+
+    /// Type of the events that are represented
+    Mantid::API::EventType m_eventType;
+    /// Time-of-flight (or other X unit) of each event
+    std::vector<double> m_tofs;
+    /// Pulse time of each event, as nanoseconds since the DateAndTime epoch
+    std::vector<int64_t> m_pulseTimes;
+    /// Weight of each event
+    std::vector<float> m_weights;
+    /// Squared error of each event
+    std::vector<float> m_errorSquareds;
+  };
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif  /* MANTID_DATAOBJECTS_EVENTCOLUMNS_H_ */
@@ -7,8 +7,10 @@
 #include "MantidAPI/IEventList.h"
 #include "MantidAPI/IEventWorkspace.h" // get EventType declaration
 #include "MantidAPI/MatrixWorkspace.h" // get MantidVec declaration
+#include "MantidDataObjects/EventColumns.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/BinIndexer.h"
 #include "MantidKernel/cow_ptr.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/System.h"
@@ -98,6 +100,8 @@ public:
 
   EventList& operator+=(const EventList& more_events);
 
+  void takeEvents(EventList& more_events);
+
   EventList& operator-=(const EventList& more_events);
 
   bool operator==(const EventList& rhs) const;
@@ -113,6 +117,7 @@ public:
    * */
   inline void addEventQuickly(const TofEvent &event)
   {
+    if (m_columnar) this->switchToRows();
     this->events.push_back(event);
     this->order = UNSORTED;
   }
@@ -123,6 +128,7 @@ public:
    * */
   inline void addEventQuickly(const WeightedEvent &event)
   {
+    if (m_columnar) this->switchToRows();
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
@@ -133,6 +139,7 @@ public:
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event)
   {
+    if (m_columnar) this->switchToRows();
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
@@ -141,6 +148,9 @@ public:
 
   void switchTo(Mantid::API::EventType newType);
 
+  void setColumnarStorage(const bool columnar);
+  bool isColumnarStorage() const;
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<TofEvent>& getEvents();
@@ -287,6 +297,11 @@ public:
   /// Split events by pulse time
   void splitByPulseTime(Kernel::TimeSplitterType & splitter, std::map<int, EventList * > outputs) const;
 
+  void splitByFullTime(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs,
+                       double tofcorrection, bool docorrection) const;
+
+  void splitByPulseTime(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs) const;
+
   void multiply(const double value, const double error = 0.0);
   EventList& operator*=(const double value);
 
@@ -325,6 +340,12 @@ private:
   /// Lock out deletion of items in the MRU
   mutable bool m_lockedMRU;
 
+  /// Events held as separate tof/pulsetime/weight/error arrays, when m_columnar is set.
+  mutable EventColumns m_columns;
+
+  /// True when the events live in m_columns rather than in the vectors of structs.
+  mutable bool m_columnar;
+
   template<class T>
   static typename std::vector<T>::const_iterator findFirstEvent(const std::vector<T> & events, const double seek_tof);
 
@@ -342,8 +363,11 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  void switchToRows() const;
 
   // helper functions are all internal to simplify the code
+  template<class T>
+  static void spliceEvents(std::vector<T> & events, std::vector<T> & more_events, const bool sorted);
   template<class T1, class T2>
   static void minusHelper(std::vector<T1> & events, const std::vector<T2> & more_events);
   template<class T>
@@ -353,6 +377,8 @@ private:
   template<class T>
   static void histogramForWeightsHelper(const std::vector<T> & events, const MantidVec & X, MantidVec & Y, MantidVec & E);
   template<class T>
+  static void histogramDirectHelper(const std::vector<T> & events, const Kernel::BinIndexer & indexer, MantidVec & Y, MantidVec & E, const bool withErrors);
+  template<class T>
   static void integrateHelper(std::vector<T> & events, const double minX, const double maxX, const bool entireRange, double & sum, double & error);
   template<class T>
   static double integrateHelper(std::vector<T> & events, const double minX, const double maxX, const bool entireRange);
@@ -385,6 +411,11 @@ private:
   template< class T >
   void splitByPulseTimeHelper(Kernel::TimeSplitterType & splitter, std::map<int, EventList * > outputs,
                               typename std::vector<T> & events) const;
+  void splitByIndex(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs,
+                    const bool pulseTimeOnly, const double tofFactor) const;
+  template< class T >
+  void splitByIndexHelper(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs,
+                          const std::vector<T> & events, const bool pulseTimeOnly, const double tofFactor) const;
   template< class T>
   static void multiplyHelper(std::vector<T> & events, const double value, const double error = 0.0);
   template<class T>
@@ -161,11 +161,16 @@ class DLLExport EventWorkspace : public API::IEventWorkspace
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Change how the events of every list are stored
+  void setColumnarStorage(const bool columnar);
+
   // Returns true always - an EventWorkspace always represents histogramm-able data
   virtual bool isHistogramData() const;
 
   std::size_t MRUSize() const;
 
+  EventWorkspaceMRU * getMRU() const;
+
   void clearMRU() const;
 
   void clearData();
@@ -32,9 +32,10 @@ namespace DataObjects
      * @param the_index :: unique index into the workspace of this data
      * @param locked :: reference to a bool that will be set to true if
      *        the marker should NOT be deleted
+     * @param x :: the X vector the data was histogrammed with
      */
-    MantidVecWithMarker(const size_t the_index, bool & locked)
-    : m_index(the_index), m_locked(locked)
+    MantidVecWithMarker(const size_t the_index, bool & locked, const MantidVec * x = NULL)
+    : m_index(the_index), m_x(x), m_locked(locked)
     {
     }
 
@@ -60,6 +61,9 @@ namespace DataObjects
     /// Pointer to a vector of data
     MantidVec m_data;
 
+    /// Identity of the X vector the data was histogrammed with
+    const MantidVec * m_x;
+
     /// Function returns a unique index, used for hashing for MRU list
     size_t hashIndexFunction() const
     {
@@ -81,6 +85,20 @@ namespace DataObjects
   //============================================================================
   /** This is a container for the MRU (most-recently-used) list
    * of generated histograms.
+   *
+   * Each thread has its own MRU lists of Y and E, each with its own lock,
+   * so that threads histogramming spectra at the same time do not wait for
+   * each other. An entry is only found if it was histogrammed with the same
+   * X vector.
+   *
+   * readY() hands out references into the cached data, which stay valid
+   * until the same thread has generated as many other histograms as its
+   * lists hold: the lists are not shared between threads, so that the
+   * histograms of one thread are never dropped by another.
+   *
+   * The number of hits and misses of find() are counted to help choosing
+   * the size of the lists, set by the EventWorkspace.HistogramCacheSize
+   * configuration key.
 
     Copyright &copy; 2011-2 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
 
@@ -107,47 +125,61 @@ namespace DataObjects
   public:
     // Typedef for a Most-Recently-Used list of Data objects.
     typedef Mantid::Kernel::MRUList<MantidVecWithMarker> mru_list;
-    // Typedef for a vector of MRUlists.
-    typedef std::vector< mru_list * > mru_lists;
 
-    EventWorkspaceMRU();
+    EventWorkspaceMRU(size_t capacity = 0);
     ~EventWorkspaceMRU();
 
-    void ensureEnoughBuffersY(size_t thread_num) const;
-    void ensureEnoughBuffersE(size_t thread_num) const;
-
     void clear();
 
-    MantidVecWithMarker * findY(size_t thread_num, size_t index);
-    MantidVecWithMarker * findE(size_t thread_num, size_t index);
-    void insertY(size_t thread_num, MantidVecWithMarker * data);
-    void insertE(size_t thread_num, MantidVecWithMarker * data);
+    MantidVecWithMarker * findY(size_t index, const MantidVec * x);
+    MantidVecWithMarker * findE(size_t index, const MantidVec * x);
+    MantidVecWithMarker * insertY(MantidVecWithMarker * data);
+    MantidVecWithMarker * insertE(MantidVecWithMarker * data);
 
     void deleteIndex(size_t index);
 
-    /** Return how many entries in the Y MRU list are used.
-     * Only used in tests. It only returns the 0-th MRU list size.
-     * @return :: number of entries in the MRU list. */
-    size_t MRUSize() const
-    { return this->m_bufferedDataY[0]->size(); }
-
-  protected:
-    /// The most-recently-used list of dataY histograms
-    mutable mru_lists m_bufferedDataY;
+    size_t MRUSize() const;
+    size_t capacity() const;
+    /// Number of threads with their own MRU lists
+    size_t numThreadCaches() const { return m_caches.size(); }
 
-    /// The most-recently-used list of dataE histograms
-    mutable mru_lists m_bufferedDataE;
+    size_t hits() const;
+    size_t misses() const;
+    void resetCounters();
 
-    /// These markers will be deleted when they are NOT locked
-    mutable std::vector<MantidVecWithMarker *> m_markersToDelete;
-
-    /// Mutex around accessing m_markersToDelete
-    Mutex m_toDeleteMutex;
-
-    /// Mutex when adding entries in the MRU list
-    mutable Mutex m_changeMruListsMutexE;
-    mutable Mutex m_changeMruListsMutexY;
+  private:
+    /// Unimplemented, private copy constructor
+    EventWorkspaceMRU(const EventWorkspaceMRU &other);
+    /// Unimplemented, private assignment operator
+    EventWorkspaceMRU& operator=(const EventWorkspaceMRU &other);
 
+    /// The cached histograms of one thread
+    struct ThreadCache
+    {
+      ThreadCache(size_t capacity);
+      /// Protects everything in the cache
+      mutable Mutex mutex;
+      /// The most-recently-used list of dataY histograms
+      mru_list bufferedDataY;
+      /// The most-recently-used list of dataE histograms
+      mru_list bufferedDataE;
+      /// Markers dropped out of the lists whose EventList was locked; deleted by clear()
+      std::vector<MantidVecWithMarker *> locked;
+      /// Number of successful find()s
+      size_t hits;
+      /// Number of unsuccessful find()s
+      size_t misses;
+    };
+
+    ThreadCache & cacheOfThisThread() const;
+    MantidVecWithMarker * find(ThreadCache & cache, mru_list & list, size_t index, const MantidVec * x);
+    MantidVecWithMarker * insert(ThreadCache & cache, mru_list & list, MantidVecWithMarker * data);
+    void drop(ThreadCache & cache, MantidVecWithMarker * data);
+
+    /// The caches, one per thread. The thread number modulo their number picks the cache.
+    std::vector<ThreadCache *> m_caches;
+    /// Number of Y (and of E) histograms each thread can hold
+    size_t m_capacity;
   };
 
 
@@ -62,6 +62,9 @@ public:
 
   void releaseData();
 
+  void readFromMemory(const double * source);
+  void writeToMemory(double * destination);
+
   size_t getNumSpectra() const
   { return m_data.size(); }
 
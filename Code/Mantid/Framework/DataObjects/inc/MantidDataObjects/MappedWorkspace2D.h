@@ -0,0 +1,95 @@
+#ifndef MANTID_DATAOBJECTS_MAPPEDWORKSPACE2D_H_
+#define MANTID_DATAOBJECTS_MAPPEDWORKSPACE2D_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidDataObjects/AbsManagedWorkspace2D.h"
+
+namespace Poco
+{
+  class SharedMemory;
+}
+
+namespace Mantid
+{
+namespace DataObjects
+{
+/** MappedWorkspace2D : a managed workspace whose data is kept in a temporary
+    file that is mapped into memory.
+
+    The file is created at its full size but sparse, so nothing is written
+    until a block is dropped from the MRU list, and unwritten spectra read
+    back as zeroes. Blocks are copied to and from the mapping with no seeking
+    or stream calls; keeping the pages in memory, reading them ahead and
+    writing them out is left to the operating system. This suits machines
+    with a lot of memory, where the file mostly stays in the page cache.
+
+    It uses the same configuration properties as ManagedWorkspace2D, and is
+    chosen by the WorkspaceFactory when ManagedWorkspace.UseMemoryMapping is 1.
+    The address space must be large enough to map the whole workspace.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>.
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MappedWorkspace2D : public AbsManagedWorkspace2D
+{
+public:
+  MappedWorkspace2D();
+  virtual ~MappedWorkspace2D();
+
+  virtual const std::string id() const {return "MappedWorkspace2D";}
+
+  virtual size_t getMemorySize() const;
+  virtual bool threadSafe() const { return false; }
+
+  /// @return the full path of the mapped file
+  std::string get_filename() const { return m_filename; }
+
+protected:
+  /// Reads in a data block.
+  virtual void readDataBlock(ManagedDataBlock2D *newBlock,std::size_t startIndex)const;
+  /// Saves the dropped data block to disk.
+  virtual void writeDataBlock(ManagedDataBlock2D *toWrite) const;
+
+private:
+  // Make copy constructor and copy assignment operator private (and without definition) unless they're needed
+  /// Private copy constructor
+  MappedWorkspace2D(const MappedWorkspace2D&);
+  /// Private copy assignment operator
+  MappedWorkspace2D& operator=(const MappedWorkspace2D&);
+
+  virtual void init(const std::size_t &NVectors, const std::size_t &XLength, const std::size_t &YLength);
+  virtual std::size_t getHistogramNumberHelper() const;
+
+  double * blockAddress(std::size_t startIndex) const;
+
+  /// The name of the temporary file
+  std::string m_filename;
+  /// The mapping of the whole file
+  Poco::SharedMemory * m_mapping;
+  /// Static instance count. Used to ensure temporary filenames are distinct.
+  static int g_uniqueID;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /*MANTID_DATAOBJECTS_MAPPEDWORKSPACE2D_H_*/
@@ -0,0 +1,513 @@
+#include "MantidDataObjects/EventColumns.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+using Mantid::Kernel::DateAndTime;
+
+namespace Mantid
+{
+namespace DataObjects
+{
+  namespace
+  {
+    /** Orders indices into a tof column by the tof they point at
+     */
+    class CompareIndexByTof
+    {
+    public:
+      explicit CompareIndexByTof(const std::vector<double> & tofs) : m_tofs(tofs) {}
+      bool operator()(const size_t lhs, const size_t rhs) const
+      {
+        return m_tofs[lhs] < m_tofs[rhs];
+      }
+    private:
+      const std::vector<double> & m_tofs;
+    };
+
+    /** Fill a vector of the position in a sorted tof column of each bin boundary.
+     * Entry i is the index of the first event with tof >= X[i].
+     *
+     * @param tofs :: tof column, sorted
+     * @param X :: bin boundaries, ascending
+     * @param edges :: filled with X.size() indices
+     */
+    void findBinEdges(const std::vector<double> & tofs, const MantidVec & X, std::vector<size_t> & edges)
+    {
+      edges.resize(X.size());
+      std::vector<double>::const_iterator start = tofs.begin();
+      for (size_t i = 0; i < X.size(); ++i)
+      {
+        // The boundaries are ascending so each search can start from the previous result
+        start = std::lower_bound(start, tofs.end(), X[i]);
+        edges[i] = static_cast<size_t>(start - tofs.begin());
+      }
+    }
+
+    /** Sum a contiguous range of a float column in double precision
+     */
+    inline double sumRange(const std::vector<float> & column, const size_t begin, const size_t end)
+    {
+      double sum = 0.0;
+      const float * data = column.empty() ? NULL : &column[0];
+      for (size_t i = begin; i < end; ++i)
+        sum += double(data[i]);
+      return sum;
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Constructor. The columns represent an empty list of TofEvent's
+   */
+  EventColumns::EventColumns() : m_eventType(Mantid::API::TOF)
+  {
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Destructor
+   */
+  EventColumns::~EventColumns()
+  {
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Fill the columns from a vector of TofEvent's. Any previous content is replaced.
+   * @param events :: the events to copy
+   */
+  void EventColumns::assign(const std::vector<TofEvent> & events)
+  {
+    this->clear();
+    m_eventType = Mantid::API::TOF;
+    const size_t numEvents = events.size();
+    m_tofs.resize(numEvents);
+    m_pulseTimes.resize(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+    {
+      m_tofs[i] = events[i].tof();
+      m_pulseTimes[i] = events[i].pulseTime().totalNanoseconds();
+    }
+  }
+
+  /** Fill the columns from a vector of WeightedEvent's. Any previous content is replaced.
+   * @param events :: the events to copy
+   */
+  void EventColumns::assign(const std::vector<WeightedEvent> & events)
+  {
+    this->clear();
+    m_eventType = Mantid::API::WEIGHTED;
+    const size_t numEvents = events.size();
+    m_tofs.resize(numEvents);
+    m_pulseTimes.resize(numEvents);
+    m_weights.resize(numEvents);
+    m_errorSquareds.resize(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+    {
+      m_tofs[i] = events[i].tof();
+      m_pulseTimes[i] = events[i].pulseTime().totalNanoseconds();
+      m_weights[i] = events[i].m_weight;
+      m_errorSquareds[i] = events[i].m_errorSquared;
+    }
+  }
+
+  /** Fill the columns from a vector of WeightedEventNoTime's. Any previous content is replaced.
+   * @param events :: the events to copy
+   */
+  void EventColumns::assign(const std::vector<WeightedEventNoTime> & events)
+  {
+    this->clear();
+    m_eventType = Mantid::API::WEIGHTED_NOTIME;
+    const size_t numEvents = events.size();
+    m_tofs.resize(numEvents);
+    m_weights.resize(numEvents);
+    m_errorSquareds.resize(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+    {
+      m_tofs[i] = events[i].tof();
+      m_weights[i] = events[i].m_weight;
+      m_errorSquareds[i] = events[i].m_errorSquared;
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Rebuild a vector of TofEvent's from the columns.
+   * @param events :: vector to fill. Previous content is replaced.
+   * @throw std::runtime_error if the columns do not hold TofEvent's
+   */
+  void EventColumns::extract(std::vector<TofEvent> & events) const
+  {
+    if (m_eventType != Mantid::API::TOF)
+      throw std::runtime_error("EventColumns::extract() called for TofEvent's on columns holding weighted events.");
+    events.clear();
+    events.reserve(m_tofs.size());
+    for (size_t i = 0; i < m_tofs.size(); ++i)
+      events.push_back(TofEvent(m_tofs[i], DateAndTime(m_pulseTimes[i])));
+  }
+
+  /** Rebuild a vector of WeightedEvent's from the columns.
+   * @param events :: vector to fill. Previous content is replaced.
+   * @throw std::runtime_error if the columns do not hold WeightedEvent's
+   */
+  void EventColumns::extract(std::vector<WeightedEvent> & events) const
+  {
+    if (m_eventType != Mantid::API::WEIGHTED)
+      throw std::runtime_error("EventColumns::extract() called for WeightedEvent's on columns not holding WeightedEvent's.");
+    events.clear();
+    events.reserve(m_tofs.size());
+    for (size_t i = 0; i < m_tofs.size(); ++i)
+      events.push_back(WeightedEvent(m_tofs[i], DateAndTime(m_pulseTimes[i]), m_weights[i], m_errorSquareds[i]));
+  }
+
+  /** Rebuild a vector of WeightedEventNoTime's from the columns.
+   * @param events :: vector to fill. Previous content is replaced.
+   * @throw std::runtime_error if the columns do not hold WeightedEventNoTime's
+   */
+  void EventColumns::extract(std::vector<WeightedEventNoTime> & events) const
+  {
+    if (m_eventType != Mantid::API::WEIGHTED_NOTIME)
+      throw std::runtime_error("EventColumns::extract() called for WeightedEventNoTime's on columns not holding WeightedEventNoTime's.");
+    events.clear();
+    events.reserve(m_tofs.size());
+    for (size_t i = 0; i < m_tofs.size(); ++i)
+      events.push_back(WeightedEventNoTime(m_tofs[i], m_weights[i], m_errorSquareds[i]));
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Remove all events and release the memory of the columns. The event type is kept.
+   */
+  void EventColumns::clear()
+  {
+    std::vector<double>().swap(m_tofs);
+    std::vector<int64_t>().swap(m_pulseTimes);
+    std::vector<float>().swap(m_weights);
+    std::vector<float>().swap(m_errorSquareds);
+  }
+
+  /** Reserve space for a number of events in the columns used by the current event type.
+   * @param num :: number of events
+   */
+  void EventColumns::reserve(size_t num)
+  {
+    m_tofs.reserve(num);
+    if (m_eventType != Mantid::API::WEIGHTED_NOTIME)
+      m_pulseTimes.reserve(num);
+    if (m_eventType != Mantid::API::TOF)
+    {
+      m_weights.reserve(num);
+      m_errorSquareds.reserve(num);
+    }
+  }
+
+  /** @return the memory used by the columns, in bytes. Uses the capacity of the vectors.
+   */
+  size_t EventColumns::getMemorySize() const
+  {
+    return m_tofs.capacity() * sizeof(double) + m_pulseTimes.capacity() * sizeof(int64_t)
+         + (m_weights.capacity() + m_errorSquareds.capacity()) * sizeof(float);
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Replace the tof of every event. Nothing is done if the
+   * vector does not have one entry per event, as in EventList::setTofs().
+   * @param tofs :: new tofs
+   */
+  void EventColumns::setTofs(const std::vector<double> & tofs)
+  {
+    if (tofs.empty() || tofs.size() != m_tofs.size())
+      return;
+    m_tofs.assign(tofs.begin(), tofs.end());
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Reorder one column so that entry i becomes the old entry order[i].
+   * @param column :: column to reorder
+   * @param order :: permutation
+   */
+  template<class T>
+  void EventColumns::permute(std::vector<T> & column, const std::vector<size_t> & order) const
+  {
+    if (column.empty()) return;
+    std::vector<T> sorted(column.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      sorted[i] = column[order[i]];
+    column.swap(sorted);
+  }
+
+  /** Sort all events by tof. The sort is done on an index array so the
+   * other columns are only touched once each, when they are permuted.
+   */
+  void EventColumns::sortTof()
+  {
+    const size_t numEvents = m_tofs.size();
+    if (numEvents < 2) return;
+    // Nothing to do if already sorted
+    if (std::adjacent_find(m_tofs.begin(), m_tofs.end(), std::greater<double>()) == m_tofs.end())
+      return;
+
+    std::vector<size_t> order(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), CompareIndexByTof(m_tofs));
+
+    permute(m_tofs, order);
+    permute(m_pulseTimes, order);
+    permute(m_weights, order);
+    permute(m_errorSquareds, order);
+  }
+
+  /** Reverse the order of the events in all columns
+   */
+  void EventColumns::reverse()
+  {
+    std::reverse(m_tofs.begin(), m_tofs.end());
+    std::reverse(m_pulseTimes.begin(), m_pulseTimes.end());
+    std::reverse(m_weights.begin(), m_weights.end());
+    std::reverse(m_errorSquareds.begin(), m_errorSquareds.end());
+  }
+
+  /** Convert the tof of every event by tof' = tof*factor + offset.
+   * Does NOT reverse the order of the events if factor < 0.
+   * @param factor :: multiply by this
+   * @param offset :: then add this
+   */
+  void EventColumns::convertTof(const double factor, const double offset)
+  {
+    const size_t numEvents = m_tofs.size();
+    if (numEvents == 0) return;
+    double * tofs = &m_tofs[0];
+    for (size_t i = 0; i < numEvents; ++i)
+      tofs[i] = tofs[i] * factor + offset;
+  }
+
+  /** Remove the events that have a tof between tofMin and tofMax (inclusively).
+   * The columns must be sorted by tof.
+   * @param tofMin :: lower bound of TOF to filter out
+   * @param tofMax :: upper bound of TOF to filter out
+   * @return the number of events removed
+   */
+  size_t EventColumns::maskTof(const double tofMin, const double tofMax)
+  {
+    if (m_tofs.empty()) return 0;
+    // quick checks to make sure that the masking range is even in the data
+    if (tofMin > m_tofs.back() || tofMax < m_tofs.front())
+      return 0;
+
+    std::vector<double>::iterator it_first = std::lower_bound(m_tofs.begin(), m_tofs.end(), tofMin);
+    if (it_first == m_tofs.end() || *it_first >= tofMax)
+      return 0;
+    std::vector<double>::iterator it_last = std::upper_bound(it_first, m_tofs.end(), tofMax);
+
+    const size_t first = static_cast<size_t>(it_first - m_tofs.begin());
+    const size_t last = static_cast<size_t>(it_last - m_tofs.begin());
+    m_tofs.erase(m_tofs.begin() + first, m_tofs.begin() + last);
+    if (!m_pulseTimes.empty())
+      m_pulseTimes.erase(m_pulseTimes.begin() + first, m_pulseTimes.begin() + last);
+    if (!m_weights.empty())
+    {
+      m_weights.erase(m_weights.begin() + first, m_weights.begin() + last);
+      m_errorSquareds.erase(m_errorSquareds.begin() + first, m_errorSquareds.begin() + last);
+    }
+    return last - first;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Histogram the events. The columns must be sorted by tof.
+   * An event is counted in bin i if X[i] <= tof < X[i+1].
+   *
+   * @param X :: bin boundaries, ascending
+   * @param Y :: filled with the counts, or sum of weights
+   * @param E :: filled with the errors
+   * @param skipError :: do not calculate E for unweighted events
+   */
+  void EventColumns::histogram(const MantidVec & X, MantidVec & Y, MantidVec & E, bool skipError) const
+  {
+    if (X.size() <= 1)
+    {
+      //X was not set. Return an empty array.
+      Y.resize(0, 0);
+      return;
+    }
+
+    if (m_eventType == Mantid::API::TOF)
+    {
+      this->histogramCounts(X, Y);
+      if (!skipError)
+      {
+        E.resize(Y.size());
+        std::transform(Y.begin(), Y.end(), E.begin(), static_cast<double (*)(double)>(std::sqrt));
+      }
+    }
+    else
+      this->histogramWeights(X, Y, E);
+  }
+
+  /** Histogram the events, in any order, into bins whose index is computed
+   * directly by the BinIndexer (linear or logarithmic bins). The tof column
+   * is already contiguous, so its bins are computed a block at a time and
+   * the weights scattered into Y.
+   *
+   * @param indexer :: BinIndexer of the bin boundaries
+   * @param Y :: counts, or sum of the weights
+   * @param E :: errors
+   * @param skipError :: skip calculating the errors of unweighted events
+   */
+  void EventColumns::histogram(const Kernel::BinIndexer & indexer, MantidVec & Y, MantidVec & E, bool skipError) const
+  {
+    const size_t numBins = indexer.numBins();
+    const bool weighted = (m_eventType != Mantid::API::TOF);
+    Y.assign(numBins, 0.0);
+    if (weighted)
+      E.assign(numBins, 0.0);
+
+    const size_t blockSize = 1024;
+    int bins[blockSize];
+    const size_t numEvents = m_tofs.size();
+    for (size_t start = 0; start < numEvents; start += blockSize)
+    {
+      const size_t count = std::min(blockSize, numEvents - start);
+      indexer.bins(&m_tofs[start], count, bins);
+      if (weighted)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          if (bins[i] < 0) continue;
+          Y[bins[i]] += static_cast<double>(m_weights[start + i]);
+          E[bins[i]] += static_cast<double>(m_errorSquareds[start + i]);
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < count; ++i)
+          if (bins[i] >= 0) Y[bins[i]] += 1.0;
+      }
+    }
+
+    if (weighted || !skipError)
+    {
+      const MantidVec & squares = weighted ? E : Y;
+      E.resize(numBins);
+      std::transform(squares.begin(), squares.end(), E.begin(), static_cast<double (*)(double)>(std::sqrt));
+    }
+  }
+
+  /** Histogram unweighted events. With fewer bins than events, the count in
+   * each bin is the distance between the positions of its boundaries in the
+   * tof column, so only log(N) tofs are read per bin.
+   *
+   * @param X :: bin boundaries
+   * @param Y :: counts
+   */
+  void EventColumns::histogramCounts(const MantidVec & X, MantidVec & Y) const
+  {
+    const size_t numBins = X.size() - 1;
+    Y.assign(numBins, 0.0);
+    if (m_tofs.empty()) return;
+
+    if (numBins < m_tofs.size())
+    {
+      std::vector<size_t> edges;
+      findBinEdges(m_tofs, X, edges);
+      for (size_t i = 0; i < numBins; ++i)
+        Y[i] = static_cast<double>(edges[i+1] - edges[i]);
+    }
+    else
+    {
+      // Few events: walk through them and find each bin by a search in X
+      std::vector<double>::const_iterator it = std::lower_bound(m_tofs.begin(), m_tofs.end(), X.front());
+      for (; it != m_tofs.end(); ++it)
+      {
+        const double tof = *it;
+        if (tof >= X.back()) break;
+        const size_t bin = static_cast<size_t>(std::upper_bound(X.begin(), X.end(), tof) - X.begin()) - 1;
+        Y[bin] += 1.0;
+      }
+    }
+  }
+
+  /** Histogram weighted events. The weights and squared errors of the events
+   * in each bin are contiguous, so they are summed in one tight loop.
+   *
+   * @param X :: bin boundaries
+   * @param Y :: sum of the weights
+   * @param E :: sqrt of the sum of the squared errors
+   */
+  void EventColumns::histogramWeights(const MantidVec & X, MantidVec & Y, MantidVec & E) const
+  {
+    const size_t numBins = X.size() - 1;
+    Y.assign(numBins, 0.0);
+    E.assign(numBins, 0.0);
+    if (m_tofs.empty()) return;
+
+    std::vector<size_t> edges;
+    findBinEdges(m_tofs, X, edges);
+    for (size_t i = 0; i < numBins; ++i)
+    {
+      if (edges[i] == edges[i+1]) continue;
+      Y[i] = sumRange(m_weights, edges[i], edges[i+1]);
+      E[i] = std::sqrt(sumRange(m_errorSquareds, edges[i], edges[i+1]));
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Integrate the events between a range of X values, or all events.
+   * Unless entireRange is set, the columns must be sorted by tof.
+   *
+   * @param minX :: minimum X bin to use in integrating.
+   * @param maxX :: maximum X bin to use in integrating.
+   * @param entireRange :: set to true to use the entire range. minX and maxX are then ignored!
+   * @param sum :: reference to a double to put the sum in.
+   * @param error :: reference to a double to put the error in.
+   */
+  void EventColumns::integrate(const double minX, const double maxX, const bool entireRange, double & sum, double & error) const
+  {
+    sum = 0;
+    error = 0;
+    if (m_tofs.empty()) return;
+
+    size_t first = 0;
+    size_t last = m_tofs.size();
+    if (!entireRange)
+    {
+      //If a silly range was given, return 0.
+      if (maxX < minX) return;
+      first = static_cast<size_t>(std::lower_bound(m_tofs.begin(), m_tofs.end(), minX) - m_tofs.begin());
+      last = static_cast<size_t>(std::upper_bound(m_tofs.begin() + first, m_tofs.end(), maxX) - m_tofs.begin());
+    }
+
+    if (m_eventType == Mantid::API::TOF)
+    {
+      sum = static_cast<double>(last - first);
+      error = sum;
+    }
+    else
+    {
+      sum = sumRange(m_weights, first, last);
+      error = sumRange(m_errorSquareds, first, last);
+    }
+    error = std::sqrt(error);
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** @return the smallest tof, or the largest double if there are no events
+   * @param sorted :: true if the columns are known to be sorted by tof
+   */
+  double EventColumns::getTofMin(const bool sorted) const
+  {
+    if (m_tofs.empty()) return std::numeric_limits<double>::max();
+    if (sorted) return m_tofs.front();
+    return *std::min_element(m_tofs.begin(), m_tofs.end());
+  }
+
+  /** @return the largest tof, or the most negative double if there are no events
+   * @param sorted :: true if the columns are known to be sorted by tof
+   */
+  double EventColumns::getTofMax(const bool sorted) const
+  {
+    if (m_tofs.empty()) return -1.*std::numeric_limits<double>::max();
+    if (sorted) return m_tofs.back();
+    return *std::max_element(m_tofs.begin(), m_tofs.end());
+  }
+
+} // namespace DataObjects
+} // namespace Mantid
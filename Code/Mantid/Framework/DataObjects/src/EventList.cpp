@@ -31,6 +31,8 @@ namespace DataObjects
   {
     /// The number of events to split for parallel sorting.
     const size_t NUM_EVENTS_PARALLEL_THRESHOLD = 500000;
+    /// The number of events whose bins are computed together when histogramming unsorted events.
+    const size_t HISTOGRAM_BLOCK_SIZE = 1024;
   }
   //==========================================================================
   /// --------------------- TofEvent Comparators ----------------------------------
@@ -81,7 +83,7 @@ namespace DataObjects
 
   /// Constructor (empty)
   EventList::EventList() :
-        eventType(TOF), order(UNSORTED), mru(NULL), m_lockedMRU(false)
+        eventType(TOF), order(UNSORTED), mru(NULL), m_lockedMRU(false), m_columnar(false)
   {
   }
 
@@ -91,7 +93,7 @@ namespace DataObjects
    */
   EventList::EventList(EventWorkspaceMRU * mru, specid_t specNo)
    : IEventList(specNo),
-     eventType(TOF), order(UNSORTED), mru(mru), m_lockedMRU(false)
+     eventType(TOF), order(UNSORTED), mru(mru), m_lockedMRU(false), m_columnar(false)
   {
   }
 
@@ -99,7 +101,7 @@ namespace DataObjects
   /** Constructor copying from an existing event list
    * @param rhs :: EventList object to copy*/
   EventList::EventList(const EventList& rhs)
-    : IEventList(rhs), mru(rhs.mru), m_lockedMRU(false)
+    : IEventList(rhs), mru(rhs.mru), m_lockedMRU(false), m_columnar(false)
   {
     //Call the copy operator to do the job,
     this->operator=(rhs);
@@ -108,7 +110,7 @@ namespace DataObjects
   /** Constructor, taking a vector of events.
    * @param events :: Vector of TofEvent's */
   EventList::EventList(const std::vector<TofEvent> &events)
-    : mru(NULL), m_lockedMRU(false)
+    : mru(NULL), m_lockedMRU(false), m_columnar(false)
   {
     this->events.assign(events.begin(), events.end());
     this->eventType = TOF;
@@ -118,7 +120,7 @@ namespace DataObjects
   /** Constructor, taking a vector of events.
    * @param events :: Vector of WeightedEvent's */
   EventList::EventList(const std::vector<WeightedEvent> &events)
-    : mru(NULL), m_lockedMRU(false)
+    : mru(NULL), m_lockedMRU(false), m_columnar(false)
   {
     this->weightedEvents.assign(events.begin(), events.end());
     this->eventType = WEIGHTED;
@@ -128,7 +130,7 @@ namespace DataObjects
   /** Constructor, taking a vector of events.
    * @param events :: Vector of WeightedEventNoTime's */
   EventList::EventList(const std::vector<WeightedEventNoTime> &events)
-    : mru(NULL), m_lockedMRU(false)
+    : mru(NULL), m_lockedMRU(false), m_columnar(false)
   {
     this->weightedEventsNoTime.assign(events.begin(), events.end());
     this->eventType = WEIGHTED_NOTIME;
@@ -160,6 +162,7 @@ namespace DataObjects
    */
   void EventList::createFromHistogram(const ISpectrum * inSpec, bool GenerateZeros, bool GenerateMultipleEvents, int MaxEventsPerBin)
   {
+    this->switchToRows();
     // Fresh start
     this->clear(true);
 
@@ -259,11 +262,13 @@ namespace DataObjects
     this->events.assign(rhs.events.begin(), rhs.events.end());
     this->weightedEvents.assign(rhs.weightedEvents.begin(), rhs.weightedEvents.end());
     this->weightedEventsNoTime.assign(rhs.weightedEventsNoTime.begin(), rhs.weightedEventsNoTime.end());
+    this->m_columns = rhs.m_columns;
+    this->m_columnar = rhs.m_columnar;
     this->eventType = rhs.eventType;
     this->refX = rhs.refX;
     this->order = rhs.order;
     //Copy the detector ID set
-    this->detectorIDs = rhs.detectorIDs;
+    this->setDetectorIDs(rhs.detectorIDs);
     return *this;
   }
 
@@ -275,6 +280,7 @@ namespace DataObjects
    * */
   EventList& EventList::operator+=(const TofEvent &event)
   {
+    this->switchToRows();
 
     switch (this->eventType)
     {
@@ -306,6 +312,7 @@ namespace DataObjects
    * */
   EventList& EventList::operator+=(const std::vector<TofEvent> & more_events)
   {
+    this->switchToRows();
     switch (this->eventType)
     {
     case TOF:
@@ -345,6 +352,7 @@ namespace DataObjects
    * */
   EventList& EventList::operator+=(const WeightedEvent &event)
   {
+    this->switchToRows();
     this->switchTo(WEIGHTED);
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
@@ -361,6 +369,7 @@ namespace DataObjects
    * */
   EventList& EventList::operator+=(const std::vector<WeightedEvent> & more_events)
   {
+    this->switchToRows();
     switch (this->eventType)
     {
     case TOF:
@@ -397,6 +406,7 @@ namespace DataObjects
    * */
   EventList& EventList::operator+=(const std::vector<WeightedEventNoTime> & more_events)
   {
+    this->switchToRows();
     switch (this->eventType)
     {
     case TOF:
@@ -427,6 +437,8 @@ namespace DataObjects
    * */
   EventList& EventList::operator+=(const EventList& more_events)
   {
+    this->switchToRows();
+    more_events.switchToRows();
     // We'll let the += operator for the given vector of event lists handle it
     switch (more_events.getEventType())
     {
@@ -446,15 +458,95 @@ namespace DataObjects
     //No guaranteed order
     this->order = UNSORTED;
     //Do a union between the detector IDs of both lists
-    std::set<detid_t>::const_iterator it;
-    for (it = more_events.detectorIDs.begin(); it != more_events.detectorIDs.end(); ++it )
-      this->detectorIDs.insert( *it );
+    this->addDetectorIDs(more_events.detectorIDs);
 
     return *this;
   }
 
 
 
+  // --------------------------------------------------------------------------
+  /** Move the events of a vector to the end of another one.
+   * If both vectors are sorted by TOF, the result is kept sorted by merging them.
+   *
+   * @param events :: the vector to append to
+   * @param more_events :: the events to move. Left empty.
+   * @param sorted :: true if both vectors are sorted by TOF
+   */
+  template<class T>
+  void EventList::spliceEvents(std::vector<T> & events, std::vector<T> & more_events, const bool sorted)
+  {
+    if (more_events.empty())
+      return;
+    if (events.empty())
+    {
+      // Nothing to copy: just take the storage
+      events.swap(more_events);
+      return;
+    }
+    const size_t oldSize = events.size();
+    events.insert(events.end(), more_events.begin(), more_events.end());
+    std::vector<T>().swap(more_events); //STL Trick to release memory
+    // Live data mostly arrives in order of TOF within each pulse, so the merge is rarely needed
+    if (sorted && compareEventTof(events[oldSize], events[oldSize-1]))
+      std::inplace_merge(events.begin(), events.begin() + oldSize, events.end(), compareEventTof<T>);
+  }
+
+  // --------------------------------------------------------------------------
+  /** Move the events of another EventList to the end of this one, without copying them
+   * when this list is empty. The other list is left empty, with its detector IDs.
+   * If both lists are sorted by TOF, this list stays sorted, which costs a merge
+   * of the lists instead of a sort of all the events.
+   * A union of the sets of detector ID's is done, as for operator+=.
+   *
+   * @param more_events :: Another EventList. Its events are removed.
+   * */
+  void EventList::takeEvents(EventList& more_events)
+  {
+    this->switchToRows();
+    more_events.switchToRows();
+    if (this->eventType != more_events.eventType)
+    {
+      // Different event types need a conversion anyway
+      this->operator+=(more_events);
+      more_events.clear(false);
+      return;
+    }
+
+    const bool wasEmpty = (this->getNumberEvents() == 0);
+    const bool nothingToTake = (more_events.getNumberEvents() == 0);
+    const bool sorted = (this->order == TOF_SORT && more_events.order == TOF_SORT);
+    switch (this->eventType)
+    {
+    case TOF:
+      spliceEvents(this->events, more_events.events, sorted);
+      break;
+    case WEIGHTED:
+      spliceEvents(this->weightedEvents, more_events.weightedEvents, sorted);
+      break;
+    case WEIGHTED_NOTIME:
+      spliceEvents(this->weightedEventsNoTime, more_events.weightedEventsNoTime, sorted);
+      break;
+    }
+
+    // Taking no events leaves the order of this list as it was
+    if (!nothingToTake)
+    {
+      if (wasEmpty)
+        this->order = more_events.order;
+      else if (!sorted)
+        this->order = UNSORTED;
+    }
+    more_events.order = UNSORTED;
+
+    //Do a union between the detector IDs of both lists
+    this->addDetectorIDs(more_events.detectorIDs);
+
+    // Only the histogram of this spectrum is out of date
+    if (mru) mru->deleteIndex(this->m_specNo);
+  }
+
+
   // --------------------------------------------------------------------------
   /** SUBTRACT another EventList from this event list.
    * The event lists are concatenated, but the weights of the incoming
@@ -497,6 +589,8 @@ namespace DataObjects
    * */
   EventList& EventList::operator-=(const EventList& more_events)
   {
+    this->switchToRows();
+    more_events.switchToRows();
     if (this == &more_events)
     {
         //Special case, ticket #3844 part 2.
@@ -558,6 +652,8 @@ namespace DataObjects
    */
   bool EventList::operator==(const EventList& rhs) const
   {
+    this->switchToRows();
+    rhs.switchToRows();
     if (this->getNumberEvents() != rhs.getNumberEvents())
       return false;
     if (this->eventType != rhs.eventType)
@@ -581,6 +677,8 @@ namespace DataObjects
   bool EventList::equals(const EventList& rhs, const double tolTof,
              const double tolWeight, const int64_t tolPulse) const
   {
+    this->switchToRows();
+    rhs.switchToRows();
     // generic checks
     if (this->getNumberEvents() != rhs.getNumberEvents())
       return false;
@@ -633,6 +731,7 @@ namespace DataObjects
    */
   void EventList::switchTo(EventType newType)
   {
+    this->switchToRows();
     switch(newType)
     {
     case TOF:
@@ -732,6 +831,86 @@ namespace DataObjects
   }
 
 
+  // -----------------------------------------------------------------------------------------------
+  /** Choose how the events are stored.
+   *
+   * In columnar storage, the tof, pulse time, weight and error of the events are kept
+   * in separate arrays (see EventColumns). Histogramming, TOF conversion, masking, sorting by
+   * TOF and integration then only read the columns they need. Any other operation
+   * converts the list back to the usual vector of events first, and the list stays that way
+   * until columnar storage is requested again.
+   *
+   * @param columnar :: true to use columnar storage, false for the usual vector of events.
+   */
+  void EventList::setColumnarStorage(const bool columnar)
+  {
+    if (columnar == m_columnar)
+      return;
+    if (!columnar)
+    {
+      this->switchToRows();
+      return;
+    }
+
+    switch (eventType)
+    {
+    case TOF:
+      m_columns.assign(this->events);
+      break;
+    case WEIGHTED:
+      m_columns.assign(this->weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_columns.assign(this->weightedEventsNoTime);
+      break;
+    }
+    m_columnar = true;
+    // The events now only live in the columns
+    std::vector<TofEvent>().swap(this->events);
+    std::vector<WeightedEvent>().swap(this->weightedEvents);
+    std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+  }
+
+  /** @return true if the events are held in columnar storage.
+   */
+  bool EventList::isColumnarStorage() const
+  {
+    return m_columnar;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  /** Move the events out of columnar storage, back into the
+   * vector of events matching the event type. Does nothing if not columnar.
+   * The sort order is preserved.
+   */
+  void EventList::switchToRows() const
+  {
+    if (!m_columnar)
+      return;
+
+    // Avoid converting from multiple threads
+    Poco::ScopedLock<Mutex> _lock(m_sortMutex);
+    // If the list was converted while waiting for the lock, return.
+    if (!m_columnar)
+      return;
+
+    switch (eventType)
+    {
+    case TOF:
+      m_columns.extract(this->events);
+      break;
+    case WEIGHTED:
+      m_columns.extract(this->weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_columns.extract(this->weightedEventsNoTime);
+      break;
+    }
+    m_columns.clear();
+    m_columnar = false;
+  }
+
+
   // ==============================================================================================
   // --- Testing functions (mostly) ---------------------------------------------------------------
   // ==============================================================================================
@@ -743,6 +922,7 @@ namespace DataObjects
    */
   WeightedEvent EventList::getEvent(size_t event_number)
   {
+    this->switchToRows();
     switch (eventType)
     {
     case TOF:
@@ -769,6 +949,7 @@ namespace DataObjects
    * */
   const std::vector<TofEvent> & EventList::getEvents() const
   {
+    this->switchToRows();
     if (eventType != TOF)
       throw std::runtime_error("EventList::getEvents() called for an EventList that has weights. Use getWeightedEvents() or getWeightedEventsNoTime().");
     return this->events;
@@ -782,6 +963,7 @@ namespace DataObjects
    * */
   std::vector<TofEvent>& EventList::getEvents()
   {
+    this->switchToRows();
     if (eventType != TOF)
       throw std::runtime_error("EventList::getEvents() called for an EventList that has weights. Use getWeightedEvents() or getWeightedEventsNoTime().");
     return this->events;
@@ -795,6 +977,7 @@ namespace DataObjects
    * */
   std::vector<WeightedEvent>& EventList::getWeightedEvents()
   {
+    this->switchToRows();
     if (eventType != WEIGHTED)
       throw std::runtime_error("EventList::getWeightedEvents() called for an EventList not of type WeightedEvent. Use getEvents() or getWeightedEventsNoTime().");
     return this->weightedEvents;
@@ -808,6 +991,7 @@ namespace DataObjects
    * */
   const std::vector<WeightedEvent>& EventList::getWeightedEvents() const
   {
+    this->switchToRows();
     if (eventType != WEIGHTED)
       throw std::runtime_error("EventList::getWeightedEvents() called for an EventList not of type WeightedEvent. Use getEvents() or getWeightedEventsNoTime().");
     return this->weightedEvents;
@@ -820,6 +1004,7 @@ namespace DataObjects
    * */
   std::vector<WeightedEventNoTime>& EventList::getWeightedEventsNoTime()
   {
+    this->switchToRows();
     if (eventType != WEIGHTED_NOTIME)
       throw std::runtime_error("EventList::getWeightedEvents() called for an EventList not of type WeightedEventNoTime. Use getEvents() or getWeightedEvents().");
     return this->weightedEventsNoTime;
@@ -832,6 +1017,7 @@ namespace DataObjects
    * */
   const std::vector<WeightedEventNoTime>& EventList::getWeightedEventsNoTime() const
   {
+    this->switchToRows();
     if (eventType != WEIGHTED_NOTIME)
       throw std::runtime_error("EventList::getWeightedEventsNoTime() called for an EventList not of type WeightedEventNoTime. Use getEvents() or getWeightedEvents().");
     return this->weightedEventsNoTime;
@@ -850,8 +1036,9 @@ namespace DataObjects
     std::vector<WeightedEvent>().swap(this->weightedEvents); //STL Trick to release memory
     this->weightedEventsNoTime.clear();
     std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime); //STL Trick to release memory
+    this->m_columns.clear();
     if (removeDetIDs)
-      this->detectorIDs.clear();
+      this->clearDetectorIDs();
   }
 
   /** Clear any unused event lists (the ones that do not
@@ -908,7 +1095,10 @@ namespace DataObjects
    */
   void EventList::reserve(size_t num)
   {
-    this->events.reserve(num);
+    if (m_columnar)
+      this->m_columns.reserve(num);
+    else
+      this->events.reserve(num);
   }
 
 
@@ -1188,6 +1378,14 @@ namespace DataObjects
     if (this->order == TOF_SORT)
       return;
 
+    if (m_columnar)
+    {
+      // The columns are sorted through an index, in one thread
+      m_columns.sortTof();
+      this->order = TOF_SORT;
+      return;
+    }
+
     switch (eventType)
     {
     case TOF:
@@ -1224,6 +1422,14 @@ namespace DataObjects
     if (this->order == TOF_SORT)
       return;
 
+    if (m_columnar)
+    {
+      // The columns are sorted through an index, in one thread
+      m_columns.sortTof();
+      this->order = TOF_SORT;
+      return;
+    }
+
     switch (eventType)
     {
     case TOF:
@@ -1260,6 +1466,14 @@ namespace DataObjects
     if (this->order == TOF_SORT)
       return;
 
+    if (m_columnar)
+    {
+      // The columns are sorted through an index, in one thread
+      m_columns.sortTof();
+      this->order = TOF_SORT;
+      return;
+    }
+
     switch (eventType)
     {
     case TOF:
@@ -1281,6 +1495,7 @@ namespace DataObjects
   /** Sort events by Frame */
   void EventList::sortPulseTime() const
   {
+    this->switchToRows();
     if (this->order == PULSETIME_SORT)
       return; // nothing to do
 
@@ -1313,6 +1528,7 @@ namespace DataObjects
    */
   void EventList::sortPulseTimeTOF() const
   {
+    this->switchToRows();
     if (this->order == PULSETIMETOF_SORT)
       return; // already ordered.
 
@@ -1368,7 +1584,11 @@ namespace DataObjects
     this->refX.access() = x;
 
     // flip the events if they are tof sorted
-    if (this->isSortedByTof())
+    if (this->isSortedByTof() && m_columnar)
+    {
+      m_columns.reverse();
+    }
+    else if (this->isSortedByTof())
     {
       switch (eventType)
       {
@@ -1397,6 +1617,9 @@ namespace DataObjects
    *  */
   size_t EventList::getNumberEvents() const
   {
+    if (m_columnar)
+      return m_columns.size();
+
     switch (eventType)
     {
     case TOF:
@@ -1414,6 +1637,9 @@ namespace DataObjects
    */
   bool EventList::empty() const
   {
+    if (m_columnar)
+      return m_columns.empty();
+
     switch (eventType)
     {
     case TOF:
@@ -1436,6 +1662,9 @@ namespace DataObjects
    * */
   size_t EventList::getMemorySize() const
   {
+    if (m_columnar)
+      return m_columns.getMemorySize() + sizeof(EventList);
+
     switch (eventType)
     {
     case TOF:
@@ -1561,22 +1790,18 @@ namespace DataObjects
   {
     if (!mru) throw std::runtime_error("EventList::constDataY() called with no MRU set. This is not allowed.");
 
-    // This is the thread number from which this function was called.
-    int thread = PARALLEL_THREAD_NUMBER;
-    mru->ensureEnoughBuffersY(thread);
-
     //Is the data in the mrulist?
+    const MantidVec * x = &(*refX);
     MantidVecWithMarker * yData;
-    yData = mru->findY(thread, this->m_specNo);
+    yData = mru->findY(this->m_specNo, x);
 
     if (yData == NULL)
     {
       //Create the MRU object
-      yData = new MantidVecWithMarker(this->m_specNo, this->m_lockedMRU);
+      yData = new MantidVecWithMarker(this->m_specNo, this->m_lockedMRU, x);
 
       // prepare to update the uncertainties
-      MantidVecWithMarker * eData = new MantidVecWithMarker(this->m_specNo, this->m_lockedMRU);
-      mru->ensureEnoughBuffersE(thread);
+      MantidVecWithMarker * eData = new MantidVecWithMarker(this->m_specNo, this->m_lockedMRU, x);
 
       // see if E should be calculated;
       bool skipErrors = (eventType == TOF);
@@ -1584,11 +1809,11 @@ namespace DataObjects
       //Set the Y data in it
       this->generateHistogram( *refX, yData->m_data, eData->m_data, skipErrors);
 
-      //Lets save it in the MRU
-      mru->insertY(thread, yData);
+      //Lets save it in the MRU. Another thread may have got there first: use its copy.
+      yData = mru->insertY(yData);
       if (!skipErrors)
       {
-        mru->insertE(thread, eData);
+        mru->insertE(eData);
       }
       else delete eData; // Need to clear up this memory if it wasn't put into MRU
 
@@ -1605,25 +1830,22 @@ namespace DataObjects
   {
     if (!mru) throw std::runtime_error("EventList::constDataE() called with no MRU set. This is not allowed.");
 
-    // This is the thread number from which this function was called.
-    int thread = PARALLEL_THREAD_NUMBER;
-    mru->ensureEnoughBuffersE(thread);
-
     //Is the data in the mrulist?
+    const MantidVec * x = &(*refX);
     MantidVecWithMarker * eData;
-    eData = mru->findE(thread, this->m_specNo);
+    eData = mru->findE(this->m_specNo, x);
 
     if (eData == NULL)
     {
       //Create the MRU object
-      eData = new MantidVecWithMarker(this->m_specNo, this->m_lockedMRU);
+      eData = new MantidVecWithMarker(this->m_specNo, this->m_lockedMRU, x);
 
       //Now use that to get E -- Y values are generated from another function
       MantidVec Y_ignored;
       this->generateHistogram(*refX, Y_ignored, eData->m_data);
 
-      //Lets save it in the MRU
-      mru->insertE(thread, eData);
+      //Lets save it in the MRU. Another thread may have got there first: use its copy.
+      eData = mru->insertE(eData);
     }
     return eData->m_data;
   }
@@ -1809,6 +2031,8 @@ namespace DataObjects
    */
   void EventList::compressEvents(double tolerance, EventList * destination, bool parallel)
   {
+    this->switchToRows();
+    destination->switchToRows();
     // Must have a sorted list
     if (parallel)
       this->sortTof4();
@@ -2024,6 +2248,51 @@ namespace DataObjects
                    static_cast<double (*)(double)>(std::sqrt));
   }
 
+  // --------------------------------------------------------------------------
+  /** Histogram events without sorting them, for bins whose index can be
+   * computed directly (linear or logarithmic binning).
+   * The tofs of a block of events are gathered, their bins computed in one
+   * go by the BinIndexer, then the weights are scattered into Y (and E).
+   *
+   * @param events: vector of events, in any order
+   * @param indexer: BinIndexer of the X-bins
+   * @param Y: counts returned
+   * @param E: errors returned, if withErrors
+   * @param withErrors: accumulate the squared errors of the events into E, then take the sqrt.
+   */
+  template<class T>
+  void EventList::histogramDirectHelper(const std::vector<T> & events, const Kernel::BinIndexer & indexer, MantidVec & Y, MantidVec & E, const bool withErrors)
+  {
+    const size_t numBins = indexer.numBins();
+    Y.assign(numBins, 0.0);
+    if (withErrors)
+      E.assign(numBins, 0.0);
+
+    double tofs[HISTOGRAM_BLOCK_SIZE];
+    int bins[HISTOGRAM_BLOCK_SIZE];
+    const size_t numEvents = events.size();
+    for (size_t start = 0; start < numEvents; start += HISTOGRAM_BLOCK_SIZE)
+    {
+      const size_t count = std::min(HISTOGRAM_BLOCK_SIZE, numEvents - start);
+      const T * block = &events[start];
+      for (size_t i = 0; i < count; ++i)
+        tofs[i] = block[i].tof();
+      indexer.bins(tofs, count, bins);
+      for (size_t i = 0; i < count; ++i)
+      {
+        const int bin = bins[i];
+        if (bin < 0) continue;
+        Y[bin] += block[i].weight();
+        if (withErrors)
+          E[bin] += block[i].errorSquared();
+      }
+    }
+
+    if (withErrors)
+      std::transform(E.begin(), E.end(), E.begin(),
+                     static_cast<double (*)(double)>(std::sqrt));
+  }
+
     // --------------------------------------------------------------------------
   /** Generates both the Y and E (error) histograms w.r.t Pulse Time
    * for an EventList with or without WeightedEvents.
@@ -2036,6 +2305,7 @@ namespace DataObjects
    */
   void EventList::generateHistogramPulseTime(const MantidVec& X, MantidVec& Y, MantidVec& E, bool skipError) const
   {
+    this->switchToRows();
     // All types of weights need to be sorted by TOF
     this->sortPulseTime(); // TODO
 
@@ -2068,8 +2338,34 @@ namespace DataObjects
    */
   void EventList::generateHistogram(const MantidVec& X, MantidVec& Y, MantidVec& E, bool skipError) const
   {
-    // All types of weights need to be sorted by TOF
+    // Linear or logarithmic bins: the bin of each event is computed, so there is no need to sort.
+    // Sorted columns are histogrammed faster by searching for the bin boundaries.
+    Kernel::BinIndexer indexer(X);
+    if (indexer.isDirect() && !(m_columnar && this->order == TOF_SORT))
+    {
+      if (m_columnar)
+      {
+        m_columns.histogram(indexer, Y, E, skipError);
+        return;
+      }
+      switch (eventType)
+      {
+      case TOF:
+        histogramDirectHelper(this->events, indexer, Y, E, false);
+        if (!skipError)
+          this->generateErrorsHistogram(Y, E);
+        break;
+      case WEIGHTED:
+        histogramDirectHelper(this->weightedEvents, indexer, Y, E, true);
+        break;
+      case WEIGHTED_NOTIME:
+        histogramDirectHelper(this->weightedEventsNoTime, indexer, Y, E, true);
+        break;
+      }
+      return;
+    }
 
+    // All types of weights need to be sorted by TOF
     size_t numEvents = getNumberEvents();
     if (numEvents > NUM_EVENTS_PARALLEL_THRESHOLD && PARALLEL_GET_MAX_THREADS >= 4)
       // Four-core sort
@@ -2081,6 +2377,12 @@ namespace DataObjects
       // One-core sort
       this->sortTof();
 
+    if (m_columnar)
+    {
+      m_columns.histogram(X, Y, E, skipError);
+      return;
+    }
+
     switch (eventType)
     {
     case TOF:
@@ -2366,6 +2668,12 @@ namespace DataObjects
       this->sortTof();
     }
 
+    if (m_columnar)
+    {
+      m_columns.integrate(minX, maxX, entireRange, sum, error);
+      return;
+    }
+
     //Convert the list
     switch (eventType)
     {
@@ -2407,6 +2715,12 @@ namespace DataObjects
 
     if (this->getNumberEvents() <= 0)  return;
 
+    if (m_columnar)
+    {
+      m_columns.convertTof(factor, offset);
+      return;
+    }
+
     //Convert the list
     switch (eventType)
     {
@@ -2489,6 +2803,7 @@ namespace DataObjects
    */
   void EventList::addPulsetime(const double seconds)
   {
+    this->switchToRows();
     if (this->getNumberEvents() <= 0)  return;
 
     //Convert the list
@@ -2573,7 +2888,12 @@ namespace DataObjects
     //Convert the list
     size_t numOrig = 0;
     size_t numDel = 0;
-    switch (eventType)
+    if (m_columnar)
+    {
+      numOrig = m_columns.size();
+      numDel = m_columns.maskTof(tofMin, tofMax);
+    }
+    else switch (eventType)
     {
     case TOF:
       numOrig = this->events.size();
@@ -2620,6 +2940,12 @@ namespace DataObjects
     // Set the capacity of the vector to avoid multiple resizes
     tofs.reserve(this->getNumberEvents());
 
+    if (m_columnar)
+    {
+      tofs.assign(m_columns.tofs().begin(), m_columns.tofs().end());
+      return;
+    }
+
     //Convert the list
     switch (eventType)
     {
@@ -2673,6 +2999,12 @@ namespace DataObjects
     // Set the capacity of the vector to avoid multiple resizes
     weights.reserve(this->getNumberEvents());
 
+    if (m_columnar && eventType != TOF)
+    {
+      weights.assign(m_columns.weights().begin(), m_columns.weights().end());
+      return;
+    }
+
     //Convert the list
     switch (eventType)
     {
@@ -2727,6 +3059,15 @@ namespace DataObjects
     // Set the capacity of the vector to avoid multiple resizes
     weightErrors.reserve(this->getNumberEvents());
 
+    if (m_columnar && eventType != TOF)
+    {
+      const std::vector<float> & errorSquareds = m_columns.errorSquareds();
+      weightErrors.resize(errorSquareds.size());
+      for (size_t i = 0; i < errorSquareds.size(); ++i)
+        weightErrors[i] = std::sqrt(double(errorSquareds[i]));
+      return;
+    }
+
     //Convert the list
     switch (eventType)
     {
@@ -2776,6 +3117,7 @@ namespace DataObjects
    */
   std::vector<Mantid::Kernel::DateAndTime> EventList::getPulseTimes() const
   {
+    this->switchToRows();
     std::vector<Mantid::Kernel::DateAndTime> times;
     // Set the capacity of the vector to avoid multiple resizes
     times.reserve(this->getNumberEvents());
@@ -2810,6 +3152,9 @@ namespace DataObjects
     if (this->empty())
       return tMin;
 
+    if (m_columnar)
+      return m_columns.getTofMin(this->order == TOF_SORT);
+
     // when events are ordered by tof just need the first value
     if (this->order == TOF_SORT) {
       switch (eventType)
@@ -2858,6 +3203,9 @@ namespace DataObjects
     if (this->empty())
       return tMax;
 
+    if (m_columnar)
+      return m_columns.getTofMax(this->order == TOF_SORT);
+
     // when events are ordered by tof just need the first value
     if (this->order == TOF_SORT) {
       switch (eventType)
@@ -2901,6 +3249,7 @@ namespace DataObjects
    */
   DateAndTime EventList::getPulseTimeMin() const
   {
+    this->switchToRows();
     // set up as the maximum available date time.
     DateAndTime tMin = DateAndTime::maximum();
 
@@ -2949,6 +3298,7 @@ namespace DataObjects
    */
   DateAndTime EventList::getPulseTimeMax() const
   {
+    this->switchToRows();
     // set up as the minimum available date time.
     DateAndTime tMax = DateAndTime::minimum();
 
@@ -3023,6 +3373,12 @@ namespace DataObjects
   {
     this->order = UNSORTED;
 
+    if (m_columnar)
+    {
+      m_columns.setTofs(tofs);
+      return;
+    }
+
     //Convert the list
     switch (eventType)
     {
@@ -3095,6 +3451,7 @@ namespace DataObjects
    */
   EventList& EventList::operator*=(const double value)
   {
+    this->switchToRows();
     this->multiply(value);
     return *this;
   }
@@ -3128,6 +3485,7 @@ namespace DataObjects
    */
   void EventList::multiply(const double value, const double error)
   {
+    this->switchToRows();
     // Do nothing if multiplying by exactly one and there is no error
     if ((value == 1.0) && (error == 0.0))
       return;
@@ -3254,6 +3612,7 @@ namespace DataObjects
    */
   void EventList::multiply(const MantidVec & X, const MantidVec & Y, const MantidVec & E)
   {
+    this->switchToRows();
     switch (eventType)
     {
     case TOF:
@@ -3397,6 +3756,7 @@ namespace DataObjects
    */
   void EventList::divide(const MantidVec & X, const MantidVec & Y, const MantidVec & E)
   {
+    this->switchToRows();
     switch (eventType)
     {
     case TOF:
@@ -3430,6 +3790,7 @@ namespace DataObjects
    */
   EventList& EventList::operator/=(const double value)
   {
+    this->switchToRows();
     if (value == 0.0)
       throw std::invalid_argument("EventList::divide() called with value of 0.0. Cannot divide by zero.");
     this->multiply(1.0/value, 0.0);
@@ -3447,6 +3808,7 @@ namespace DataObjects
    */
   void EventList::divide(const double value, const double error)
   {
+    this->switchToRows();
     if (value == 0.0)
       throw std::invalid_argument("EventList::divide() called with value of 0.0. Cannot divide by zero.");
     //Do nothing if dividing by exactly 1.0, no error
@@ -3504,6 +3866,7 @@ namespace DataObjects
    */
   void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop, EventList & output) const
   {
+    this->switchToRows();
     if ( this == &output )
     {
       throw std::invalid_argument("In-place filtering is not allowed");
@@ -3516,7 +3879,7 @@ namespace DataObjects
     //Has to match the given type
     output.switchTo(eventType);
     //Copy the detector IDs
-    output.detectorIDs = this->detectorIDs;
+    output.setDetectorIDs(this->detectorIDs);
     output.refX = this->refX;
 
     //Iterate through all events (sorted by pulse time)
@@ -3622,6 +3985,7 @@ namespace DataObjects
    */
   void EventList::filterInPlace(Kernel::TimeSplitterType & splitter)
   {
+    this->switchToRows();
     //Start by sorting the event list by pulse time.
     this->sortPulseTime();
 
@@ -3713,6 +4077,7 @@ namespace DataObjects
    */
   void EventList::splitByTime(Kernel::TimeSplitterType & splitter, std::vector< EventList * > outputs) const
   {
+    this->switchToRows();
     if (eventType == WEIGHTED_NOTIME)
       throw std::runtime_error("EventList::splitByTime() called on an EventList that no longer has time information.");
 
@@ -3724,7 +4089,7 @@ namespace DataObjects
     for (size_t i=0; i<numOutputs; i++)
     {
       outputs[i]->clear();
-      outputs[i]->detectorIDs = this->detectorIDs;
+      outputs[i]->setDetectorIDs(this->detectorIDs);
       outputs[i]->refX = this->refX;
       // Match the output event type.
       outputs[i]->switchTo(eventType);
@@ -3853,6 +4218,7 @@ namespace DataObjects
    */
   void EventList::splitByFullTime(Kernel::TimeSplitterType & splitter, std::map<int, EventList * > outputs, double tofcorrection, bool docorrection) const
   {
+    this->switchToRows();
     if (eventType == WEIGHTED_NOTIME)
       throw std::runtime_error("EventList::splitByTime() called on an EventList that no longer has time information.");
 
@@ -3865,7 +4231,7 @@ namespace DataObjects
     {
       EventList* opeventlist = outiter->second;
       opeventlist->clear();
-      opeventlist->detectorIDs = this->detectorIDs;
+      opeventlist->setDetectorIDs(this->detectorIDs);
       opeventlist->refX = this->refX;
       // Match the output event type.
       opeventlist->switchTo(eventType);
@@ -3979,6 +4345,7 @@ namespace DataObjects
     */
   void EventList::splitByPulseTime(Kernel::TimeSplitterType & splitter, std::map<int, EventList * > outputs) const
   {
+    this->switchToRows();
     // Check for supported event type
     if (eventType == WEIGHTED_NOTIME)
       throw std::runtime_error("EventList::splitByTime() called on an EventList that no longer has time information.");
@@ -3992,7 +4359,7 @@ namespace DataObjects
     {
       EventList* opeventlist = outiter->second;
       opeventlist->clear();
-      opeventlist->detectorIDs = this->detectorIDs;
+      opeventlist->setDetectorIDs(this->detectorIDs);
       opeventlist->refX = this->refX;
       // Match the output event type.
       opeventlist->switchTo(eventType);
@@ -4024,6 +4391,131 @@ namespace DataObjects
   }
 
 
+  //----------------------------------------------------------------------------------------------
+  /** Send each event to the output of the time of the event, operating on a vector of either
+   * TofEvent's or WeightedEvent's. The outputs have been cleared and set to the right type already.
+   *
+   * The events are counted per output first, so that the events of each output are allocated once.
+   * The events keep their order, so the outputs are sorted like this list.
+   *
+   * @param splitter :: the splitter index giving the output of each time
+   * @param outputs :: one event list for each output of the splitter
+   * @param events :: either this->events or this->weightedEvents.
+   * @param pulseTimeOnly :: use the pulse time of the events only, instead of pulse time + TOF
+   * @param tofFactor :: factor to multiply the TOF with, when it is used
+   */
+  template< class T >
+  void EventList::splitByIndexHelper(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs,
+                                     const std::vector<T> & events, const bool pulseTimeOnly, const double tofFactor) const
+  {
+    const size_t numEvents = events.size();
+
+    // 1. Find the output of each event
+    std::vector<size_t> destinations(numEvents);
+    std::vector<size_t> counts(outputs.size(), 0);
+    size_t hint = 0;
+    for (size_t i = 0; i < numEvents; ++i)
+    {
+      int64_t time = events[i].m_pulsetime.totalNanoseconds();
+      if (!pulseTimeOnly)
+        time += static_cast<int64_t>(events[i].m_tof*1000*tofFactor);
+      const size_t output = splitter.getOutput(time, hint);
+      destinations[i] = output;
+      if (output != Kernel::TimeSplitterIndex::NO_OUTPUT)
+        ++counts[output];
+    }
+
+    // 2. Make room in the outputs
+    std::vector<std::vector<T> *> outputEvents(outputs.size(), NULL);
+    for (size_t output = 0; output < outputs.size(); ++output)
+    {
+      if (counts[output] == 0) continue;
+      getEventsFrom(*outputs[output], outputEvents[output]);
+      outputEvents[output]->reserve(counts[output]);
+      outputs[output]->setSortOrder(this->order);
+    }
+
+    // 3. Copy
+    for (size_t i = 0; i < numEvents; ++i)
+    {
+      if (destinations[i] != Kernel::TimeSplitterIndex::NO_OUTPUT)
+        outputEvents[destinations[i]]->push_back(events[i]);
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Common part of splitting with a TimeSplitterIndex: prepare the outputs and split the events
+   *
+   * @param splitter :: the splitter index giving the output of each time
+   * @param outputs :: one event list for each output of the splitter
+   * @param pulseTimeOnly :: use the pulse time of the events only, instead of pulse time + TOF
+   * @param tofFactor :: factor to multiply the TOF with, when it is used
+   */
+  void EventList::splitByIndex(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs,
+                               const bool pulseTimeOnly, const double tofFactor) const
+  {
+    this->switchToRows();
+    if (eventType == WEIGHTED_NOTIME)
+      throw std::runtime_error("EventList::splitByTime() called on an EventList that no longer has time information.");
+    if (outputs.size() != splitter.getNumberOfOutputs())
+      throw std::invalid_argument("EventList::splitByTime() needs one output event list per output of the splitter.");
+
+    // Initialize all the outputs
+    for (size_t output = 0; output < outputs.size(); ++output)
+    {
+      EventList* opeventlist = outputs[output];
+      opeventlist->clear();
+      opeventlist->setDetectorIDs(this->detectorIDs);
+      opeventlist->refX = this->refX;
+      // Match the output event type.
+      opeventlist->switchTo(eventType);
+    }
+
+    switch (eventType)
+    {
+    case TOF:
+      splitByIndexHelper(splitter, outputs, this->events, pulseTimeOnly, tofFactor);
+      break;
+    case WEIGHTED:
+      splitByIndexHelper(splitter, outputs, this->weightedEvents, pulseTimeOnly, tofFactor);
+      break;
+    case WEIGHTED_NOTIME:
+      break;
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Split the event list into the outputs of a splitter index by event's full time (tof + pulse time).
+   * Unlike the version taking a TimeSplitterType, the list does not need to be sorted first, and
+   * the cost per event does not depend on the number of intervals. It does not change this list
+   * (other than switching a columnar list to rows), so different lists can be split in parallel
+   * with the same splitter.
+   *
+   * @param splitter :: the splitter index, giving the output of each time
+   * @param outputs :: one event list for each output of the splitter, in the order of the outputs.
+   *        Output 0 receives the events outside of the intervals.
+   * @param tofcorrection :: a correction for each TOF to multiply with.
+   * @param docorrection :: a boolean to indiciate whether it is need to do correction
+   */
+  void EventList::splitByFullTime(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs,
+                                  double tofcorrection, bool docorrection) const
+  {
+    this->splitByIndex(splitter, outputs, false, docorrection ? tofcorrection : 1.0);
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Split the event list into the outputs of a splitter index by the pulse time of the events.
+   * See splitByFullTime().
+   *
+   * @param splitter :: the splitter index, giving the output of each time
+   * @param outputs :: one event list for each output of the splitter, in the order of the outputs.
+   */
+  void EventList::splitByPulseTime(const Kernel::TimeSplitterIndex & splitter, const std::vector<EventList *> & outputs) const
+  {
+    this->splitByIndex(splitter, outputs, true, 1.0);
+  }
+
+
   //--------------------------------------------------------------------------
   /** Get the vector of events contained in an EventList;
    * this is overloaded by event type.
@@ -4110,6 +4602,7 @@ namespace DataObjects
    */
   void EventList::convertUnitsViaTof(Mantid::Kernel::Unit * fromUnit, Mantid::Kernel::Unit * toUnit)
   {
+    this->switchToRows();
     // Check for initialized
     if (!fromUnit || !toUnit)
       throw std::runtime_error("EventList::convertUnitsViaTof(): one of the units is NULL!");
@@ -4160,6 +4653,7 @@ namespace DataObjects
    */
   void EventList::convertUnitsQuickly(const double& factor, const double& power)
   {
+    this->switchToRows();
     switch (eventType)
     {
     case TOF:
@@ -387,6 +387,24 @@ namespace DataObjects
   }
 
 
+  //-----------------------------------------------------------------------------
+  /** Switch the storage of all event lists between the usual vectors of
+   * events and separate tof/pulse time/weight/error arrays.
+   * See EventList::setColumnarStorage().
+   *
+   * @param columnar :: true for columnar storage
+   */
+  void EventWorkspace::setColumnarStorage(const bool columnar)
+  {
+    const int64_t numLists = static_cast<int64_t>(this->data.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numLists; ++i)
+    {
+      this->data[i]->setColumnarStorage(columnar);
+    }
+  }
+
+
   //-----------------------------------------------------------------------------
   /// Returns true always - an EventWorkspace always represents histogramm-able data
   /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -397,7 +415,6 @@ namespace DataObjects
 
   //-----------------------------------------------------------------------------
   /** Return how many entries in the Y MRU list are used.
-   * Only used in tests. It only returns the 0-th MRU list size.
    * @return :: number of entries in the MRU list.
    */
   size_t EventWorkspace::MRUSize() const
@@ -405,6 +422,15 @@ namespace DataObjects
     return mru->MRUSize();
   }
 
+  //-----------------------------------------------------------------------------
+  /** Returns the MRU of generated histograms, e.g. to look at its hit and miss counters.
+   * @return :: the MRU shared by the event lists of this workspace.
+   */
+  EventWorkspaceMRU * EventWorkspace::getMRU() const
+  {
+    return mru;
+  }
+
   //-----------------------------------------------------------------------------
   /** Clears the MRU lists */
   void EventWorkspace::clearMRU() const
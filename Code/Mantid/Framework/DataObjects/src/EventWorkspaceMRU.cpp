@@ -1,199 +1,285 @@
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/System.h"
 
 namespace Mantid
 {
 namespace DataObjects
 {
+  namespace
+  {
+    /// Number of Y (and of E) histograms cached per thread when the configuration does not say
+    const size_t DEFAULT_CAPACITY = 50;
+  }
 
+  //----------------------------------------------------------------------------------------------
+  /** Constructor of the cache of one thread
+   * @param capacity :: number of Y (and of E) histograms it can hold
+   */
+  EventWorkspaceMRU::ThreadCache::ThreadCache(size_t capacity)
+    : bufferedDataY(capacity), bufferedDataE(capacity), hits(0), misses(0)
+  {
+  }
 
   //----------------------------------------------------------------------------------------------
   /** Constructor
+   *
+   * @param capacity :: number of Y (and of E) histograms to cache for each thread. Default 0 = the
+   *        value of EventWorkspace.HistogramCacheSize in the configuration, or 50 if it is not set.
    */
-  EventWorkspaceMRU::EventWorkspaceMRU()
+  EventWorkspaceMRU::EventWorkspaceMRU(size_t capacity)
   {
+    if (capacity == 0)
+    {
+      int configured = 0;
+      if (Kernel::ConfigService::Instance().getValue("EventWorkspace.HistogramCacheSize", configured) && configured > 0)
+        capacity = static_cast<size_t>(configured);
+      else
+        capacity = DEFAULT_CAPACITY;
+    }
+    m_capacity = capacity;
+    size_t numThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+    if (numThreads == 0)
+      numThreads = 1;
+    m_caches.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; i++)
+      m_caches.push_back(new ThreadCache(m_capacity));
   }
-    
+
   //----------------------------------------------------------------------------------------------
   /** Destructor
    */
   EventWorkspaceMRU::~EventWorkspaceMRU()
   {
-    //Make sure you free up the memory in the MRUs
-    for (size_t i=0; i < m_bufferedDataY.size(); i++)
-      if (m_bufferedDataY[i])
-      {
-        m_bufferedDataY[i]->clear();
-        delete m_bufferedDataY[i];
-      };
-    m_bufferedDataY.clear();
-
-    for (size_t i=0; i < m_bufferedDataE.size(); i++)
-      if (m_bufferedDataE[i])
-      {
-        m_bufferedDataE[i]->clear();
-        delete m_bufferedDataE[i];
-      };
-    m_bufferedDataE.clear();
-
+    //Make sure you free up the memory in the MRUs. The event lists may be gone, so
+    // the locks of the dropped markers are not looked at.
+    for (size_t i=0; i < m_caches.size(); i++)
+    {
+      ThreadCache * cache = m_caches[i];
+      for (size_t j=0; j < cache->locked.size(); j++)
+        delete cache->locked[j];
+      delete cache;
+    }
+    m_caches.clear();
   }
-  
 
   //---------------------------------------------------------------------------
-  /** This function makes sure that there are enough data
-   * buffers (MRU's) for E for the number of threads requested.
-   * @param thread_num :: thread number that wants a MRU buffer
-   */
-  void EventWorkspaceMRU::ensureEnoughBuffersE(size_t thread_num) const
+  /// Clear all the data in the MRU buffers
+  void EventWorkspaceMRU::clear()
   {
-    Mutex::ScopedLock _lock(m_changeMruListsMutexE);
-    if (m_bufferedDataE.size() <= thread_num)
+    for (size_t i=0; i < m_caches.size(); i++)
     {
-      m_bufferedDataE.resize(thread_num+1, NULL);
-      for (size_t i=0; i < m_bufferedDataE.size(); i++)
-      {
-        if (!m_bufferedDataE[i])
-          m_bufferedDataE[i] = new mru_list(50); //Create a MRU list with this many entries.
+      ThreadCache & cache = *m_caches[i];
+      Mutex::ScopedLock _lock(cache.mutex);
+      cache.bufferedDataY.clear();
+      cache.bufferedDataE.clear();
 
+      std::vector<MantidVecWithMarker *> stillLocked;
+      for (size_t j=0; j < cache.locked.size(); j++)
+      {
+        if (cache.locked[j]->m_locked)
+          stillLocked.push_back(cache.locked[j]);
+        else
+          delete cache.locked[j];
       }
+      cache.locked.swap(stillLocked);
     }
   }
+
   //---------------------------------------------------------------------------
-  /** This function makes sure that there are enough data
-   * buffers (MRU's) for Y for the number of threads requested.
-   * @param thread_num :: thread number that wants a MRU buffer
+  /** Find a Y histogram in the MRU of the calling thread
+   *
+   * @param index :: index of the data to return
+   * @param x :: the X vector the histogram must have been made with
+   * @return pointer to the MantidVecWithMarker that has the data; NULL if not found.
    */
-  void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const
+  MantidVecWithMarker * EventWorkspaceMRU::findY(size_t index, const MantidVec * x)
   {
-    Mutex::ScopedLock _lock(m_changeMruListsMutexY);
-    if (m_bufferedDataY.size() <= thread_num)
-    {
-      m_bufferedDataY.resize(thread_num+1, NULL);
-      for (size_t i=0; i < m_bufferedDataY.size(); i++)
-      {
-        if (!m_bufferedDataY[i])
-          m_bufferedDataY[i] = new mru_list(50); //Create a MRU list with this many entries.
+    ThreadCache & cache = cacheOfThisThread();
+    return find(cache, cache.bufferedDataY, index, x);
+  }
 
-      }
+  /** Find an E histogram in the MRU of the calling thread
+   *
+   * @param index :: index of the data to return
+   * @param x :: the X vector the histogram must have been made with
+   * @return pointer to the MantidVecWithMarker that has the data; NULL if not found.
+   */
+  MantidVecWithMarker * EventWorkspaceMRU::findE(size_t index, const MantidVec * x)
+  {
+    ThreadCache & cache = cacheOfThisThread();
+    return find(cache, cache.bufferedDataE, index, x);
+  }
+
+  /** Insert a new Y histogram into the MRU of the calling thread. If the same
+   * histogram is already there, that one is kept and the new one deleted.
+   *
+   * @param data :: the new data. The MRU takes ownership of it.
+   * @return the marker now in the MRU for this index, to use instead of data.
+   */
+  MantidVecWithMarker * EventWorkspaceMRU::insertY(MantidVecWithMarker * data)
+  {
+    ThreadCache & cache = cacheOfThisThread();
+    return insert(cache, cache.bufferedDataY, data);
+  }
+
+  /** Insert a new E histogram into the MRU of the calling thread. If the same
+   * histogram is already there, that one is kept and the new one deleted.
+   *
+   * @param data :: the new data. The MRU takes ownership of it.
+   * @return the marker now in the MRU for this index, to use instead of data.
+   */
+  MantidVecWithMarker * EventWorkspaceMRU::insertE(MantidVecWithMarker * data)
+  {
+    ThreadCache & cache = cacheOfThisThread();
+    return insert(cache, cache.bufferedDataE, data);
+  }
+
+  /** Delete any entries in the MRUs of all the threads at the given index
+   *
+   * @param index :: index to delete.
+   */
+  void EventWorkspaceMRU::deleteIndex(size_t index)
+  {
+    for (size_t i=0; i < m_caches.size(); i++)
+    {
+      ThreadCache & cache = *m_caches[i];
+      Mutex::ScopedLock _lock(cache.mutex);
+      MantidVecWithMarker * data = cache.bufferedDataY.remove(index);
+      if (data) drop(cache, data);
+      data = cache.bufferedDataE.remove(index);
+      if (data) drop(cache, data);
     }
   }
 
   //---------------------------------------------------------------------------
-  /// Clear all the data in the MRU buffers
-  void EventWorkspaceMRU::clear()
+  /** Return how many entries in the Y MRU list are used.
+   * Only used in tests. It only returns the size of the list of thread 0.
+   * @return :: number of Y histograms in the cache of thread 0. */
+  size_t EventWorkspaceMRU::MRUSize() const
   {
-    Mutex::ScopedLock _lock(this->m_toDeleteMutex);
-
-    //FIXME: don't clear the locked ones!
-    for (size_t i=0; i<m_markersToDelete.size(); i++)
-      if (!m_markersToDelete[i]->m_locked)
-        delete m_markersToDelete[i];
-    m_markersToDelete.clear();
+    Mutex::ScopedLock _lock(m_caches[0]->mutex);
+    return m_caches[0]->bufferedDataY.size();
+  }
 
-    //Make sure you free up the memory in the MRUs
-    for (size_t i=0; i < m_bufferedDataY.size(); i++)
-      if (m_bufferedDataY[i])
-      {
-        m_bufferedDataY[i]->clear();
-      };
+  /// @return the number of Y (and of E) histograms the cache of each thread can hold
+  size_t EventWorkspaceMRU::capacity() const
+  {
+    return m_capacity;
+  }
 
+  /// @return the number of times a histogram was found in the cache, by all threads
+  size_t EventWorkspaceMRU::hits() const
+  {
+    size_t total = 0;
+    for (size_t i=0; i < m_caches.size(); i++)
+    {
+      Mutex::ScopedLock _lock(m_caches[i]->mutex);
+      total += m_caches[i]->hits;
+    }
+    return total;
+  }
 
-    for (size_t i=0; i < m_bufferedDataE.size(); i++)
-      if (m_bufferedDataE[i])
-      {
-        m_bufferedDataE[i]->clear();
-      };
+  /// @return the number of times a histogram was not found in the cache, by all threads
+  size_t EventWorkspaceMRU::misses() const
+  {
+    size_t total = 0;
+    for (size_t i=0; i < m_caches.size(); i++)
+    {
+      Mutex::ScopedLock _lock(m_caches[i]->mutex);
+      total += m_caches[i]->misses;
+    }
+    return total;
   }
 
-//---------------------------------------------------------------------------
-  /** Find a Y histogram in the MRU
-   *
-   * @param thread_num :: number of the thread in which this is run
-   * @param index :: index of the data to return
-   * @return pointer to the MantidVecWithMarker that has the data; NULL if not found.
-   */
-  MantidVecWithMarker * EventWorkspaceMRU::findY(size_t thread_num, size_t index)
+  /// Set the hit and miss counters back to zero
+  void EventWorkspaceMRU::resetCounters()
   {
-    Mutex::ScopedLock _lock(m_changeMruListsMutexY);
-    return m_bufferedDataY[thread_num]->find(index);
+    for (size_t i=0; i < m_caches.size(); i++)
+    {
+      Mutex::ScopedLock _lock(m_caches[i]->mutex);
+      m_caches[i]->hits = 0;
+      m_caches[i]->misses = 0;
+    }
   }
 
-  /** Find a Y histogram in the MRU
-   *
-   * @param thread_num :: number of the thread in which this is run
-   * @param index :: index of the data to return
-   * @return pointer to the MantidVecWithMarker that has the data; NULL if not found.
-   */
-  MantidVecWithMarker * EventWorkspaceMRU::findE(size_t thread_num, size_t index)
+  //---------------------------------------------------------------------------
+  /** @return the cache of the calling thread. Threads that are not OpenMP threads
+   * all get the cache of thread 0, whose lock keeps it consistent. */
+  EventWorkspaceMRU::ThreadCache & EventWorkspaceMRU::cacheOfThisThread() const
   {
-    Mutex::ScopedLock _lock(m_changeMruListsMutexE);
-    return m_bufferedDataE[thread_num]->find(index);
+    return *m_caches[static_cast<size_t>(PARALLEL_THREAD_NUMBER) % m_caches.size()];
   }
 
-  /** Insert a new histogram into the MRU
+  /** Look for a histogram in one of the lists of a cache. An entry made with
+   * another X vector is out of date and is dropped.
    *
-   * @param thread_num :: thread being accessed
-   * @param data :: the new data
-   * @return a MantidVecWithMarker * that needs to be deleted, or NULL if nothing needs to be deleted.
+   * @param cache :: cache of the thread
+   * @param list :: Y or E list of the cache
+   * @param index :: index of the data to return
+   * @param x :: the X vector the histogram must have been made with
+   * @return the marker with the data; NULL if not found.
    */
-  void EventWorkspaceMRU::insertY(size_t thread_num, MantidVecWithMarker * data)
+  MantidVecWithMarker * EventWorkspaceMRU::find(ThreadCache & cache, mru_list & list, size_t index, const MantidVec * x)
   {
-    Mutex::ScopedLock _lock(m_changeMruListsMutexY);
-    MantidVecWithMarker * oldData = m_bufferedDataY[thread_num]->insert(data);
-    //And clear up the memory of the old one, if it is dropping out.
-    if (oldData)
+    Mutex::ScopedLock _lock(cache.mutex);
+    MantidVecWithMarker * data = list.find(index);
+    if (data && data->m_x != x)
     {
-      if (oldData->m_locked)
-      {
-        Mutex::ScopedLock _lock(this->m_toDeleteMutex);
-        m_markersToDelete.push_back(oldData);
-      }
-      else
-        delete oldData;
+      drop(cache, list.remove(index));
+      data = NULL;
+    }
+    if (data)
+    {
+      // Move it to the front of the list
+      list.insert(data);
+      cache.hits++;
     }
+    else
+      cache.misses++;
+    return data;
   }
 
-  /** Insert a new histogram into the MRU
+  /** Put a histogram in one of the lists of a cache, dropping the one that falls out.
    *
-   * @param thread_num :: thread being accessed
+   * @param cache :: cache of the thread
+   * @param list :: Y or E list of the cache
    * @param data :: the new data
-   * @return a MantidVecWithMarker * that needs to be deleted, or NULL if nothing needs to be deleted.
+   * @return the marker now in the list for this index
    */
-  void EventWorkspaceMRU::insertE(size_t thread_num, MantidVecWithMarker * data)
+  MantidVecWithMarker * EventWorkspaceMRU::insert(ThreadCache & cache, mru_list & list, MantidVecWithMarker * data)
   {
-    Mutex::ScopedLock _lock(m_changeMruListsMutexE);
-    MantidVecWithMarker * oldData = m_bufferedDataE[thread_num]->insert(data);
-    //And clear up the memory of the old one, if it is dropping out.
-    if (oldData)
+    Mutex::ScopedLock _lock(cache.mutex);
+    MantidVecWithMarker * existing = list.find(data->m_index);
+    if (existing)
     {
-      if (oldData->m_locked)
+      if (existing->m_x == data->m_x)
       {
-        Mutex::ScopedLock _lock(this->m_toDeleteMutex);
-        m_markersToDelete.push_back(oldData);
+        delete data;
+        return existing;
       }
-      else
-        delete oldData;
+      drop(cache, list.remove(data->m_index));
     }
+    MantidVecWithMarker * oldData = list.insert(data);
+    if (oldData)
+      drop(cache, oldData);
+    return data;
   }
 
-
-  /** Delete any entries in the MRU at the given index
+  /** Delete a marker that is out of the lists, or keep it until clear() if its
+   * EventList is locked. The cache must be locked by the caller.
    *
-   * @param index :: index to delete.
+   * @param cache :: the cache the marker was in
+   * @param data :: the marker
    */
-  void EventWorkspaceMRU::deleteIndex(size_t index)
+  void EventWorkspaceMRU::drop(ThreadCache & cache, MantidVecWithMarker * data)
   {
-    Mutex::ScopedLock _lock1(m_changeMruListsMutexE);
-    for (size_t i=0; i < m_bufferedDataE.size(); i++)
-      if (m_bufferedDataE[i])
-        m_bufferedDataE[i]->deleteIndex(index);
-    Mutex::ScopedLock _lock2(m_changeMruListsMutexY);
-    for (size_t i=0; i < m_bufferedDataY.size(); i++)
-      if (m_bufferedDataY[i])
-        m_bufferedDataY[i]->deleteIndex(index);
+    if (data->m_locked)
+      cache.locked.push_back(data);
+    else
+      delete data;
   }
 
 
 } // namespace Mantid
 } // namespace DataObjects
-
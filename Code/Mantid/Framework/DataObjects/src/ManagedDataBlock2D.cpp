@@ -6,6 +6,7 @@
 #include "MantidDataObjects/ManagedDataBlock2D.h"
 #include "MantidDataObjects/ManagedHistogram1D.h"
 #include "MantidKernel/Exception.h"
+#include <algorithm>
 #include <iostream>
 
 using Mantid::API::ISpectrum;
@@ -141,6 +142,64 @@ void ManagedDataBlock2D::releaseData()
 
 
 
+/** Fill the block from memory holding the vectors in the same layout as
+ *  the file written by operator<<: X, Y then E of each spectrum in turn.
+ *  @param source :: start of the data of this block
+ */
+void ManagedDataBlock2D::readFromMemory(const double * source)
+{
+  for (std::vector<ManagedHistogram1D*>::iterator iter = m_data.begin(); iter != m_data.end(); ++iter)
+  {
+    ManagedHistogram1D * it = *iter;
+    it->directDataX().assign(source, source + m_XLength);
+    source += m_XLength;
+    it->directDataY().assign(source, source + m_YLength);
+    source += m_YLength;
+    it->directDataE().assign(source, source + m_YLength);
+    source += m_YLength;
+    // Yes, it is loaded
+    it->setLoaded(true);
+  }
+  m_loaded = true;
+}
+
+/** Copy the block to memory, in the layout read by readFromMemory().
+ *  @param destination :: start of the data of this block
+ */
+void ManagedDataBlock2D::writeToMemory(double * destination)
+{
+  for (std::vector<ManagedHistogram1D*>::iterator iter = m_data.begin(); iter != m_data.end(); ++iter)
+  {
+    ManagedHistogram1D * it = *iter;
+    // If anyone's gone and changed the size of the vectors then get them back to the
+    // correct size, removing elements or adding zeroes as appropriate.
+    if (it->directDataX().size() != m_XLength)
+    {
+      it->directDataX().resize(m_XLength, 0.0);
+      g_log.warning() << "X vector resized to " << m_XLength << " elements.";
+    }
+    std::copy(it->directDataX().begin(), it->directDataX().end(), destination);
+    destination += m_XLength;
+    if (it->directDataY().size() != m_YLength)
+    {
+      it->directDataY().resize(m_YLength, 0.0);
+      g_log.warning() << "Y vector resized to " << m_YLength << " elements.";
+    }
+    std::copy(it->directDataY().begin(), it->directDataY().end(), destination);
+    destination += m_YLength;
+    if (it->directDataE().size() != m_YLength)
+    {
+      it->directDataE().resize(m_YLength, 0.0);
+      g_log.warning() << "E vector resized to " << m_YLength << " elements.";
+    }
+    std::copy(it->directDataE().begin(), it->directDataE().end(), destination);
+    destination += m_YLength;
+
+    // Clear the "dirty" flag since it was just written out.
+    it->setDirty(false);
+  }
+}
+
 /** Output file stream operator.
  *  @param fs :: The stream to write to
  *  @param data :: The object to write to file
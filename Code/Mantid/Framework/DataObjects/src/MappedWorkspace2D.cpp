@@ -0,0 +1,163 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidDataObjects/MappedWorkspace2D.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include <Poco/File.h>
+#include <Poco/SharedMemory.h>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace Mantid
+{
+namespace DataObjects
+{
+
+  namespace
+  {
+    /// static logger
+    Kernel::Logger g_log("MappedWorkspace2D");
+  }
+
+using std::size_t;
+
+DECLARE_WORKSPACE(MappedWorkspace2D)
+
+// Initialise the instance count
+int MappedWorkspace2D::g_uniqueID = 1;
+
+/// Constructor
+MappedWorkspace2D::MappedWorkspace2D() :
+  AbsManagedWorkspace2D(), m_mapping(NULL)
+{
+}
+
+//------------------------------------------------------------------------------------------------------
+/** Sets the size of the workspace, creates the temporary file and maps it
+ *  @param NVectors :: The number of vectors/histograms/detectors in the workspace
+ *  @param XLength :: The number of X data points/bin boundaries in each vector (must all be the same)
+ *  @param YLength :: The number of data/error points in each vector (must all be the same)
+ *  @throw std::runtime_error if unable to create or map the temporary file
+ */
+void MappedWorkspace2D::init(const std::size_t &NVectors, const std::size_t &XLength, const std::size_t &YLength)
+{
+  AbsManagedWorkspace2D::init(NVectors,XLength,YLength);
+
+  m_vectorSize = ( m_XLength + ( 2*m_YLength ) ) * sizeof(double);
+
+  // Get memory size of a block from config file
+  int blockMemory;
+  if ( ! Kernel::ConfigService::Instance().getValue("ManagedWorkspace.DataBlockSize", blockMemory)
+      || blockMemory <= 0 )
+  {
+    // default to 1MB if property not found
+    blockMemory = 1024*1024;
+  }
+  m_vectorsPerBlock = blockMemory / static_cast<int>(m_vectorSize);
+  // Should this ever come out to be zero, then actually set it to 1
+  if ( m_vectorsPerBlock == 0 ) m_vectorsPerBlock = 1;
+
+  // Create all the blocks
+  this->initBlocks();
+
+  // The whole workspace must fit in the address space
+  const double fileSize = static_cast<double>(m_vectorSize) * static_cast<double>(m_noVectors);
+  if ( fileSize > static_cast<double>(std::numeric_limits<size_t>::max()) )
+  {
+    throw std::runtime_error("MappedWorkspace2D: The workspace is too large to be mapped into memory");
+  }
+
+  // Look for the (optional) path from the configuration file
+  std::string path = Kernel::ConfigService::Instance().getString("ManagedWorkspace.FilePath");
+  if( path.empty() || !Poco::File(path).exists() || !Poco::File(path).canWrite() )
+  {
+    path = Kernel::ConfigService::Instance().getUserPropertiesDir();
+  }
+  // Append a slash if necessary
+  if( ( *(path.rbegin()) != '/' ) && ( *(path.rbegin()) != '\\' ) )
+  {
+    path.push_back('/');
+  }
+
+  std::stringstream filestem;
+  filestem << "WS2DMapped" << MappedWorkspace2D::g_uniqueID;
+  // Increment the instance count
+  ++MappedWorkspace2D::g_uniqueID;
+  m_filename = path + filestem.str() + this->getTitle() + ".tmp";
+  g_log.debug() << "Temporary file mapped from " << m_filename << std::endl;
+
+  try
+  {
+    // Create the file, sparse, at its full size
+    {
+      std::ofstream create(m_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if ( ! create )
+        throw std::runtime_error("Unable to create the file");
+    }
+    Poco::File file(m_filename);
+    file.setSize(static_cast<Poco::File::FileSize>(fileSize));
+    m_mapping = new Poco::SharedMemory(file, Poco::SharedMemory::AM_WRITE);
+  }
+  catch (std::exception & e)
+  {
+    g_log.error() << "Unable to map temporary data file " << m_filename << ": " << e.what() << std::endl;
+    throw std::runtime_error("MappedWorkspace2D: Unable to map temporary data file");
+  }
+}
+
+/// Destructor. Unmaps and deletes the temporary file.
+MappedWorkspace2D::~MappedWorkspace2D()
+{
+  delete m_mapping;
+  if ( !m_filename.empty() )
+    remove(m_filename.c_str());
+}
+
+/** @return the address of the data of a block in the mapping
+ *  @param startIndex :: Starting spectrum index in the block
+ */
+double * MappedWorkspace2D::blockAddress(std::size_t startIndex) const
+{
+  return reinterpret_cast<double *>(m_mapping->begin() + startIndex * m_vectorSize);
+}
+
+/**  Copies the ManagedDataBlock2D with given startIndex from the mapping,
+     if it is not in memory already. Blocks never written read as zeroes.
+     @param newBlock :: Returned data block address
+     @param startIndex :: Starting spectrum index in the block
+*/
+void MappedWorkspace2D::readDataBlock(ManagedDataBlock2D *newBlock,std::size_t startIndex)const
+{
+  if (!newBlock->isLoaded())
+  {
+    newBlock->readFromMemory(blockAddress(startIndex));
+  }
+}
+
+/**
+ * Copy a data block to the mapping. The operating system writes it to disk when it needs to.
+ * @param toWrite :: pointer to the ManagedDataBlock2D to write.
+ */
+void MappedWorkspace2D::writeDataBlock(ManagedDataBlock2D *toWrite) const
+{
+  toWrite->writeToMemory(blockAddress(static_cast<size_t>(toWrite->minIndex())));
+}
+
+/** Returns the number of histograms.
+ *  @return the number of histograms associated with the workspace
+ */
+size_t MappedWorkspace2D::getHistogramNumberHelper() const
+{
+  return m_noVectors;
+}
+
+/// Return the size used in memory by the blocks in the MRU list. The mapped pages are not counted.
+size_t MappedWorkspace2D::getMemorySize() const
+{
+  return size_t(m_vectorSize)*size_t(m_bufferedMarkers.size())*size_t(m_vectorsPerBlock);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,168 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidDataObjects/EventColumns.h"
+#include <cmath>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+class EventColumnsTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite( EventColumnsTest *suite ) { delete suite; }
+
+  void test_assign_and_extract_TofEvents()
+  {
+    std::vector<TofEvent> events = makeEvents();
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT_EQUALS( columns.getEventType(), TOF );
+    TS_ASSERT_EQUALS( columns.size(), 4 );
+    TS_ASSERT_EQUALS( columns.pulseTimes().size(), 4 );
+    TS_ASSERT( columns.weights().empty() );
+
+    std::vector<TofEvent> out;
+    columns.extract(out);
+    TS_ASSERT_EQUALS( out, events );
+    std::vector<WeightedEvent> wrongType;
+    TS_ASSERT_THROWS( columns.extract(wrongType), std::runtime_error );
+  }
+
+  void test_assign_and_extract_WeightedEventNoTime()
+  {
+    std::vector<WeightedEventNoTime> events;
+    events.push_back(WeightedEventNoTime(5.0, 2.0, 4.0));
+    events.push_back(WeightedEventNoTime(1.0, 3.0, 9.0));
+    EventColumns columns;
+    columns.assign(events);
+    TS_ASSERT_EQUALS( columns.getEventType(), WEIGHTED_NOTIME );
+    TS_ASSERT( columns.pulseTimes().empty() );
+    TS_ASSERT_EQUALS( columns.weights().size(), 2 );
+
+    std::vector<WeightedEventNoTime> out;
+    columns.extract(out);
+    TS_ASSERT_EQUALS( out, events );
+  }
+
+  void test_sortTof_keeps_columns_together()
+  {
+    EventColumns columns;
+    columns.assign(makeWeightedEvents());
+    columns.sortTof();
+    const std::vector<double> & tofs = columns.tofs();
+    TS_ASSERT_EQUALS( tofs[0], 1.0 );
+    TS_ASSERT_EQUALS( tofs[3], 40.0 );
+    // The weight of each event was set to its tof / 10
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      TS_ASSERT_DELTA( columns.weights()[i], tofs[i] / 10., 1e-6 );
+      TS_ASSERT_EQUALS( columns.pulseTimes()[i], static_cast<int64_t>(tofs[i]) );
+    }
+  }
+
+  void test_histogram_counts()
+  {
+    EventColumns columns;
+    columns.assign(makeEvents());
+    columns.sortTof();
+
+    MantidVec X, Y, E;
+    X.push_back(0); X.push_back(10); X.push_back(20); X.push_back(30);
+    columns.histogram(X, Y, E, false);
+    TS_ASSERT_EQUALS( Y.size(), 3 );
+    TS_ASSERT_EQUALS( Y[0], 1 );
+    TS_ASSERT_EQUALS( Y[1], 2 ); // 10 is in the second bin
+    TS_ASSERT_EQUALS( Y[2], 0 ); // 40 is beyond the last boundary
+    TS_ASSERT_DELTA( E[1], std::sqrt(2.0), 1e-10 );
+  }
+
+  void test_histogram_counts_more_bins_than_events()
+  {
+    EventColumns columns;
+    columns.assign(makeEvents());
+    columns.sortTof();
+
+    MantidVec X, Y, E;
+    for (double x = 0; x <= 50; x += 0.5)
+      X.push_back(x);
+    columns.histogram(X, Y, E, true);
+    TS_ASSERT_EQUALS( Y.size(), 100 );
+    TS_ASSERT_EQUALS( Y[2], 1 );  // tof 1.0
+    TS_ASSERT_EQUALS( Y[20], 1 ); // tof 10.0
+    TS_ASSERT_EQUALS( Y[30], 1 ); // tof 15.0
+    TS_ASSERT_EQUALS( Y[80], 1 ); // tof 40.0
+  }
+
+  void test_histogram_weights()
+  {
+    EventColumns columns;
+    columns.assign(makeWeightedEvents());
+    columns.sortTof();
+
+    MantidVec X, Y, E;
+    X.push_back(0); X.push_back(20); X.push_back(50);
+    columns.histogram(X, Y, E, false);
+    TS_ASSERT_DELTA( Y[0], 0.1 + 1.0 + 1.5, 1e-6 );
+    TS_ASSERT_DELTA( Y[1], 4.0, 1e-6 );
+    TS_ASSERT_DELTA( E[1], 4.0, 1e-6 );
+  }
+
+  void test_convertTof_maskTof_integrate()
+  {
+    EventColumns columns;
+    columns.assign(makeEvents());
+    columns.sortTof();
+    columns.convertTof(2.0, 1.0);
+    TS_ASSERT_EQUALS( columns.getTofMin(true), 3.0 );
+    TS_ASSERT_EQUALS( columns.getTofMax(false), 81.0 );
+
+    double sum, error;
+    columns.integrate(0, 31.0, false, sum, error);
+    TS_ASSERT_EQUALS( sum, 3.0 );
+    TS_ASSERT_DELTA( error, std::sqrt(3.0), 1e-10 );
+
+    TS_ASSERT_EQUALS( columns.maskTof(20.0, 31.0), 2 );
+    TS_ASSERT_EQUALS( columns.size(), 2 );
+    TS_ASSERT_EQUALS( columns.pulseTimes().size(), 2 );
+    TS_ASSERT_EQUALS( columns.tofs()[1], 81.0 );
+  }
+
+  void test_clear()
+  {
+    EventColumns columns;
+    columns.assign(makeWeightedEvents());
+    columns.clear();
+    TS_ASSERT( columns.empty() );
+    TS_ASSERT_EQUALS( columns.getMemorySize(), 0 );
+    TS_ASSERT_EQUALS( columns.getEventType(), WEIGHTED );
+  }
+
+private:
+  std::vector<TofEvent> makeEvents()
+  {
+    std::vector<TofEvent> events;
+    events.push_back(TofEvent(15.0, 100));
+    events.push_back(TofEvent(1.0, 200));
+    events.push_back(TofEvent(40.0, 300));
+    events.push_back(TofEvent(10.0, 400));
+    return events;
+  }
+
+  std::vector<WeightedEvent> makeWeightedEvents()
+  {
+    std::vector<WeightedEvent> events;
+    const double tofs[4] = {15.0, 1.0, 40.0, 10.0};
+    for (size_t i = 0; i < 4; ++i)
+      events.push_back(WeightedEvent(tofs[i], static_cast<int64_t>(tofs[i]), tofs[i] / 10., tofs[i] * tofs[i] / 100.));
+    return events;
+  }
+};
+
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_ */
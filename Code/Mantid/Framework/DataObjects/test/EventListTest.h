@@ -8,6 +8,7 @@
 #include <cmath>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/VectorHelper.h"
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -199,6 +200,64 @@ public:
     TS_ASSERT( !el2.hasDetectorID(0) );
   }
 
+  void test_takeEvents()
+  {
+    EventList accum;
+    EventList chunk;
+    chunk.addDetectorID( 3 );
+    chunk += TofEvent(10, 0);
+    chunk += TofEvent(30, 0);
+    chunk.sortTof();
+
+    // Taking the events of a sorted list into an empty one keeps the order
+    accum.takeEvents(chunk);
+    TS_ASSERT_EQUALS( accum.getNumberEvents(), 2 );
+    TS_ASSERT_EQUALS( chunk.getNumberEvents(), 0 );
+    TS_ASSERT( accum.isSortedByTof() );
+    TS_ASSERT( accum.hasDetectorID(3) );
+
+    // Sorted events are merged
+    chunk.addDetectorID( 4 );
+    chunk += TofEvent(5, 0);
+    chunk += TofEvent(20, 0);
+    chunk += TofEvent(40, 0);
+    chunk.sortTof();
+    accum.takeEvents(chunk);
+    TS_ASSERT_EQUALS( chunk.getNumberEvents(), 0 );
+    TS_ASSERT( accum.isSortedByTof() );
+    const vector<TofEvent> & events = accum.getEvents();
+    TS_ASSERT_EQUALS( events.size(), 5 );
+    for (size_t i = 0; i < events.size(); ++i)
+      TS_ASSERT_EQUALS( events[i].tof(), i == 0 ? 5 : 10.0 * static_cast<double>(i) );
+    TS_ASSERT_EQUALS( accum.getDetectorIDs().size(), 2 );
+
+    // An empty chunk, sorted or not, changes neither the events nor the order
+    EventList empty;
+    empty.sortTof();
+    accum.takeEvents(empty);
+    TS_ASSERT_EQUALS( accum.getNumberEvents(), 5 );
+    TS_ASSERT( accum.isSortedByTof() );
+    TS_ASSERT_EQUALS( accum.getEvents().back().tof(), 40 );
+    EventList unsortedEmpty;
+    accum.takeEvents(unsortedEmpty);
+    TS_ASSERT_EQUALS( accum.getNumberEvents(), 5 );
+    TS_ASSERT( accum.isSortedByTof() );
+
+    // Unsorted events are appended
+    chunk += TofEvent(1, 0);
+    accum.takeEvents(chunk);
+    TS_ASSERT( !accum.isSortedByTof() );
+    TS_ASSERT_EQUALS( accum.getEvents().back().tof(), 1 );
+
+    // Weighted events are converted
+    EventList weighted;
+    weighted += WeightedEvent(50, 0, 2.0, 4.0);
+    accum.takeEvents(weighted);
+    TS_ASSERT_EQUALS( accum.getEventType(), WEIGHTED );
+    TS_ASSERT_EQUALS( accum.getNumberEvents(), 7 );
+    TS_ASSERT_EQUALS( weighted.getNumberEvents(), 0 );
+  }
+
 
   //==================================================================================
   //--- Switching to Weighted Events ----
@@ -1566,6 +1625,82 @@ public:
 
 
 
+  //-----------------------------------------------------------------------------------------------
+  void test_splitByPulseTime_withTimeSplitterIndex()
+  {
+    this->fake_uniform_time_data();
+
+    TimeSplitterType split;
+    split.push_back( SplittingInterval(500, 600, 2) );
+    split.push_back( SplittingInterval(100, 200, 2) );
+    split.push_back( SplittingInterval(300, 400, 5) );
+    TimeSplitterIndex index(split);
+    TS_ASSERT_EQUALS( index.getNumberOfOutputs(), 3 );
+
+    EventList unfiltered, out2, out5;
+    std::vector<EventList *> outputs;
+    outputs.push_back(&unfiltered);
+    outputs.push_back(&out2);
+    outputs.push_back(&out5);
+    el.splitByPulseTime(index, outputs);
+
+    // 0-99, 200-299 and 400-499 are outside of the intervals; 600 and after are thrown out.
+    TS_ASSERT_EQUALS( unfiltered.getNumberEvents(), 300 );
+    TS_ASSERT_EQUALS( out2.getNumberEvents(), 200 );
+    TS_ASSERT_EQUALS( out5.getNumberEvents(), 100 );
+    TS_ASSERT_EQUALS( out2.getEvent(0).pulseTime(), 100 );
+    TS_ASSERT_EQUALS( out2.getEvent(100).pulseTime(), 500 );
+    TS_ASSERT_EQUALS( out5.getEvent(99).pulseTime(), 399 );
+    TS_ASSERT_EQUALS( unfiltered.getEvent(299).pulseTime(), 499 );
+
+    // One output per output of the splitter is needed
+    outputs.pop_back();
+    TS_ASSERT_THROWS( el.splitByPulseTime(index, outputs), std::invalid_argument );
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  void test_splitByFullTime_withTimeSplitterIndex_unsortedEvents()
+  {
+    el = EventList();
+    // Full times of 500, 100, 300 and 0 ns
+    el += TofEvent(0.5, 0);
+    el += TofEvent(0.1, 0);
+    el += TofEvent(0.3, 0);
+    el += TofEvent(0.0, 0);
+    el.switchTo(WEIGHTED);
+
+    TimeSplitterType split;
+    split.push_back( SplittingInterval(100, 200, 0) );
+    split.push_back( SplittingInterval(200, 400, 1) );
+    TimeSplitterIndex index(split);
+
+    EventList unfiltered, out0, out1;
+    std::vector<EventList *> outputs;
+    outputs.push_back(&unfiltered);
+    outputs.push_back(&out0);
+    outputs.push_back(&out1);
+    el.splitByFullTime(index, outputs, 1.0, false);
+
+    TS_ASSERT_EQUALS( unfiltered.getNumberEvents(), 1 );
+    TS_ASSERT_EQUALS( out0.getNumberEvents(), 1 );
+    TS_ASSERT_EQUALS( out1.getNumberEvents(), 1 );
+    TS_ASSERT_DELTA( out0.getEvent(0).tof(), 0.1, 1e-9 );
+    TS_ASSERT_DELTA( out1.getEvent(0).tof(), 0.3, 1e-9 );
+    TS_ASSERT_EQUALS( out1.getEventType(), WEIGHTED );
+    // The input was not sorted, so neither are the outputs
+    TS_ASSERT( !out1.isSortedByTof() );
+
+    // With the TOF correction, the times are 1000, 200, 600 and 0 ns
+    el.splitByFullTime(index, outputs, 2.0, true);
+    TS_ASSERT_EQUALS( unfiltered.getNumberEvents(), 1 );
+    TS_ASSERT_EQUALS( out0.getNumberEvents(), 0 );
+    TS_ASSERT_EQUALS( out1.getNumberEvents(), 1 );
+    TS_ASSERT_DELTA( out1.getEvent(0).tof(), 0.1, 1e-9 );
+
+    el.switchTo(WEIGHTED_NOTIME);
+    TS_ASSERT_THROWS( el.splitByFullTime(index, outputs, 1.0, false), std::runtime_error );
+  }
+
   //-----------------------------------------------------------------------------------------------
   void do_testSplit_FilterInPlace(bool weighted)
   {
@@ -1851,6 +1986,135 @@ public:
 
   }
 
+  /// Linear and logarithmic bins are computed for each event, without sorting the list first.
+  void test_histogram_direct_bins_unsorted_allTypes()
+  {
+    std::vector<double> params;
+    params.push_back(10.0); params.push_back(-0.001); params.push_back(1e7);
+    MantidVec logX;
+    VectorHelper::createAxisFromRebinParams(params, logX);
+
+    for (int this_type=0; this_type<3; this_type++)
+    {
+      for (int columnar=0; columnar<2; columnar++)
+      {
+        this->fake_data();
+        el.switchTo(static_cast<EventType>(this_type));
+        el.setColumnarStorage(columnar != 0);
+        checkDirectHistogram(this->makeX(BIN_DELTA, NUMBINS));
+        checkDirectHistogram(logX);
+        TS_ASSERT( !el.isSortedByTof() );
+      }
+    }
+  }
+
+  //==================================================================================
+  //--- Columnar storage ----
+  //==================================================================================
+
+  void test_columnarStorage_histogram_matches_rows_allTypes()
+  {
+    for (int this_type=0; this_type<3; this_type++)
+    {
+      EventType curType = static_cast<EventType>(this_type);
+      this->fake_data();
+      el.switchTo(curType);
+      EventList columnar(el);
+      columnar.setColumnarStorage(true);
+      TS_ASSERT( columnar.isColumnarStorage() );
+      TS_ASSERT( !el.isColumnarStorage() );
+      TS_ASSERT_EQUALS( columnar.getNumberEvents(), el.getNumberEvents() );
+      TS_ASSERT_EQUALS( columnar.getEventType(), curType );
+
+      MantidVec X = this->makeX(BIN_DELTA, NUMBINS), Y, E, Ycol, Ecol;
+      el.generateHistogram(X, Y, E);
+      columnar.generateHistogram(X, Ycol, Ecol);
+      TS_ASSERT( columnar.isColumnarStorage() );
+      TS_ASSERT_EQUALS( Ycol.size(), Y.size() );
+      for (size_t i=0; i<Y.size(); i++)
+      {
+        TS_ASSERT_DELTA( Ycol[i], Y[i], 1e-6 );
+        TS_ASSERT_DELTA( Ecol[i], E[i], 1e-6 );
+      }
+    }
+  }
+
+  void test_columnarStorage_convertTof_maskTof_integrate()
+  {
+    this->fake_uniform_data();
+    EventList columnar(el);
+    columnar.setColumnarStorage(true);
+
+    el.convertTof(2.5, 1.0);
+    columnar.convertTof(2.5, 1.0);
+    TS_ASSERT_DELTA( columnar.getTofMin(), el.getTofMin(), 1e-6 );
+    TS_ASSERT_DELTA( columnar.getTofMax(), el.getTofMax(), 1e-6 );
+
+    el.maskTof(1e6, 2e6);
+    columnar.maskTof(1e6, 2e6);
+    TS_ASSERT_EQUALS( columnar.getNumberEvents(), el.getNumberEvents() );
+    TS_ASSERT_DELTA( columnar.integrate(3e6, 5e6, false), el.integrate(3e6, 5e6, false), 1e-6 );
+    TS_ASSERT_DELTA( columnar.integrate(0, 0, true), el.integrate(0, 0, true), 1e-6 );
+    TS_ASSERT( columnar.isColumnarStorage() );
+
+    std::vector<double> tofs = columnar.getTofs();
+    TS_ASSERT_EQUALS( tofs, el.getTofs() );
+  }
+
+  void test_columnarStorage_other_operations_switch_back_to_rows()
+  {
+    this->fake_uniform_data_weights();
+    EventList columnar(el);
+    columnar.setColumnarStorage(true);
+    TS_ASSERT_EQUALS( columnar.getWeights(), el.getWeights() );
+    TS_ASSERT_EQUALS( columnar.getWeightErrors(), el.getWeightErrors() );
+
+    // Multiplying has no columnar implementation
+    columnar *= 2.0;
+    el *= 2.0;
+    TS_ASSERT( !columnar.isColumnarStorage() );
+    TS_ASSERT( columnar == el );
+
+    // Going back and forth keeps all the event information
+    columnar.setColumnarStorage(true);
+    columnar.setColumnarStorage(false);
+    TS_ASSERT( columnar == el );
+    TS_ASSERT_EQUALS( columnar.getWeightedEvents()[0].pulseTime(), el.getWeightedEvents()[0].pulseTime() );
+  }
+
+  void test_columnarStorage_addEventQuickly_switches_back_to_rows()
+  {
+    this->fake_data();
+    el.setColumnarStorage(true);
+    el.addEventQuickly(TofEvent(123.0, 456));
+    TS_ASSERT( !el.isColumnarStorage() );
+    TS_ASSERT_EQUALS( el.getNumberEvents(), NUMEVENTS+1 );
+    TS_ASSERT_EQUALS( el.getEvents().back().tof(), 123.0 );
+  }
+
+  /** Histogram el with the given direct (linear/log) X, and compare with a
+   * histogram done by searching: an extra, narrower bin is added in front of X
+   * so that the bins are no longer regular.
+   */
+  void checkDirectHistogram(const MantidVec & X)
+  {
+    MantidVec Y, E;
+    el.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS( Y.size(), X.size()-1 );
+
+    MantidVec searchX(X);
+    searchX.insert(searchX.begin(), X[0] - 0.3*(X[1]-X[0]));
+    EventList copy(el);
+    MantidVec Ysearch, Esearch;
+    copy.generateHistogram(searchX, Ysearch, Esearch);
+    TS_ASSERT( copy.isSortedByTof() );
+    for (size_t i=0; i<Y.size(); i++)
+    {
+      TS_ASSERT_DELTA( Y[i], Ysearch[i+1], 1e-6 );
+      TS_ASSERT_DELTA( E[i], Esearch[i+1], 1e-6 );
+    }
+  }
+
   //==================================================================================
   // Mocking functions
   //==================================================================================
@@ -2021,10 +2285,15 @@ public:
     // Coarse vector, 1000 bins.
     for (double i=0; i < 100000; i += 100)
       coarseX.push_back(i);
+    // The fine bins, moved a little so they are no longer regular
+    fineArbitraryX = fineX;
+    for (size_t i=1; i+1 < fineArbitraryX.size(); i++)
+      fineArbitraryX[i] += 1e-3 * static_cast<double>(i % 7);
   }
 
   EventList el_random, el_random_source, el_sorted, el_sorted_original, el_sorted_weighted, el4, el5;
   MantidVec fineX;
+  MantidVec fineArbitraryX;
   MantidVec coarseX;
 
   void setUp()
@@ -2105,6 +2374,59 @@ public:
     el_sorted_weighted.generateHistogram(coarseX, Y, E);
   }
 
+  /// Linear bins on unsorted events: the bin of each event is computed, no sorting
+  void test_histogram_random_linear()
+  {
+    MantidVec Y, E;
+    el_random.generateHistogram(fineX, Y, E);
+  }
+
+  /// The same bins slightly moved, so the events must be sorted and searched
+  void test_histogram_random_arbitrary()
+  {
+    MantidVec Y, E;
+    el_random.generateHistogram(fineArbitraryX, Y, E);
+  }
+
+  void test_histogram_random_linear_columnar()
+  {
+    MantidVec Y, E;
+    el_random.setColumnarStorage(true);
+    el_random.generateHistogram(fineX, Y, E);
+  }
+
+  void test_histogram_fine_arbitrary()
+  {
+    MantidVec Y, E;
+    el_sorted.generateHistogram(fineArbitraryX, Y, E);
+  }
+
+  void test_histogram_fine_columnar()
+  {
+    MantidVec Y, E;
+    el_sorted.setColumnarStorage(true);
+    el_sorted.generateHistogram(fineX, Y, E);
+  }
+
+  void test_histogram_coarse_columnar()
+  {
+    MantidVec Y, E;
+    el_sorted.setColumnarStorage(true);
+    el_sorted.generateHistogram(coarseX, Y, E);
+  }
+
+  void test_convertTof_columnar()
+  {
+    el_random.setColumnarStorage(true);
+    el_random.convertTof(2.5, 6.78);
+  }
+
+  void test_sort_tof_columnar()
+  {
+    el_random.setColumnarStorage(true);
+    el_random.sortTof();
+  }
+
   void test_maskTof()
   {
     TS_ASSERT_EQUALS(el_sorted.getNumberEvents(), 10000000);
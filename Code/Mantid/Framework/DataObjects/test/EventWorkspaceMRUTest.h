@@ -9,6 +9,7 @@
 
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 
+using namespace Mantid;
 using namespace Mantid::DataObjects;
 
 
@@ -16,13 +17,131 @@ class EventWorkspaceMRUTest : public CxxTest::TestSuite
 {
 public:
 
-  void test_Something()
+  void test_one_cache_per_thread()
   {
+    EventWorkspaceMRU mru(10);
+    TS_ASSERT_EQUALS( mru.numThreadCaches(), size_t(PARALLEL_GET_MAX_THREADS) );
+    TS_ASSERT_EQUALS( mru.capacity(), 10 );
+    TS_ASSERT_EQUALS( mru.MRUSize(), 0 );
   }
 
+  void test_find_and_insert()
+  {
+    EventWorkspaceMRU mru(8);
+    MantidVec x(3, 1.0);
+    bool locked = false;
+    TS_ASSERT( !mru.findY(5, &x) );
+    MantidVecWithMarker * data = new MantidVecWithMarker(5, locked, &x);
+    data->m_data.assign(2, 3.0);
+    TS_ASSERT_EQUALS( mru.insertY(data), data );
+    TS_ASSERT_EQUALS( mru.findY(5, &x), data );
+    // Only Y was inserted
+    TS_ASSERT( !mru.findE(5, &x) );
+    TS_ASSERT_EQUALS( mru.MRUSize(), 1 );
+    TS_ASSERT_EQUALS( mru.hits(), 1 );
+    TS_ASSERT_EQUALS( mru.misses(), 2 );
+    mru.resetCounters();
+    TS_ASSERT_EQUALS( mru.hits(), 0 );
+    TS_ASSERT_EQUALS( mru.misses(), 0 );
+  }
+
+  void test_entry_made_with_another_X_is_not_found()
+  {
+    EventWorkspaceMRU mru(8);
+    MantidVec x1(3, 1.0), x2(3, 2.0);
+    bool locked = false;
+    mru.insertY(new MantidVecWithMarker(5, locked, &x1));
+    TS_ASSERT( !mru.findY(5, &x2) );
+    // ... and it was dropped
+    TS_ASSERT( !mru.findY(5, &x1) );
+    TS_ASSERT_EQUALS( mru.MRUSize(), 0 );
+  }
+
+  void test_second_insert_of_the_same_histogram_keeps_the_first()
+  {
+    EventWorkspaceMRU mru(8);
+    MantidVec x(3, 1.0);
+    bool locked = false;
+    MantidVecWithMarker * first = new MantidVecWithMarker(3, locked, &x);
+    MantidVecWithMarker * second = new MantidVecWithMarker(3, locked, &x);
+    TS_ASSERT_EQUALS( mru.insertE(first), first );
+    TS_ASSERT_EQUALS( mru.insertE(second), first );
+    TS_ASSERT_EQUALS( mru.findE(3, &x), first );
+  }
+
+  void test_size_is_bounded()
+  {
+    EventWorkspaceMRU mru(2);
+    MantidVec x(3, 1.0);
+    bool locked = false;
+    for (size_t i = 0; i < 5; i++)
+      mru.insertY(new MantidVecWithMarker(i, locked, &x));
+    TS_ASSERT_EQUALS( mru.MRUSize(), 2 );
+    TS_ASSERT( mru.findY(4, &x) );
+    TS_ASSERT( mru.findY(3, &x) );
+    TS_ASSERT( !mru.findY(2, &x) );
+  }
+
+  void test_dropped_entry_of_a_locked_list_stays_readable()
+  {
+    EventWorkspaceMRU mru(2);
+    MantidVec x(3, 1.0);
+    bool locked = true;
+    MantidVecWithMarker * data = new MantidVecWithMarker(0, locked, &x);
+    data->m_data.assign(5, 7.0);
+    mru.insertY(data);
+    const MantidVec & y = data->m_data;
+    bool notLocked = false;
+    mru.insertY(new MantidVecWithMarker(1, notLocked, &x));
+    // Drops index 0; it is kept since its list is locked
+    mru.insertY(new MantidVecWithMarker(2, notLocked, &x));
+    TS_ASSERT( !mru.findY(0, &x) );
+    TS_ASSERT_EQUALS( y.size(), 5 );
+    TS_ASSERT_EQUALS( y[4], 7.0 );
+    // Deleted by clear() once unlocked
+    locked = false;
+    mru.clear();
+  }
+
+  void test_deleteIndex_and_clear()
+  {
+    EventWorkspaceMRU mru(8);
+    MantidVec x(3, 1.0);
+    bool locked = false;
+    mru.insertY(new MantidVecWithMarker(1, locked, &x));
+    mru.insertE(new MantidVecWithMarker(1, locked, &x));
+    mru.insertY(new MantidVecWithMarker(2, locked, &x));
+    mru.deleteIndex(1);
+    TS_ASSERT( !mru.findY(1, &x) );
+    TS_ASSERT( !mru.findE(1, &x) );
+    TS_ASSERT_EQUALS( mru.MRUSize(), 1 );
+    mru.clear();
+    TS_ASSERT_EQUALS( mru.MRUSize(), 0 );
+  }
+
+  void test_threadSafety()
+  {
+    EventWorkspaceMRU mru(64);
+    MantidVec x(3, 1.0);
+    bool locked = false;
+    PRAGMA_OMP( parallel for )
+    for (int i = 0; i < 10000; i++)
+    {
+      size_t index = size_t(i % 64);
+      MantidVecWithMarker * data = mru.findY(index, &x);
+      if (!data)
+      {
+        data = new MantidVecWithMarker(index, locked, &x);
+        data->m_data.assign(10, double(index));
+        data = mru.insertY(data);
+      }
+      TS_ASSERT_EQUALS( data->m_data[9], double(index) );
+    }
+    TS_ASSERT_LESS_THAN_EQUALS( mru.MRUSize(), 64 );
+    TS_ASSERT_EQUALS( mru.hits() + mru.misses(), 10000 );
+  }
 
 };
 
 
 #endif /* MANTID_DATAOBJECTS_EVENTWORKSPACEMRUTEST_H_ */
-
@@ -17,6 +17,7 @@
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
 #include "MantidKernel/Timer.h"
+#include "MantidKernel/VectorHelper.h"
 
 #ifndef _WIN32
   #include <sys/resource.h>
@@ -876,4 +877,66 @@ public:
 
 };
 
+
+//==========================================================================================
+class EventWorkspaceTestPerformance : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventWorkspaceTestPerformance *createSuite() { return new EventWorkspaceTestPerformance(); }
+  static void destroySuite( EventWorkspaceTestPerformance *suite ) { delete suite; }
+
+  EventWorkspaceTestPerformance()
+  {
+    // 2000 spectra of 5000 events, as re-histogrammed by Rebin/RebinToWorkspace
+    for (double x = 0; x <= 5000; x += 0.5)
+      linearX.push_back(x);
+    // The same bins moved a little, so they are no longer regular
+    arbitraryX = linearX;
+    for (size_t i = 1; i + 1 < arbitraryX.size(); i++)
+      arbitraryX[i] += 1e-3 * static_cast<double>(i % 7);
+    std::vector<double> params;
+    params.push_back(1.0); params.push_back(-0.001); params.push_back(5000.0);
+    VectorHelper::createAxisFromRebinParams(params, logX);
+  }
+
+  void setUp()
+  {
+    ws = WorkspaceCreationHelper::CreateEventWorkspace(2000, 5000, 5000, 0.0, 1.0, 3);
+    // Make the events unsorted
+    for (size_t wi = 0; wi < ws->getNumberHistograms(); wi++)
+      ws->getEventList(wi).reverse();
+  }
+
+  void test_histogram_linear()
+  {
+    histogramAll(linearX);
+  }
+
+  void test_histogram_logarithmic()
+  {
+    histogramAll(logX);
+  }
+
+  void test_histogram_arbitrary()
+  {
+    histogramAll(arbitraryX);
+  }
+
+private:
+  void histogramAll(const MantidVec & X)
+  {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int wi = 0; wi < static_cast<int>(ws->getNumberHistograms()); wi++)
+    {
+      MantidVec Y, E;
+      ws->getEventList(wi).generateHistogram(X, Y, E);
+    }
+  }
+
+  EventWorkspace_sptr ws;
+  MantidVec linearX, logX, arbitraryX;
+};
+
 #endif /* EVENTWORKSPACETEST_H_ */
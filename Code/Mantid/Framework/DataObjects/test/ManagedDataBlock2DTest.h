@@ -167,6 +167,27 @@ public:
     remove("ManagedDataBlock2DTest.tmp");
   }
 
+  void test_memory_round_trip()
+  {
+    // Same layout as the file: X, Y, E of each spectrum
+    std::vector<double> memory(2 * (4 + 3 + 3), -1.0);
+    data.writeToMemory(&memory[0]);
+    TS_ASSERT_EQUALS( memory[0], 0.0 );
+    TS_ASSERT_EQUALS( memory[4], 0.0 );
+    TS_ASSERT_EQUALS( memory[5], 10.0 );
+    TS_ASSERT_EQUALS( memory[10], 4.0 );
+
+    ManagedDataBlock2D readData(0,2,4,3, NULL, MantidVecPtr());
+    readData.releaseData();
+    TS_ASSERT( !readData.isLoaded() );
+    readData.readFromMemory(&memory[0]);
+    TS_ASSERT( readData.isLoaded() );
+    TS_ASSERT( ! readData.hasChanges() );
+    dataXTester(readData);
+    dataYTester(readData);
+    dataETester(readData);
+  }
+
 private:
     ManagedDataBlock2D data;
     
@@ -0,0 +1,151 @@
+#ifndef MANTID_DATAOBJECTS_MAPPEDWORKSPACE2DTEST_H_
+#define MANTID_DATAOBJECTS_MAPPEDWORKSPACE2DTEST_H_
+
+#include "MantidDataObjects/MappedWorkspace2D.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Timer.h"
+#include <cxxtest/TestSuite.h>
+#include <Poco/File.h>
+#include <boost/lexical_cast.hpp>
+
+using Mantid::MantidVec;
+using Mantid::DataObjects::MappedWorkspace2D;
+
+class MappedWorkspace2DTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MappedWorkspace2DTest *createSuite() { return new MappedWorkspace2DTest(); }
+  static void destroySuite( MappedWorkspace2DTest *suite ) { delete suite; }
+
+  void test_init()
+  {
+    MappedWorkspace2D ws;
+    ws.setTitle("MappedWorkspace2DTest_init");
+    TS_ASSERT_EQUALS( ws.id(), "MappedWorkspace2D" );
+    TS_ASSERT_THROWS_NOTHING( ws.initialize(5,6,5) );
+    TS_ASSERT_EQUALS( ws.getNumberHistograms(), 5 );
+    TS_ASSERT_EQUALS( ws.blocksize(), 5 );
+    TS_ASSERT_EQUALS( ws.size(), 25 );
+
+    // The file has the full size straight away
+    Poco::File file(ws.get_filename());
+    TS_ASSERT( file.exists() );
+    TS_ASSERT_EQUALS( file.getSize(), 5 * (6 + 2*5) * sizeof(double) );
+
+    // Never written: all zeroes
+    for (size_t i = 0; i < 5; ++i)
+    {
+      TS_ASSERT_EQUALS( ws.readX(i).size(), 6 );
+      TS_ASSERT_EQUALS( ws.readY(i).size(), 5 );
+      TS_ASSERT_EQUALS( ws.readE(i).size(), 5 );
+      TS_ASSERT_EQUALS( ws.readY(i)[4], 0.0 );
+    }
+  }
+
+  void test_file_is_removed()
+  {
+    std::string filename;
+    {
+      MappedWorkspace2D ws;
+      ws.initialize(2,3,2);
+      filename = ws.get_filename();
+      TS_ASSERT( Poco::File(filename).exists() );
+    }
+    TS_ASSERT( !Poco::File(filename).exists() );
+  }
+
+  /** Small blocks and many spectra, so that blocks are dropped from the MRU list and read back */
+  void test_data_survives_being_dropped()
+  {
+    const size_t NHist = 1111;
+    const size_t NY = 9;
+    const size_t NX = NY + 1;
+
+    // This will make sure 1 ManagedDataBlock = 2 Vectors
+    Mantid::Kernel::ConfigServiceImpl& conf = Mantid::Kernel::ConfigService::Instance();
+    const std::string blocksize = "ManagedWorkspace.DataBlockSize";
+    const std::string oldValue = conf.getString(blocksize);
+    conf.setString(blocksize,boost::lexical_cast<std::string>(2 * ( NX + 2*NY ) * sizeof(double)));
+
+    MappedWorkspace2D ws;
+    ws.initialize(NHist, NX, NY);
+
+    // Write only every other spectrum; the rest must stay at zero
+    for(size_t i = 0; i < ws.getNumberHistograms(); i += 2 )
+    {
+      MantidVec & x = ws.dataX( i );
+      MantidVec & y = ws.dataY( i );
+      MantidVec & e = ws.dataE( i );
+      for(size_t j = 0; j < y.size(); ++j)
+      {
+        x[j] = double(j);
+        y[j] = double(1000*i) + double(j);
+        e[j] = double(i);
+      }
+    }
+    TS_ASSERT_LESS_THAN( ws.getMemorySize(), NHist * ( NX + 2*NY ) * sizeof(double) );
+
+    for(size_t i = 0; i < ws.getNumberHistograms(); ++i )
+    {
+      const MantidVec & y = ws.readY( i );
+      const MantidVec & e = ws.readE( i );
+      for(size_t j = 0; j < y.size(); ++j)
+      {
+        if (i % 2 == 0)
+        {
+          TS_ASSERT_EQUALS( y[j], double(1000*i) + double(j) );
+          TS_ASSERT_EQUALS( e[j], double(i) );
+        }
+        else
+        {
+          TS_ASSERT_EQUALS( y[j], 0.0 );
+        }
+      }
+    }
+
+    conf.setString(blocksize,oldValue);
+  }
+};
+
+
+class MappedWorkspace2DTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static MappedWorkspace2DTestPerformance *createSuite() { return new MappedWorkspace2DTestPerformance(); }
+  static void destroySuite( MappedWorkspace2DTestPerformance *suite ) { delete suite; }
+
+  /** Fill a workspace much larger than the MRU list, then sum it twice */
+  void test_fill_and_sum()
+  {
+    const size_t NHist = 20000;
+    const size_t NY = 1000;
+    MappedWorkspace2D ws;
+    ws.initialize(NHist, NY+1, NY);
+
+    Mantid::Kernel::Timer timer;
+    for (size_t i = 0; i < NHist; ++i)
+    {
+      MantidVec & y = ws.dataY(i);
+      std::fill(y.begin(), y.end(), 1.0);
+    }
+    std::cout << timer.elapsed() << " sec to fill " << NHist << " spectra." << std::endl;
+
+    double total = 0;
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+      for (size_t i = 0; i < NHist; ++i)
+      {
+        const MantidVec & y = ws.readY(i);
+        for (size_t j = 0; j < NY; ++j)
+          total += y[j];
+      }
+    }
+    std::cout << timer.elapsed() << " sec to sum them twice." << std::endl;
+    TS_ASSERT_DELTA( total, 2.0 * NHist * NY, 1e-6 );
+  }
+};
+
+
+#endif /* MANTID_DATAOBJECTS_MAPPEDWORKSPACE2DTEST_H_ */
@@ -81,6 +81,7 @@ namespace Mantid
       Kernel::V3D getBeamDirection() const;
 
       IDetector_const_sptr getDetector(const detid_t &detector_id) const;
+      const IDetector * getBaseDetector(const detid_t &detector_id) const;
       bool isMonitor(const detid_t &detector_id) const;
       bool isMonitor(const std::set<detid_t> &detector_ids) const;
       bool isDetectorMasked(const detid_t &detector_id) const;
@@ -237,9 +238,22 @@ namespace Mantid
       /// Add a plottable component
       void appendPlottable(const CompAssembly& ca,std::vector<IObjComponent_const_sptr>& lst)const;
 
+      /// Find a detector in the detector cache of this (unparametrized) instrument
+      const IDetector_const_sptr * findDetector(const detid_t detector_id) const;
+      /// Put a detector of the detector cache into the dense detector index
+      void addToDetectorIndex(const detid_t detector_id, const IDetector_const_sptr * det);
+      /// Rebuild the dense detector index from the detector cache
+      void rebuildDetectorIndex(const detid_t newDetectorID);
+
       /// Map which holds detector-IDs and pointers to detector components
       std::map<detid_t, IDetector_const_sptr > m_detectorCache;
 
+      /// Dense index of the entries of m_detectorCache: the detector with ID id is at [id - m_detectorIndexOffset],
+      /// NULL where there is no such detector. Empty if the detector IDs are too sparse for it.
+      std::vector<const IDetector_const_sptr *> m_detectorIndex;
+      /// The detector ID of the first entry of m_detectorIndex
+      detid_t m_detectorIndexOffset;
+
       /// Purpose to hold copy of source component. For now assumed to be just one component
       const IComponent* m_sourceCache;
 
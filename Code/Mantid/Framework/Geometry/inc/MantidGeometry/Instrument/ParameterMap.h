@@ -36,6 +36,9 @@ namespace Geometry
     components. ParameterMap has a number of 'add' methods for adding parameters of
     different types. 
 
+    The parameters of a component are kept together in one block, so that finding
+    a parameter takes one lookup of the component and a scan of a short vector.
+
     @author Roman Tolchenov, Tessella Support Services plc
     @date 2/12/2008
 
@@ -62,27 +65,29 @@ namespace Geometry
   class MANTID_GEOMETRY_DLL ParameterMap
   {
   public:
+    /// The parameters of a component
+    typedef std::vector<boost::shared_ptr<Parameter> > ParameterBlock;
 #ifndef HAS_UNORDERED_MAP_H
     /// Parameter map typedef
-    typedef std::multimap<const ComponentID,boost::shared_ptr<Parameter> > pmap;
+    typedef std::map<const ComponentID,ParameterBlock> pmap;
     /// Parameter map iterator typedef
-    typedef std::multimap<const ComponentID,boost::shared_ptr<Parameter> >::iterator pmap_it;
+    typedef std::map<const ComponentID,ParameterBlock>::iterator pmap_it;
     /// Parameter map iterator typedef
-    typedef std::multimap<const ComponentID,boost::shared_ptr<Parameter> >::const_iterator pmap_cit;
+    typedef std::map<const ComponentID,ParameterBlock>::const_iterator pmap_cit;
 #else
     /// Parameter map typedef
-    typedef std::tr1::unordered_multimap<const ComponentID,boost::shared_ptr<Parameter> > pmap;
+    typedef std::tr1::unordered_map<const ComponentID,ParameterBlock> pmap;
     /// Parameter map iterator typedef
-    typedef std::tr1::unordered_multimap<const ComponentID,boost::shared_ptr<Parameter> >::iterator pmap_it;
+    typedef std::tr1::unordered_map<const ComponentID,ParameterBlock>::iterator pmap_it;
     /// Parameter map iterator typedef
-    typedef std::tr1::unordered_multimap<const ComponentID,boost::shared_ptr<Parameter> >::const_iterator pmap_cit;
+    typedef std::tr1::unordered_map<const ComponentID,ParameterBlock>::const_iterator pmap_cit;
 #endif
     /// Default constructor
     ParameterMap();
     /// Returns true if the map is empty, false otherwise
     inline bool empty() const { return m_map.empty(); }
-    /// Return the size of the map
-    inline int size() const { return static_cast<int>(m_map.size()); }
+    /// Return the number of parameters in the map
+    inline int size() const { return static_cast<int>(m_nParameters); }
     /// Return string to be used in the map
     static const std::string & pos();
     static const std::string & posx();
@@ -108,8 +113,11 @@ namespace Geometry
     inline void clear()
     {
       m_map.clear();
+      m_nParameters = 0;
       clearPositionSensitiveCaches();
     }
+    /// Returns a stamp which changes whenever the parameters change. A copy of the map keeps the stamp until it is changed.
+    inline size_t getModificationStamp() const { return m_modificationStamp; }
     /// Clear any parameters with the given name
     void clearParametersByName(const std::string & name);
 
@@ -144,8 +152,9 @@ namespace Geometry
         paramT->setValue(value);
         if( created )
         {
-          m_map.insert(std::make_pair(comp->getComponentID(),param));
+          insert(comp->getComponentID(),param);
         }
+        markModified();
       }
     }
     /** @name Helper methods for adding and updating paramter types  */
@@ -279,15 +288,25 @@ namespace Geometry
     /// Retrieve a parameter by either creating a new one of getting an existing one
     Parameter_sptr retrieveParameter(bool &created, const std::string & type, const IComponent* comp,
                                      const std::string & name);
+    /// Add a new parameter to the block of a component
+    void insert(const ComponentID id, const Parameter_sptr & param);
+    /// Find the parameters of a component, NULL if it has none
+    const ParameterBlock * findBlock(const IComponent* comp) const;
+    /// Give the map a new modification stamp
+    void markModified();
 
     /// internal parameter map instance
     pmap m_map;
+    /// the number of parameters in all the blocks of m_map
+    size_t m_nParameters;
     /// internal cache map instance for cached postition values
     mutable Kernel::Cache<const ComponentID, Kernel::V3D > m_cacheLocMap;
     /// internal cache map instance for cached rotation values
     mutable Kernel::Cache<const ComponentID, Kernel::Quat > m_cacheRotMap;
     ///internal cache map for cached bounding boxes
     mutable Kernel::Cache<const ComponentID,BoundingBox> m_boundingBoxMap;
+    /// stamp of the last change, unique across all the maps
+    size_t m_modificationStamp;
   };
 
   /// ParameterMap shared pointer typedef
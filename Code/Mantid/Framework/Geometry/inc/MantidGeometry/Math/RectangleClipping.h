@@ -0,0 +1,63 @@
+#ifndef MANTID_GEOMETRY_RECTANGLECLIPPING_H_
+#define MANTID_GEOMETRY_RECTANGLECLIPPING_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Math/Quadrilateral.h"
+
+namespace Mantid
+{
+  namespace Geometry
+  {
+    /** 
+    This header defines the clipping of a quadrilateral to an axis-aligned rectangle, as
+    needed to share out the signal of a bin between the bins of a rectangular grid.
+
+    The quadrilateral is clipped by each side of the rectangle in turn (Sutherland-Hodgman).
+    The vertices are kept in small fixed-size arrays on the stack, so unlike
+    intersectionByLaszlo nothing is allocated and no exception is thrown when the
+    shapes do not overlap.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+    */
+
+    /// The part of a quadrilateral inside a rectangle
+    struct RectangleOverlap
+    {
+      /// The area of the overlap
+      double area;
+      /// The smallest X of the overlap
+      double smallestX;
+      /// The largest X of the overlap
+      double largestX;
+    };
+
+    /// Compute the overlap of a quadrilateral with an axis-aligned rectangle
+    MANTID_GEOMETRY_DLL
+    bool overlapWithRectangle(const Quadrilateral & quad, const double xmin, const double xmax,
+                              const double ymin, const double ymax, RectangleOverlap & overlap);
+
+  } // namespace Geometry
+} // namespace Mantid
+
+#endif  /* MANTID_GEOMETRY_RECTANGLECLIPPING_H_ */
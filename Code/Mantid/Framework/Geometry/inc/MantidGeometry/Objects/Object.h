@@ -116,6 +116,7 @@ namespace Mantid
 
       // INTERSECTION
       int interceptSurface(Geometry::Track&) const;
+      bool exitDistance(const Kernel::V3D& start, const Kernel::V3D& direction, double& distance) const;
 
       // Solid angle - uses triangleSolidAngle unless many (>30000) triangles
       double solidAngle(const Kernel::V3D& observer) const;
@@ -12,6 +12,7 @@
 
 #include <Poco/Path.h>
 #include <algorithm>
+#include <limits>
 #include <sstream>
 #include <queue>
 
@@ -31,14 +32,14 @@ namespace Mantid
 
     /// Default constructor
     Instrument::Instrument() : CompAssembly(),
-      m_detectorCache(),m_sourceCache(0), m_chopperPoints(new std::vector<const ObjComponent*>), m_sampleCache(0),
+      m_detectorCache(), m_detectorIndexOffset(0), m_sourceCache(0), m_chopperPoints(new std::vector<const ObjComponent*>), m_sampleCache(0),
       m_defaultView("3D"), m_defaultViewAxis("Z+"), m_referenceFrame(new ReferenceFrame)
     {
     }
 
     /// Constructor with name
     Instrument::Instrument(const std::string& name) : CompAssembly(name),
-      m_detectorCache(),m_sourceCache(0), m_chopperPoints(new std::vector<const ObjComponent*>),m_sampleCache(0),
+      m_detectorCache(), m_detectorIndexOffset(0), m_sourceCache(0), m_chopperPoints(new std::vector<const ObjComponent*>),m_sampleCache(0),
       m_defaultView("3D"), m_defaultViewAxis("Z+"), m_referenceFrame(new ReferenceFrame)
     {
     }
@@ -49,7 +50,7 @@ namespace Mantid
      */
     Instrument::Instrument(const boost::shared_ptr<const Instrument> instr, boost::shared_ptr<ParameterMap> map)
       : CompAssembly(instr.get(), map.get() ),
-      m_sourceCache(instr->m_sourceCache), m_chopperPoints(instr->m_chopperPoints), m_sampleCache(instr->m_sampleCache),
+      m_detectorIndexOffset(0), m_sourceCache(instr->m_sourceCache), m_chopperPoints(instr->m_chopperPoints), m_sampleCache(instr->m_sampleCache),
       m_defaultView(instr->m_defaultView),
       m_defaultViewAxis(instr->m_defaultViewAxis),
       m_instr(instr), m_map_nonconst(map),
@@ -62,7 +63,7 @@ namespace Mantid
      *  in indirect instruments.
      */
     Instrument::Instrument(const Instrument& instr) : CompAssembly(instr),
-        m_sourceCache(NULL), m_chopperPoints(new std::vector<const ObjComponent*>), m_sampleCache(NULL), /* Should only be temporarily null */
+        m_detectorIndexOffset(0), m_sourceCache(NULL), m_chopperPoints(new std::vector<const ObjComponent*>), m_sampleCache(NULL), /* Should only be temporarily null */
         m_logfileCache(instr.m_logfileCache), m_logfileUnit(instr.m_logfileUnit),
         m_monitorCache(instr.m_monitorCache), m_defaultView(instr.m_defaultView), m_defaultViewAxis(instr.m_defaultViewAxis),
         m_instr(), m_map_nonconst(), /* Should not be parameterized */
@@ -501,35 +502,63 @@ namespace Mantid
     */
     IDetector_const_sptr Instrument::getDetector(const detid_t &detector_id) const
     {
+      const IDetector_const_sptr * baseDet = m_isParametrized ? m_instr->findDetector(detector_id) : findDetector(detector_id);
+      if ( baseDet == NULL )
+      {
+        //FIXME: When ticket #4544 is fixed, re-enable this debug print:
+        //g_log.debug() << "Detector with ID " << detector_id << " not found." << std::endl;
+        std::stringstream readInt;
+        readInt << detector_id;
+        throw Kernel::Exception::NotFoundError("Instrument: Detector with ID " + readInt.str() + " not found.","");
+      }
+
       if (m_isParametrized)
       {
-        IDetector_const_sptr baseDet = m_instr->getDetector(detector_id);
-        return ParComponentFactory::createDetector(baseDet.get(), m_map);
+        return ParComponentFactory::createDetector(baseDet->get(), m_map);
       }
       else
       {
-        detid2det_map::const_iterator it = m_detectorCache.find(detector_id);
-        if ( it == m_detectorCache.end() )
-        {
-          //FIXME: When ticket #4544 is fixed, re-enable this debug print:
-          //g_log.debug() << "Detector with ID " << detector_id << " not found." << std::endl;
-          std::stringstream readInt;
-          readInt << detector_id;
-          throw Kernel::Exception::NotFoundError("Instrument: Detector with ID " + readInt.str() + " not found.","");
-        }
+        return *baseDet;
+      }
+    }
 
-        return it->second;
+    /** Gets the unparametrized detector with the given ID. This is much cheaper than getDetector()
+    *  on a parametrized instrument, which creates a new parametrized detector: the component ID of the
+    *  detector or its parameters in the ParameterMap can be used without creating one.
+    *  @param   detector_id The requested detector ID
+    *  @returns A pointer to the detector object of the base instrument, or NULL if there is no detector with this ID
+    */
+    const IDetector * Instrument::getBaseDetector(const detid_t &detector_id) const
+    {
+      const IDetector_const_sptr * det = m_isParametrized ? m_instr->findDetector(detector_id) : findDetector(detector_id);
+      return det ? det->get() : NULL;
+    }
+
+    /** Finds a detector in the detector cache, through the dense detector index if there is one.
+    *  @param   detector_id The requested detector ID
+    *  @returns A pointer to the entry of the detector cache, or NULL if there is no detector with this ID
+    */
+    const IDetector_const_sptr * Instrument::findDetector(const detid_t detector_id) const
+    {
+      if ( !m_detectorIndex.empty() )
+      {
+        const int64_t index = int64_t(detector_id) - int64_t(m_detectorIndexOffset);
+        if ( index < 0 || index >= int64_t(m_detectorIndex.size()) ) return NULL;
+        return m_detectorIndex[size_t(index)];
       }
+      detid2det_map::const_iterator it = m_detectorCache.find(detector_id);
+      if ( it == m_detectorCache.end() ) return NULL;
+      return &(it->second);
     }
 
     bool Instrument::isMonitor(const detid_t &detector_id) const
     {
-      // Find the (base) detector object in the map.
-      detid2det_map::const_iterator it = m_instr->m_detectorCache.find(detector_id);
-      if ( it == m_instr->m_detectorCache.end() )
+      // Find the (base) detector object
+      const IDetector * baseDet = getBaseDetector(detector_id);
+      if ( baseDet == NULL )
         return false;
       // This is the detector
-      const Detector * det = dynamic_cast<const Detector*>(it->second.get());
+      const Detector * det = dynamic_cast<const Detector*>(baseDet);
       if (det == NULL)
          return false;
       return det->isMonitor();
@@ -559,12 +588,12 @@ namespace Mantid
       // With no parameter map, then no detector is EVER masked
       if (!isParametrized())
         return false;
-      // Find the (base) detector object in the map.
-      detid2det_map::const_iterator it = m_instr->m_detectorCache.find(detector_id);
-      if ( it == m_instr->m_detectorCache.end() )
+      // Find the (base) detector object
+      const IDetector * baseDet = getBaseDetector(detector_id);
+      if ( baseDet == NULL )
         return false;
       // This is the detector
-      const Detector * det = dynamic_cast<const Detector*>(it->second.get());
+      const Detector * det = dynamic_cast<const Detector*>(baseDet);
       if (det == NULL)
          return false;
       // Access the parameter map directly.
@@ -751,7 +780,64 @@ namespace Mantid
       //Create a (non-deleting) shared pointer to it
       IDetector_const_sptr det_sptr = IDetector_const_sptr(det, NoDeleting() );
       std::map<int, IDetector_const_sptr >::iterator it = m_detectorCache.end();
-      m_detectorCache.insert( it, std::map<int, IDetector_const_sptr >::value_type(det->getID(), det_sptr) );
+      it = m_detectorCache.insert( it, std::map<int, IDetector_const_sptr >::value_type(det->getID(), det_sptr) );
+      // Index it unless there was already a detector with this ID
+      if ( it->second.get() == det ) addToDetectorIndex(det->getID(), &(it->second));
+    }
+
+    /** Sets the entry of the dense detector index of a detector of the detector cache. The index is
+    *  rebuilt if the detector is outside of it.
+    *  @param detector_id :: the detector ID
+    *  @param det :: the entry of m_detectorCache for the detector
+    */
+    void Instrument::addToDetectorIndex(const detid_t detector_id, const IDetector_const_sptr * det)
+    {
+      const int64_t index = int64_t(detector_id) - int64_t(m_detectorIndexOffset);
+      if ( index >= 0 && index < int64_t(m_detectorIndex.size()) )
+      {
+        m_detectorIndex[size_t(index)] = det;
+      }
+      else
+      {
+        rebuildDetectorIndex(detector_id);
+      }
+    }
+
+    /** Rebuilds the dense detector index so that it covers all the IDs of the detector cache,
+    *  or clears it if the IDs are too sparse for it to be worth it.
+    *  Detectors are usually marked in increasing or decreasing order of ID, so the index is extended by
+    *  its own length on the side of the detector just added: rebuilding it is then amortised over the next detectors.
+    *  @param newDetectorID :: the ID of the detector just added
+    */
+    void Instrument::rebuildDetectorIndex(const detid_t newDetectorID)
+    {
+      // The index is used while it has at most this many entries per detector: a map node is about as big
+      const int64_t maxEntriesPerDetector = 4;
+
+      m_detectorIndex.clear();
+      if ( m_detectorCache.empty() ) return;
+      const int64_t minID = m_detectorCache.begin()->first;
+      const int64_t maxID = m_detectorCache.rbegin()->first;
+      const int64_t span = maxID - minID + 1;
+      if ( span > maxEntriesPerDetector * int64_t(m_detectorCache.size()) )
+      {
+        std::vector<const IDetector_const_sptr *>().swap(m_detectorIndex);
+        return;
+      }
+
+      int64_t first = minID;
+      int64_t last = maxID;
+      if ( newDetectorID == maxID )
+        last = std::min(maxID + span, int64_t(std::numeric_limits<detid_t>::max()));
+      else if ( newDetectorID == minID )
+        first = std::max(minID - span, int64_t(std::numeric_limits<detid_t>::min()));
+
+      m_detectorIndexOffset = detid_t(first);
+      m_detectorIndex.assign(size_t(last - first + 1), NULL);
+      for ( detid2det_map::const_iterator it = m_detectorCache.begin(); it != m_detectorCache.end(); ++it )
+      {
+        m_detectorIndex[size_t(int64_t(it->first) - first)] = &(it->second);
+      }
     }
 
     /** Mark a Component which has already been added to the Instrument class
@@ -793,7 +879,11 @@ namespace Mantid
 
       const detid_t id = det->getID();
       // Remove the detector from the detector cache
-      m_detectorCache.erase(id);
+      if ( m_detectorCache.erase(id) )
+      {
+        const int64_t index = int64_t(id) - int64_t(m_detectorIndexOffset);
+        if ( index >= 0 && index < int64_t(m_detectorIndex.size()) ) m_detectorIndex[size_t(index)] = NULL;
+      }
       // Also need to remove from monitor cache if appropriate
       if ( det->isMonitor() )
       {
@@ -310,9 +310,11 @@ namespace Geometry
   {
     if( m_isParametrized )
     {
-      if( m_map->contains(m_base, "pos") )
+      // One lookup instead of contains() and get()
+      Parameter_sptr par = m_map->get(m_base, "pos");
+      if( par )
       {
-        return m_map->get(m_base, "pos")->value<V3D>();
+        return par->value<V3D>();
       }
       else return m_base->m_pos;
     }
@@ -395,9 +397,11 @@ namespace Geometry
   {
     if( m_isParametrized )
     {
-      if( m_map->contains(m_base, "rot") )
+      Parameter_sptr par = m_map->get(m_base, "rot");
+      if( par )
       {
-        return m_map->get(m_base, "rot")->value<Quat>();
+        // The parameter is owned by the map, so the reference stays valid
+        return par->value<Quat>();
       }
       return m_base->m_rot;
     }
@@ -4,8 +4,8 @@
 #include "MantidGeometry/Instrument/NearestNeighbours.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidGeometry/Instrument.h"
+#include <cctype>
 #include <cstring>
-#include <boost/algorithm/string.hpp>
 
 
 namespace Mantid
@@ -37,6 +37,26 @@ namespace Mantid
 
       // static logger reference
       Kernel::Logger g_log("ParameterMap");
+
+      /**
+       * Compare two parameter names ignoring the case of (ASCII) letters. Much cheaper than boost::iequals,
+       * which goes through the locale for every character.
+       * @param name1 :: A null-terminated name
+       * @param name2 :: Another null-terminated name
+       * @returns true if the names are the same but for the case
+       */
+      inline bool namesMatch(const char * name1, const char * name2)
+      {
+        for( ; *name1 && *name2; ++name1, ++name2 )
+        {
+          if( *name1 != *name2 &&
+              std::tolower(static_cast<unsigned char>(*name1)) != std::tolower(static_cast<unsigned char>(*name2)) )
+          {
+            return false;
+          }
+        }
+        return *name1 == *name2;
+      }
     }
     //--------------------------------------------------------------------------
     // Public method
@@ -45,8 +65,10 @@ namespace Mantid
      * Default constructor
      */
     ParameterMap::ParameterMap()
-      : m_map()
-    {}
+      : m_map(), m_nParameters(0), m_modificationStamp(0)
+    {
+      markModified();
+    }
 
     /**
     * Return string to be inserted into the parameter map
@@ -158,19 +180,31 @@ namespace Mantid
       {
         const IComponent * comp = static_cast<IComponent*>(thisIt->first);
         const std::string fullName = comp->getFullName();
-        const auto & param = thisIt->second;
-        bool match(false);
+        // Find the block of the component with the same name in rhs
+        const ParameterBlock * rhsBlock = NULL;
         for(pmap_cit rhsIt = rhs.m_map.begin(); rhsIt != rhsEnd; ++rhsIt)
         {
           const IComponent * rhsComp = static_cast<IComponent*>(rhsIt->first);
-          const std::string rhsFullName = rhsComp->getFullName();
-          if(fullName == rhsFullName && (*param) == (*rhsIt->second))
+          if(fullName == rhsComp->getFullName())
           {
-            match = true;
+            rhsBlock = &rhsIt->second;
             break;
           }
         }
-        if(!match) return false;
+        if(!rhsBlock) return false;
+        for(ParameterBlock::const_iterator param = thisIt->second.begin(); param != thisIt->second.end(); ++param)
+        {
+          bool match(false);
+          for(ParameterBlock::const_iterator rhsParam = rhsBlock->begin(); rhsParam != rhsBlock->end(); ++rhsParam)
+          {
+            if((**param) == (**rhsParam))
+            {
+              match = true;
+              break;
+            }
+          }
+          if(!match) return false;
+        }
       }
       return true;
     }
@@ -184,7 +218,20 @@ namespace Mantid
       // Key is component ID so have to search through whole lot
       for( pmap_it itr = m_map.begin(); itr != m_map.end();)
       {
-        if(itr->second->name() == name)
+        ParameterBlock & block = itr->second;
+        for( ParameterBlock::iterator param = block.begin(); param != block.end(); )
+        {
+          if((*param)->name() == name)
+          {
+            param = block.erase(param);
+            --m_nParameters;
+          }
+          else
+          {
+            ++param;
+          }
+        }
+        if(block.empty())
         {
           m_map.erase(itr++);
         }
@@ -193,6 +240,7 @@ namespace Mantid
           ++itr;
         }
       }
+      markModified();
       // Check if the caches need invalidating
       if( name == pos() || name == rot() ) clearPositionSensitiveCaches();
     }
@@ -210,15 +258,22 @@ namespace Mantid
         pmap_it it_found = m_map.find(id);
         if (it_found != m_map.end())
         {
-          if(it_found->second->name() == name)
+          ParameterBlock & block = it_found->second;
+          for( ParameterBlock::iterator param = block.begin(); param != block.end(); )
           {
-            m_map.erase(it_found++);
-          }
-          else
-          {
-            ++it_found;
+            if((*param)->name() == name)
+            {
+              param = block.erase(param);
+              --m_nParameters;
+            }
+            else
+            {
+              ++param;
+            }
           }
+          if(block.empty()) m_map.erase(it_found);
         }
+        markModified();
 
         // Check if the caches need invalidating
         if( name == pos() || name == rot() ) clearPositionSensitiveCaches();
@@ -242,8 +297,9 @@ namespace Mantid
         param->fromString(value);
         if( created )
         {
-          m_map.insert(std::make_pair(comp->getComponentID(),param));
+          insert(comp->getComponentID(),param);
         }
+        markModified();
       }
     }
 
@@ -506,14 +562,13 @@ namespace Mantid
      */
     bool ParameterMap::contains(const IComponent* comp, const char * name, const char *type) const
     {
-      if( m_map.empty() ) return false;
-      const ComponentID id = comp->getComponentID();
-      std::pair<pmap_cit,pmap_cit> components = m_map.equal_range(id);
-      bool anytype = (strlen(type) == 0);
-      for( pmap_cit itr = components.first; itr != components.second; ++itr )
+      const ParameterBlock * block = findBlock(comp);
+      if( !block ) return false;
+      const bool anytype = (type[0] == '\0');
+      for( ParameterBlock::const_iterator itr = block->begin(); itr != block->end(); ++itr )
       {
-        boost::shared_ptr<Parameter> param = itr->second;
-        if( boost::iequals(param->name(),name) && (anytype || param->type() == type) )
+        const Parameter & param = **itr;
+        if( namesMatch(param.nameAsCString(),name) && (anytype || param.type() == type) )
         {
           return true;
         }
@@ -528,23 +583,15 @@ namespace Mantid
      */
     bool ParameterMap::contains(const IComponent* comp, const Parameter & parameter) const
     {
-      if( m_map.empty() || !comp) return false;
+      if( !comp ) return false;
 
-      const ComponentID id = comp->getComponentID();
-      pmap_cit it_found = m_map.find(id);
-      if(it_found != m_map.end())
+      const ParameterBlock * block = findBlock(comp);
+      if( !block ) return false;
+      for( ParameterBlock::const_iterator itr = block->begin(); itr != block->end(); ++itr )
       {
-        pmap_cit itr = m_map.lower_bound(id);
-        pmap_cit itr_end = m_map.upper_bound(id);
-        for(; itr != itr_end; ++itr)
-        {
-          const Parameter_sptr & param = itr->second;
-          if(*param == parameter) return true;
-        }
-        return false;
+        if(**itr == parameter) return true;
       }
-      else 
-        return false;
+      return false;
     }
 
     /** Return a named parameter of a given type
@@ -569,32 +616,21 @@ namespace Mantid
     boost::shared_ptr<Parameter> ParameterMap::get(const IComponent* comp,
                                                    const char *name, const char * type) const
     {
-      Parameter_sptr result;
-      if(!comp) return result;
-      const bool anytype = (strlen(type) == 0);
-      PARALLEL_CRITICAL(ParameterMap_get)
+      if(!comp) return Parameter_sptr();
+      // Reading the map needs no lock: it is only changed by the adding methods, which must not run
+      // at the same time as the lookups
+      const ParameterBlock * block = findBlock(comp);
+      if( !block ) return Parameter_sptr();
+      const bool anytype = (type[0] == '\0');
+      for( ParameterBlock::const_iterator itr = block->begin(); itr != block->end(); ++itr )
       {
-        if( !m_map.empty() )
+        const Parameter & param = **itr;
+        if( namesMatch(param.nameAsCString(), name) && (anytype || param.type() == type) )
         {
-          const ComponentID id = comp->getComponentID();
-          pmap_cit it_found = m_map.find(id);
-          if (it_found != m_map.end())
-          {
-            pmap_cit itr = m_map.lower_bound(id);
-            pmap_cit itr_end = m_map.upper_bound(id);
-            for( ; itr != itr_end; ++itr )
-            {
-              Parameter_sptr param = itr->second;
-              if( boost::iequals(param->nameAsCString(), name) && (anytype || param->type() == type) )
-              {
-                result = param;
-                break;
-              }
-            }
-          }
+          return *itr;
         }
       }
-      return result;
+      return Parameter_sptr();
     }
 
      /** Look for a parameter in the given component by the type of the parameter.
@@ -604,33 +640,16 @@ namespace Mantid
      */
     Parameter_sptr ParameterMap::getByType(const IComponent* comp, const std::string& type) const
     {
-      Parameter_sptr result = Parameter_sptr();
-      PARALLEL_CRITICAL(ParameterMap_get)
+      const ParameterBlock * block = findBlock(comp);
+      if( !block ) return Parameter_sptr();
+      for( ParameterBlock::const_iterator itr = block->begin(); itr != block->end(); ++itr )
       {
-        if( !m_map.empty() )
+        if( namesMatch((*itr)->type().c_str(), type.c_str()) )
         {
-          const ComponentID id = comp->getComponentID();
-          pmap_cit it_found = m_map.find(id);
-          if(it_found != m_map.end() )
-          {
-             if (it_found->first)
-             {
-                pmap_cit itr = m_map.lower_bound(id);
-                pmap_cit itr_end = m_map.upper_bound(id);
-                for( ; itr != itr_end; ++itr )
-                {
-                    Parameter_sptr param = itr->second;
-                    if( boost::iequals(param->type(), type) )
-                    {
-                        result = param;
-                        break;
-                    }
-                }
-             } // found->firdst
-          } // it_found != m_map.end()
-        } //!m_map.empty()
-      } // PARALLEL_CRITICAL(ParameterMap_get)
-      return result;
+          return *itr;
+        }
+      }
+      return Parameter_sptr();
     }
 
      /** Looks recursively upwards in the component tree for the first instance of a component with a matching type.
@@ -714,19 +733,15 @@ namespace Mantid
     std::set<std::string> ParameterMap::names(const IComponent* comp)const
     {
       std::set<std::string> paramNames;
-      const ComponentID id = comp->getComponentID();
-      pmap_cit it_found = m_map.find(id);
-      if (it_found == m_map.end())
+      const ParameterBlock * block = findBlock(comp);
+      if (!block)
       {
         return paramNames;
       }
 
-      pmap_cit it_begin = m_map.lower_bound(id);
-      pmap_cit it_end = m_map.upper_bound(id);
-
-      for(pmap_cit it = it_begin; it != it_end; ++it)
+      for(ParameterBlock::const_iterator it = block->begin(); it != block->end(); ++it)
       {
-        paramNames.insert(it->second->name());
+        paramNames.insert((*it)->name());
       }
 
       return paramNames;
@@ -743,11 +758,13 @@ namespace Mantid
       std::stringstream out;
       for(pmap_cit it=m_map.begin();it!=m_map.end();it++)
       {
-        boost::shared_ptr<Parameter> p = it->second;
-        if (p && it->first)
+        if (!it->first) continue;
+        const IComponent* comp = (const IComponent*)(it->first);
+        const IDetector* det = dynamic_cast<const IDetector*>(comp);
+        for(ParameterBlock::const_iterator pit = it->second.begin(); pit != it->second.end(); ++pit)
         {
-          const IComponent* comp = (const IComponent*)(it->first);
-          const IDetector* det = dynamic_cast<const IDetector*>(comp);
+          boost::shared_ptr<Parameter> p = *pit;
+          if (!p) continue;
           if (det)
           {
             out << "detID:"<<det->getID();
@@ -770,6 +787,21 @@ namespace Mantid
       m_cacheLocMap.clear();
       m_cacheRotMap.clear();
       m_boundingBoxMap.clear();
+      // positions are changed by setting the parameters in place
+      markModified();
+    }
+
+    /**
+     * Give the map a stamp that no other map has had. Called for every change of the parameters,
+     * so that caches built from the map can tell when they are out of date.
+     */
+    void ParameterMap::markModified()
+    {
+      static size_t lastStamp = 0;
+      PARALLEL_CRITICAL(parameter_stamp)
+      {
+        m_modificationStamp = ++lastStamp;
+      }
     }
  
     ///Sets a cached location on the location cache
@@ -777,11 +809,7 @@ namespace Mantid
     /// @param location :: The location 
     void ParameterMap::setCachedLocation(const IComponent* comp, const V3D& location) const
     {
-      // Call to setCachedLocation is a write so not thread-safe
-      PARALLEL_CRITICAL(positionCache)
-      {
-        m_cacheLocMap.setCache(comp->getComponentID(),location);
-      }
+      m_cacheLocMap.setCache(comp->getComponentID(),location);
     }
 
     ///Attempts to retreive a location from the location cache
@@ -790,12 +818,8 @@ namespace Mantid
     /// @returns true if the location is in the map, otherwise false
     bool ParameterMap::getCachedLocation(const IComponent* comp, V3D& location) const
     {
-      bool inMap(false);
-      PARALLEL_CRITICAL(positionCache)
-      {
-        inMap = m_cacheLocMap.getCache(comp->getComponentID(),location);
-      }
-      return inMap;
+      // The cache locks itself, letting the threads look up locations at the same time
+      return m_cacheLocMap.getCache(comp->getComponentID(),location);
     }
 
     ///Sets a cached rotation on the rotation cache
@@ -803,11 +827,7 @@ namespace Mantid
     /// @param rotation :: The rotation as a quaternion 
     void ParameterMap::setCachedRotation(const IComponent* comp, const Quat& rotation) const
     {
-      // Call to setCachedRotation is a write so not thread-safe
-      PARALLEL_CRITICAL(rotationCache)
-      {
-        m_cacheRotMap.setCache(comp->getComponentID(),rotation);
-      }
+      m_cacheRotMap.setCache(comp->getComponentID(),rotation);
     }
 
     ///Attempts to retreive a rotation from the rotation cache
@@ -816,12 +836,7 @@ namespace Mantid
     /// @returns true if the rotation is in the map, otherwise false
     bool ParameterMap::getCachedRotation(const IComponent* comp, Quat& rotation) const
     {
-      bool inMap(false);
-      PARALLEL_CRITICAL(rotationCache)
-      {
-        inMap = m_cacheRotMap.getCache(comp->getComponentID(),rotation);
-      }
-      return inMap;
+      return m_cacheRotMap.getCache(comp->getComponentID(),rotation);
     }
 
     ///Sets a cached bounding box
@@ -829,11 +844,7 @@ namespace Mantid
     /// @param box :: A reference to the bounding box
     void ParameterMap::setCachedBoundingBox(const IComponent *comp, const BoundingBox & box) const
     {
-      // Call to setCachedRotation is a write so not thread-safe
-      PARALLEL_CRITICAL(boundingBoxCache)
-      {
-        m_boundingBoxMap.setCache(comp->getComponentID(), box);
-      }
+      m_boundingBoxMap.setCache(comp->getComponentID(), box);
     }
 
     ///Attempts to retreive a bounding box from the cache
@@ -862,8 +873,9 @@ namespace Mantid
       {
         Parameter_sptr thisParameter = oldPMap->get(oldComp,*it);
         // Insert the fecthed parameter in the m_map
-        m_map.insert(std::make_pair(newComp->getComponentID(),thisParameter));
+        insert(newComp->getComponentID(),thisParameter);
       }
+      markModified();
     }
     
     //--------------------------------------------------------------------------------------------
@@ -916,6 +928,30 @@ namespace Mantid
       return param;
     }
 
+    /**
+     * Add a parameter to the block of a component, creating the block if needed.
+     * The parameter must not be in the block already.
+     * @param id :: The ID of the component
+     * @param param :: The new parameter
+     */
+    void ParameterMap::insert(const ComponentID id, const Parameter_sptr & param)
+    {
+      m_map[id].push_back(param);
+      ++m_nParameters;
+    }
+
+    /**
+     * @param comp :: A component
+     * @returns The parameters of the component, or NULL if it has none
+     */
+    const ParameterMap::ParameterBlock * ParameterMap::findBlock(const IComponent* comp) const
+    {
+      if( m_map.empty() ) return NULL;
+      pmap_cit it_found = m_map.find(comp->getComponentID());
+      if( it_found == m_map.end() ) return NULL;
+      return &it_found->second;
+    }
+
   } // Namespace Geometry
 } // Namespace Mantid
 
@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidGeometry/Math/RectangleClipping.h"
+#include <cmath>
+
+namespace Mantid
+{
+  namespace Geometry
+  {
+    namespace
+    {
+      /// The most vertices a quadrilateral can have after the clipping: each side adds at most two
+      const size_t MAX_VERTICES = 12;
+
+      /**
+       * Clip a polygon to the side of an axis-aligned line.
+       * @param in :: The X and Y of the vertices of the polygon
+       * @param nIn :: The number of vertices of the polygon
+       * @param out :: [Output] The X and Y of the vertices of the clipped polygon
+       * @param axis :: 0 for a line of constant X, 1 for a line of constant Y
+       * @param limit :: The X or Y of the line
+       * @param sign :: 1 to keep the part below the line, -1 to keep the part above it
+       * @returns The number of vertices of the clipped polygon
+       */
+      size_t clipToLine(const double (&in)[2][MAX_VERTICES], const size_t nIn,
+                        double (&out)[2][MAX_VERTICES], const size_t axis,
+                        const double limit, const double sign)
+      {
+        if( nIn == 0 ) return 0;
+        size_t nOut(0);
+        size_t prev = nIn - 1;
+        double prevDist = sign*(in[axis][prev] - limit);
+        for( size_t cur = 0; cur < nIn; ++cur )
+        {
+          const double curDist = sign*(in[axis][cur] - limit);
+          if( (prevDist <= 0.0) != (curDist <= 0.0) )
+          {
+            // The edge crosses the line
+            const double t = prevDist/(prevDist - curDist);
+            out[0][nOut] = in[0][prev] + t*(in[0][cur] - in[0][prev]);
+            out[1][nOut] = in[1][prev] + t*(in[1][cur] - in[1][prev]);
+            out[axis][nOut] = limit;
+            ++nOut;
+          }
+          if( curDist <= 0.0 )
+          {
+            out[0][nOut] = in[0][cur];
+            out[1][nOut] = in[1][cur];
+            ++nOut;
+          }
+          prev = cur;
+          prevDist = curDist;
+        }
+        return nOut;
+      }
+    }
+
+    /**
+     * Compute the overlap of a quadrilateral with an axis-aligned rectangle by clipping the
+     * quadrilateral to each side of the rectangle.
+     * @param quad :: The quadrilateral
+     * @param xmin :: The lower X edge of the rectangle
+     * @param xmax :: The upper X edge of the rectangle
+     * @param ymin :: The lower Y edge of the rectangle
+     * @param ymax :: The upper Y edge of the rectangle
+     * @param overlap :: [Output] The area and X range of the overlap, set only if they overlap
+     * @returns True if the overlap has a non-zero area
+     */
+    bool overlapWithRectangle(const Quadrilateral & quad, const double xmin, const double xmax,
+                              const double ymin, const double ymax, RectangleOverlap & overlap)
+    {
+      double first[2][MAX_VERTICES];
+      double second[2][MAX_VERTICES];
+      for( size_t i = 0; i < 4; ++i )
+      {
+        const Kernel::V2D & vertex = quad[i];
+        first[0][i] = vertex.X();
+        first[1][i] = vertex.Y();
+      }
+      size_t n = clipToLine(first, 4, second, 0, xmin, -1.0);
+      n = clipToLine(second, n, first, 0, xmax, 1.0);
+      n = clipToLine(first, n, second, 1, ymin, -1.0);
+      n = clipToLine(second, n, first, 1, ymax, 1.0);
+      if( n < 3 ) return false;
+
+      // Shoelace formula. The vertices may go either way round.
+      double twiceArea(0.0);
+      double smallestX(first[0][0]), largestX(first[0][0]);
+      size_t prev = n - 1;
+      for( size_t cur = 0; cur < n; ++cur )
+      {
+        twiceArea += first[0][prev]*first[1][cur] - first[0][cur]*first[1][prev];
+        if( first[0][cur] < smallestX ) smallestX = first[0][cur];
+        if( first[0][cur] > largestX ) largestX = first[0][cur];
+        prev = cur;
+      }
+      const double area = 0.5*std::fabs(twiceArea);
+      if( area <= 0.0 ) return false;
+
+      overlap.area = area;
+      overlap.smallestX = smallestX;
+      overlap.largestX = largestX;
+      return true;
+    }
+
+  } // namespace Geometry
+} // namespace Mantid
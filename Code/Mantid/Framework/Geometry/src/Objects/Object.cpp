@@ -17,6 +17,7 @@
 #include "MantidGeometry/Rendering/vtkGeometryCacheWriter.h"
 #include "MantidKernel/RegexStrings.h"
 #include "MantidKernel/Tolerance.h"
+#include <algorithm>
 #include <deque>
 #include <iostream>
 #include <stack>
@@ -823,6 +824,54 @@ namespace Mantid
       return (UT.count() - cnt);
     }
 
+    /**
+    * Finds where a ray leaves the object: the nearest point along the ray where it goes from the inside to the
+    * outside. For a ray starting inside the object this is the end of the first link of the track filled by
+    * interceptSurface(), but without building the track: the intersections are tried nearest first, so usually
+    * only one of them has to be classified. A ray starting outside the bounding box that misses it is
+    * rejected straight away (if the bounding box has already been calculated).
+    * @param start :: Start point of the ray
+    * @param direction :: Unit vector of the ray
+    * @param distance :: Set to the distance from the start point to the exit point, if the ray leaves the object
+    * @return True if the ray leaves the object
+    */
+    bool Object::exitDistance(const Kernel::V3D& start, const Kernel::V3D& direction, double& distance) const
+    {
+      if ( m_boundingBox.isNonNull() && m_boundingBox.isAxisAligned() &&
+           !m_boundingBox.doesLineIntersect(start, direction) )
+      {
+        return false;
+      }
+
+      LineIntersectVisit LI(start, direction);
+      std::vector<const Surface*>::const_iterator vc;
+      for (vc = SurList.begin(); vc != SurList.end(); ++vc)
+      {
+        (*vc)->acceptVisitor(LI);
+      }
+      const std::vector<Kernel::V3D>& IPts(LI.getPoints());
+      const std::vector<double>& dPts(LI.getDistance());
+
+      // Forward going points, nearest first
+      std::vector<std::pair<double,size_t> > order;
+      order.reserve(dPts.size());
+      for (size_t i = 0; i < dPts.size(); ++i)
+      {
+        if (dPts[i] > 0.0) order.push_back(std::make_pair(dPts[i], i));
+      }
+      std::sort(order.begin(), order.end());
+
+      for (size_t i = 0; i < order.size(); ++i)
+      {
+        if (calcValidType(IPts[order[i].second], direction) == -1)
+        {
+          distance = order[i].first;
+          return true;
+        }
+      }
+      return false;
+    }
+
     /**
     * Calculate if a point PT is a valid point on the track
     * @param Pt :: Point to calculate from.
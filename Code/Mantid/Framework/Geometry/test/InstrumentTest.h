@@ -297,6 +297,63 @@ public:
     TS_ASSERT( i.getDetectorIDs(false).empty() );
   }
 
+  void test_getBaseDetector()
+  {
+    TS_ASSERT_EQUALS( instrument.getBaseDetector(1), det );
+    TS_ASSERT_EQUALS( instrument.getBaseDetector(10), det2 );
+    TS_ASSERT_EQUALS( instrument.getBaseDetector(11), det3 );
+    TS_ASSERT( !instrument.getBaseDetector(0) );
+    TS_ASSERT( !instrument.getBaseDetector(2) );
+    TS_ASSERT( !instrument.getBaseDetector(-100) );
+    TS_ASSERT( !instrument.getBaseDetector(1000000) );
+
+    // The parametrized instrument gives the same base detectors
+    boost::shared_ptr<Instrument> base(new Instrument(instrument));
+    ParameterMap_sptr map(new ParameterMap());
+    Instrument parInstrument(base, map);
+    TS_ASSERT_EQUALS( parInstrument.getBaseDetector(10), base->getDetector(10).get() );
+    TS_ASSERT_EQUALS( parInstrument.getDetector(10)->getComponentID(), parInstrument.getBaseDetector(10)->getComponentID() );
+    TS_ASSERT( !parInstrument.getBaseDetector(2) );
+  }
+
+  void test_detector_lookup_with_compact_and_sparse_IDs()
+  {
+    // Detectors marked in decreasing order of ID
+    Instrument i;
+    std::vector<Detector*> dets;
+    for (detid_t id = 100; id > 0; --id)
+    {
+      dets.push_back(new Detector("det",id,&i));
+      i.add(dets.back());
+      i.markAsDetector(dets.back());
+    }
+    TS_ASSERT_THROWS( i.getDetector(0), Exception::NotFoundError );
+    TS_ASSERT_THROWS( i.getDetector(101), Exception::NotFoundError );
+
+    // A removed detector is not found any more (and is deleted)
+    i.removeDetector(dets.front());
+    dets.erase(dets.begin());
+    TS_ASSERT( !i.getBaseDetector(100) );
+    TS_ASSERT_THROWS( i.getDetector(100), Exception::NotFoundError );
+
+    // Then a few far away
+    dets.push_back(new Detector("far",1000000,&i));
+    i.add(dets.back());
+    i.markAsDetector(dets.back());
+    dets.push_back(new Detector("negative",-5,&i));
+    i.add(dets.back());
+    i.markAsDetector(dets.back());
+
+    for (size_t j = 0; j < dets.size(); ++j)
+    {
+      TS_ASSERT_EQUALS( i.getDetector(dets[j]->getID()).get(), dets[j] );
+      TS_ASSERT_EQUALS( i.getBaseDetector(dets[j]->getID()), dets[j] );
+    }
+    TS_ASSERT( !i.getBaseDetector(100) );
+    TS_ASSERT( !i.getBaseDetector(0) );
+    TS_ASSERT_EQUALS( i.getNumberDetectors(), 101 );
+  }
+
   void test_GetDetectors_With_All_Valid_IDs()
   {
     const size_t ndets(3);
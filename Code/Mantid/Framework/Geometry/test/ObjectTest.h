@@ -306,6 +306,64 @@ public:
     checkTrackIntercept(geom_obj,track,expectedResults);
   }
 
+  void testExitDistanceCappedCylinder()
+  {
+    Object_sptr geom_obj = createCappedCylinder();
+    double distance(-1.0);
+    // Through the side
+    TS_ASSERT( geom_obj->exitDistance(V3D(0,0,0), V3D(0,1,0), distance) );
+    TS_ASSERT_DELTA( distance, 3.0, 1e-6 );
+    // Through the caps
+    TS_ASSERT( geom_obj->exitDistance(V3D(0,1,0), V3D(1,0,0), distance) );
+    TS_ASSERT_DELTA( distance, 1.2, 1e-6 );
+    TS_ASSERT( geom_obj->exitDistance(V3D(0,1,0), V3D(-1,0,0), distance) );
+    TS_ASSERT_DELTA( distance, 3.2, 1e-6 );
+    // From outside, through the object
+    TS_ASSERT( geom_obj->exitDistance(V3D(-10,0,0), V3D(1,0,0), distance) );
+    TS_ASSERT_DELTA( distance, 11.2, 1e-6 );
+    // Missing it
+    TS_ASSERT( !geom_obj->exitDistance(V3D(-10,0,0), V3D(1,1,0)*(1.0/M_SQRT2), distance) );
+    TS_ASSERT( !geom_obj->exitDistance(V3D(-10,0,0), V3D(-1,0,0), distance) );
+    // With the bounding box, which is checked first
+    geom_obj->getBoundingBox();
+    TS_ASSERT( !geom_obj->exitDistance(V3D(-10,0,0), V3D(-1,0,0), distance) );
+    TS_ASSERT( geom_obj->exitDistance(V3D(-10,0,0), V3D(1,0,0), distance) );
+    TS_ASSERT_DELTA( distance, 11.2, 1e-6 );
+  }
+
+  void testExitDistanceMatchesInterceptSurface()
+  {
+    // A cube with a spherical hole
+    std::string ObjA="60001 -60002 60003 -60004 60005 -60006 71";
+    createSurfaces(ObjA);
+    Object object1=Object();
+    object1.setObject(3,ObjA);
+    object1.populate(SMap);
+
+    const V3D starts[] = { V3D(-0.9,0,0), V3D(0.5,0.7,-0.3), V3D(0,0,0.9), V3D(-0.95,-0.95,-0.95) };
+    const V3D directions[] = { V3D(1,0,0), V3D(0,-1,0), V3D(1,2,-3), V3D(-1,0.5,0.2), V3D(1,1,1) };
+    for (size_t i = 0; i < 4; ++i)
+    {
+      for (size_t j = 0; j < 5; ++j)
+      {
+        V3D direction = directions[j];
+        direction.normalize();
+        Track track(starts[i], direction);
+        double distance(-1.0);
+        const bool leaves = object1.exitDistance(starts[i], direction, distance);
+        TS_ASSERT_EQUALS( leaves, object1.interceptSurface(track) > 0 );
+        if ( leaves )
+        {
+          TS_ASSERT_DELTA( distance, track.begin()->distFromStart, 1e-6 );
+        }
+      }
+    }
+    // Through the hole
+    double distance(-1.0);
+    TS_ASSERT( object1.exitDistance(V3D(-0.9,0,0), V3D(1,0,0), distance) );
+    TS_ASSERT_DELTA( distance, 0.1, 1e-6 );
+  }
+
   void checkTrackIntercept(Track& track, const std::vector<Link>& expectedResults)
   {
     int index = 0;
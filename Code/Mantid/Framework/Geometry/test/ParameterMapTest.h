@@ -239,6 +239,24 @@ public:
     TSM_ASSERT_EQUALS("Parameter called first for inst should not exist", stored, Parameter_sptr());
   }
 
+  void testClearByName_for_Cmpt_Finds_The_Parameter_Wherever_It_Was_Added()
+  {
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "second", 10.3);
+    pmap.addDouble(m_testInstrument.get(), "first", 5.4);
+    pmap.addDouble(m_testInstrument.get(), "third", 1.2);
+    TS_ASSERT_EQUALS(pmap.size(), 3);
+    pmap.clearParametersByName("first",m_testInstrument.get());
+    TS_ASSERT_EQUALS(pmap.size(), 2);
+    TS_ASSERT( !pmap.contains(m_testInstrument.get(), "first") );
+    TS_ASSERT( pmap.contains(m_testInstrument.get(), "second") );
+    TS_ASSERT( pmap.contains(m_testInstrument.get(), "third") );
+    pmap.clearParametersByName("second");
+    pmap.clearParametersByName("third",m_testInstrument.get());
+    TS_ASSERT_EQUALS(pmap.size(), 0);
+    TS_ASSERT( pmap.empty() );
+  }
+
   void testClear_Results_In_Empty_Map()
   {
     ParameterMap pmap;
@@ -0,0 +1,98 @@
+#ifndef MANTID_GEOMETRY_RECTANGLECLIPPINGTEST_H_
+#define MANTID_GEOMETRY_RECTANGLECLIPPINGTEST_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidGeometry/Math/RectangleClipping.h"
+#include "MantidGeometry/Math/LaszloIntersection.h"
+#include <cxxtest/TestSuite.h>
+
+using Mantid::Kernel::V2D;
+using namespace Mantid::Geometry;
+
+class RectangleClippingTest : public CxxTest::TestSuite
+{
+public:
+
+  void test_Overlap_Of_Axis_Aligned_Squares()
+  {
+    Quadrilateral square(0.0, 2.0, 0.0, 2.0);
+    RectangleOverlap overlap;
+    TS_ASSERT( overlapWithRectangle(square, 1.0, 3.0, 1.0, 3.0, overlap) );
+    TS_ASSERT_DELTA( overlap.area, 1.0, 1e-12 );
+    TS_ASSERT_DELTA( overlap.smallestX, 1.0, 1e-12 );
+    TS_ASSERT_DELTA( overlap.largestX, 2.0, 1e-12 );
+  }
+
+  void test_Quadrilateral_Inside_Rectangle()
+  {
+    Quadrilateral quad(V2D(1.0, 1.0), V2D(2.0, 1.5), V2D(2.5, 3.0), V2D(0.5, 2.0));
+    RectangleOverlap overlap;
+    TS_ASSERT( overlapWithRectangle(quad, 0.0, 10.0, 0.0, 10.0, overlap) );
+    TS_ASSERT_DELTA( overlap.area, quad.area(), 1e-12 );
+    TS_ASSERT_DELTA( overlap.smallestX, 0.5, 1e-12 );
+    TS_ASSERT_DELTA( overlap.largestX, 2.5, 1e-12 );
+  }
+
+  void test_Rectangle_Inside_Quadrilateral()
+  {
+    Quadrilateral quad(V2D(-5.0, -4.0), V2D(6.0, -5.0), V2D(5.0, 6.0), V2D(-4.0, 5.0));
+    RectangleOverlap overlap;
+    TS_ASSERT( overlapWithRectangle(quad, 0.0, 1.0, 0.0, 2.0, overlap) );
+    TS_ASSERT_DELTA( overlap.area, 2.0, 1e-12 );
+    TS_ASSERT_DELTA( overlap.smallestX, 0.0, 1e-12 );
+    TS_ASSERT_DELTA( overlap.largestX, 1.0, 1e-12 );
+  }
+
+  void test_Matches_Laszlo_Intersection_For_A_Skewed_Quadrilateral()
+  {
+    Quadrilateral quad(V2D(0.1, 0.2), V2D(1.3, 0.5), V2D(1.6, 1.9), V2D(0.4, 1.4));
+    Quadrilateral rectangle(0.5, 1.5, 0.0, 1.0);
+    RectangleOverlap overlap;
+    TS_ASSERT( overlapWithRectangle(quad, 0.5, 1.5, 0.0, 1.0, overlap) );
+    ConvexPolygon expected = intersectionByLaszlo(rectangle, quad);
+    TS_ASSERT_DELTA( overlap.area, expected.area(), 1e-12 );
+    TS_ASSERT_DELTA( overlap.smallestX, expected.smallestX(), 1e-12 );
+    TS_ASSERT_DELTA( overlap.largestX, expected.largestX(), 1e-12 );
+  }
+
+  void test_No_Overlap()
+  {
+    Quadrilateral square(0.0, 1.0, 0.0, 1.0);
+    RectangleOverlap overlap;
+    TS_ASSERT( !overlapWithRectangle(square, 2.0, 3.0, 0.0, 1.0, overlap) );
+    // Touching along an edge only
+    TS_ASSERT( !overlapWithRectangle(square, 1.0, 2.0, 0.0, 1.0, overlap) );
+  }
+
+};
+
+
+class RectangleClippingTestPerformance : public CxxTest::TestSuite
+{
+public:
+
+  void test_Overlap_With_A_Grid()
+  {
+    Quadrilateral quad(V2D(0.1, 0.2), V2D(1.3, 0.5), V2D(1.6, 1.9), V2D(0.4, 1.4));
+    RectangleOverlap overlap;
+    double total(0.0);
+    for( size_t n = 0; n < 100; ++n )
+    {
+      for( size_t i = 0; i < 100; ++i )
+      {
+        for( size_t j = 0; j < 100; ++j )
+        {
+          const double x = 0.02*static_cast<double>(i);
+          const double y = 0.02*static_cast<double>(j);
+          if( overlapWithRectangle(quad, x, x + 0.02, y, y + 0.02, overlap) ) total += overlap.area;
+        }
+      }
+    }
+    TS_ASSERT_DELTA( total, 100.0*quad.area(), 1e-8 );
+  }
+
+};
+
+#endif /* MANTID_GEOMETRY_RECTANGLECLIPPINGTEST_H_ */
@@ -0,0 +1,85 @@
+#ifndef MANTID_KERNEL_BININDEXER_H_
+#define MANTID_KERNEL_BININDEXER_H_
+
+#include "MantidKernel/DllConfig.h"
+#include <vector>
+
+namespace Mantid
+{
+namespace Kernel
+{
+
+  /** BinIndexer : finds the bin index of many values in a set of bin boundaries.
+
+    The boundaries are inspected once on construction. If they are linear (constant
+    width) or logarithmic (constant ratio), the bin of a value is computed directly
+    from its distance to the first boundary, and corrected by at most a step in
+    each direction to absorb rounding; no search is done. Other boundaries fall back
+    to a binary search. A final bin of a different width, as produced by
+    VectorHelper::createAxisFromRebinParams(), keeps the direct calculation.
+
+    bins() computes the indices of a whole block of values in two passes: a
+    branch-free pass that the compiler can vectorise, then the correction pass.
+
+    The boundaries are not copied: they must outlive the BinIndexer.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+  */
+  class MANTID_KERNEL_DLL BinIndexer
+  {
+  public:
+    /// The kind of bin boundaries
+    enum BinningType { Arbitrary, Linear, Logarithmic };
+
+    BinIndexer(const std::vector<double> & binEdges);
+
+    /// The kind of bin boundaries that was detected
+    BinningType binningType() const { return m_type; }
+    /// True if the bin index is computed rather than searched for
+    bool isDirect() const { return m_type != Arbitrary; }
+    /// Number of bins, one less than the number of boundaries
+    size_t numBins() const { return m_numBins; }
+
+    int bin(const double x) const;
+    void bins(const double * x, const size_t n, int * indices) const;
+
+  private:
+    int correct(int guess, const double x) const;
+    int search(const double x) const;
+
+    /// The bin boundaries
+    const std::vector<double> & m_edges;
+    /// Number of bins
+    size_t m_numBins;
+    /// Type of the boundaries
+    BinningType m_type;
+    /// First boundary
+    double m_first;
+    /// Last boundary
+    double m_last;
+    /// 1/width for linear bins, 1/log(ratio) for logarithmic bins
+    double m_invStep;
+  };
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif  /* MANTID_KERNEL_BININDEXER_H_ */
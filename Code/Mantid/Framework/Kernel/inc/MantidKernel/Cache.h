@@ -7,6 +7,7 @@
 #include <map>
 #include "MantidKernel/DllConfig.h"
 #include "MantidKernel/MultiThreaded.h"
+#include <Poco/RWLock.h>
 
 namespace Mantid
 {
@@ -14,7 +15,8 @@ namespace Mantid
   {
     /** @class Cache Cache.h Kernel/Cache.h
 
-    Cache is a generic caching storage class.
+    Cache is a generic caching storage class. Any number of threads can look values up
+    at the same time; setting or removing a value waits for them.
 
     @author Nick Draper, Tessella Support Services plc
     @date 20/10/2009
@@ -45,7 +47,7 @@ namespace Mantid
     public:
 
       /// No-arg Constructor
-      Cache():m_cacheHit(0),m_cacheMiss(0),m_cacheMap(), m_mutex()
+      Cache():m_cacheHit(0),m_cacheMiss(0),m_cacheMap(), m_lock()
       {
       }
 
@@ -55,7 +57,7 @@ namespace Mantid
        */
       Cache(const Cache<KEYTYPE,VALUETYPE> & src) :
         m_cacheHit(src.m_cacheHit), m_cacheMiss(src.m_cacheMiss),
-        m_cacheMap(src.m_cacheMap), m_mutex() // New mutex which is unlocked
+        m_cacheMap(src.m_cacheMap), m_lock() // New lock which is unlocked
       {
       }
 
@@ -76,7 +78,7 @@ namespace Mantid
       /// Clears the cache
       void clear()
       {
-        MutexLocker lock(m_mutex);
+        WriteLocker lock(m_lock);
         m_cacheHit = 0;
         m_cacheMiss = 0;
         m_cacheMap.clear();
@@ -107,7 +109,7 @@ namespace Mantid
        */
       void setCache(const KEYTYPE& key, const VALUETYPE& value)
       {
-        MutexLocker lock(m_mutex);
+        WriteLocker lock(m_lock);
         m_cacheMap[key] = value;
       }
 
@@ -143,7 +145,7 @@ namespace Mantid
        */
       void removeCache(const KEYTYPE& key)
       {
-        MutexLocker lock(m_mutex);
+        WriteLocker lock(m_lock);
         m_cacheMap.erase(key);
       }
 
@@ -156,7 +158,7 @@ namespace Mantid
        */
       bool getCacheNoStats(const KEYTYPE key, VALUETYPE& value) const
       {
-        MutexLocker lock(m_mutex);
+        ReadLocker lock(m_lock);
         CacheMapConstIterator it_found = m_cacheMap.find(key);
         if (it_found == m_cacheMap.end()) 
         {
@@ -173,10 +175,12 @@ namespace Mantid
       mutable int m_cacheMiss;
       /// internal cache map
       std::map<const KEYTYPE,VALUETYPE > m_cacheMap;
-      /// internal mutex
-      mutable Poco::FastMutex m_mutex;
-      /// typedef for Scoped Lock
-      typedef Poco::FastMutex::ScopedLock MutexLocker;
+      /// internal lock, shared by the lookups
+      mutable Poco::RWLock m_lock;
+      /// typedef for Scoped Lock of the lookups
+      typedef Poco::ScopedReadRWLock ReadLocker;
+      /// typedef for Scoped Lock of the changes
+      typedef Poco::ScopedWriteRWLock WriteLocker;
       /// iterator typedef 
       typedef typename std::map<const KEYTYPE,VALUETYPE >::iterator CacheMapIterator;
       /// const_iterator typedef 
@@ -11,7 +11,9 @@
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
+#include <Poco/Condition.h>
 #include <map>
+#include <set>
 #include <stdint.h>
 #include <vector>
 #include <list>
@@ -31,6 +33,18 @@ namespace Kernel
     It also stores a list of "free" blocks in the output file,
     to allow new blocks to fill them later.
 
+    The to-write buffer is split into shards, each with its own lock.
+    A thread adds objects to its own shard, so threads filling boxes
+    at the same time do not wait for each other. When the buffer is
+    full, one thread takes the writable objects out of all the shards
+    and writes them in order of their position in the file, while the
+    other threads carry on adding to their shards.
+
+    Objects taken out to be written are "in flight" until the writer is
+    done with them. Use markBusy() before accessing the data of an
+    object: it waits for the object to be written out, if it is in flight,
+    so that its data are not saved or cleared from under the caller.
+
     @date 2011-12-30
 
     Copyright &copy; 2011 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
@@ -75,15 +89,16 @@ namespace Kernel
 
 
     DiskBuffer();
-    DiskBuffer(uint64_t m_writeBufferSize);
+    DiskBuffer(uint64_t m_writeBufferSize, size_t numShards = 0);
     virtual ~DiskBuffer();
 
     void toWrite(ISaveable *  item);
+    void markBusy(ISaveable * item);
     void flushCache();
     void objectDeleted(ISaveable * item);
 
     // Free space map methods
-    void freeBlock(uint64_t const pos, uint64_t const fileSize);
+    virtual void freeBlock(uint64_t const pos, uint64_t const fileSize);
     void defragFreeBlocks();
 
     // Allocating
@@ -110,9 +125,11 @@ namespace Kernel
     uint64_t getWriteBufferSize() const
     { return m_writeBufferSize; }
 
-    ///@return the memory used in the "toWrite" buffer, in number of events
-    uint64_t getWriteBufferUsed() const
-    { return m_writeBufferUsed;  }
+    uint64_t getWriteBufferUsed() const;
+
+    /// @return the number of independently locked parts of the "toWrite" buffer
+    size_t getNumShards() const
+    { return m_shards.size(); }
 
     //-------------------------------------------------------------------------------------------
     ///@return reference to the free space map (for testing only!)
@@ -132,24 +149,41 @@ namespace Kernel
     //-------------------------------------------------------------------------------------------
 
   protected:
-    inline void writeOldObjects();
+    /// One independently locked part of the "toWrite" buffer
+    struct WriteShard
+    {
+      WriteShard() : used(0), nObjects(0) {}
+      /// Mutex for modifying this shard
+      Kernel::Mutex mutex;
+      /** A forward list for the buffer of "toWrite" objects.   */
+      std::list<ISaveable * > toWrite;
+      /// Amount of memory in this shard
+      size_t used;
+      /// number of objects stored in this shard
+      size_t nObjects;
+    };
+
+    void initShards(size_t numShards);
+    size_t currentShard() const;
+    void writeOldObjects(bool wait);
+    void waitUntilWritten(ISaveable * item);
+    void finishedWriting(ISaveable * item);
 
     // ----------------------- To-write buffer --------------------------------------
-    /// Do we use the write buffer? Always now
-    //bool m_useWriteBuffer;
-
     /// Amount of memory to accumulate in the write buffer before writing.
     size_t m_writeBufferSize;
 
-    /// Total amount of memory in the "toWrite" buffer.
-    size_t m_writeBufferUsed;
-    /// number of objects stored in to write buffer list
-    size_t m_nObjectsToWrite;
-    /** A forward list for the buffer of "toWrite" objects.   */
-    std::list<ISaveable * > m_toWriteBuffer;
-
-    /// Mutex for modifying the the toWrite buffer.
-    Kernel::Mutex m_mutex;
+    /// The shards of the "toWrite" buffer
+    std::vector<WriteShard *> m_shards;
+
+    /// Mutex held while writing out; only one thread writes at a time.
+    Kernel::Mutex m_flushMutex;
+    /// Objects taken out of the shards that are being written out
+    std::set<ISaveable *> m_inFlight;
+    /// Mutex for the objects in flight and the busy flags of objects about to be written
+    Kernel::Mutex m_inFlightMutex;
+    /// Signalled when objects stop being in flight
+    Poco::Condition m_inFlightDone;
 
     // ----------------------- Free space map --------------------------------------
     /// Map of the free blocks in the file
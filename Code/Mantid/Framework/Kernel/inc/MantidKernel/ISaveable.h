@@ -143,6 +143,8 @@ namespace Kernel
     boost::optional< std::list<ISaveable * >::iterator> m_BufPosition;
     // the size of the object in the memory buffer, used to calculate the total amount of memory the objects occupy
     size_t m_BufMemorySize;
+    // the shard of the DiskBuffer whose to-write list holds m_BufPosition
+    size_t m_BufShard;
    /// Start point in the NXS file where the events are located
     uint64_t m_fileIndexStart;
     /// Number of events saved in the file, after the start index location
@@ -157,10 +159,12 @@ namespace Kernel
     void saveAt(uint64_t newPos, uint64_t newSize);
 
     /// sets the iterator pointing to the location of this object in the memory buffer to write later
-    size_t setBufferPosition(std::list<ISaveable * >::iterator bufPosition);
+    size_t setBufferPosition(std::list<ISaveable * >::iterator bufPosition, size_t shard = 0);
     /// returns the iterator pointing to the position of this object within the memory to-write buffer
     boost::optional<std::list<ISaveable *>::iterator > & getBufPostion()
     {return m_BufPosition;}
+    /// returns the shard of the to-write buffer that holds this object
+    size_t getBufferShard()const{return m_BufShard;}
     /// return the amount of memory, this object had when it was stored in buffer last time;
     size_t getBufferSize()const{return m_BufMemorySize;}
     void setBufferSize(size_t newSize){m_BufMemorySize = newSize;}
@@ -154,6 +154,22 @@ namespace Kernel
 
     }
 
+    //---------------------------------------------------------------------------------------------
+    /** Take the T at the given index out of the list, without deleting it.
+     *  @param index :: the key (index) for this T that you want to remove from the MRU.
+     *  @return the removed T, which the calling code must delete. NULL if it was not in the list.
+     */
+    T* remove(const size_t index)
+    {
+      Mutex::ScopedLock _lock(m_mutex);
+      auto it = il.template get<1>().find((int)index);
+      if (it == il.template get<1>().end())
+        return NULL;
+      T* item = *it;
+      il.template get<1>().erase(it);
+      return item;
+    }
+
     //---------------------------------------------------------------------------------------------
     /// Size of the list
     size_t size() const
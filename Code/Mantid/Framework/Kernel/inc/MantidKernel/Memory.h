@@ -54,6 +54,7 @@ namespace Mantid
       std::size_t totalMem() const;
       std::size_t availMem() const;
       std::size_t residentMem() const;
+      std::size_t peakResidentMem() const;
       std::size_t virtualMem() const;
       std::size_t reservedMem() const;
       double getFreeRatio() const;
@@ -62,6 +63,7 @@ namespace Mantid
       MemoryStatsIgnore ignore; ///< What fields to ignore.
       std::size_t vm_usage; ///< Virtual memory usage by process in kiB.
       std::size_t res_usage; ///< Resident memory usage by process in kiB.
+      std::size_t peak_res_usage; ///< Largest resident memory usage by process since it started in kiB.
       std::size_t total_memory; ///< Total physical memory of system in kiB.
       std::size_t avail_memory; ///< Available memory of system in kiB.
       friend MANTID_KERNEL_DLL std::ostream& operator<<(std::ostream& out, const MemoryStats &stats);
@@ -55,7 +55,7 @@ namespace Kernel
 
     ~ThreadPool();
 
-    void start(double waitSec = 0.0);
+    void start(double waitSec = 0.0, bool waitBetweenTasks = false);
 
     void schedule(Task * task, bool start = false);
 
@@ -24,7 +24,7 @@ namespace Kernel
   {
   public:
     ThreadPoolRunnable(size_t threadnum, ThreadScheduler * scheduler,
-        ProgressBase * prog = NULL, double waitSec = 0.0);
+        ProgressBase * prog = NULL, double waitSec = 0.0, bool waitBetweenTasks = false);
     ~ThreadPoolRunnable();
 
     /// Return the thread number of this thread.
@@ -36,6 +36,8 @@ namespace Kernel
     void clearWait();
 
   private:
+    void waitForTasks();
+
     /// ID of this thread.
     size_t m_threadnum;
 
@@ -47,6 +49,9 @@ namespace Kernel
 
     /// How many seconds you are allowed to wait with no tasks before exiting.
     double m_waitSec;
+
+    /// Also wait for new tasks when the scheduler runs empty between tasks
+    bool m_waitBetweenTasks;
   };
 
 
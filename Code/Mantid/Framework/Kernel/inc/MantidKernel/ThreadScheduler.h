@@ -115,7 +115,7 @@ namespace Kernel
 
     //-------------------------------------------------------------------------------
     /// Returns the total cost of all Task's in the queue.
-    double totalCost()
+    virtual double totalCost()
     {
       return m_cost;
     }
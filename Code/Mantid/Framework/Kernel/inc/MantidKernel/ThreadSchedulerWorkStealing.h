@@ -0,0 +1,148 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/Timer.h"
+#include <Poco/AtomicCounter.h>
+#include <Poco/ThreadLocal.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mantid
+{
+namespace Kernel
+{
+
+  /** Counters gathered by a ThreadSchedulerWorkStealing, for tuning.
+   */
+  struct MANTID_KERNEL_DLL ThreadSchedulerStatistics
+  {
+    ThreadSchedulerStatistics();
+    std::string toString() const;
+
+    /// Number of tasks pushed
+    size_t tasksPushed;
+    /// Number of tasks popped to be run
+    size_t tasksPopped;
+    /// Number of successful steals from another thread's queue
+    size_t steals;
+    /// Number of tasks moved by all the steals
+    size_t tasksStolen;
+    /// Number of times a thread found no task in any queue
+    size_t failedSteals;
+    /// Largest number of tasks seen in any one queue
+    size_t maxQueueDepth;
+    /// Total time, in seconds, that threads spent with no task to run
+    double idleSeconds;
+  };
+
+
+  /** ThreadSchedulerWorkStealing : a ThreadScheduler with one queue of tasks
+   * per thread, so that the threads of a ThreadPool do not all contend for
+   * the same lock.
+   *
+   * - push() adds the task to the queue of the calling thread when it is one of
+   *   the pool's threads (tasks creating sub-tasks keep them local), otherwise
+   *   it deals the tasks to the queues in turn.
+   * - pop() takes tasks in FIFO order from the thread's own queue. When that
+   *   queue is empty, the thread steals from the back of the queue with the
+   *   largest remaining cost, taking tasks worth up to half of that cost so
+   *   that it does not have to come back immediately.
+   * - A task whose mutex is held by a running task is passed over; it stays
+   *   queued until that task has finished, so two tasks with the same mutex
+   *   never run at once. Tasks without a mutex never touch a shared lock.
+   *
+   * Statistics (steals, idle time, queue depth) are kept per queue and summed
+   * by getStatistics().
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+  */
+  class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler
+  {
+  public:
+    ThreadSchedulerWorkStealing(size_t numThreads = 0);
+    virtual ~ThreadSchedulerWorkStealing();
+
+    void push(Task * newTask);
+    Task * pop(size_t threadnum);
+    void finished(Task * task, size_t threadnum);
+    size_t size();
+    bool empty();
+    void clear();
+    double totalCost();
+
+    /// Number of per-thread queues
+    size_t numQueues() const { return m_queues.size(); }
+    size_t queueSize(size_t threadnum);
+    ThreadSchedulerStatistics getStatistics();
+
+  private:
+    /// A task and its cost when it was pushed
+    typedef std::pair<double, Task*> QueuedTask;
+
+    /// The queue of one thread, with its statistics
+    struct WorkQueue
+    {
+      WorkQueue();
+      /// Protects this queue
+      Mutex lock;
+      /// The tasks, oldest first
+      std::deque<QueuedTask> tasks;
+      /// Sum of the costs of the tasks
+      double cost;
+      /// Statistics of the thread owning this queue
+      ThreadSchedulerStatistics stats;
+      /// Is the owning thread idle?
+      bool idle;
+      /// Time since the owning thread became idle
+      Timer idleTimer;
+    };
+
+    Task * take(WorkQueue & queue, const bool fromFront);
+    Task * steal(size_t thief);
+    bool reserveMutex(Task * task);
+    void addToQueue(WorkQueue & queue, const QueuedTask & task);
+
+    /// One queue per thread
+    std::vector<WorkQueue *> m_queues;
+    /// Total number of queued tasks, read by empty() without locking
+    Poco::AtomicCounter m_numTasks;
+    /// Queue that the next push() from outside the pool goes to
+    Poco::AtomicCounter m_nextQueue;
+    /// Unique ID of this scheduler, to recognise its entry in m_localQueue
+    int m_id;
+    /// (scheduler ID, queue) of the calling thread, set when it pops from this scheduler
+    Poco::ThreadLocal<std::pair<int, size_t> > m_localQueue;
+    /// Protects m_mutexes
+    Mutex m_mutexesLock;
+    /// Mutexes of the tasks being run, with the number of running tasks holding each
+    std::map<boost::shared_ptr<Mutex>, size_t> m_mutexes;
+  };
+
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif  /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
@@ -7,6 +7,7 @@
 #include "MantidKernel/DllConfig.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/ITimeSeriesProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
 #include <utility>
@@ -139,6 +140,8 @@ namespace Mantid
     public:
       /// Constructor
       explicit TimeSeriesProperty(const std::string &name);
+      /// Copy constructor
+      TimeSeriesProperty(const TimeSeriesProperty<TYPE> &other);
       /// Virtual destructor
       virtual ~TimeSeriesProperty();
       /// "Virtual" copy constructor
@@ -290,6 +293,8 @@ namespace Mantid
       void applyFilter() const;
       /// A new algorithm to find Nth index.  It is simple and leave a lot work to the callers
       size_t findNthIndexFromQuickRef(int n) const;
+      /// Fill m_cumulativeIntegral if it is empty
+      void buildCumulativeIntegral() const;
       /// Set a value from another property
       virtual std::string setValueFromProperty( const Property& right );
 
@@ -308,6 +313,12 @@ namespace Mantid
       mutable std::vector<std::pair<size_t, size_t> > m_filterQuickRef;
       /// True if a filter has been applied
       mutable bool m_filterApplied;
+
+      /// Time-integral of the (sorted) values from the first time to the time of each entry, in value*seconds.
+      /// Built on demand by the time averages; empty if the values changed since.
+      mutable std::vector<double> m_cumulativeIntegral;
+      /// Lock for m_cumulativeIntegral, which is filled by const methods
+      mutable Mutex m_cumulativeIntegralMutex;
     };
 
     /// Function filtering double TimeSeriesProperties according to the requested statistics.
@@ -2,6 +2,7 @@
 #define TIMESPLITTER_H
 
 #include "MantidKernel/DateAndTime.h"
+#include <vector>
 
 namespace Mantid
 {
@@ -61,6 +62,75 @@ private:
  */
 typedef std::vector< SplittingInterval > TimeSplitterType;
 
+
+/**
+ * A read-only form of a TimeSplitterType made to split many events.
+ *
+ * The intervals are sorted once, and the interval holding a time is found by a binary
+ * search, so the cost per event does not grow with the number of intervals. The
+ * destinations are numbered as "outputs" 0..getNumberOfOutputs()-1: output 0 is for the times
+ * before or between the intervals (destination index -1), and the others follow the destination
+ * indexes in increasing order.
+ * Times at or after the end of the last interval have no output (NO_OUTPUT).
+ * The intervals should not overlap; if they do, the interval which starts last wins.
+ *
+ * Nothing changes once it is built, so one index can be shared by all the threads splitting events.
+ */
+class MANTID_KERNEL_DLL TimeSplitterIndex
+{
+public:
+  /// Output of the times after the last interval
+  static const size_t NO_OUTPUT;
+
+  explicit TimeSplitterIndex(const TimeSplitterType & splitter);
+
+  /// @return the number of outputs, including the one for the times outside of the intervals
+  size_t getNumberOfOutputs() const { return m_outputIndexes.size(); }
+  /// @return the destination index of an output (-1 for output 0)
+  int getOutputIndex(const size_t output) const { return m_outputIndexes[output]; }
+  /// @return the number of intervals
+  size_t size() const { return m_starts.size(); }
+
+  size_t getOutput(const int64_t time) const;
+
+  /** Get the output of a time, starting with the guess that it is in the same place as the time before.
+   * This makes runs of sorted times cheap.
+   * @param time :: absolute time in nanoseconds
+   * @param hint :: position found for the previous time, updated. Start with 0.
+   * @return the output for the time, or NO_OUTPUT
+   */
+  inline size_t getOutput(const int64_t time, size_t & hint) const
+  {
+    if ((hint > 0 && time < m_starts[hint-1]) || (hint < m_starts.size() && time >= m_starts[hint]))
+      hint = findPosition(time);
+    return outputAtPosition(time, hint);
+  }
+
+private:
+  size_t findPosition(const int64_t time) const;
+
+  /** @return the output of a time, knowing the number of intervals which start at or before it
+   * @param time :: absolute time in nanoseconds
+   * @param position :: number of intervals starting at or before the time */
+  inline size_t outputAtPosition(const int64_t time, const size_t position) const
+  {
+    if (position == 0)
+      return 0;
+    if (time < m_stops[position-1])
+      return m_intervalOutputs[position-1];
+    return (position == m_starts.size()) ? NO_OUTPUT : 0;
+  }
+
+  /// start of each interval, in nanoseconds, sorted
+  std::vector<int64_t> m_starts;
+  /// end of each interval, in nanoseconds
+  std::vector<int64_t> m_stops;
+  /// output of each interval
+  std::vector<size_t> m_intervalOutputs;
+  /// the destination index of each output
+  std::vector<int> m_outputIndexes;
+};
+
 // -------------- Operators ---------------------
 MANTID_KERNEL_DLL TimeSplitterType operator +(const TimeSplitterType& a, const TimeSplitterType& b);
 MANTID_KERNEL_DLL TimeSplitterType operator &(const TimeSplitterType& a, const TimeSplitterType& b);
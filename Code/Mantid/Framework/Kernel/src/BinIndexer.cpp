@@ -0,0 +1,152 @@
+#include "MantidKernel/BinIndexer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Mantid
+{
+namespace Kernel
+{
+  namespace
+  {
+    /// Relative tolerance on the bin widths/ratios for the bins to count as regular
+    const double REGULAR_TOLERANCE = 1e-6;
+    /// Number of values whose index is computed in one go by bins()
+    const size_t BLOCK_SIZE = 256;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Constructor. Inspects the boundaries to choose how bins are found.
+   *
+   * @param binEdges :: the bin boundaries, ascending. Must outlive this object.
+   */
+  BinIndexer::BinIndexer(const std::vector<double> & binEdges)
+    : m_edges(binEdges), m_numBins(0), m_type(Arbitrary), m_first(0.), m_last(0.), m_invStep(0.)
+  {
+    if (binEdges.size() < 2)
+      return;
+    m_numBins = binEdges.size() - 1;
+    m_first = binEdges.front();
+    m_last = binEdges.back();
+
+    // The last bin may have any width (see createAxisFromRebinParams()): correct() clamps to it.
+    const size_t numChecked = (m_numBins > 1) ? m_numBins - 1 : 1;
+
+    const double width = binEdges[1] - binEdges[0];
+    if (width <= 0.)
+      return;
+    bool linear = true;
+    for (size_t i = 1; i < numChecked && linear; ++i)
+      linear = (std::fabs((binEdges[i+1] - binEdges[i]) - width) <= REGULAR_TOLERANCE * width);
+    if (linear)
+    {
+      m_type = Linear;
+      m_invStep = 1.0 / width;
+      return;
+    }
+
+    if (binEdges[0] <= 0.)
+      return;
+    const double ratio = binEdges[1] / binEdges[0];
+    bool logarithmic = true;
+    for (size_t i = 1; i < numChecked && logarithmic; ++i)
+      logarithmic = (std::fabs(binEdges[i+1] / binEdges[i] - ratio) <= REGULAR_TOLERANCE * ratio);
+    if (logarithmic)
+    {
+      m_type = Logarithmic;
+      m_invStep = 1.0 / std::log(ratio);
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Find the bin of a value. Bin i holds values in [X[i], X[i+1]).
+   * @param x :: the value
+   * @return the bin index, or -1 if the value is outside of the boundaries.
+   */
+  int BinIndexer::bin(const double x) const
+  {
+    if (!(x >= m_first && x < m_last))
+      return -1;
+    switch (m_type)
+    {
+    case Linear:
+      return correct(static_cast<int>((x - m_first) * m_invStep), x);
+    case Logarithmic:
+      return correct(static_cast<int>(std::log(x / m_first) * m_invStep), x);
+    default:
+      return search(x);
+    }
+  }
+
+  /** Find the bins of a block of values.
+   * @param x :: pointer to the values
+   * @param n :: number of values
+   * @param indices :: filled with the n bin indices, -1 for values outside of the boundaries.
+   */
+  void BinIndexer::bins(const double * x, const size_t n, int * indices) const
+  {
+    if (m_type == Arbitrary)
+    {
+      for (size_t i = 0; i < n; ++i)
+        indices[i] = this->bin(x[i]);
+      return;
+    }
+
+    double guess[BLOCK_SIZE];
+    const double first = m_first;
+    const double invStep = m_invStep;
+    for (size_t start = 0; start < n; start += BLOCK_SIZE)
+    {
+      const size_t count = std::min(BLOCK_SIZE, n - start);
+      const double * values = x + start;
+      // Pass 1: no branches, so this loop can be vectorised
+      if (m_type == Linear)
+      {
+        for (size_t i = 0; i < count; ++i)
+          guess[i] = (values[i] - first) * invStep;
+      }
+      else
+      {
+        for (size_t i = 0; i < count; ++i)
+          guess[i] = std::log(values[i] / first) * invStep;
+      }
+      // Pass 2: range check and rounding correction
+      for (size_t i = 0; i < count; ++i)
+      {
+        const double value = values[i];
+        if (value >= first && value < m_last)
+          indices[start + i] = correct(static_cast<int>(guess[i]), value);
+        else
+          indices[start + i] = -1;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Correct a computed bin index for rounding errors and a narrow last bin.
+   * @param guess :: the computed index
+   * @param x :: the value, known to be within the boundaries
+   * @return the bin that holds x
+   */
+  int BinIndexer::correct(int guess, const double x) const
+  {
+    const int lastBin = static_cast<int>(m_numBins) - 1;
+    if (guess < 0) guess = 0;
+    if (guess > lastBin) guess = lastBin;
+    while (guess > 0 && x < m_edges[guess])
+      --guess;
+    while (guess < lastBin && x >= m_edges[guess+1])
+      ++guess;
+    return guess;
+  }
+
+  /** Find the bin of a value by a binary search.
+   * @param x :: the value, known to be within the boundaries
+   * @return the bin that holds x
+   */
+  int BinIndexer::search(const double x) const
+  {
+    return static_cast<int>(std::upper_bound(m_edges.begin(), m_edges.end(), x) - m_edges.begin()) - 1;
+  }
+
+} // namespace Kernel
+} // namespace Mantid
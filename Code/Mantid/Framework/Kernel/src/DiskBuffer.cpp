@@ -1,6 +1,10 @@
 #include "MantidKernel/DiskBuffer.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/ThreadPool.h"
+#include <Poco/AtomicCounter.h>
 #include <Poco/ScopedLock.h>
+#include <Poco/ThreadLocal.h>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -12,35 +16,59 @@ namespace Kernel
 {
 
 #define DISK_BUFFER_SIZE_TO_REPORT_WRITE  10000
+
+  namespace
+  {
+    /// Shard used by each thread (+1; 0 until the thread first adds an object)
+    Poco::ThreadLocal<size_t> g_threadShard;
+    /// Number of threads that were given a shard
+    Poco::AtomicCounter g_numThreadShards(0);
+
+    /// An object to write and where it goes in the file
+    struct BlockToWrite
+    {
+      BlockToWrite(ISaveable * obj, uint64_t pos, uint64_t size) : obj(obj), pos(pos), size(size) {}
+      ISaveable * obj;
+      uint64_t pos;
+      uint64_t size;
+    };
+
+    /// Order by position in the file
+    bool compareFilePosition(const BlockToWrite & lhs, const BlockToWrite & rhs)
+    {
+      return lhs.pos < rhs.pos;
+    }
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Constructor
    */
   DiskBuffer::DiskBuffer() :
     m_writeBufferSize(50),  
-    m_writeBufferUsed(0),
-    m_nObjectsToWrite(0),
     m_free(),
     m_free_bySize( m_free.get<1>() ),
     m_fileLength(0)
   {
     m_free.clear();
+    initShards(0);
   }
 
   //----------------------------------------------------------------------------------------------
   /** Constructor
    *
    * @param m_writeBufferSize :: Amount of memory to accumulate in the write buffer before writing.
+   * @param numShards :: number of independently locked parts of the write buffer.
+   *        Default 0 = the number of cores.
    * @return
    */
-  DiskBuffer::DiskBuffer(uint64_t m_writeBufferSize) :
+  DiskBuffer::DiskBuffer(uint64_t m_writeBufferSize, size_t numShards) :
     m_writeBufferSize(m_writeBufferSize),
-    m_writeBufferUsed(0),
-    m_nObjectsToWrite(0),
     m_free(),
     m_free_bySize( m_free.get<1>() ),
     m_fileLength(0)
   {
     m_free.clear();
+    initShards(numShards);
   }
     
   //----------------------------------------------------------------------------------------------
@@ -48,8 +76,32 @@ namespace Kernel
    */
   DiskBuffer::~DiskBuffer()
   {
+    for (size_t i=0; i < m_shards.size(); i++)
+      delete m_shards[i];
   }
-  
+
+  /** Create the shards of the to-write buffer
+   * @param numShards :: number of shards, 0 = the number of cores */
+  void DiskBuffer::initShards(size_t numShards)
+  {
+    if (numShards == 0)
+      numShards = ThreadPool::getNumPhysicalCores();
+    if (numShards == 0)
+      numShards = 1;
+    for (size_t i=0; i < numShards; i++)
+      m_shards.push_back(new WriteShard());
+  }
+
+  /** @return the shard the calling thread adds new objects to.
+   * Threads are given shards in turn, the first time they add an object. */
+  size_t DiskBuffer::currentShard() const
+  {
+    size_t & shard = g_threadShard.get();
+    if (shard == 0)
+      shard = static_cast<size_t>(++g_numThreadShards);
+    return (shard - 1) % m_shards.size();
+  }
+
   //---------------------------------------------------------------------------------------------
   /** Call this method when an object is ready to be written
    * out to disk.
@@ -57,40 +109,87 @@ namespace Kernel
    * When the to-write buffer is full, all of it gets written
    * out to disk using writeOldObjects()
    *
+   * If the item is being written out right now, this waits for the writer
+   * to be done with it first.
+   *
    * @param item :: item that can be written to disk.
    */
   void DiskBuffer::toWrite(ISaveable * item)
   {
     if (item == NULL) return;
-//    if (!m_useWriteBuffer) return;
+    waitUntilWritten(item);
 
+    bool inBuffer = false;
     if(item->getBufPostion()) // already in the buffer and probably have changed its size in memory
     {
+      WriteShard & shard = *m_shards[item->getBufferShard() % m_shards.size()];
+      Mutex::ScopedLock _lock(shard.mutex);
+      // Check again: it may have been taken out to be written in the meantime
+      if(item->getBufPostion())
+      {
         // forget old memory size
-        m_mutex.lock();	
-          m_writeBufferUsed-=item->getBufferSize();
-          // add new size
-          size_t newMemorySize =item->getDataMemorySize(); 
-          m_writeBufferUsed+=newMemorySize;
-        m_mutex.unlock();	
+        shard.used -= item->getBufferSize();
+        // add new size
+        size_t newMemorySize = item->getDataMemorySize();
+        shard.used += newMemorySize;
         item->setBufferSize(newMemorySize);
+        inBuffer = true;
+      }
     }
-    else
+    if (!inBuffer)
     {
-        m_mutex.lock();
-            m_toWriteBuffer.push_front(item);
-            m_writeBufferUsed += item->setBufferPosition(m_toWriteBuffer.begin());
-            m_nObjectsToWrite++;
-        m_mutex.unlock();
+      const size_t index = currentShard();
+      WriteShard & shard = *m_shards[index];
+      Mutex::ScopedLock _lock(shard.mutex);
+      shard.toWrite.push_front(item);
+      shard.used += item->setBufferPosition(shard.toWrite.begin(), index);
+      shard.nObjects++;
     }
-     
 
-   // Should we now write out the old data?
-     if (m_writeBufferUsed > m_writeBufferSize)
-          writeOldObjects();
+    // Should we now write out the old data?
+    // The shards are added up without locking: an approximate total is good enough here.
+    size_t used = 0;
+    for (size_t i=0; i < m_shards.size(); i++)
+      used += m_shards[i]->used;
+    if (used > m_writeBufferSize)
+      writeOldObjects(false);
+  }
 
+  //---------------------------------------------------------------------------------------------
+  /** Call this method, rather than ISaveable::setBusy(true), before accessing
+   * the data of an object.
+   * If the object is being written out, this waits for the writer to be done with it
+   * (the data will then have to be loaded again). The writer checks the busy flag under
+   * the same lock, so it either sees the object busy and leaves it alone, or
+   * has it in flight and this waits.
+   *
+   * @param item :: ISaveable object whose data are going to be accessed.
+   */
+  void DiskBuffer::markBusy(ISaveable * item)
+  {
+    if (item == NULL) return;
+    Mutex::ScopedLock _lock(m_inFlightMutex);
+    while (m_inFlight.find(item) != m_inFlight.end())
+      m_inFlightDone.wait(m_inFlightMutex);
+    item->setBusy(true);
+  }
 
+  /** Wait for the writer to be done with an object, if it is in flight
+   * @param item :: ISaveable object */
+  void DiskBuffer::waitUntilWritten(ISaveable * item)
+  {
+    Mutex::ScopedLock _lock(m_inFlightMutex);
+    while (m_inFlight.find(item) != m_inFlight.end())
+      m_inFlightDone.wait(m_inFlightMutex);
+  }
 
+  /** The writer is done with an object: wake up the threads waiting for it
+   * @param item :: ISaveable object */
+  void DiskBuffer::finishedWriting(ISaveable * item)
+  {
+    Mutex::ScopedLock _lock(m_inFlightMutex);
+    m_inFlight.erase(item);
+    m_inFlightDone.broadcast();
   }
 
   //---------------------------------------------------------------------------------------------
@@ -104,24 +203,22 @@ namespace Kernel
   void DiskBuffer::objectDeleted(ISaveable * item)
   {
     if(item==NULL)return ;
+    // A write in progress may be using the object: wait for it to finish.
+    Mutex::ScopedLock _flushLock(m_flushMutex);
     // have it ever been in the buffer?
-    m_mutex.lock();
     auto opt2it = item->getBufPostion();
-    if(opt2it)
-    {
-          m_writeBufferUsed -=item->getBufferSize();
-          m_toWriteBuffer.erase(*opt2it);
-    }
-    else
-    {
-        m_mutex.unlock();
-        return;
-    }
+    if(!opt2it)
+      return;
 
+    {
+      WriteShard & shard = *m_shards[item->getBufferShard() % m_shards.size()];
+      Mutex::ScopedLock _lock(shard.mutex);
+      shard.used -= item->getBufferSize();
+      shard.toWrite.erase(*opt2it);
+      shard.nObjects--;
       // indicate to the object that it is not stored in memory any more
-     item->clearBufferState();
-     m_mutex.unlock();
-    //std::cout << "DiskBuffer deleting ID " << item->getId() << "; new size " << m_writeBuffer.size() << std::endl;
+      item->clearBufferState();
+    }
 
     // Mark the amount of space used on disk as free
     if(item->wasSaved())
@@ -132,93 +229,151 @@ namespace Kernel
   //---------------------------------------------------------------------------------------------
   /** Method to write out the old objects that have been
    * stored in the "toWrite" buffer.
+   *
+   * The objects that are not busy are taken out of all the shards, which are
+   * each locked only for that time. They are then given their place in the file
+   * and written in order of file position, so that neighbouring boxes are
+   * written one after the other and the data are flushed only once.
+   * The objects stay in flight until written, so that toWrite() and markBusy()
+   * on them wait for the writer.
+   *
+   * @param wait :: if another thread is already writing, wait for it and write
+   *        out again. If false, return at once and leave the writing to that thread.
    */
-  void DiskBuffer::writeOldObjects()
+  void DiskBuffer::writeOldObjects(bool wait)
   {
-    if (m_writeBufferUsed > DISK_BUFFER_SIZE_TO_REPORT_WRITE)
-      std::cout << "DiskBuffer:: Writing out " << m_writeBufferUsed << " events in " << m_nObjectsToWrite << " objects." << std::endl;
-
-    Poco::ScopedLock<Kernel::Mutex> _lock(m_mutex);
-    // Holder for any objects that you were NOT able to write.
-    std::list<ISaveable *> couldNotWrite;
-    size_t objectsNotWritten(0);
-    size_t memoryNotWritten(0);
+    if (wait)
+      m_flushMutex.lock();
+    else if (!m_flushMutex.tryLock())
+      return;
 
+    try
+    {
+      // Take the writable objects out of the shards
+      std::vector<ISaveable *> toSave;
+      size_t memoryToWrite(0);
+      for (size_t i=0; i < m_shards.size(); i++)
+      {
+        WriteShard & shard = *m_shards[i];
+        Mutex::ScopedLock _lock(shard.mutex);
+        Mutex::ScopedLock _inFlightLock(m_inFlightMutex);
+        auto it = shard.toWrite.begin();
+        while (it != shard.toWrite.end())
+        {
+          ISaveable * obj = *it;
+          if (obj->isBusy())
+          {
+            // The object is busy, can't write. Leave it for later
+            ++it;
+            continue;
+          }
+          memoryToWrite += obj->getBufferSize();
+          shard.used -= obj->getBufferSize();
+          shard.nObjects--;
+          it = shard.toWrite.erase(it);
+          // tell the object that it has been removed from the buffer
+          obj->clearBufferState();
+          m_inFlight.insert(obj);
+          toSave.push_back(obj);
+        }
+      }
 
+      // Check again for objects that became busy since: they are not written now,
+      // and will be put back in the buffer by their user. From here on markBusy()
+      // waits for the others, so they cannot become busy while being written.
+      {
+        Mutex::ScopedLock _lock(m_inFlightMutex);
+        std::vector<ISaveable *> notBusy;
+        notBusy.reserve(toSave.size());
+        for (size_t i=0; i < toSave.size(); i++)
+        {
+          if (toSave[i]->isBusy())
+            m_inFlight.erase(toSave[i]);
+          else
+            notBusy.push_back(toSave[i]);
+        }
+        if (notBusy.size() != toSave.size())
+          m_inFlightDone.broadcast();
+        toSave.swap(notBusy);
+      }
 
-    // Iterate through the list
-    auto it = m_toWriteBuffer.begin();
-    auto it_end = m_toWriteBuffer.end();
+      if (memoryToWrite > DISK_BUFFER_SIZE_TO_REPORT_WRITE)
+        std::cout << "DiskBuffer:: Writing out " << memoryToWrite << " events in " << toSave.size() << " objects." << std::endl;
 
-    ISaveable * obj = NULL;
+      // Objects with events added while the rest is on file load that rest when saved.
+      // Do it now, before their old place in the file can be given to another object.
+      for (size_t i=0; i < toSave.size(); i++)
+      {
+        if (toSave[i]->wasSaved() && !toSave[i]->isLoaded())
+          toSave[i]->load();
+      }
 
-    for (; it != it_end; ++it)
-    {
-      obj = *it;
-      if (!obj->isBusy())
+      // Find where each object goes, in the order they were taken out.
+      std::vector<BlockToWrite> blocks;
+      blocks.reserve(toSave.size());
+      for (size_t i=0; i < toSave.size(); i++)
       {
+        ISaveable * obj = toSave[i];
         uint64_t NumObjEvents = obj->getTotalDataSize();
-        uint64_t fileIndexStart;
         if (!obj->wasSaved())
         {
-            fileIndexStart=this->allocate(NumObjEvents);
-           // Write to the disk; this will call the object specific save function;
-          // Prevent simultaneous file access (e.g. write while loading)
-            obj->saveAt(fileIndexStart,NumObjEvents);
+          blocks.push_back(BlockToWrite(obj, this->allocate(NumObjEvents), NumObjEvents));
         }
         else
         {
           uint64_t NumFileEvents= obj->getFileSize();
           if (NumObjEvents != NumFileEvents)
           {
-          // Event list changed size. The MRU can tell us where it best fits now.
-            fileIndexStart= this->relocate(obj->getFilePosition(), NumFileEvents, NumObjEvents);
-           // Write to the disk; this will call the object specific save function;
-            obj->saveAt(fileIndexStart,NumObjEvents);
-          }       
+            // Event list changed size. The MRU can tell us where it best fits now.
+            blocks.push_back(BlockToWrite(obj, this->relocate(obj->getFilePosition(), NumFileEvents, NumObjEvents), NumObjEvents));
+          }
           else // despite object size have not been changed, it can be modified other way. In this case, the method which changed the data should set dataChanged ID
           {
             if(obj->isDataChanged())
             {
-              fileIndexStart = obj->getFilePosition();
-              // Write to the disk; this will call the object specific save function;
-              obj->saveAt(fileIndexStart,NumObjEvents);
+              uint64_t fileIndexStart = obj->getFilePosition();
+              blocks.push_back(BlockToWrite(obj, fileIndexStart, NumObjEvents));
               // this is questionable operation, which adjust file size in case when the file postions were allocated externaly
+              Mutex::ScopedLock _lock(m_freeMutex);
               if(fileIndexStart+NumObjEvents>m_fileLength)m_fileLength=fileIndexStart+NumObjEvents;
             }
             else // just clean the object up -- it just occupies memory
+            {
               obj->clearDataFromMemory();
+              finishedWriting(obj);
+            }
           }
         }
-       // tell the object that it has been removed from the buffer
-        obj->clearBufferState();
-      } 
-      else // object busy
+      }
+
+      // Write to the disk in file order; this will call the object specific save function
+      std::stable_sort(blocks.begin(), blocks.end(), compareFilePosition);
+      for (size_t i=0; i < blocks.size(); i++)
       {
-        // The object is busy, can't write. Save it for later
-        couldNotWrite.push_back(obj );	
-        // When a prefix or postfix operator is applied to a function argument, the value of the argument is 
-        // NOT GUARANTEED to be incremented or decremented before it is passed to the function.
-        std::list<ISaveable * >::iterator it = --couldNotWrite.end();
-        memoryNotWritten += obj->setBufferPosition(it);
-        objectsNotWritten++;
+        blocks[i].obj->saveAt(blocks[i].pos, blocks[i].size);
+        finishedWriting(blocks[i].obj);
       }
-    }
 
-    // use last object to clear NeXus buffer and actually write data to HDD
-    if (obj)
+      // use last object to clear NeXus buffer and actually write data to HDD
+      if (!toSave.empty())
+      {
+        // NXS needs to flush the writes to file by closing and re-opening the data block.
+        // For speed, it is best to do this only once per write dump, using last object saved
+        toSave.back()->flushData();
+      }
+    }
+    catch (...)
     {
-      // NXS needs to flush the writes to file by closing and re-opening the data block.
-      // For speed, it is best to do this only once per write dump, using last object saved
-      obj->flushData();
+      // Do not leave anyone waiting for objects that will not be written
+      {
+        Mutex::ScopedLock _lock(m_inFlightMutex);
+        m_inFlight.clear();
+        m_inFlightDone.broadcast();
+      }
+      m_flushMutex.unlock();
+      throw;
     }
-
-    // Exchange with the new map you built out of the not-written blocks.
-    m_toWriteBuffer.swap(couldNotWrite);
-    m_writeBufferUsed = memoryNotWritten;
-    m_nObjectsToWrite = objectsNotWritten;
-
-   
+    m_flushMutex.unlock();
   }
 
 
@@ -227,13 +382,26 @@ namespace Kernel
   void DiskBuffer::flushCache()
   {
     // Now write everything out.
-    writeOldObjects();
+    writeOldObjects(true);
+  }
+
+  ///@return the memory used in the "toWrite" buffer, in number of events
+  uint64_t DiskBuffer::getWriteBufferUsed() const
+  {
+    uint64_t used = 0;
+    for (size_t i=0; i < m_shards.size(); i++)
+    {
+      Mutex::ScopedLock _lock(m_shards[i]->mutex);
+      used += m_shards[i]->used;
+    }
+    return used;
   }
 
   //---------------------------------------------------------------------------------------------
   /** This method is called by this->relocate when object that has shrunk
    * and so has left a bit of free space after itself on the file;
    * or when an object gets moved to a new spot.
+   * IO classes which hold the data themselves override it to release the data of the block.
    *
    * @param pos :: position in the file of the START of the new free block
    * @param size :: size of the free block
@@ -419,7 +587,13 @@ namespace Kernel
   std::string DiskBuffer::getMemoryStr() const
   {
     std::ostringstream mess;
-    mess << "Buffer: "  << m_writeBufferUsed << " in " << m_nObjectsToWrite << " objects. ";
+    size_t nObjects = 0;
+    for (size_t i=0; i < m_shards.size(); i++)
+    {
+      Mutex::ScopedLock _lock(m_shards[i]->mutex);
+      nObjects += m_shards[i]->nObjects;
+    }
+    mess << "Buffer: "  << getWriteBufferUsed() << " in " << nObjects << " objects. ";
     return mess.str();
   }
 
@@ -11,7 +11,7 @@ namespace Mantid
         /** Constructor    */
         ISaveable::ISaveable():
             m_Busy(false),m_dataChanged(false),m_wasSaved(false),m_isLoaded(false),
-            m_BufMemorySize(0),m_fileIndexStart(std::numeric_limits<uint64_t>::max() ),m_fileNumEvents(0)
+            m_BufMemorySize(0),m_BufShard(0),m_fileIndexStart(std::numeric_limits<uint64_t>::max() ),m_fileNumEvents(0)
         {}
 
         //----------------------------------------------------------------------------------------------
@@ -21,6 +21,7 @@ namespace Mantid
             m_Busy(other.m_Busy),m_dataChanged(other.m_dataChanged),m_wasSaved(other.m_wasSaved),m_isLoaded(false),
             m_BufPosition(other.m_BufPosition),
             m_BufMemorySize(other.m_BufMemorySize),
+            m_BufShard(other.m_BufShard),
             m_fileIndexStart(other.m_fileIndexStart),m_fileNumEvents(other.m_fileNumEvents)
             
 
@@ -67,13 +68,15 @@ namespace Mantid
 
         /** Method stores the position of the object in Disc buffer and returns the size of this object for disk buffer to store 
         * @param bufPosition -- the allocator which specifies the position of the object in the list of objects to write
+        * @param shard -- the shard of the disk buffer which owns that list
         * @returns the size of the object it currently occupies in memory. This size is also stored by the object itself for further references
         */
-        size_t ISaveable::setBufferPosition(std::list<ISaveable *>::iterator bufPosition)
+        size_t ISaveable::setBufferPosition(std::list<ISaveable *>::iterator bufPosition, size_t shard)
         {
             Mutex::ScopedLock _lock(m_setter);
 
             m_BufPosition = boost::optional<std::list<ISaveable *>::iterator >(bufPosition);
+            m_BufShard = shard;
             m_BufMemorySize  = this->getDataMemorySize();
 
             return m_BufMemorySize ;
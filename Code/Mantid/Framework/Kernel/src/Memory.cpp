@@ -13,9 +13,11 @@
   #include <unistd.h>
   #include <fstream>
   #include<malloc.h>
+  #include <sys/resource.h>
 #endif
 #ifdef __APPLE__
   #include <malloc/malloc.h>
+  #include <sys/resource.h>
   #include <sys/sysctl.h>
   #include <mach/mach_host.h>
   #include <mach/task.h>
@@ -123,6 +125,36 @@ void process_mem_usage(size_t & vm_usage, size_t & resident_set)
 #endif
 }
 
+/** Attempts to read the largest resident memory the process has used since it started
+ * @param peak_resident_set:: The peak memory associated with the current process in KiB, 0 if unknown
+ */
+void process_peak_mem_usage(size_t & peak_resident_set)
+{
+  peak_resident_set = 0;
+
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return;
+#ifdef __APPLE__
+  // in bytes on OS X
+  peak_resident_set = static_cast<size_t>(usage.ru_maxrss / 1024);
+#else
+  // in kiB on linux
+  peak_resident_set = static_cast<size_t>(usage.ru_maxrss);
+#endif
+#elif _WIN32
+  DWORD pid = GetCurrentProcessId();
+  HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION|PROCESS_VM_READ, FALSE, pid);
+  if (NULL == hProcess) return;
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc)))
+  {
+    peak_resident_set = pmc.PeakWorkingSetSize / 1024;
+  }
+  CloseHandle(hProcess);
+#endif
+}
+
 // ----------------------- functions associated with getting the memory of the system
 
 #ifdef __linux__
@@ -320,7 +352,7 @@ void MemoryOptions::initAllocatorOptions()
  * @param ignore :: Which memory stats should be ignored.
  */
 MemoryStats::MemoryStats(const MemoryStatsIgnore ignore): vm_usage(0), res_usage(0),
-    total_memory(0), avail_memory(0)
+    peak_res_usage(0), total_memory(0), avail_memory(0)
 {
 
 #ifdef _WIN32
@@ -343,6 +375,7 @@ void MemoryStats::update()
   if (this->ignore != MEMORY_STATS_IGNORE_PROCESS)
   {
     process_mem_usage(this->vm_usage, this->res_usage);
+    process_peak_mem_usage(this->peak_res_usage);
   }
 
   // get the system information
@@ -425,6 +458,15 @@ std::size_t MemoryStats::residentMem() const
   return this->res_usage;
 }
 
+/**
+ * Returns the largest memory usage of the current process since it started, in kiB
+ * @returns An unsigned containing the peak resident memory of the current process in kiB, 0 if not known
+ */
+std::size_t MemoryStats::peakResidentMem() const
+{
+  return this->peak_res_usage;
+}
+
 /**
  * Returns the virtual memory usage of the current process in kiB
  * @returns An unsigned containing the virtual memory used by the current process in kiB
@@ -77,10 +77,13 @@ namespace Kernel
    *        before exiting. Default 0.0 (exit right away).
    *        This allows you to start a ThreadPool before you start adding tasks.
    *        You still need to call joinAll() after you've finished!
+   * @param waitBetweenTasks :: if true, waitSec is a total budget that also covers the time
+   *        the threads wait whenever they run out of tasks, so that tasks can keep being added
+   *        from another thread while the pool runs. joinAll() stops the waiting. Default false.
    *
    * @throw runtime_error if called when it has already started.
    */
-  void ThreadPool::start(double waitSec)
+  void ThreadPool::start(double waitSec, bool waitBetweenTasks)
   {
     if (m_started)
       throw std::runtime_error("Threads have already started.");
@@ -104,7 +107,7 @@ namespace Kernel
       m_threads.push_back(thread);
 
       // Make the runnable object and run it
-      ThreadPoolRunnable * runnable = new ThreadPoolRunnable(i, m_scheduler, m_prog, waitSec);
+      ThreadPoolRunnable * runnable = new ThreadPoolRunnable(i, m_scheduler, m_prog, waitSec, waitBetweenTasks);
       m_runnables.push_back(runnable);
 
       thread->start(*runnable);
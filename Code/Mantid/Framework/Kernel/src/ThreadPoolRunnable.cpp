@@ -15,10 +15,13 @@ namespace Kernel
    * @param prog :: optional pointer to a Progress reporter object. If passed, then
    *        automatic progress reporting will be handled by the thread pool.
    * @param waitSec :: how many seconds the thread is allowed to wait with no tasks.
+   * @param waitBetweenTasks :: if true, waitSec is a total budget that also covers
+   *        waiting for new tasks whenever the scheduler runs empty, not just at the start.
    */
   ThreadPoolRunnable::ThreadPoolRunnable(size_t threadnum, ThreadScheduler * scheduler,
-      ProgressBase * prog, double waitSec)
-  :  m_threadnum(threadnum), m_scheduler(scheduler), m_prog(prog), m_waitSec(waitSec)
+      ProgressBase * prog, double waitSec, bool waitBetweenTasks)
+  :  m_threadnum(threadnum), m_scheduler(scheduler), m_prog(prog), m_waitSec(waitSec),
+     m_waitBetweenTasks(waitBetweenTasks)
   {
     if (!m_scheduler)
       throw std::invalid_argument("NULL ThreadScheduler passed to ThreadPoolRunnable::ctor()");
@@ -40,6 +43,17 @@ namespace Kernel
 
 
 
+  //-----------------------------------------------------------------------------------
+  /** Wait while there are no tasks, up to the remaining wait time. */
+  void ThreadPoolRunnable::waitForTasks()
+  {
+    while (m_scheduler->empty() && m_waitSec > 0.0)
+    {
+      Poco::Thread::sleep(10); // millisec
+      m_waitSec -= 0.01; // Subtract ten millisec from the time left to wait.
+    }
+  }
+
   //-----------------------------------------------------------------------------------
   /** Thread method. Will wait for new tasks and run them
    * as scheduled to it.
@@ -49,11 +63,7 @@ namespace Kernel
     Task * task;
 
     // If there are no tasks yet, wait up to m_waitSec for them to come up
-    while (m_scheduler->empty() && m_waitSec > 0.0)
-    {
-      Poco::Thread::sleep(10); // millisec
-      m_waitSec -= 0.01; // Subtract ten millisec from the time left to wait.
-    }
+    this->waitForTasks();
 
     while (!m_scheduler->empty())
     {
@@ -101,6 +111,10 @@ namespace Kernel
         // So we wait a bit before checking again.
         Poco::Thread::sleep(10); // millisec
       }
+
+      // Tasks may still be coming from another thread: keep waiting for them
+      if (m_waitBetweenTasks)
+        this->waitForTasks();
     }
     // Ran out of tasks that could be run.
     // Thread now will exit
@@ -0,0 +1,351 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+#include <algorithm>
+#include <sstream>
+
+namespace Mantid
+{
+namespace Kernel
+{
+  namespace
+  {
+    /// Source of unique scheduler IDs. A new scheduler can reuse the address of a
+    /// deleted one, so the address alone cannot identify a thread's local queue.
+    Poco::AtomicCounter g_schedulerCount(0);
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Constructor: all counters at zero */
+  ThreadSchedulerStatistics::ThreadSchedulerStatistics()
+    : tasksPushed(0), tasksPopped(0), steals(0), tasksStolen(0), failedSteals(0),
+      maxQueueDepth(0), idleSeconds(0.0)
+  {
+  }
+
+  /// @return a one-line summary of the statistics, for logging
+  std::string ThreadSchedulerStatistics::toString() const
+  {
+    std::ostringstream out;
+    out << tasksPushed << " tasks pushed, " << tasksPopped << " popped, "
+        << steals << " steals (" << tasksStolen << " tasks), "
+        << failedSteals << " failed steals, max queue depth " << maxQueueDepth
+        << ", idle for " << idleSeconds << " sec";
+    return out.str();
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Constructor of a per-thread queue */
+  ThreadSchedulerWorkStealing::WorkQueue::WorkQueue()
+    : cost(0.0), idle(false)
+  {
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Constructor
+   *
+   * @param numThreads :: number of threads that will pop tasks, and so of queues.
+   *        Default 0 = the number of cores, as used by ThreadPool.
+   */
+  ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numThreads)
+    : ThreadScheduler(), m_numTasks(0), m_nextQueue(0), m_id(++g_schedulerCount)
+  {
+    if (numThreads == 0)
+      numThreads = ThreadPool::getNumPhysicalCores();
+    if (numThreads == 0)
+      numThreads = 1;
+    m_queues.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i)
+      m_queues.push_back(new WorkQueue());
+  }
+
+  /** Destructor. Deletes any task left in the queues. */
+  ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing()
+  {
+    clear();
+    for (size_t i = 0; i < m_queues.size(); ++i)
+      delete m_queues[i];
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Add a Task. It goes to the queue of the calling thread if that thread
+   * pops from this scheduler, otherwise the queues are filled in turn.
+   *
+   * @param newTask :: Task to add
+   */
+  void ThreadSchedulerWorkStealing::push(Task * newTask)
+  {
+    const std::pair<int, size_t> & local = m_localQueue.get();
+    size_t index;
+    if (local.first == m_id)
+      index = local.second;
+    else
+      index = static_cast<size_t>(m_nextQueue++) % m_queues.size();
+
+    WorkQueue & queue = *m_queues[index];
+    // Counted before it can be seen, so that the count is never below the number of queued tasks
+    ++m_numTasks;
+    Mutex::ScopedLock _lock(queue.lock);
+    addToQueue(queue, QueuedTask(newTask->cost(), newTask));
+    queue.stats.tasksPushed++;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Retrieve the next Task to execute: from the thread's own queue if it
+   * has any, otherwise stolen from another queue.
+   *
+   * @param threadnum :: ID of the calling thread.
+   * @return a Task pointer to execute, or NULL if there are none available.
+   */
+  Task * ThreadSchedulerWorkStealing::pop(size_t threadnum)
+  {
+    const size_t index = threadnum % m_queues.size();
+    m_localQueue.get() = std::make_pair(m_id, index);
+    WorkQueue & own = *m_queues[index];
+
+    Task * task = NULL;
+    {
+      Mutex::ScopedLock _lock(own.lock);
+      task = take(own, true);
+    }
+    // If only tasks whose mutex is busy are left, none is returned: the thread
+    // waits and tries again once the running task has finished.
+    if (!task)
+      task = steal(index);
+
+    Mutex::ScopedLock _lock(own.lock);
+    if (task)
+    {
+      own.stats.tasksPopped++;
+      if (own.idle)
+      {
+        own.stats.idleSeconds += own.idleTimer.elapsed();
+        own.idle = false;
+      }
+    }
+    else
+    {
+      own.stats.failedSteals++;
+      if (!own.idle)
+      {
+        own.idleTimer.reset();
+        own.idle = true;
+      }
+    }
+    return task;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Signal that a task is complete, releasing its mutex.
+   *
+   * @param task :: the Task that was completed.
+   * @param threadnum :: unused argument
+   */
+  void ThreadSchedulerWorkStealing::finished(Task * task, size_t threadnum)
+  {
+    UNUSED_ARG(threadnum);
+    boost::shared_ptr<Mutex> mut = task->getMutex();
+    if (mut)
+    {
+      Mutex::ScopedLock _lock(m_mutexesLock);
+      std::map<boost::shared_ptr<Mutex>, size_t>::iterator it = m_mutexes.find(mut);
+      if (it != m_mutexes.end() && --(it->second) == 0)
+        m_mutexes.erase(it);
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /// @return the total number of tasks in all the queues
+  size_t ThreadSchedulerWorkStealing::size()
+  {
+    const int num = m_numTasks.value();
+    return (num > 0) ? static_cast<size_t>(num) : 0;
+  }
+
+  /// @return true if all the queues are empty
+  bool ThreadSchedulerWorkStealing::empty()
+  {
+    return m_numTasks.value() <= 0;
+  }
+
+  /** @return the number of tasks in the queue of a thread
+   * @param threadnum :: ID of the thread */
+  size_t ThreadSchedulerWorkStealing::queueSize(size_t threadnum)
+  {
+    WorkQueue & queue = *m_queues[threadnum % m_queues.size()];
+    Mutex::ScopedLock _lock(queue.lock);
+    return queue.tasks.size();
+  }
+
+  /// @return the total cost of the tasks in all the queues
+  double ThreadSchedulerWorkStealing::totalCost()
+  {
+    double total = 0;
+    for (size_t i = 0; i < m_queues.size(); ++i)
+    {
+      Mutex::ScopedLock _lock(m_queues[i]->lock);
+      total += m_queues[i]->cost;
+    }
+    return total;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Empty out all the queues, deleting the tasks. */
+  void ThreadSchedulerWorkStealing::clear()
+  {
+    for (size_t i = 0; i < m_queues.size(); ++i)
+    {
+      WorkQueue & queue = *m_queues[i];
+      Mutex::ScopedLock _lock(queue.lock);
+      for (std::deque<QueuedTask>::iterator it = queue.tasks.begin(); it != queue.tasks.end(); ++it)
+      {
+        delete it->second;
+        --m_numTasks;
+      }
+      queue.tasks.clear();
+      queue.cost = 0;
+    }
+    m_cost = 0;
+    m_costExecuted = 0;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** @return the statistics of all the threads added up */
+  ThreadSchedulerStatistics ThreadSchedulerWorkStealing::getStatistics()
+  {
+    ThreadSchedulerStatistics total;
+    for (size_t i = 0; i < m_queues.size(); ++i)
+    {
+      WorkQueue & queue = *m_queues[i];
+      Mutex::ScopedLock _lock(queue.lock);
+      const ThreadSchedulerStatistics & stats = queue.stats;
+      total.tasksPushed += stats.tasksPushed;
+      total.tasksPopped += stats.tasksPopped;
+      total.steals += stats.steals;
+      total.tasksStolen += stats.tasksStolen;
+      total.failedSteals += stats.failedSteals;
+      total.maxQueueDepth = std::max(total.maxQueueDepth, stats.maxQueueDepth);
+      total.idleSeconds += stats.idleSeconds;
+    }
+    return total;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Take a task out of a queue. The queue must be locked by the caller.
+   *
+   * @param queue :: queue to take from
+   * @param fromFront :: take the oldest task (owner) rather than the newest (thief)
+   * @return the task, or NULL if none can be taken
+   */
+  Task * ThreadSchedulerWorkStealing::take(WorkQueue & queue, const bool fromFront)
+  {
+    const size_t num = queue.tasks.size();
+    for (size_t i = 0; i < num; ++i)
+    {
+      const size_t pos = fromFront ? i : num - 1 - i;
+      Task * task = queue.tasks[pos].second;
+      if (!reserveMutex(task))
+        continue;
+      queue.cost -= queue.tasks[pos].first;
+      queue.tasks.erase(queue.tasks.begin() + pos);
+      --m_numTasks;
+      return task;
+    }
+    return NULL;
+  }
+
+  /** Steal tasks from the back of the queue with the largest remaining cost.
+   * One task is returned; further tasks, up to half of the victim's cost, are
+   * moved to the thief's queue.
+   *
+   * @param thief :: index of the queue of the stealing thread
+   * @return the task to run, or NULL if there was nothing to steal
+   */
+  Task * ThreadSchedulerWorkStealing::steal(size_t thief)
+  {
+    const size_t num = m_queues.size();
+    // Find the victim. Queues that are busy are skipped rather than waited for.
+    size_t victim = num;
+    double largestCost = -1.0;
+    for (size_t i = 1; i < num; ++i)
+    {
+      const size_t index = (thief + i) % num;
+      WorkQueue & queue = *m_queues[index];
+      if (!queue.lock.tryLock())
+        continue;
+      if (!queue.tasks.empty() && queue.cost > largestCost)
+      {
+        largestCost = queue.cost;
+        victim = index;
+      }
+      queue.lock.unlock();
+    }
+    if (victim == num)
+      return NULL;
+
+    Task * task = NULL;
+    std::vector<QueuedTask> extra;
+    {
+      WorkQueue & queue = *m_queues[victim];
+      Mutex::ScopedLock _lock(queue.lock);
+      task = take(queue, false);
+      if (!task)
+        return NULL;
+      double stolenCost = task->cost();
+      const double maxCost = 0.5 * (queue.cost + stolenCost);
+      // Only tasks without a mutex are moved, so that no mutex gets reserved here.
+      while (!queue.tasks.empty() && !queue.tasks.back().second->getMutex()
+             && stolenCost + queue.tasks.back().first <= maxCost)
+      {
+        const QueuedTask & back = queue.tasks.back();
+        stolenCost += back.first;
+        queue.cost -= back.first;
+        extra.push_back(back);
+        queue.tasks.pop_back();
+      }
+    }
+
+    WorkQueue & own = *m_queues[thief];
+    Mutex::ScopedLock _lock(own.lock);
+    // Keep the order they had in the victim's queue
+    for (std::vector<QueuedTask>::reverse_iterator it = extra.rbegin(); it != extra.rend(); ++it)
+      addToQueue(own, *it);
+    own.stats.steals++;
+    own.stats.tasksStolen += 1 + extra.size();
+    return task;
+  }
+
+  /** Check that a task's mutex is not used by a running task, and mark it as used.
+   *
+   * @param task :: the task about to be popped
+   * @return true if the task can be popped
+   */
+  bool ThreadSchedulerWorkStealing::reserveMutex(Task * task)
+  {
+    boost::shared_ptr<Mutex> mut = task->getMutex();
+    if (!mut)
+      return true;
+    Mutex::ScopedLock _lock(m_mutexesLock);
+    size_t & users = m_mutexes[mut];
+    if (users > 0)
+      return false;
+    ++users;
+    return true;
+  }
+
+  /** Append a task to a queue. The queue must be locked by the caller.
+   * The task is not counted in m_numTasks: a new task is counted by push(),
+   * and a stolen one was never uncounted.
+   *
+   * @param queue :: queue to add to
+   * @param task :: task and its cost
+   */
+  void ThreadSchedulerWorkStealing::addToQueue(WorkQueue & queue, const QueuedTask & task)
+  {
+    queue.tasks.push_back(task);
+    queue.cost += task.first;
+    if (queue.tasks.size() > queue.stats.maxQueueDepth)
+      queue.stats.maxQueueDepth = queue.tasks.size();
+  }
+
+} // namespace Kernel
+} // namespace Mantid
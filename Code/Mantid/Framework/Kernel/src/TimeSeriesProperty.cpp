@@ -5,6 +5,7 @@
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/TimeSplitter.h"
 
+#include <algorithm>
 #include <sstream>
 
 using namespace std;
@@ -29,6 +30,18 @@ namespace Mantid
     {
     }
 
+    /**
+     * Copy constructor. The cached time integral is not copied.
+     *  @param other :: The property to copy
+     */
+    template <typename TYPE>
+    TimeSeriesProperty<TYPE>::TimeSeriesProperty(const TimeSeriesProperty<TYPE> &other) :
+    Property(other), ITimeSeriesProperty(other), m_values(other.m_values), m_size(other.m_size),
+    m_propSortedFlag(other.m_propSortedFlag), m_filter(other.m_filter), m_filterQuickRef(other.m_filterQuickRef),
+    m_filterApplied(other.m_filterApplied), m_cumulativeIntegral(), m_cumulativeIntegralMutex()
+    {
+    }
+
     /// Virtual destructor
     template <typename TYPE>
     TimeSeriesProperty<TYPE>::~TimeSeriesProperty()
@@ -81,6 +94,8 @@ namespace Mantid
         {
           m_values.insert(m_values.end(), rhs->m_values.begin(), rhs->m_values.end());
           m_propSortedFlag = false;
+          m_filterApplied = false;
+          m_cumulativeIntegral.clear();
         }
         else
         {
@@ -242,6 +257,8 @@ namespace Mantid
 
       // 4. Make size consistent
       m_size = static_cast<int>(m_values.size());
+      m_filterApplied = false;
+      m_cumulativeIntegral.clear();
 
       return;
     }
@@ -334,6 +351,8 @@ namespace Mantid
       mp_copy.clear();
 
       m_size = static_cast<int>(m_values.size());
+      m_filterApplied = false;
+      m_cumulativeIntegral.clear();
 
       return;
     }
@@ -366,6 +385,7 @@ namespace Mantid
         if (myOutput)
         {
           outputs_tsp.push_back(myOutput);
+          myOutput->m_cumulativeIntegral.clear();
           if (this->m_values.size() == 1)
           {
             // Special case for TSP with a single entry = just copy.
@@ -401,10 +421,12 @@ namespace Mantid
         DateAndTime stop = itspl->stop();
         int index = itspl->index();
 
-        // Skip the events before the start of the time
-        // TODO  Algorithm here can be refactored for better performance
-        while (ip < this->m_values.size() && m_values[ip].time() < start)
-          ip ++;
+        // Skip the entries before the start of the time
+        if (ip < this->m_values.size() && m_values[ip].time() < start)
+        {
+          TimeValueUnit<TYPE> startEntry(start, m_values[ip].value());
+          ip = static_cast<size_t>(std::lower_bound(m_values.begin()+ip, m_values.end(), startEntry) - m_values.begin());
+        }
 
         //Go through all the events that are in the interval (if any)
         // while ((it != this->m_propertySeries.end()) && (it->first < stop))
@@ -632,32 +654,29 @@ namespace Mantid
         return static_cast<double>(m_values.front().value());
       }
 
-      // Sort, if necessary.
-      sort();
+      // Sort, if necessary, and integrate the log once: each filter range then costs 2 binary searches
+      buildCumulativeIntegral();
 
       double numerator(0.0),totalTime(0.0);
+      const TimeValueUnit<TYPE> & first = m_values.front();
       // Loop through the filter ranges
       for ( TimeSplitterType::const_iterator it = filter.begin(); it != filter.end(); ++it )
       {
         // Calculate the total time duration (in seconds) within by the filter
         totalTime += it->duration();
 
-        // Get the log value and index at the start time of the filter
-        int index;
-        double value = getSingleValue(it->start(), index);
-        DateAndTime startTime = it->start();
+        // The entries in force at the start and stop of the range. The first value is used before the log starts.
+        const TimeValueUnit<TYPE> startEntry(it->start(), first.value());
+        const TimeValueUnit<TYPE> stopEntry(it->stop(), first.value());
+        size_t istart = static_cast<size_t>(std::upper_bound(m_values.begin(), m_values.end(), startEntry) - m_values.begin());
+        size_t istop = static_cast<size_t>(std::upper_bound(m_values.begin(), m_values.end(), stopEntry) - m_values.begin());
+        if (istart > 0) --istart;
+        if (istop > 0) --istop;
 
-        while ( index < realSize()-1 && m_values[index+1].time() < it->stop() )
-        {
-          ++index;
-          numerator += DateAndTime::secondsFromDuration( m_values[index].time() - startTime )
-                         * value;
-          startTime = m_values[index].time();
-          value = static_cast<double>(m_values[index].value());
-        }
-
-        // Now close off with the end of the current filter range
-        numerator += DateAndTime::secondsFromDuration( it->stop() - startTime ) * value;
+        // Integral from the entry at the start to the entry at the stop, corrected for the parts of these entries outside the range
+        numerator += m_cumulativeIntegral[istop] - m_cumulativeIntegral[istart]
+            + DateAndTime::secondsFromDuration( it->stop() - m_values[istop].time() ) * static_cast<double>(m_values[istop].value())
+            - DateAndTime::secondsFromDuration( it->start() - m_values[istart].time() ) * static_cast<double>(m_values[istart].value());
       }
 
       // 'Normalise' by the total time
@@ -826,6 +845,7 @@ namespace Mantid
       }
 
       m_filterApplied = false;
+      m_cumulativeIntegral.clear();
 
       return;
     }
@@ -875,7 +895,11 @@ namespace Mantid
       }
 
       if (values.size() > 0)
+      {
         m_propSortedFlag = false;
+        m_filterApplied = false;
+        m_cumulativeIntegral.clear();
+      }
 
       return;
         }
@@ -1099,6 +1123,7 @@ namespace Mantid
 
       m_propSortedFlag = false;
       m_filterApplied = false;
+      m_cumulativeIntegral.clear();
     }
 
     /** Clears out all but the last value in the property.
@@ -1758,6 +1783,11 @@ namespace Mantid
       }
 
       // 3. Finish
+      if (numremoved > 0)
+      {
+        m_filterApplied = false;
+        m_cumulativeIntegral.clear();
+      }
       g_log.warning() << "Log " << this->name() << " has " << numremoved << " entries removed due to duplicated time. " << "\n";
 
       return;
@@ -1790,6 +1820,9 @@ namespace Mantid
       {
         std::stable_sort(m_values.begin(), m_values.end());
         m_propSortedFlag = true;
+        // The filter quick references are indices of the values
+        m_filterApplied = false;
+        m_cumulativeIntegral.clear();
       }
     }
 
@@ -2029,20 +2062,58 @@ namespace Mantid
       }
       else
       {
-        // 2B. Inside
-        for (size_t i = 0; i < m_filterQuickRef.size(); i+=4)
+        // 2B. Inside. The references come by 4 per filter interval, with non-decreasing counts of values:
+        // bisect for the first interval whose end count is above n.
+        size_t ilow = 0;
+        size_t ihigh = m_filterQuickRef.size()/4;
+        while (ilow < ihigh)
         {
-          if (static_cast<size_t>(n) >= m_filterQuickRef[i].second && static_cast<size_t>(n) < m_filterQuickRef[i+3].second)
-          {
-            index = i;
-            break;
-          }
+          size_t imid = (ilow + ihigh)/2;
+          if (m_filterQuickRef[imid*4+3].second > static_cast<size_t>(n))
+            ihigh = imid;
+          else
+            ilow = imid + 1;
         }
+        size_t i = ilow*4;
+        if (i < m_filterQuickRef.size() && static_cast<size_t>(n) >= m_filterQuickRef[i].second)
+          index = i;
       }
 
       return index;
     }
 
+    /** Sort the values and fill m_cumulativeIntegral, unless it is up to date.
+     *  The value of each entry holds until the time of the next entry.
+     */
+    template<typename TYPE>
+    void TimeSeriesProperty<TYPE>::buildCumulativeIntegral() const
+    {
+      // Const methods fill the cache: threads reading the same log take turns
+      Mutex::ScopedLock lock(m_cumulativeIntegralMutex);
+      sort();
+      if (m_cumulativeIntegral.size() == m_values.size())
+        return;
+
+      m_cumulativeIntegral.resize(m_values.size());
+      double integral(0.0);
+      for (size_t i = 0; i < m_values.size(); ++i)
+      {
+        if (i > 0)
+          integral += DateAndTime::secondsFromDuration( m_values[i].time() - m_values[i-1].time() )
+                        * static_cast<double>(m_values[i-1].value());
+        m_cumulativeIntegral[i] = integral;
+      }
+    }
+
+    /** Function specialization for TimeSeriesProperty<std::string>
+     *  @throws Kernel::Exception::NotImplementedError always
+     */
+    template<>
+    void TimeSeriesProperty<std::string>::buildCumulativeIntegral() const
+    {
+      throw Exception::NotImplementedError("TimeSeriesProperty::buildCumulativeIntegral is not implemented for string properties");
+    }
+
     /**
      * Set the value of the property via a reference to another property.
      * If the value is unacceptable the value is not changed but a string is returned.
@@ -2063,6 +2134,7 @@ namespace Mantid
       m_filter = prop->m_filter;
       m_filterQuickRef = prop->m_filterQuickRef;
       m_filterApplied = prop->m_filterApplied;
+      m_cumulativeIntegral.clear();
       return "";
     }
 
@@ -1,6 +1,8 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/TimeSplitter.h"
+#include <algorithm>
 #include <ctime>
+#include <map>
 #include <ostream>
 
 namespace Mantid
@@ -309,5 +311,57 @@ TimeSplitterType operator ~(const TimeSplitterType& a)
   return out;
 }
 
+//------------------------------------------------------------------------------------------------
+/// Output of the times after the last interval
+const size_t TimeSplitterIndex::NO_OUTPUT = size_t(-1);
+
+/** Constructor
+ * @param splitter :: the intervals to split by, in any order
+ */
+TimeSplitterIndex::TimeSplitterIndex(const TimeSplitterType & splitter)
+{
+  TimeSplitterType sorted(splitter);
+  std::stable_sort(sorted.begin(), sorted.end());
+
+  // Number the destinations: -1 first, then the others in increasing order
+  std::map<int, size_t> outputOfIndex;
+  for (size_t i = 0; i < sorted.size(); i++)
+    if (sorted[i].index() != -1)
+      outputOfIndex.insert(std::make_pair(sorted[i].index(), 0));
+  m_outputIndexes.push_back(-1);
+  for (std::map<int, size_t>::iterator it = outputOfIndex.begin(); it != outputOfIndex.end(); ++it)
+  {
+    it->second = m_outputIndexes.size();
+    m_outputIndexes.push_back(it->first);
+  }
+  outputOfIndex[-1] = 0;
+
+  m_starts.reserve(sorted.size());
+  m_stops.reserve(sorted.size());
+  m_intervalOutputs.reserve(sorted.size());
+  for (size_t i = 0; i < sorted.size(); i++)
+  {
+    m_starts.push_back(sorted[i].start().totalNanoseconds());
+    m_stops.push_back(sorted[i].stop().totalNanoseconds());
+    m_intervalOutputs.push_back(outputOfIndex[sorted[i].index()]);
+  }
+}
+
+/** @return the number of intervals which start at or before a time
+ * @param time :: absolute time in nanoseconds */
+size_t TimeSplitterIndex::findPosition(const int64_t time) const
+{
+  return std::upper_bound(m_starts.begin(), m_starts.end(), time) - m_starts.begin();
+}
+
+/** Get the output of a time
+ * @param time :: absolute time in nanoseconds
+ * @return the output for the time, or NO_OUTPUT if it is after the last interval
+ */
+size_t TimeSplitterIndex::getOutput(const int64_t time) const
+{
+  return outputAtPosition(time, findPosition(time));
+}
+
 }
 }
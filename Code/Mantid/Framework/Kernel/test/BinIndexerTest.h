@@ -0,0 +1,149 @@
+#ifndef MANTID_KERNEL_BININDEXERTEST_H_
+#define MANTID_KERNEL_BININDEXERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidKernel/BinIndexer.h"
+#include "MantidKernel/VectorHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace Mantid::Kernel;
+
+class BinIndexerTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BinIndexerTest *createSuite() { return new BinIndexerTest(); }
+  static void destroySuite( BinIndexerTest *suite ) { delete suite; }
+
+  void test_linear()
+  {
+    std::vector<double> X;
+    for (int i = 0; i <= 50; ++i)
+      X.push_back(i * 2.0);
+    BinIndexer indexer(X);
+    TS_ASSERT_EQUALS( indexer.binningType(), BinIndexer::Linear );
+    TS_ASSERT( indexer.isDirect() );
+    TS_ASSERT_EQUALS( indexer.numBins(), 50 );
+    TS_ASSERT_EQUALS( indexer.bin(-0.1), -1 );
+    TS_ASSERT_EQUALS( indexer.bin(100.0), -1 );
+    TS_ASSERT_EQUALS( indexer.bin(0.0), 0 );
+    TS_ASSERT_EQUALS( indexer.bin(1.999), 0 );
+    TS_ASSERT_EQUALS( indexer.bin(2.0), 1 );
+    TS_ASSERT_EQUALS( indexer.bin(99.9), 49 );
+  }
+
+  void test_linear_with_narrow_last_bin()
+  {
+    std::vector<double> params, X;
+    params.push_back(0.0); params.push_back(0.3); params.push_back(10.0);
+    VectorHelper::createAxisFromRebinParams(params, X);
+    BinIndexer indexer(X);
+    TS_ASSERT_EQUALS( indexer.binningType(), BinIndexer::Linear );
+    TS_ASSERT_EQUALS( indexer.bin(9.95), static_cast<int>(X.size()) - 2 );
+    checkAgainstSearch(X, indexer);
+  }
+
+  void test_logarithmic()
+  {
+    std::vector<double> params, X;
+    params.push_back(1.0); params.push_back(-0.01); params.push_back(1000.0);
+    VectorHelper::createAxisFromRebinParams(params, X);
+    BinIndexer indexer(X);
+    TS_ASSERT_EQUALS( indexer.binningType(), BinIndexer::Logarithmic );
+    TS_ASSERT_EQUALS( indexer.bin(0.5), -1 );
+    TS_ASSERT_EQUALS( indexer.bin(1.0), 0 );
+    TS_ASSERT_EQUALS( indexer.bin(1.01), 1 );
+    checkAgainstSearch(X, indexer);
+  }
+
+  void test_arbitrary()
+  {
+    std::vector<double> X;
+    X.push_back(0.0); X.push_back(1.0); X.push_back(5.0); X.push_back(6.0);
+    BinIndexer indexer(X);
+    TS_ASSERT_EQUALS( indexer.binningType(), BinIndexer::Arbitrary );
+    TS_ASSERT( !indexer.isDirect() );
+    TS_ASSERT_EQUALS( indexer.bin(0.5), 0 );
+    TS_ASSERT_EQUALS( indexer.bin(4.9), 1 );
+    TS_ASSERT_EQUALS( indexer.bin(5.0), 2 );
+    TS_ASSERT_EQUALS( indexer.bin(6.0), -1 );
+    checkAgainstSearch(X, indexer);
+  }
+
+  void test_too_few_boundaries()
+  {
+    std::vector<double> X(1, 3.0);
+    BinIndexer indexer(X);
+    TS_ASSERT_EQUALS( indexer.numBins(), 0 );
+    TS_ASSERT( !indexer.isDirect() );
+    TS_ASSERT_EQUALS( indexer.bin(3.0), -1 );
+  }
+
+private:
+  /// Compare bin() and bins() with a binary search, for values on and between the boundaries
+  void checkAgainstSearch(const std::vector<double> & X, const BinIndexer & indexer)
+  {
+    std::vector<double> values;
+    for (size_t i = 0; i < X.size(); ++i)
+    {
+      values.push_back(X[i]);
+      if (i + 1 < X.size())
+        values.push_back(0.5 * (X[i] + X[i+1]));
+    }
+    values.push_back(X.front() - 1.0);
+    values.push_back(X.back() + 1.0);
+
+    std::vector<int> indices(values.size());
+    indexer.bins(&values[0], values.size(), &indices[0]);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      int expected = static_cast<int>(std::upper_bound(X.begin(), X.end(), values[i]) - X.begin()) - 1;
+      if (expected >= static_cast<int>(X.size()) - 1) expected = -1;
+      TS_ASSERT_EQUALS( indexer.bin(values[i]), expected );
+      TS_ASSERT_EQUALS( indices[i], expected );
+    }
+  }
+};
+
+
+class BinIndexerTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static BinIndexerTestPerformance *createSuite() { return new BinIndexerTestPerformance(); }
+  static void destroySuite( BinIndexerTestPerformance *suite ) { delete suite; }
+
+  BinIndexerTestPerformance()
+  {
+    for (double x = 0; x <= 100000; x += 1.0)
+      linearX.push_back(x);
+    // Same bins, moved a little so they are no longer regular
+    arbitraryX = linearX;
+    for (size_t i = 1; i + 1 < arbitraryX.size(); ++i)
+      arbitraryX[i] += 1e-3 * static_cast<double>(i % 7);
+    for (size_t i = 0; i < 10000000; ++i)
+      values.push_back((rand() % 2000000) * 0.05);
+    indices.resize(values.size());
+  }
+
+  void test_bins_linear()
+  {
+    BinIndexer indexer(linearX);
+    indexer.bins(&values[0], values.size(), &indices[0]);
+  }
+
+  void test_bins_arbitrary()
+  {
+    BinIndexer indexer(arbitraryX);
+    indexer.bins(&values[0], values.size(), &indices[0]);
+  }
+
+private:
+  std::vector<double> linearX, arbitraryX, values;
+  std::vector<int> indices;
+};
+
+
+#endif /* MANTID_KERNEL_BININDEXERTEST_H_ */
@@ -334,6 +334,51 @@ public:
   }
 
 
+  //--------------------------------------------------------------------------------
+  /** Objects already on file are written out in order of their file position */
+  void test_writesOutInFilePositionOrder()
+  {
+    DiskBuffer dbuf(10);
+    size_t order[5] = {3, 0, 4, 1, 2};
+    for (size_t i=0; i<5; i++)
+    {
+      data[order[i]]->setFilePosition(order[i], 1, true);
+      data[order[i]]->setDataChanged();
+      dbuf.toWrite(data[order[i]]);
+    }
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(ISaveableTester::fakeFile, "0,1,2,3,4,");
+  }
+
+  //--------------------------------------------------------------------------------
+  /** Objects added from several threads go to several shards, and are all written out once */
+  void test_shards_multithread()
+  {
+    DiskBuffer dbuf(BIG_NUM+1, 4);
+    TS_ASSERT_EQUALS( dbuf.getNumShards(), 4);
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (long i=0; i<BIG_NUM; i++)
+    {
+      dbuf.toWrite(bigData[i]);
+    }
+    TS_ASSERT_EQUALS( dbuf.getWriteBufferUsed(), BIG_NUM);
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS( dbuf.getWriteBufferUsed(), 0);
+    TS_ASSERT_EQUALS( dbuf.getFileLength(), BIG_NUM);
+
+    // Every object has its own place in the file
+    std::vector<bool> placeUsed(BIG_NUM, false);
+    for (long i=0; i<BIG_NUM; i++)
+    {
+      uint64_t pos = bigData[i]->getFilePosition();
+      TS_ASSERT_LESS_THAN( pos, uint64_t(BIG_NUM) );
+      if (pos >= uint64_t(BIG_NUM)) continue;
+      TS_ASSERT( !placeUsed[pos] );
+      placeUsed[pos] = true;
+    }
+  }
+
   //--------------------------------------------------------------------------------
   /** Accessing the map from multiple threads simultaneously does not segfault */
   void test_thread_safety()
@@ -14,6 +14,7 @@
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <cxxtest/TestSuite.h>
+#include <Poco/AtomicCounter.h>
 #include <iomanip>
 #include <iostream>
 
@@ -125,8 +126,52 @@ public:
 std::string SaveableTesterWithFile::fakeFile;
 Kernel::Mutex SaveableTesterWithFile::streamMutex;
 
+//====================================================================================
+/** A SaveableTesterWithFile that remembers what was in its place in the file when it loaded */
+class SaveableTesterRecordingLoad : public SaveableTesterWithFile
+{
+public:
+  SaveableTesterRecordingLoad(size_t id, uint64_t pos, uint64_t size, char ch) :
+    SaveableTesterWithFile(id, pos, size, ch)
+  {}
+
+  virtual void load()
+  {
+    if (this->wasSaved() && !this->isLoaded())
+      loaded = fakeFile.substr(size_t(this->getFilePosition()), size_t(this->getFileSize()));
+    SaveableTesterWithFile::load();
+  }
+
+  std::string loaded;
+};
 
 
+//====================================================================================
+/** A SaveableTesterWithFile that counts the times it was saved or cleared while busy */
+class SaveableTesterCheckingBusy : public SaveableTesterWithFile
+{
+public:
+  SaveableTesterCheckingBusy(size_t id, uint64_t pos, uint64_t size, char ch) :
+    SaveableTesterWithFile(id, pos, size, ch)
+  {}
+
+  virtual void save() const
+  {
+    if (this->isBusy()) ++usedWhileBusy;
+    SaveableTesterWithFile::save();
+  }
+
+  virtual void clearDataFromMemory()
+  {
+    if (this->isBusy()) ++usedWhileBusy;
+    SaveableTesterWithFile::clearDataFromMemory();
+  }
+
+  static Poco::AtomicCounter usedWhileBusy;
+};
+
+Poco::AtomicCounter SaveableTesterCheckingBusy::usedWhileBusy;
+
 //====================================================================================
 class DiskBufferTest : public CxxTest::TestSuite
 {
@@ -243,6 +288,26 @@ public:
 
 
 
+  //--------------------------------------------------------------------------------
+  /** An object with data added while the rest is on file must read that rest back
+   * before its old place in the file is given to another object */
+  void test_partlyLoadedObject_loadsBeforeItsPlaceIsReused()
+  {
+    SaveableTesterWithFile::fakeFile = "AA";
+    DiskBuffer dbuf(3);
+    dbuf.setFileLength(2);
+    SaveableTesterRecordingLoad grown(0, 0, 2, 'A');
+    grown.setLoaded(false);
+    grown.AddNewObjects(2);
+    SaveableTesterWithFile fresh(1, 0, 2, 'B', false);
+    // The most recent object is placed first: grown moves to the end of the file, freeing its place for fresh
+    dbuf.toWrite(&fresh);
+    dbuf.toWrite(&grown);
+    TS_ASSERT_EQUALS( dbuf.getWriteBufferUsed(), 0);
+    TS_ASSERT_EQUALS( grown.loaded, "AA");
+    TS_ASSERT_EQUALS( SaveableTesterWithFile::fakeFile, "BBAAAA");
+  }
+
   //--------------------------------------------------------------------------------
   /** If a block will get deleted it needs to be taken
    * out of the caches */
@@ -313,6 +378,39 @@ public:
         delete bigData[i];
 
   }
+  //--------------------------------------------------------------------------------
+  /** Objects marked busy while others are being written out are never saved or cleared
+   * from under their user */
+  void test_markBusy_while_writing()
+  {
+    // Room for 3 in the to-write cache
+    DiskBuffer dbuf(3);
+    size_t bigNum=1000;
+    std::vector<SaveableTesterCheckingBusy *> bigData;
+    bigData.reserve(bigNum);
+    for (size_t i=0; i<bigNum; i++)
+      bigData.push_back( new SaveableTesterCheckingBusy(i,2*i,2,char(i+0x41)) );
+    SaveableTesterCheckingBusy::usedWhileBusy = 0;
+
+    for (int round=0; round < 10; round++)
+    {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i=0; i<int(bigNum); i++)
+      {
+        dbuf.markBusy(bigData[i]);
+        bigData[i]->load();
+        bigData[i]->AddNewObjects(1);
+        dbuf.toWrite(bigData[i]);
+        bigData[i]->setBusy(false);
+      }
+    }
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS( int(SaveableTesterCheckingBusy::usedWhileBusy), 0);
+
+    for (size_t i=0; i<size_t(bigNum); i++)
+      delete bigData[i];
+  }
+
   ////--------------------------------------------------------------------------------
   ////--------------------------------------------------------------------------------
   ////----------TESTS FOR FREE SPACE MAPS --------------------------------------------
@@ -862,6 +960,30 @@ public:
     std::cout << tim << " to grow " << dataSeek.size() << " into MRU with fake seeking. " << std::endl;
   }
 
+  /** Many threads adding objects to a small write buffer, so that it is written out often */
+  void test_toWrite_multithread()
+  {
+    const int numObjects = 200000;
+    std::vector<SaveableTesterWithFile *> objects;
+    objects.reserve(numObjects);
+    for (int i=0; i<numObjects; i++)
+      objects.push_back( new SaveableTesterWithFile(i, 0, 1, 'A', false) );
+
+    CPUTimer tim;
+    DiskBuffer dbuf(1000);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i=0; i<numObjects; i++)
+    {
+      dbuf.toWrite(objects[i]);
+    }
+    dbuf.flushCache();
+    std::cout << tim << " to write " << numObjects << " objects from " << dbuf.getNumShards() << " shards." << std::endl;
+    TS_ASSERT_EQUALS( dbuf.getWriteBufferUsed(), 0);
+
+    for (int i=0; i<numObjects; i++)
+      delete objects[i];
+  }
+
   /** Speed of freeing a lot of blocks and putting them in the free space map */
   void test_freeBlock()
   {
@@ -85,6 +85,14 @@ public:
     TS_ASSERT_THROWS_NOTHING( m.deleteIndex(50) );
     TS_ASSERT_EQUALS( m.size(), 2 );
 
+    // remove() hands the item back instead of deleting it
+    MyTestClass * removed = m.remove(60);
+    TS_ASSERT( removed );
+    TS_ASSERT_EQUALS( removed->value, 120 );
+    delete removed;
+    TS_ASSERT_EQUALS( m.size(), 1 );
+    TS_ASSERT( !m.remove(60) );
+
     // Test out the clear method.
     m.clear();
     TS_ASSERT_EQUALS( m.size(), 0 );
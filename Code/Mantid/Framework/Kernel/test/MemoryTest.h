@@ -43,6 +43,17 @@ public:
     TS_ASSERT_DIFFERS( mem.vmUsageStr(), "");
   }
 
+  void test_peakResidentMem()
+  {
+    MemoryStats mem;
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+    TS_ASSERT_LESS_THAN(0, mem.peakResidentMem());
+#endif
+    // The peak can not be below what is used now
+    mem.update();
+    TS_ASSERT_LESS_THAN_EQUALS(mem.residentMem(), mem.peakResidentMem());
+  }
+
 
   /// Update in parallel to test thread safety
   void test_parallel()
@@ -10,6 +10,7 @@
 #include <MantidKernel/ThreadPool.h>
 #include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 #include <boost/bind.hpp>
 #include <boost/make_shared.hpp>
@@ -17,6 +18,7 @@
 #include <iomanip>
 #include <Poco/Mutex.h>
 #include <cstdlib>
+#include <limits>
 
 using namespace Mantid::Kernel;
 
@@ -289,6 +291,27 @@ public:
     TS_ASSERT_EQUALS( threadpooltest_check, 12);
   }
 
+  /** With waitBetweenTasks, the threads keep waiting for tasks after running out of them */
+  void test_start_and_wait_between_tasks()
+  {
+    ThreadPool p; // Makes a default scheduler
+    threadpooltest_check = 0;
+    p.start(std::numeric_limits<double>::max(), true);
+
+    for (int i=0; i < 2; i++)
+    {
+      threadpooltest_check = 0;
+      p.schedule( new FunctionTask( threadpooltest_function ) );
+      // Give the task up to 10 seconds to run, without calling joinAll()
+      for (int j=0; j < 1000 && threadpooltest_check == 0; j++)
+        Poco::Thread::sleep(10);
+      TS_ASSERT_EQUALS( threadpooltest_check, 12);
+    }
+
+    // joinAll() stops the waiting
+    TS_ASSERT_THROWS_NOTHING( p.joinAll() );
+  }
+
 
   //=======================================================================================
 
@@ -424,6 +447,11 @@ public:
     do_StressTest_scheduler(new ThreadSchedulerMutexes());
   }
 
+  void test_StressTest_ThreadSchedulerWorkStealing()
+  {
+    do_StressTest_scheduler(new ThreadSchedulerWorkStealing());
+  }
+
 
   //--------------------------------------------------------------------
   /** Perform a stress test on the given scheduler.
@@ -468,6 +496,11 @@ public:
     do_StressTest_TasksThatCreateTasks(new ThreadSchedulerMutexes());
   }
 
+  void test_StressTest_TasksThatCreateTasks_ThreadSchedulerWorkStealing()
+  {
+    do_StressTest_TasksThatCreateTasks(new ThreadSchedulerWorkStealing());
+  }
+
   //=======================================================================================
   /** Task that throws an exception */
   class TaskThatThrows : public Task
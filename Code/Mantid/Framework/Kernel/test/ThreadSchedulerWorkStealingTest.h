@@ -0,0 +1,165 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include <MantidKernel/System.h>
+#include <MantidKernel/Timer.h>
+#include <boost/make_shared.hpp>
+
+#include <MantidKernel/ThreadSchedulerWorkStealing.h>
+
+using namespace Mantid::Kernel;
+
+int ThreadSchedulerWorkStealingTest_numDestructed;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() { return new ThreadSchedulerWorkStealingTest(); }
+  static void destroySuite( ThreadSchedulerWorkStealingTest *suite ) { delete suite; }
+
+  class TaskWithCost : public Task
+  {
+  public:
+    TaskWithCost(double cost, boost::shared_ptr<Mutex> mutex = boost::shared_ptr<Mutex>())
+    {
+      m_cost = cost;
+      m_mutex = mutex;
+    }
+
+    ~TaskWithCost()
+    {
+      // To keep track of proper deleting of Task pointers
+      ThreadSchedulerWorkStealingTest_numDestructed++;
+    }
+
+    void run() {}
+  };
+
+  void test_push_deals_tasks_to_the_queues()
+  {
+    ThreadSchedulerWorkStealing sc(2);
+    TS_ASSERT_EQUALS( sc.numQueues(), 2 );
+    TS_ASSERT( sc.empty() );
+    for (size_t i=0; i<5; i++)
+      sc.push( new TaskWithCost(1.0) );
+    TS_ASSERT_EQUALS( sc.size(), 5 );
+    TS_ASSERT( !sc.empty() );
+    TS_ASSERT_EQUALS( sc.queueSize(0), 3 );
+    TS_ASSERT_EQUALS( sc.queueSize(1), 2 );
+    TS_ASSERT_DELTA( sc.totalCost(), 5.0, 1e-10 );
+  }
+
+  void test_clear_deletes_tasks()
+  {
+    ThreadSchedulerWorkStealing sc(3);
+    for (size_t i=0; i<4; i++)
+      sc.push( new TaskWithCost(1.0) );
+    ThreadSchedulerWorkStealingTest_numDestructed = 0;
+    sc.clear();
+    TS_ASSERT( sc.empty() );
+    TS_ASSERT_EQUALS( sc.size(), 0 );
+    TS_ASSERT_EQUALS( ThreadSchedulerWorkStealingTest_numDestructed, 4 );
+  }
+
+  void test_pop_own_queue_in_order_then_steal()
+  {
+    ThreadSchedulerWorkStealing sc(2);
+    Task * tasks[4];
+    for (size_t i=0; i<4; i++)
+    {
+      tasks[i] = new TaskWithCost(static_cast<double>(i+1));
+      sc.push( tasks[i] );
+    }
+    // Queue 0 has tasks 0 and 2, queue 1 has tasks 1 and 3.
+    Task * task = sc.pop(0);
+    TS_ASSERT_EQUALS( task, tasks[0] );
+    delete task;
+    task = sc.pop(0);
+    TS_ASSERT_EQUALS( task, tasks[2] );
+    delete task;
+    // Queue 0 is empty: steal the newest task of queue 1
+    task = sc.pop(0);
+    TS_ASSERT_EQUALS( task, tasks[3] );
+    delete task;
+    task = sc.pop(1);
+    TS_ASSERT_EQUALS( task, tasks[1] );
+    delete task;
+    TS_ASSERT( sc.empty() );
+    TS_ASSERT( !sc.pop(1) );
+
+    ThreadSchedulerStatistics stats = sc.getStatistics();
+    TS_ASSERT_EQUALS( stats.tasksPushed, 4 );
+    TS_ASSERT_EQUALS( stats.tasksPopped, 4 );
+    TS_ASSERT_EQUALS( stats.steals, 1 );
+    TS_ASSERT_EQUALS( stats.tasksStolen, 1 );
+    TS_ASSERT_EQUALS( stats.failedSteals, 1 );
+    TS_ASSERT_EQUALS( stats.maxQueueDepth, 2 );
+    TS_ASSERT( !stats.toString().empty() );
+  }
+
+  void test_steal_moves_up_to_half_of_the_cost()
+  {
+    ThreadSchedulerWorkStealing sc(2);
+    for (size_t i=0; i<8; i++)
+      sc.push( new TaskWithCost(1.0) );
+    // Empty queue 1 completely
+    for (size_t i=0; i<4; i++)
+      delete sc.pop(1);
+    TS_ASSERT_EQUALS( sc.queueSize(1), 0 );
+    // Steal from queue 0: one task to run and up to half of the cost moved over.
+    Task * task = sc.pop(1);
+    TS_ASSERT( task );
+    delete task;
+    TS_ASSERT_EQUALS( sc.queueSize(0), 2 );
+    TS_ASSERT_EQUALS( sc.queueSize(1), 1 );
+    // Only the task handed out is no longer counted
+    TS_ASSERT_EQUALS( sc.size(), 3 );
+    ThreadSchedulerStatistics stats = sc.getStatistics();
+    TS_ASSERT_EQUALS( stats.steals, 1 );
+    TS_ASSERT_EQUALS( stats.tasksStolen, 2 );
+  }
+
+  void test_tasks_with_busy_mutex_are_passed_over()
+  {
+    ThreadSchedulerWorkStealing sc(1);
+    boost::shared_ptr<Mutex> mut = boost::make_shared<Mutex>();
+    Task * task1 = new TaskWithCost(1.0, mut);
+    Task * task2 = new TaskWithCost(1.0, mut);
+    Task * task3 = new TaskWithCost(1.0);
+    sc.push(task1);
+    sc.push(task2);
+    sc.push(task3);
+
+    TS_ASSERT_EQUALS( sc.pop(0), task1 );
+    // task2 shares the busy mutex, so task3 comes first
+    TS_ASSERT_EQUALS( sc.pop(0), task3 );
+    sc.finished(task3, 0);
+    // Only task2 is left: it waits until task1 has finished
+    TS_ASSERT( !sc.pop(0) );
+    TS_ASSERT_EQUALS( sc.size(), 1 );
+    sc.finished(task1, 0);
+    TS_ASSERT_EQUALS( sc.pop(0), task2 );
+    sc.finished(task2, 0);
+    TS_ASSERT( sc.empty() );
+    delete task1;
+    delete task2;
+    delete task3;
+  }
+
+  void test_abort_clears_the_queues()
+  {
+    ThreadSchedulerWorkStealing sc(2);
+    sc.push( new TaskWithCost(1.0) );
+    sc.push( new TaskWithCost(1.0) );
+    sc.abort(std::runtime_error("stop"));
+    TS_ASSERT( sc.getAborted() );
+    TS_ASSERT( sc.empty() );
+    TS_ASSERT( !sc.pop(0) );
+  }
+};
+
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
@@ -4,6 +4,7 @@
 #include <cxxtest/TestSuite.h>
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/TimeSplitter.h"
 
@@ -514,6 +515,50 @@ public:
     delete intLog;
   }
 
+  /// The integral kept for the averages follows the changes of the log
+  void test_timeAverageValue_after_changing_the_log()
+  {
+    auto intLog = createIntegerTSP(5);
+    TS_ASSERT_DELTA(intLog->timeAverageValue(), 2.5, .0001);
+    TS_ASSERT_DELTA(intLog->timeAverageValue(), 2.5, .0001);
+
+    // Value 6 from 16:17:50 to 16:18:00, added out of order
+    intLog->addValue(DateAndTime("2007-11-30T16:18:00"), 7);
+    intLog->addValue(DateAndTime("2007-11-30T16:17:50"), 6);
+    TS_ASSERT_DELTA(intLog->timeAverageValue(), 3.5, .0001);
+
+    // Keeps 1, 2 and 3
+    intLog->filterByTime(DateAndTime("2007-11-30T16:17:00"), DateAndTime("2007-11-30T16:17:30"));
+    TS_ASSERT_DELTA(intLog->timeAverageValue(), 1.5, .0001);
+
+    TimeSeriesProperty<int> * copy = intLog->clone();
+    copy->clear();
+    copy->addValue(DateAndTime("2007-11-30T16:17:00"), 1);
+    copy->addValue(DateAndTime("2007-11-30T16:17:30"), 2);
+    TS_ASSERT_DELTA(copy->timeAverageValue(), 1.0, .0001);
+    TS_ASSERT_DELTA(intLog->timeAverageValue(), 1.5, .0001);
+
+    delete copy;
+    delete intLog;
+  }
+
+  /// Threads can take averages of the same log
+  void test_timeAverageValue_from_several_threads()
+  {
+    auto intLog = createIntegerTSP(5);
+    std::vector<double> averages(100, 0.0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 100; ++i)
+    {
+      averages[i] = intLog->timeAverageValue();
+    }
+    for (size_t i = 0; i < averages.size(); ++i)
+    {
+      TS_ASSERT_DELTA(averages[i], 2.5, .0001);
+    }
+    delete intLog;
+  }
+
   void test_averageValueInFilter_throws_for_string_property()
   {
     TimeSplitterType splitter;
@@ -1452,6 +1497,50 @@ public:
     return;
   }
 
+  /*
+   * Test the n-th values of a filter with many intervals, before and after the log is re-sorted
+   */
+  void test_filter_many_intervals()
+  {
+    Mantid::Kernel::DateAndTime tStart("2007-11-30T16:17:00");
+    std::vector<double> deltaTs;
+    std::vector<double> valueXs;
+    for (int i = 0; i < 20; i ++)
+    {
+      deltaTs.push_back(static_cast<double>(i)*10.0);
+      valueXs.push_back(static_cast<double>(i)+1.0);
+    }
+    TimeSeriesProperty<double> * p1 = new TimeSeriesProperty<double>("BaseProperty");
+    p1->create(tStart, deltaTs, valueXs);
+
+    // Each interval covers the values at 40*k and 40*k+10 seconds
+    TimeSeriesProperty<bool> *filter = new TimeSeriesProperty<bool>("Filter");
+    for (int k = 0; k < 5; k ++)
+    {
+      filter->addValue(tStart + static_cast<double>(40*k+5), true);
+      filter->addValue(tStart + static_cast<double>(40*k+15), false);
+    }
+    p1->filterWith(filter);
+    p1->countSize();
+    TS_ASSERT_EQUALS(p1->size(), 10);
+    for (int k = 0; k < 5; k ++)
+    {
+      TS_ASSERT_DELTA(p1->nthValue(2*k), 4.0*k+1.0, 1.0E-8);
+      TS_ASSERT_DELTA(p1->nthValue(2*k+1), 4.0*k+2.0, 1.0E-8);
+    }
+
+    // An entry before the others, outside of the filter, moves all the values when the log is sorted
+    p1->addValue(tStart - 10.0, 0.0);
+    for (int k = 0; k < 5; k ++)
+    {
+      TS_ASSERT_DELTA(p1->nthValue(2*k), 4.0*k+1.0, 1.0E-8);
+      TS_ASSERT_DELTA(p1->nthValue(2*k+1), 4.0*k+2.0, 1.0E-8);
+    }
+
+    delete p1;
+    delete filter;
+  }
+
   void test_filter_with_single_value_in_series()
   {
     auto p1 = boost::make_shared<TimeSeriesProperty<double>>("SingleValueTSP");
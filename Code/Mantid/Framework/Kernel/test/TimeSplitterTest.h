@@ -520,6 +520,43 @@ public:
     TS_ASSERT_EQUALS(b[3].start(), DateAndTime("2007-11-30T16:19:00"));
   }
 
+  //----------------------------------------------------------------------------
+  void test_TimeSplitterIndex()
+  {
+    TimeSplitterType b;
+    // Out of order, with a gap between 250 and 300
+    b.push_back( SplittingInterval(DateAndTime(int64_t(300)), DateAndTime(int64_t(400)), 5) );
+    b.push_back( SplittingInterval(DateAndTime(int64_t(100)), DateAndTime(int64_t(200)), 2) );
+    b.push_back( SplittingInterval(DateAndTime(int64_t(200)), DateAndTime(int64_t(250)), 5) );
+
+    TimeSplitterIndex index(b);
+    TS_ASSERT_EQUALS( index.size(), 3 );
+    TS_ASSERT_EQUALS( index.getNumberOfOutputs(), 3 );
+    TS_ASSERT_EQUALS( index.getOutputIndex(0), -1 );
+    TS_ASSERT_EQUALS( index.getOutputIndex(1), 2 );
+    TS_ASSERT_EQUALS( index.getOutputIndex(2), 5 );
+
+    const int64_t times[11] = {0, 100, 150, 200, 249, 250, 299, 300, 399, 400, 1000};
+    const size_t outputs[11] = {0, 1, 1, 2, 2, 0, 0, 2, 2, TimeSplitterIndex::NO_OUTPUT, TimeSplitterIndex::NO_OUTPUT};
+    size_t hint = 0;
+    for (size_t i = 0; i < 11; i++)
+    {
+      TS_ASSERT_EQUALS( index.getOutput(times[i]), outputs[i] );
+      TS_ASSERT_EQUALS( index.getOutput(times[i], hint), outputs[i] );
+    }
+    // The hint works backwards too
+    for (size_t i = 11; i > 0; i--)
+      TS_ASSERT_EQUALS( index.getOutput(times[i-1], hint), outputs[i-1] );
+  }
+
+  void test_TimeSplitterIndex_empty()
+  {
+    TimeSplitterIndex index((TimeSplitterType()));
+    TS_ASSERT_EQUALS( index.getNumberOfOutputs(), 1 );
+    TS_ASSERT_EQUALS( index.getOutputIndex(0), -1 );
+    TS_ASSERT_EQUALS( index.getOutput(12345), 0 );
+  }
+
   //----------------------------------------------------------------------------
   void test_find()
   {
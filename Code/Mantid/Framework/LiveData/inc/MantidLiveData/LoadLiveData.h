@@ -5,6 +5,7 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidLiveData/LiveDataAlgorithm.h"
 #include "MantidAPI/Workspace.h"
+#include "MantidDataObjects/EventWorkspace.h"
 
 namespace Mantid
 {
@@ -61,6 +62,7 @@ namespace LiveData
     void replaceChunk(Mantid::API::Workspace_sptr chunkWS);
     void addChunk(Mantid::API::Workspace_sptr chunkWS);
     void addMatrixWSChunk(const std::string &algoName, API::Workspace_sptr accumWS, API::Workspace_sptr chunkWS);
+    void addEventChunk(DataObjects::EventWorkspace_sptr accumWS, DataObjects::EventWorkspace_sptr chunkWS);
     void appendChunk(Mantid::API::Workspace_sptr chunkWS);
     API::Workspace_sptr appendMatrixWSChunk(API::Workspace_sptr accumWS, Mantid::API::Workspace_sptr chunkWS);
 
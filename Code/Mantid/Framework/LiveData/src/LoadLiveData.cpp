@@ -35,6 +35,7 @@ by the [[MonitorLiveData]] algorithm.
 
 * The ''AccumulationMethod'' property specifies what to do with each chunk.
 ** If you select 'Add', the chunks of processed data will be added using [[Plus]] or [[PlusMD]].
+*** EventWorkspaces with the same spectra are added in place instead: the events of the chunk are moved to the accumulated workspace, which is kept sorted, so adding a chunk takes a time depending on its size rather than on the size of the accumulated data.
 ** If you select 'Replace', then the output workspace will always be equal to the latest processed chunk.
 ** If you select 'Append', then the spectra from each chunk will be appended to the output workspace.
 
@@ -306,9 +307,9 @@ namespace LiveData
    */
   void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS)
   {
-    // Acquire locks on the workspaces we use
+    // Acquire locks on the workspaces we use. The events of an event chunk are moved out of it.
     WriteLock _lock1(*m_accumWS);
-    ReadLock _lock2(*chunkWS);
+    WriteLock _lock2(*chunkWS);
 
     // Choose the appropriate algorithm to add chunks
     std::string algoName = "PlusMD";
@@ -351,6 +352,19 @@ namespace LiveData
    */
   void LoadLiveData::addMatrixWSChunk(const std::string& algoName, Workspace_sptr accumWS, Workspace_sptr chunkWS)
   {
+      // Event workspaces with the same spectra are added in place, without running Plus
+      EventWorkspace_sptr accumEventWS = boost::dynamic_pointer_cast<EventWorkspace>(accumWS);
+      EventWorkspace_sptr chunkEventWS = boost::dynamic_pointer_cast<EventWorkspace>(chunkWS);
+      if (algoName == "Plus" && accumEventWS && chunkEventWS && accumEventWS != chunkEventWS
+          && accumEventWS->getNumberHistograms() == chunkEventWS->getNumberHistograms()
+          && accumEventWS->getAxis(0)->unit()->unitID() == chunkEventWS->getAxis(0)->unit()->unitID())
+      {
+        addEventChunk(accumEventWS, chunkEventWS);
+        // Only the spectra which got unsorted events are sorted again
+        doSortEvents(accumWS);
+        return;
+      }
+
       IAlgorithm_sptr alg = this->createChildAlgorithm(algoName);
       alg->setProperty("LHSWorkspace", accumWS);
       alg->setProperty("RHSWorkspace", chunkWS);
@@ -377,6 +391,41 @@ namespace LiveData
   }
 
 
+  //----------------------------------------------------------------------------------------------
+  /**
+   * Add a chunk of events to the accumulation workspace in place.
+   * The events of each spectrum of the chunk are sorted and moved to the end of the same
+   * spectrum of the accumulation workspace, which stays sorted by TOF. Only the histograms
+   * of the spectra which got events are dropped from the MRU. The chunk is left without events.
+   *
+   * @param accumWS :: accumulation event workspace
+   * @param chunkWS :: processed live data chunk event workspace, with the same spectra
+   */
+  void LoadLiveData::addEventChunk(EventWorkspace_sptr accumWS, EventWorkspace_sptr chunkWS)
+  {
+    CPUTimer tim;
+    const int64_t numHistograms = static_cast<int64_t>(chunkWS->getNumberHistograms());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t wi = 0; wi < numHistograms; ++wi)
+    {
+      PARALLEL_START_INTERUPT_REGION
+      EventList & chunkList = chunkWS->getEventList(wi);
+      if (chunkList.getNumberEvents() > 0)
+      {
+        // Sorting the new events is enough to keep the accumulated ones sorted
+        chunkList.sortTof();
+        accumWS->getEventList(wi).takeEvents(chunkList);
+      }
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+
+    // As Plus does: add up the proton charges, append the logs, etc.
+    accumWS->mutableRun() += chunkWS->run();
+    g_log.debug() << tim << " to add the events of the chunk to " << accumWS->name() << std::endl;
+  }
+
+
   //----------------------------------------------------------------------------------------------
   /** Accumulate the data by replacing the output workspace.
    * Sets m_accumWS.
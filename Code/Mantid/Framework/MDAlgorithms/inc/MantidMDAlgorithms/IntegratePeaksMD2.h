@@ -52,8 +52,8 @@ namespace MDAlgorithms
     Geometry::Instrument_const_sptr inst;
 
     /// Check if peaks overlap
-    void checkOverlap(int i,
-    		Mantid::DataObjects::PeaksWorkspace_sptr peakWS, int CoordinatesToUse, double radius);
+    void checkOverlap(Mantid::DataObjects::PeaksWorkspace_sptr peakWS, int CoordinatesToUse,
+    		const std::vector<double> & radius);
 
   };
 
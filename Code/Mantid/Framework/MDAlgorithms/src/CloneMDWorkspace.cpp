@@ -11,6 +11,9 @@ If you wish to clone a file-backed MDEventWorkspace to an in-memory MDEventWorks
 recommend that you first call [[SaveMD]] with UpdateFileBackEnd=True (if necessary),
 followed by a simple LoadMD call to the file in question.
 
+If the InputWorkspace keeps its events packed in memory (compact storage, see [[CreateMDWorkspace]]),
+the clone is made in memory and gets compact storage too.
+
 *WIKI*/
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidKernel/System.h"
@@ -72,7 +75,7 @@ namespace MDAlgorithms
     declareProperty(new FileProperty("Filename", "", FileProperty::OptionalSave, exts),
         "If the input workspace is file-backed, specify a file to which to save the cloned workspace.\n"
         "If the workspace is file-backed but this parameter is NOT specified, then a new filename with '_clone' appended is created next to the original file.\n"
-        "No effect if the input workspace is NOT file-backed.\n"
+        "No effect if the input workspace is NOT file-backed, or keeps its events packed in memory.\n"
         "");
 
   }
@@ -89,7 +92,35 @@ namespace MDAlgorithms
     BoxController_sptr bc = ws->getBoxController();
 
     if (!bc) throw std::runtime_error("Error with InputWorkspace: no BoxController!");
-    if (bc->isFileBacked())
+    if (bc->hasCompactStorage())
+    {
+      // There is no file to copy, and the copy constructor only copies the events which are in memory.
+      // Give the clone compact storage too and copy the events box by box, so they get packed as they come.
+      boost::shared_ptr<MDEventWorkspace<MDE,nd> > outWS(new MDEventWorkspace<MDE,nd>(*ws));
+      MDEventFactory::setCompactStorage(outWS, bc->getFileIO()->getWriteBufferSize());
+
+      std::vector<API::IMDNode *> boxes, outBoxes;
+      ws->getBoxes(boxes, 10000, true);
+      outWS->getBoxes(outBoxes, 10000, true);
+      if (boxes.size() != outBoxes.size())
+        throw std::runtime_error("CloneMDWorkspace: the box structure of the clone does not match the one of the InputWorkspace.");
+
+      prog.setNumSteps(int64_t(boxes.size()));
+      for (size_t i=0; i<boxes.size(); i++)
+      {
+        MDBox<MDE,nd> * box = dynamic_cast<MDBox<MDE,nd> *>(boxes[i]);
+        MDBox<MDE,nd> * outBox = dynamic_cast<MDBox<MDE,nd> *>(outBoxes[i]);
+        if (box && outBox)
+        {
+          outBox->getEvents() = box->getConstEvents();
+          outBox->releaseEvents();
+          box->releaseEvents();
+        }
+        prog.report("Copying Boxes");
+      }
+      this->setProperty("OutputWorkspace", boost::dynamic_pointer_cast<IMDWorkspace>(outWS) );
+    }
+    else if (bc->isFileBacked())
     {
       if (ws->fileNeedsUpdating())
       {
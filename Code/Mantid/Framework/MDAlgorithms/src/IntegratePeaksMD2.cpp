@@ -78,6 +78,7 @@ IntegratePeaksMD(InputWorkspace='TOPAZ_3131_md', PeaksWorkspace='peaks',
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/TextAxis.h"
 #include "MantidKernel/Utils.h"
+#include "MantidKernel/ANN/ANN.h"
 #include "MantidAPI/FileProperty.h"
 #include "MantidAPI/TableRow.h"
 #include "MantidAPI/Column.h"
@@ -87,6 +88,7 @@ IntegratePeaksMD(InputWorkspace='TOPAZ_3131_md', PeaksWorkspace='peaks',
 #include "MantidAPI/IPeakFunction.h"
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <gsl/gsl_integration.h>
+#include <algorithm>
 #include <fstream>
 
 namespace Mantid
@@ -291,18 +293,23 @@ namespace MDAlgorithms
 		outFile = save_path + outFile;
 		out.open(outFile.c_str(), std::ofstream::out);
     }
-//
-// If the following OMP pragma is included, this algorithm seg faults
-// sporadically when processing multiple TOPAZ runs in a script, on 
-// Scientific Linux 6.2.  Typically, it seg faults after 2 to 6 runs are 
-// processed, though occasionally it will process all 8 requested in the 
-// script without crashing.  Since the lower level codes already use OpenMP, 
-// parallelizing at this level is only marginally useful, giving about a 
-// 5-10% speedup.  Perhaps is should just be removed permanantly, but for 
-// now it is commented out to avoid the seg faults.  Refs #5533
-//PRAGMA_OMP(parallel for schedule(dynamic, 10) )
-    for (int i=0; i < peakWS->getNumberPeaks(); ++i)
+
+    // Get the instrument and its detectors
+    inst = peakWS->getInstrument();
+    const int nPeaks = peakWS->getNumberPeaks();
+    // The distance below which the peaks after each peak overlap with it; 0 if the peak was not integrated
+    std::vector<double> overlapRadius(nPeaks, 0.0);
+
+    // The spheres are integrated for several peaks in parallel, as this only reads the boxes; the instrument
+    // is got once, above, and the ray tracing on it is done one peak at a time (see below).
+    // The cylinders fill shared profile workspaces and a file, and the boxes of file-backed workspaces are
+    // moved in the disk buffer when they are read, so these are integrated one peak after the other.
+    // This includes compact storage: its boxes are loaded on demand the same way, and two peaks may need the same box.
+    const bool integrateInParallel = !cylinderBool && !ws->isFileBacked();
+    PARALLEL_FOR_IF(integrateInParallel)
+    for (int i=0; i < nPeaks; ++i)
     {
+      PARALLEL_START_INTERUPT_REGION
       // Get a direct ref to that peak.
       IPeak & p = peakWS->getPeak(i);
 
@@ -315,24 +322,21 @@ namespace MDAlgorithms
       else if (CoordinatesToUse == 3) //"HKL"
         pos = p.getHKL();
 
-      // Get the instrument and its detectors
-      inst = peakWS->getInstrument();
-      // Do not integrate if sphere is off edge of detector
-      if (BackgroundOuterRadius > PeakRadius)
+      // Do not integrate if sphere is off edge of detector.
+      // Finding the detectors traces rays through the instrument, which fills its bounding box caches
+      // without a lock: only one thread at a time does it.
+      bool onDetector;
+      PARALLEL_CRITICAL(IntegratePeaksMD2_detectorQ)
       {
-        if (!detectorQ(p.getQLabFrame(), BackgroundOuterRadius))
-          {
-             g_log.warning() << "Warning: sphere/cylinder for integration is off edge of detector for peak " << i << std::endl;
-             if (!integrateEdge)continue;
-          }
+        if (BackgroundOuterRadius > PeakRadius)
+          onDetector = detectorQ(p.getQLabFrame(), BackgroundOuterRadius);
+        else
+          onDetector = detectorQ(p.getQLabFrame(), PeakRadius);
       }
-      else
+      if (!onDetector)
       {
-        if (!detectorQ(p.getQLabFrame(), PeakRadius))
-          {
-             g_log.warning() << "Warning: sphere/cylinder for integration is off edge of detector for peak " << i << std::endl;
-             if (!integrateEdge)continue;
-          }
+        g_log.warning() << "Warning: sphere/cylinder for integration is off edge of detector for peak " << i << std::endl;
+        if (!integrateEdge)continue;
       }
 
       // Build the sphere transformation
@@ -366,31 +370,35 @@ namespace MDAlgorithms
 			BackgroundOuterRadiusVector[i] = lenQpeak*BackgroundOuterRadius;
 			CoordTransformDistance sphere(nd, center, dimensionsUsed);
 
-			// Perform the integration into whatever box is contained within.
-			ws->getBox()->integrateSphere(sphere, static_cast<coord_t>(lenQpeak*PeakRadius*lenQpeak*PeakRadius), signal, errorSquared);
+			// The peak radius and, if there is a background shell, its inner and outer radii, in increasing order.
+			// BackgroundInnerRadius >= PeakRadius, but it could be above BackgroundOuterRadius.
+			const size_t numRadii = (BackgroundOuterRadius > PeakRadius) ? 3 : 1;
+			size_t innerIndex = 1;
+			size_t outerIndex = 2;
+			if (BackgroundInnerRadius > BackgroundOuterRadius) std::swap(innerIndex, outerIndex);
+			coord_t radiiSquared[3];
+			radiiSquared[0] = static_cast<coord_t>(lenQpeak*PeakRadius*lenQpeak*PeakRadius);
+			radiiSquared[innerIndex] = static_cast<coord_t>(lenQpeak*BackgroundInnerRadius*lenQpeak*BackgroundInnerRadius);
+			radiiSquared[outerIndex] = static_cast<coord_t>(lenQpeak*BackgroundOuterRadius*lenQpeak*BackgroundOuterRadius);
+			signal_t signals[3] = {0., 0., 0.};
+			signal_t errorsSquared[3] = {0., 0., 0.};
+
+			// Perform the integration of all the radii into whatever box is contained within, in one go.
+			ws->getBox()->integrateSpheres(sphere, numRadii, radiiSquared, signals, errorsSquared);
+			signal = signals[0];
+			errorSquared = errorsSquared[0];
 
 			// Integrate around the background radius
 
 			if (BackgroundOuterRadius > PeakRadius )
 			{
 				// Get the total signal inside "BackgroundOuterRadius"
-				ws->getBox()->integrateSphere(sphere, static_cast<coord_t>(lenQpeak*BackgroundOuterRadius*lenQpeak*BackgroundOuterRadius), bgSignal, bgErrorSquared);
+				bgSignal = signals[outerIndex];
+				bgErrorSquared = errorsSquared[outerIndex];
 
 				// Evaluate the signal inside "BackgroundInnerRadius"
-				signal_t interiorSignal = 0;
-				signal_t interiorErrorSquared = 0;
-
-				// Integrate this 3rd radius, if needed
-				if (BackgroundInnerRadius != PeakRadius)
-				{
-					ws->getBox()->integrateSphere(sphere, static_cast<coord_t>(lenQpeak*BackgroundInnerRadius*lenQpeak*BackgroundInnerRadius), interiorSignal, interiorErrorSquared);
-				}
-				else
-				{
-					// PeakRadius == BackgroundInnerRadius, so use the previous value
-					interiorSignal = signal;
-					interiorErrorSquared = errorSquared;
-				}
+				signal_t interiorSignal = signals[innerIndex];
+				signal_t interiorErrorSquared = errorsSquared[innerIndex];
 		        // Subtract the peak part to get the intensity in the shell (BackgroundInnerRadius < r < BackgroundOuterRadius)
 		        bgSignal -= interiorSignal;
 		        // We can subtract the error (instead of adding) because the two values are 100% dependent; this is the same as integrating a shell.
@@ -605,8 +613,7 @@ namespace MDAlgorithms
 				}
 			}
       	  }
-          checkOverlap (i, peakWS, CoordinatesToUse,
-        		  2.0 * std::max(PeakRadiusVector[i],BackgroundOuterRadiusVector[i]));
+          overlapRadius[i] = 2.0 * std::max(PeakRadiusVector[i],BackgroundOuterRadiusVector[i]);
 		  // Save it back in the peak object.
 		  if (signal != 0. || replaceIntensity)
 		  {
@@ -619,7 +626,12 @@ namespace MDAlgorithms
 			  << bgSignal << " (sig^2 " << bgErrorSquared << ") subtracted."
 			  << std::endl;
 
+      PARALLEL_END_INTERUPT_REGION
     }
+    PARALLEL_CHECK_INTERUPT_REGION
+
+    checkOverlap(peakWS, CoordinatesToUse, overlapRadius);
+
     // This flag is used by the PeaksWorkspace to evaluate whether it has been integrated.
     peakWS->mutableRun().addProperty("PeaksIntegrated", 1, true); 
     // These flags are specific to the algorithm.
@@ -690,35 +702,68 @@ namespace MDAlgorithms
     }
     return in;
   }
-  void IntegratePeaksMD2::checkOverlap(int i,
-		  Mantid::DataObjects::PeaksWorkspace_sptr peakWS, int CoordinatesToUse, double radius)
+  /** Warn about the peaks whose integration spheres overlap.
+   * The peak centres are put in a kd-tree, so that only the peaks near each peak are looked at.
+   *
+   * @param peakWS: The peaks.
+   * @param CoordinatesToUse: The coordinates of the peak centres, as in the MD workspace.
+   * @param radius: For each peak, the distance below which the peaks after it overlap with it; 0 to skip the peak.
+   */
+  void IntegratePeaksMD2::checkOverlap(Mantid::DataObjects::PeaksWorkspace_sptr peakWS, int CoordinatesToUse,
+		  const std::vector<double> & radius)
   {
-      // Get a direct ref to that peak.
-      IPeak & p1 = peakWS->getPeak(i);
-      V3D pos1;
+    const int nPeaks = peakWS->getNumberPeaks();
+    if (nPeaks < 2) return;
+
+    std::vector<V3D> positions(nPeaks);
+    ANNpointArray dataPoints = annAllocPts(nPeaks, 3);
+    for (int i=0; i < nPeaks; ++i)
+    {
+      IPeak & p = peakWS->getPeak(i);
       if (CoordinatesToUse == 1) //"Q (lab frame)"
-        pos1 = p1.getQLabFrame();
+        positions[i] = p.getQLabFrame();
       else if (CoordinatesToUse == 2) //"Q (sample frame)"
-        pos1 = p1.getQSampleFrame();
+        positions[i] = p.getQSampleFrame();
       else if (CoordinatesToUse == 3) //"HKL"
-        pos1 = p1.getHKL();
-	    for (int j=i+1; j < peakWS->getNumberPeaks(); ++j)
-	    {
-			  // Get a direct ref to rest of peaks peak.
-			  IPeak & p2 = peakWS->getPeak(j);
-			  V3D pos2;
-			  if (CoordinatesToUse == 1) //"Q (lab frame)"
-				pos2 = p2.getQLabFrame();
-			  else if (CoordinatesToUse == 2) //"Q (sample frame)"
-				pos2 = p2.getQSampleFrame();
-			  else if (CoordinatesToUse == 3) //"HKL"
-				pos2 = p2.getHKL();
-			  if (pos1.distance(pos2) < radius)
-			  {
-				  g_log.warning() << " Warning:  Peak integration spheres for peaks "
-						  << i << " and " << j <<" overlap.  Distance between peaks is "<< pos1.distance(pos2)<<std::endl;
-			  }
-	    }
+        positions[i] = p.getHKL();
+      dataPoints[i][0] = positions[i].X();
+      dataPoints[i][1] = positions[i].Y();
+      dataPoints[i][2] = positions[i].Z();
+    }
+    ANNkd_tree *annTree = new ANNkd_tree(dataPoints, nPeaks, 3);
+
+    std::vector<ANNidx> nnIndexList;
+    std::vector<ANNdist> nnDistList;
+    for (int i=0; i < nPeaks; ++i)
+    {
+      if (radius[i] <= 0.0) continue;
+      // Count the peaks within the radius (this one included), then get them
+      const ANNdist radiusSquared = radius[i] * radius[i];
+      const int nNeighbours = annTree->annkFRSearch(dataPoints[i], radiusSquared, 0);
+      if (nNeighbours < 2) continue;
+      nnIndexList.resize(nNeighbours);
+      nnDistList.resize(nNeighbours);
+      annTree->annkFRSearch(dataPoints[i], radiusSquared, nNeighbours, &nnIndexList[0], &nnDistList[0]);
+
+      // Report the ones after this peak, in order
+      std::vector<int> overlapping;
+      for (int k=0; k < nNeighbours; ++k)
+      {
+        const int j = nnIndexList[k];
+        if (j > i && positions[i].distance(positions[j]) < radius[i])
+          overlapping.push_back(j);
+      }
+      std::sort(overlapping.begin(), overlapping.end());
+      for (size_t k=0; k < overlapping.size(); ++k)
+      {
+        const int j = overlapping[k];
+        g_log.warning() << " Warning:  Peak integration spheres for peaks "
+            << i << " and " << j <<" overlap.  Distance between peaks is "<< positions[i].distance(positions[j])<<std::endl;
+      }
+    }
+    delete annTree;
+    annDeallocPts(dataPoints);
+    annClose();
   }
   //----------------------------------------------------------------------------------------------
   /** Execute the algorithm.
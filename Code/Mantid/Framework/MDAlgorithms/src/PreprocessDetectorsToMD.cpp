@@ -100,6 +100,7 @@ The workspace also has the following properties attached to it:
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidAPI/NumericAxis.h"
+#include "MantidAPI/DetectorGeometryTable.h"
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -300,6 +301,9 @@ namespace Mantid
          pMasksArray    = targWS->getColDataArray<int>("detMask");
 
 
+      // the geometry of the detectors of all the spectra, kept by the workspace
+      boost::shared_ptr<const API::DetectorGeometryTable> geometry = inputWS->detectorGeometry();
+
       //// progress messave appearence
       size_t div=100;
       size_t nHist = targWS->rowCount();
@@ -317,22 +321,14 @@ namespace Mantid
    //     detMask[i]  = true;
 
    
-        // get detector or detector group which corresponds to the spectra i
-        Geometry::IDetector_const_sptr spDet;
-        try
-        {
-          spDet= inputWS->getDetector(i);      
-        }
-        catch(Kernel::Exception::NotFoundError &)
-        {
-          continue;
-        }
+        // check there is a detector or detector group which corresponds to the spectra i
+        if (!geometry->hasDetector(i))continue;
 
         // Check that we aren't dealing with monitor...
-        if (spDet->isMonitor())continue;   
+        if (geometry->isMonitor(i))continue;   
 
         // if masked detectors state is not used, masked detectors just ignored;
-        bool maskDetector = spDet->isMasked();
+        bool maskDetector = geometry->isMasked(i);
         if(m_getIsMasked)
           *(pMasksArray+liveDetectorsCount) = maskDetector?1:0;
         else
@@ -340,12 +336,12 @@ namespace Mantid
 
         // calculate the requested values;
         sp2detMap[i]                = liveDetectorsCount;
-        detId[liveDetectorsCount]   = int32_t(spDet->getID());
+        detId[liveDetectorsCount]   = int32_t(geometry->detectorID(i));
         detIDMap[liveDetectorsCount]= i;
-        L2[liveDetectorsCount]      = spDet->getDistance(*sample);
+        L2[liveDetectorsCount]      = geometry->l2(i);
 
-        double polar   =  inputWS->detectorTwoTheta(spDet);
-        double azim    =  spDet->getPhi();    
+        double polar   =  geometry->twoTheta(i);
+        double azim    =  geometry->phi(i);    
         TwoTheta[liveDetectorsCount]  =  polar;
         Azimuthal[liveDetectorsCount] =  azim;
 
@@ -368,6 +364,7 @@ namespace Mantid
         {
           try
           {
+            Geometry::IDetector_const_sptr spDet= inputWS->getDetector(i);
             Geometry::Parameter_sptr par = pmap.getRecursive(spDet.get(),"eFixed");
             if (par) Efi = par->value<double>();
           }
@@ -399,25 +396,19 @@ namespace Mantid
       if (nHist != nRows)
         throw std::invalid_argument(" source workspace "+ inputWS->getName()+ " and target workspace "+targWS->getName()+" are inconsistent as have different numner of detectors");
 
+      boost::shared_ptr<const API::DetectorGeometryTable> geometry = inputWS->detectorGeometry();
+
       uint32_t liveDetectorsCount(0);
       for (size_t i = 0; i < nHist; i++)
       {   
-        // get detector or detector group which corresponds to the spectra i
-        Geometry::IDetector_const_sptr spDet;
-        try
-        {
-          spDet= inputWS->getDetector(i);      
-        }
-        catch(Kernel::Exception::NotFoundError &)
-        {
-          continue;
-        }
+        // check there is a detector or detector group which corresponds to the spectra i
+        if (!geometry->hasDetector(i))continue;
 
         // Check that we aren't dealing with monitor...
-        if (spDet->isMonitor())continue;   
+        if (geometry->isMonitor(i))continue;   
 
         // if masked detectors state is not used, masked detectors just ignored;
-        bool maskDetector = spDet->isMasked();
+        bool maskDetector = geometry->isMasked(i);
         *(pMasksArray+liveDetectorsCount) = maskDetector?1:0;
 
         liveDetectorsCount++;
@@ -7,6 +7,8 @@ If you specify MakeFileBacked, then this will turn an in-memory workspace to a f
 
 If you specify UpdateFileBackEnd, then any changes (e.g. events added using the PlusMD algorithm) will be saved to the file back-end.
 
+A workspace which keeps its events packed in memory (compact storage) is saved like an in-memory one; it has no file back-end to update.
+
 *WIKI*/
 
 #include "MantidAPI/CoordTransform.h"
@@ -108,14 +110,17 @@ namespace MDAlgorithms
     bool update = getProperty("UpdateFileBackEnd");
     bool MakeFileBacked = getProperty("MakeFileBacked");
 
-    bool wsIsFileBacked = ws->isFileBacked();
+    BoxController_sptr bc = ws->getBoxController();
+    // Compact storage has no file behind it: its events are saved as if they were in memory
+    bool compactStorage = bc->hasCompactStorage();
+    bool wsIsFileBacked = ws->isFileBacked() && !compactStorage;
     if (update && MakeFileBacked)
       throw std::invalid_argument("Please choose either UpdateFileBackEnd or MakeFileBacked, not both.");
 
     if (MakeFileBacked && wsIsFileBacked)
       throw std::invalid_argument("You picked MakeFileBacked but the workspace is already file-backed!");
-
-    BoxController_sptr bc = ws->getBoxController();
+    if (MakeFileBacked && compactStorage)
+      throw std::invalid_argument("You picked MakeFileBacked but the workspace keeps its events packed in memory (compact storage)!");
 
     if(!wsIsFileBacked)
     {   // Erase the file if it exists
@@ -127,7 +132,7 @@ namespace MDAlgorithms
     Progress * prog = new Progress(this, 0.0, 0.05,1);
     if(update)  // workspace has its own file and ignores any changes to the algorithm parameters
     {
-      if(!ws->isFileBacked())
+      if(!wsIsFileBacked)
         throw std::runtime_error(" attemtp to update non-file backed workspace");
       filename = bc->getFileIO()->getFileName();
     }
@@ -202,7 +207,14 @@ namespace MDAlgorithms
         for(size_t i=0;i<boxes.size();i++)
         {
           if(eventIndex[2*i+1]==0)continue;
+          MDBox<MDE,nd> * mdBox = NULL;
+          if(compactStorage)
+          { // bring the packed events back to memory for the time of saving
+            mdBox = dynamic_cast<MDBox<MDE,nd> *>(boxes[i]);
+            if(mdBox) mdBox->getConstEvents();
+          }
           boxes[i]->saveAt(Saver.get(),eventIndex[2*i]);
+          if(mdBox) mdBox->releaseEvents();
           prog->report("Saving Box");
         }
         Saver->closeFile();
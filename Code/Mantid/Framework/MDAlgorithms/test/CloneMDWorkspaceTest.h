@@ -56,6 +56,41 @@ public:
   }
 
 
+  /** The events of a workspace with compact storage are packed in memory:
+   * there is no file to copy, and the clone gets all the events */
+  void test_exec_CompactStorage()
+  {
+    std::string outWSName("CloneMDWorkspaceTest_OutputWS");
+    MDEventWorkspace3Lean::sptr ws1 = MDEventsTestHelper::makeFileBackedMDEW("CloneMDWorkspaceTest_ws", false);
+    MDEventFactory::setCompactStorage(ws1, 0);
+    // Pack all the events
+    ws1->getBoxController()->getFileIO()->flushCache();
+
+    CloneMDWorkspace alg;
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("InputWorkspace", "CloneMDWorkspaceTest_ws") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputWorkspace", outWSName) );
+    TS_ASSERT_THROWS_NOTHING( alg.execute(); );
+    TS_ASSERT( alg.isExecuted() );
+
+    MDEventWorkspace3Lean::sptr ws2;
+    TS_ASSERT_THROWS_NOTHING( ws2 = AnalysisDataService::Instance().retrieveWS<MDEventWorkspace3Lean>(outWSName) );
+    TS_ASSERT(ws2); if (!ws2) return;
+    TS_ASSERT( ws2->getBoxController()->hasCompactStorage() );
+    TS_ASSERT( ws2->getBoxController()->getFilename().empty() );
+    TS_ASSERT_DIFFERS( ws1->getBoxController()->getFileIO(), ws2->getBoxController()->getFileIO() );
+
+    ws1->refreshCache();
+    ws2->refreshCache();
+    TS_ASSERT_EQUALS( ws2->getNPoints(), ws1->getNPoints() );
+    TS_ASSERT_DELTA( ws2->getBox()->getSignal(), ws1->getBox()->getSignal(), 1e-6 );
+    TS_ASSERT_EQUALS( ws2->getBoxController()->getTotalNumMDBoxes(), ws1->getBoxController()->getTotalNumMDBoxes() );
+
+    AnalysisDataService::Instance().remove("CloneMDWorkspaceTest_ws");
+    AnalysisDataService::Instance().remove(outWSName);
+  }
+
+
   void do_test(bool fileBacked, std::string Filename = "", bool file_needs_updating = false)
   {
     // Name of the output workspace.
@@ -338,6 +338,54 @@ void test_EventFromTOFConv()
     //float sec = Clock.elapsedCPU();
     TS_WARN("Time to complete: <EventWSType,Q3D,Indir,ConvFromTOF,CrystType>: "+boost::lexical_cast<std::string>(sec)+" sec");
 }
+void test_EventFromTOFConvSingleThreaded()
+{
+    NumericAxis *pAxis0 = new NumericAxis(2); 
+    pAxis0->setUnit("TOF");
+    inWsEv->replaceAxis(0,pAxis0);
+  
+    MDWSDescription WSD;
+    std::vector<double> min(4,-1e+30),max(4,1e+30);
+    WSD.setMinMax(min,max);
+    WSD.buildFromMatrixWS(inWsEv,"Q3D","Indirect");
+
+    WSD.m_PreprDetTable =pDetLoc_events;
+    WSD.m_RotMatrix = Rot;
+    WSD.addProperty("RUN_INDEX",static_cast<uint16_t>(10),true);
+
+    // convert the events in parallel and then in one thread
+    pTargWS->releaseWorkspace();   
+    pTargWS->createEmptyMDWS(WSD);
+    ConvToMDSelector AlgoSelector;
+    pConvMethods = AlgoSelector.convSelector(inWsEv,pConvMethods);
+    pConvMethods->initialize(WSD,pTargWS,false);
+    pMockAlgorithm->resetProgress(numHist);
+    TS_ASSERT_THROWS_NOTHING(pConvMethods->runConversion(pMockAlgorithm->getProgress()));
+    IMDEventWorkspace_sptr parallelWS = pTargWS->pWorkspace();
+
+    inWsEv->mutableRun().addProperty("NUM_THREADS",0.,true);
+    pTargWS->releaseWorkspace();   
+    pTargWS->createEmptyMDWS(WSD);
+    pConvMethods = AlgoSelector.convSelector(inWsEv,pConvMethods);
+    pConvMethods->initialize(WSD,pTargWS,false);
+    pMockAlgorithm->resetProgress(numHist);
+    std::time (&start);
+    TS_ASSERT_THROWS_NOTHING(pConvMethods->runConversion(pMockAlgorithm->getProgress()));
+    std::time (&end);
+    inWsEv->mutableRun().removeProperty("NUM_THREADS");
+    double sec = std::difftime (end,start);
+    TS_WARN("Time to complete: <EventWSType,Q3D,Indir,ConvFromTOF,CrystType> in one thread: "+boost::lexical_cast<std::string>(sec)+" sec");
+
+    // the events are added in a different order, but they have to be the same
+    IMDEventWorkspace_sptr serialWS = pTargWS->pWorkspace();
+    TS_ASSERT_EQUALS(parallelWS->getNPoints(),serialWS->getNPoints());
+    MDEventWorkspace<MDEvent<4>,4> * pParallelWS = dynamic_cast<MDEventWorkspace<MDEvent<4>,4> *>(parallelWS.get());
+    MDEventWorkspace<MDEvent<4>,4> * pSerialWS   = dynamic_cast<MDEventWorkspace<MDEvent<4>,4> *>(serialWS.get());
+    TS_ASSERT(pParallelWS && pSerialWS);
+    if(pParallelWS && pSerialWS)
+      TS_ASSERT_DELTA(pParallelWS->getBox()->getSignal(),pSerialWS->getBox()->getSignal(),1.e-6*pSerialWS->getBox()->getSignal());
+}
+
 void test_HistoFromTOFConv()
 {
 
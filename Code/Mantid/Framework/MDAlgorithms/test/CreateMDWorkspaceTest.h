@@ -189,6 +189,37 @@ public:
   {
     do_test_exec("", true, 2, 216*216);
   }
+
+  void test_exec_CompactStorage()
+  {
+    std::string wsName = "CreateMDWorkspaceTest_out";
+    CreateMDWorkspace alg;
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    alg.setPropertyValue("Dimensions", "3");
+    alg.setPropertyValue("Extents", "-1,1,-2,2,-3,3");
+    alg.setPropertyValue("Names", "x,y,z");
+    alg.setPropertyValue("Units", "m,mm,um");
+    alg.setPropertyValue("OutputWorkspace",wsName);
+    alg.setProperty("CompactStorage", true);
+    alg.setPropertyValue("Memory", "1");
+    TS_ASSERT_THROWS_NOTHING( alg.execute(); );
+    TS_ASSERT( alg.isExecuted() );
+
+    IMDEventWorkspace_sptr ws;
+    TS_ASSERT_THROWS_NOTHING(ws = boost::dynamic_pointer_cast<IMDEventWorkspace>( AnalysisDataService::Instance().retrieve(wsName) ));
+    TS_ASSERT( ws ); if (!ws) return;
+    BoxController_sptr bc = ws->getBoxController();
+    TS_ASSERT( bc->hasCompactStorage() );
+    TS_ASSERT( bc->getFilename().empty() );
+    // 1 MB of lean 3D events
+    TS_ASSERT_EQUALS( bc->getFileIO()->getWriteBufferSize(), 1024*1024/sizeof(MDLeanEvent<3>)+1 );
+
+    // Not with a file back end
+    alg.setPropertyValue("Filename", "CreateMDWorkspaceTest.nxs");
+    TS_ASSERT_THROWS_NOTHING( alg.execute(); );
+    TS_ASSERT( !alg.isExecuted() );
+    AnalysisDataService::Instance().remove(wsName);
+  }
 };
 
 
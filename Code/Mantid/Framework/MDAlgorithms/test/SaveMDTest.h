@@ -5,6 +5,7 @@
 #include "MantidKernel/Timer.h"
 #include "MantidMDEvents/MDEventFactory.h"
 #include "MantidMDAlgorithms/BinMD.h"
+#include "MantidMDAlgorithms/LoadMD.h"
 #include "MantidMDAlgorithms/SaveMD.h"
 #include "MantidTestHelpers/MDEventsTestHelper.h"
 #include "MantidAPI/FrameworkManager.h"
@@ -68,6 +69,54 @@ public:
   }
 
 
+  /** A workspace which keeps its events packed in memory is saved whole,
+   * but it has no file back-end to update or to replace */
+  void test_exec_CompactStorage()
+  {
+    MDEventWorkspace1Lean::sptr ws = MDEventsTestHelper::makeMDEW<1>(10, 0.0, 10.0, 23);
+    ws->splitBox();
+    ws->refreshCache();
+    MDEventFactory::setCompactStorage(ws, 0);
+    // Pack all the events
+    ws->getBoxController()->getFileIO()->flushCache();
+    AnalysisDataService::Instance().addOrReplace("SaveMDTest_ws", ws);
+
+    SaveMD alg;
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    alg.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("InputWorkspace", "SaveMDTest_ws") );
+    TS_ASSERT_THROWS_NOTHING( alg.setProperty("UpdateFileBackEnd", true) );
+    TS_ASSERT_THROWS_ANYTHING( alg.execute() );
+    TS_ASSERT_THROWS_NOTHING( alg.setProperty("UpdateFileBackEnd", false) );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("Filename", "SaveMDTest_compact.nxs") );
+    TS_ASSERT_THROWS_NOTHING( alg.setProperty("MakeFileBacked", true) );
+    TS_ASSERT_THROWS_ANYTHING( alg.execute() );
+    TS_ASSERT_THROWS_NOTHING( alg.setProperty("MakeFileBacked", false) );
+
+    std::string this_filename = alg.getPropertyValue("Filename");
+    if (Poco::File(this_filename).exists()) Poco::File(this_filename).remove();
+    TS_ASSERT_THROWS_NOTHING( alg.execute() );
+    TS_ASSERT( alg.isExecuted() );
+    TSM_ASSERT("The workspace keeps its compact storage", ws->getBoxController()->hasCompactStorage() );
+
+    // All the events made it to the file
+    LoadMD load;
+    TS_ASSERT_THROWS_NOTHING( load.initialize() )
+    TS_ASSERT_THROWS_NOTHING( load.setPropertyValue("Filename", this_filename) );
+    TS_ASSERT_THROWS_NOTHING( load.setPropertyValue("OutputWorkspace", "SaveMDTest_loaded") );
+    TS_ASSERT_THROWS_NOTHING( load.execute() );
+    TS_ASSERT( load.isExecuted() );
+    IMDEventWorkspace_sptr loaded;
+    TS_ASSERT_THROWS_NOTHING( loaded = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>("SaveMDTest_loaded") );
+    TS_ASSERT(loaded); if (!loaded) return;
+    TS_ASSERT_EQUALS( loaded->getNPoints(), 230 );
+
+    AnalysisDataService::Instance().remove("SaveMDTest_ws");
+    AnalysisDataService::Instance().remove("SaveMDTest_loaded");
+    if (Poco::File(this_filename).exists()) Poco::File(this_filename).remove();
+  }
+
+
   void do_test_exec(size_t numPerBox, std::string filename, bool MakeFileBacked = false, bool UpdateFileBackEnd = false)
   {
    
@@ -0,0 +1,136 @@
+#ifndef MANTID_MDEVENTS_BOXCONTROLLER_COMPACT_IO_H
+#define MANTID_MDEVENTS_BOXCONTROLLER_COMPACT_IO_H
+
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidAPI/BoxController.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidMDEvents/MDCompactEventBlock.h"
+#include <map>
+
+
+namespace Mantid
+{
+namespace MDEvents
+{
+
+  //===============================================================================================
+  /** Box controller IO which keeps the events "written out" by the disk buffer in memory, packed as
+    * MDCompactEventBlock's, instead of in a file.
+    *
+    * A workspace backed by it keeps its boxes as usual, but the events of the boxes which are not in
+    * the write buffer take 2-3 times less memory, at the cost of a bounded loss of precision of the
+    * coordinates (see MDCompactEventBlock). The "file" positions are the positions given by the disk
+    * buffer, in events, so nothing changes for the boxes. There is no file: the file name is only
+    * used for reporting, and the events are lost when the IO is closed.
+    * Expected to provide thread-safe access.
+
+      @date 2013-11-12
+
+      Copyright &copy; 2013 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+      This file is part of Mantid.
+
+      Mantid is free software; you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation; either version 3 of the License, or
+      (at your option) any later version.
+
+      Mantid is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+      File change history is stored at: <https://github.com/mantidproject/mantid>.
+      Code Documentation is available at: <http://doxygen.mantidproject.org>
+  */
+    class DLLExport BoxControllerCompactIO : public API::IBoxControllerIO
+    {
+        public:
+            BoxControllerCompactIO(API::BoxController *const theBC);
+
+           ///@return true if the IO is ready to accept events and false otherwise
+            virtual bool isOpened()const
+            {
+                return  m_isOpened;
+            }
+            /// get the name given when the IO was opened
+            virtual const std::string &getFileName()const
+            {
+                return m_fileName;
+            }
+            /**Return the size of the data block used in IO operations*/
+            size_t getDataChunk()const
+            {
+                return 1;
+            }
+
+            virtual bool openFile(const std::string &fileName,const std::string &mode);
+
+            virtual void saveBlock(const std::vector<float> & /* DataBlock */, const uint64_t /*blockPosition*/)const;
+            virtual void loadBlock(std::vector<float> &  /* Block */, const uint64_t /*blockPosition*/,const size_t /*BlockSize*/)const;
+            virtual void saveBlock(const std::vector<double> & /* DataBlock */, const uint64_t /*blockPosition*/)const;
+            virtual void loadBlock(std::vector<double> &  /* Block */, const uint64_t /*blockPosition*/,const size_t /*BlockSize*/)const;
+
+            virtual void flushData()const{};
+            virtual void closeFile();
+
+            virtual void freeBlock(uint64_t const pos, uint64_t const size);
+
+            virtual ~BoxControllerCompactIO();
+            virtual void setDataType(const size_t coordSize, const std::string &typeName);
+            virtual void getDataType(size_t &coordSize, std::string &typeName)const;
+            virtual size_t getMemorySize()const;
+            /// there is no file: the events are kept in memory
+            virtual bool isInMemory()const
+            { return true; }
+  //------------------------------------------------------------------------------------------------------------------------
+            //Auxiliary functions (non-virtual, used for testing)
+            int64_t getNDataColums()const
+            {
+                return m_nColumns;
+            }
+            /// @return the number of packed blocks held
+            size_t getNumBlocks()const
+            {
+                Kernel::Mutex::ScopedLock _lock(m_blocksMutex);
+                return m_blocks.size();
+            }
+    private:
+        /// the packed blocks, by position
+        typedef std::map<uint64_t, MDCompactEventBlock *> BlockMap;
+
+        /// name given at opening, for reporting only
+        std::string m_fileName;
+        /// identifier of the IO state, if it is open or not.
+        bool m_isOpened;
+        /// number of dimensions of the events
+        size_t m_nDims;
+        /// number of columns of a tabled event
+        int64_t m_nColumns;
+        /// number of bytes in the event coorinates (coord_t length). Set by setDataType
+        unsigned int m_CoordSize;
+        /// the name of the event type
+        std::string m_TypeName;
+        /// true for events with run index and detector ID
+        bool m_fatEvents;
+
+        /// the packed blocks
+        mutable BlockMap m_blocks;
+        /// memory held by the packed blocks, in bytes
+        mutable size_t m_memoryUsed;
+        /// lock for the blocks
+        mutable Kernel::Mutex m_blocksMutex;
+
+        void eraseBlocks(const uint64_t pos, const uint64_t size)const;
+        template<typename Type>
+        void saveGenericBlock(const std::vector<Type> & DataBlock, const uint64_t blockPosition)const;
+        template<typename Type>
+        void loadGenericBlock(std::vector<Type> & DataBlock, const uint64_t blockPosition,const size_t nPoints)const;
+    };
+
+}
+}
+#endif
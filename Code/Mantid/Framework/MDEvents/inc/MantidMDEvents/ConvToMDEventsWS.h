@@ -61,13 +61,28 @@ class ConvToMDEventsWS: public ConvToMDBase
     void runConversion(API::Progress *pProgress);
 
 private:
+   /// Buffers of the converted events, which are added to the target workspace together
+   struct EventsBuffer
+   {
+     std::vector<coord_t>  allCoord;   // MD events coordinates
+     std::vector<float>    sig_err;    // signal and error of each event
+     std::vector<uint16_t> run_index;  // run index of each event
+     std::vector<uint32_t> det_ids;    // detector ID of each event
+   };
+
    // function runs the conversion on 
    virtual size_t conversionChunk(size_t workspaceIndex);
+   // converts the spectra of a range of workspace indices; run in parallel by the thread pool
+   void convertSpectra(size_t startIndex, size_t endIndex);
+   // converts the events of a spectrum, whatever their type, into the buffer
+   size_t convertEvents(size_t workspaceIndex, MDTransfInterface &qConverter, EventsBuffer &buffer);
+   // adds the buffered events to the target workspace and clears the buffer
+   void addEvents(EventsBuffer &buffer);
    // the pointer to the source event workspace as event ws does not work through the public Matrix WS interface
     DataObjects::EventWorkspace_const_sptr m_EventWS;
 
-   /**function converts particular type of events into MD space and add these events to the workspace itself    */
-   template <class T>   size_t convertEventList(size_t workspaceIndex);
+   /**function converts particular type of events into MD space and appends these events to the buffer    */
+   template <class T>   size_t convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter, EventsBuffer &buffer);
 };
 
 } // endNamespace MDEvents
@@ -143,6 +143,7 @@ namespace MDEvents
     void calculateCentroid(coord_t * centroid) const;
     void calculateDimensionStats(MDDimensionStats * stats) const;
     void integrateSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, signal_t & signal, signal_t & errorSquared) const;
+    void integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const size_t numRadii, const coord_t * radiiSquared, signal_t * signal, signal_t * errorSquared) const;
     void centroidSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, coord_t * centroid, signal_t & signal) const;
     void integrateCylinder(Mantid::API::CoordTransform & radiusTransform, const coord_t radius, const coord_t length, signal_t & signal, signal_t & errorSquared, std::vector<signal_t> & signal_fit) const;
  
@@ -119,6 +119,9 @@ namespace MDEvents
     /** Sphere (peak) integration */
     virtual void integrateSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, signal_t & signal, signal_t & errorSquared) const = 0;
 
+    /** Sphere (peak) integration for a number of radii around the same center, in one pass */
+    virtual void integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const size_t numRadii, const coord_t * radiiSquared, signal_t * signal, signal_t * errorSquared) const = 0;
+
     /** Find the centroid around a sphere */
     virtual void centroidSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, coord_t * centroid, signal_t & signal) const = 0;
 
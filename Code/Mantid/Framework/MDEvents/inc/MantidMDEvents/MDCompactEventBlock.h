@@ -0,0 +1,108 @@
+#ifndef MANTID_MDEVENTS_MDCOMPACTEVENTBLOCK_H_
+#define MANTID_MDEVENTS_MDCOMPACTEVENTBLOCK_H_
+
+#include "MantidKernel/System.h"
+#include <vector>
+#include <stdint.h>
+
+namespace Mantid
+{
+namespace MDEvents
+{
+
+  //===============================================================================================
+  /** Packed, lossy representation of a block of events, in the tabled form used by the
+   * box controller IO (signal, errorSquared, [runIndex, detectorId], center (each dim.)).
+   *
+   * The coordinates of each dimension are stored as 16-bit fixed-point offsets from the smallest
+   * coordinate of the block, in steps of (max-min)/65535. As all the events of a block belong to
+   * the same MDBox, the unpacked coordinates stay inside the box and are within half a step of
+   * the original ones. The signal is kept as float (as in the events), or once if it is the same
+   * for all the events; the error is not kept at all if it equals the signal for every event,
+   * which is the case for unweighted counts. Blocks with non-finite coordinates are kept unpacked.
+   *
+   * In 4D, a block of lean events of unit weight takes 8 bytes per event instead of 24
+   * (float coordinates) or 48 (double).
+
+      @date 2013-11-12
+
+      Copyright &copy; 2013 ISIS Rutherford Appleton Laboratory & NScD Oak Ridge National Laboratory
+
+      This file is part of Mantid.
+
+      Mantid is free software; you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation; either version 3 of the License, or
+      (at your option) any later version.
+
+      Mantid is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+      File change history is stored at: <https://github.com/mantidproject/mantid>.
+      Code Documentation is available at: <http://doxygen.mantidproject.org>
+  */
+  class DLLExport MDCompactEventBlock
+  {
+  public:
+    template<typename Type>
+    MDCompactEventBlock(const std::vector<Type> & table, const size_t nDims, const bool fatEvents);
+
+    template<typename Type>
+    void unpack(std::vector<Type> & table) const;
+
+    /// @return the number of events in the block
+    size_t getNumEvents() const
+    { return m_nEvents; }
+
+    /// @return true if the events have run index and detector ID columns
+    bool hasFatEvents() const
+    { return m_fatEvents; }
+
+    /// @return true if the error of the events is kept (i.e. it is not equal to the signal)
+    bool hasErrors() const
+    { return !m_errorSquared.empty(); }
+
+    /// @return true if the coordinates were packed (false if the block is kept as it came)
+    bool isPacked() const
+    { return m_rawTable.empty(); }
+
+    double getMaxCoordError(const size_t dim) const;
+    size_t getMemorySize() const;
+
+  private:
+    /// Number of events in the block
+    size_t m_nEvents;
+    /// Number of dimensions of the events
+    size_t m_nDims;
+    /// Whether the events have runIndex and detectorId
+    bool m_fatEvents;
+
+    /// Smallest coordinate of each dimension
+    std::vector<double> m_origin;
+    /// Size of the fixed-point step of each dimension (0 if all events have the same coordinate)
+    std::vector<double> m_step;
+    /// Fixed-point coordinates, m_nDims per event
+    std::vector<uint16_t> m_coords;
+
+    /// Signal of each event; a single value if they are all equal
+    std::vector<float> m_signal;
+    /// Error squared of each event; empty if it equals the signal
+    std::vector<float> m_errorSquared;
+    /// Run index of each event (fat events only)
+    std::vector<uint16_t> m_runIndex;
+    /// Detector ID of each event (fat events only)
+    std::vector<int32_t> m_detectorId;
+
+    /// Copy of the table, for blocks that can not be packed
+    std::vector<double> m_rawTable;
+  };
+
+} // namespace MDEvents
+} // namespace Mantid
+
+#endif /* MANTID_MDEVENTS_MDCOMPACTEVENTBLOCK_H_ */
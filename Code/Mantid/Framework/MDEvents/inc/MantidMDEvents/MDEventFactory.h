@@ -56,6 +56,8 @@ namespace Mantid
                 const std::vector<Mantid::Geometry::MDDimensionExtents<coord_t> > & extentsVector = std::vector<Mantid::Geometry::MDDimensionExtents<coord_t> >(),
                 const uint32_t depth=0,const size_t nBoxEvents=UNDEF_SIZET,const size_t boxID=UNDEF_SIZET);
 
+            // keep the events of a workspace packed in memory when they are not in use
+            static void setCompactStorage(API::IMDEventWorkspace_sptr ws, const uint64_t eventsInMemory);
             /** Returns max number of MD dimensions allowed by current Mantid version*/
             static size_t getMaxNumDim(){return size_t(MAX_MD_DIMENSIONS_NUM);}
         private:   
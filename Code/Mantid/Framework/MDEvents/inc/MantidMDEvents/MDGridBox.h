@@ -120,6 +120,8 @@ namespace MDEvents
 
     void integrateSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, signal_t & signal, signal_t & errorSquared) const;
 
+    void integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const size_t numRadii, const coord_t * radiiSquared, signal_t * signal, signal_t * errorSquared) const;
+
     void centroidSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, coord_t * centroid, signal_t & signal) const;
 
     void integrateCylinder(Mantid::API::CoordTransform & radiusTransform, const coord_t radius, const coord_t length, signal_t & signal, signal_t & errorSquared, std::vector<signal_t> & signal_fit) const;
@@ -177,16 +179,25 @@ namespace MDEvents
     /// Cached number of points contained (including all sub-boxes)
     size_t nPoints;
 
+    /** One block of memory holding the MDBox children created by this grid box, in the order of m_Children,
+     * so that walking through the children walks through the memory. NULL if the children were allocated one by one. */
+    MDBox<MDE,nd> * m_childArena;
+    /// Number of MDBox'es the m_childArena has room for
+    size_t m_arenaSize;
+
     //=================== PRIVATE METHODS =======================================
 
     size_t getLinearIndex(size_t * indices) const;
 
     size_t computeSizesFromSplit();
-    void fillBoxShell(const size_t tot,const coord_t inverseVolume);
+    void fillBoxShell(const size_t tot,const coord_t inverseVolume, const std::vector<size_t> * childSizes = NULL);
+    void allocateChildArena(const size_t tot);
+    void deleteChild(API::IMDNode * child);
+    size_t getChildIndex(const MDE & event) const;
     /**private default copy constructor as the only correct constructor is the one with box controller */
     MDGridBox(const MDGridBox<MDE, nd> & box);
     /**Private constructor as it does not work without box controller */
-    MDGridBox() {}
+    MDGridBox() : m_childArena(NULL), m_arenaSize(0) {}
     /// common part of MDGridBox contstructor;
     void initGridBox();
   };
@@ -57,6 +57,9 @@ namespace MDEvents
     void integrateSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/, signal_t & /*signal*/, signal_t & /*errorSquared*/) const
     { throw std::runtime_error("Not implemented."); }
 
+    void integrateSpheres(Mantid::API::CoordTransform & , const size_t , const coord_t * , signal_t * , signal_t * ) const
+    { throw std::runtime_error("Not implemented."); }
+
     void centroidSphere(Mantid::API::CoordTransform & , const coord_t , coord_t * , signal_t & ) const
     { throw std::runtime_error("Not implemented."); }
 
@@ -0,0 +1,222 @@
+#include "MantidMDEvents/BoxControllerCompactIO.h"
+#include "MantidKernel/Exception.h"
+#include "MantidMDEvents/MDEvent.h"
+
+#include <limits>
+#include <string>
+
+namespace Mantid
+{
+namespace MDEvents
+{
+
+   /**Constructor
+    @param bc pointer to the box controller which uses this IO operations
+   */
+   BoxControllerCompactIO::BoxControllerCompactIO(API::BoxController *const bc) :
+       m_isOpened(false),
+       m_nDims(bc->getNDims()),
+       m_nColumns(4+int64_t(bc->getNDims())),
+       m_CoordSize(sizeof(coord_t)),
+       m_TypeName(MDEvent<1>::getTypeName()),
+       m_fatEvents(true),
+       m_memoryUsed(0)
+   {
+   }
+
+ /** Set up the event type and the size of the event coordinate, which define the meaning of the blocks
+   * given to save/load operations.
+   * @param blockSize -- size (in bytes) of the coordinates. 4 and 8 are supported only e.g. float and double
+   * @param typeName  -- the name of the event used in the operations: MDLeanEvent or MDEvent  */
+  void BoxControllerCompactIO::setDataType(const size_t blockSize, const std::string &typeName)
+  {
+      if(blockSize!=4 && blockSize!=8)
+          throw std::invalid_argument("The class currently supports 4(float) and 8(double) event coordinates only");
+
+      if(typeName == MDLeanEvent<1>::getTypeName())
+          m_fatEvents = false;
+      else if(typeName == MDEvent<1>::getTypeName())
+          m_fatEvents = true;
+      else
+          throw std::invalid_argument("Unsupported event type: "+typeName+" provided ");
+
+      Kernel::Mutex::ScopedLock _lock(m_blocksMutex);
+      if(!m_blocks.empty())
+          throw std::runtime_error("Can not change the type of the events held by BoxControllerCompactIO");
+      m_CoordSize = static_cast<unsigned int>(blockSize);
+      m_TypeName  = typeName;
+      m_nColumns  = int64_t(m_nDims) + (m_fatEvents ? 4 : 2);
+  }
+
+  /** Get the event type and the size of the event coordinate
+   *@return CoordSize -- size (in bytes) of the coordinates
+   *@return typeName  -- the name of the event used in the operations
+  */
+  void BoxControllerCompactIO::getDataType(size_t &CoordSize, std::string &typeName)const
+  {
+      CoordSize= m_CoordSize;
+      typeName = m_TypeName;
+  }
+
+  /** Make the IO ready to accept events. There is no file behind it.
+   *
+   *@param fileName -- the name to report as the file name.
+   *@param mode  -- ignored: the events held are always readable and writable
+   *@return false if the IO had been already opened.
+  */
+  bool BoxControllerCompactIO::openFile(const std::string &fileName,const std::string &mode)
+  {
+      UNUSED_ARG(mode);
+      if(m_isOpened)return false;
+
+      m_fileName = fileName;
+      m_isOpened = true;
+      this->setFileLength(0);
+      return true;
+  }
+
+  /** Delete the packed blocks which overlap with a range of positions. Must be called with the blocks locked.
+   *@param pos  -- start of the range
+   *@param size -- number of events in the range  */
+  void BoxControllerCompactIO::eraseBlocks(const uint64_t pos, const uint64_t size)const
+  {
+      // same convention as DiskBuffer::freeBlock: no size or undefined size
+      if(size == 0 || size == std::numeric_limits<uint64_t>::max())return;
+
+      BlockMap::iterator it = m_blocks.lower_bound(pos);
+      // The block before can extend into the range
+      if(it != m_blocks.begin())
+      {
+          BlockMap::iterator previous = it;
+          --previous;
+          if(previous->first + previous->second->getNumEvents() > pos)
+              it = previous;
+      }
+      const uint64_t end = (size > std::numeric_limits<uint64_t>::max()-pos) ? std::numeric_limits<uint64_t>::max() : pos+size;
+      while(it != m_blocks.end() && it->first < end)
+      {
+          m_memoryUsed -= it->second->getMemorySize();
+          delete it->second;
+          m_blocks.erase(it++);
+      }
+  }
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+ /** Pack a data block and keep it at the specified position, in place of whatever was there
+   *@param DataBlock     -- the vector with data to save
+   *@param blockPosition -- The position to save data to   */
+ template<typename Type>
+ void BoxControllerCompactIO::saveGenericBlock(const std::vector<Type> & DataBlock, const uint64_t blockPosition)const
+ {
+     MDCompactEventBlock * block = new MDCompactEventBlock(DataBlock, m_nDims, m_fatEvents);
+     const uint64_t nEvents = block->getNumEvents();
+
+     Kernel::Mutex::ScopedLock _lock(m_blocksMutex);
+     eraseBlocks(blockPosition, nEvents);
+     m_blocks[blockPosition] = block;
+     m_memoryUsed += block->getMemorySize();
+
+     if(blockPosition+nEvents>this->getFileLength())
+         this->setFileLength(blockPosition+nEvents);
+ }
+
+/** Save float data block on specific position
+   *@param DataBlock     -- the vector with data to write
+   *@param blockPosition -- The starting place to save data to   */
+  void BoxControllerCompactIO::saveBlock(const std::vector<float> & DataBlock, const uint64_t blockPosition)const
+ {
+     this->saveGenericBlock(DataBlock,blockPosition);
+ }
+/** Save double precision data block on specific position
+   *@param DataBlock     -- the vector with data to write
+   *@param blockPosition -- The starting place to save data to   */
+ void BoxControllerCompactIO::saveBlock(const std::vector<double> & DataBlock, const uint64_t blockPosition)const
+ {
+     this->saveGenericBlock(DataBlock,blockPosition);
+ }
+
+ /** Unpack (a part of) a data block saved before
+   *@param Block         -- the storage vector to place data into
+   *@param blockPosition -- The starting place to read data from, within one saved block
+   *@param nPoints       -- number of data points (events) to read
+
+   *@returns Block -- resized block of data containing serialized events representation.
+ */
+ template<typename Type>
+ void BoxControllerCompactIO::loadGenericBlock(std::vector<Type> & Block, const uint64_t blockPosition,const size_t nPoints)const
+ {
+     Kernel::Mutex::ScopedLock _lock(m_blocksMutex);
+     // the block which starts at or before the position
+     BlockMap::const_iterator it = m_blocks.upper_bound(blockPosition);
+     if(it == m_blocks.begin())
+         throw Kernel::Exception::FileError("Attempt to read events which were not saved",m_fileName);
+     --it;
+     const uint64_t offset = blockPosition - it->first;
+     if(offset + nPoints > it->second->getNumEvents())
+         throw Kernel::Exception::FileError("Attempt to read events which were not saved in one block",m_fileName);
+
+     it->second->unpack(Block);
+     const size_t nColumns = size_t(m_nColumns);
+     if(offset > 0)
+         Block.erase(Block.begin(), Block.begin() + size_t(offset)*nColumns);
+     Block.resize(nPoints*nColumns);
+ }
+
+ /** Load float data block
+   *@param Block         -- the storage vector to place data into
+   *@param blockPosition -- The starting place to read data from
+   *@param nPoints       -- number of data points (events) to read
+ */
+ void BoxControllerCompactIO::loadBlock(std::vector<float> & Block, const uint64_t blockPosition,const size_t nPoints)const
+ {
+     this->loadGenericBlock(Block,blockPosition,nPoints);
+ }
+ /** Load double data block
+   *@param Block         -- the storage vector to place data into
+   *@param blockPosition -- The starting place to read data from
+   *@param nPoints       -- number of data points (events) to read
+ */
+ void BoxControllerCompactIO::loadBlock(std::vector<double> & Block, const uint64_t blockPosition,const size_t nPoints)const
+ {
+     this->loadGenericBlock(Block,blockPosition,nPoints);
+ }
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+ /** Mark a range of positions as free, dropping the events packed there
+   * @param pos :: start of the free block
+   * @param size :: size of the free block  */
+ void BoxControllerCompactIO::freeBlock(uint64_t const pos, uint64_t const size)
+ {
+     {
+         Kernel::Mutex::ScopedLock _lock(m_blocksMutex);
+         eraseBlocks(pos, size);
+     }
+     DiskBuffer::freeBlock(pos, size);
+ }
+
+ /// @return the memory taken by the packed events, in bytes
+ size_t BoxControllerCompactIO::getMemorySize()const
+ {
+     Kernel::Mutex::ScopedLock _lock(m_blocksMutex);
+     return m_memoryUsed;
+ }
+
+ /** Drop all the events held and close the IO*/
+ void BoxControllerCompactIO::closeFile()
+ {
+     Kernel::Mutex::ScopedLock _lock(m_blocksMutex);
+     for(BlockMap::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+         delete it->second;
+     m_blocks.clear();
+     m_memoryUsed = 0;
+     m_isOpened = false;
+ }
+
+ BoxControllerCompactIO::~BoxControllerCompactIO()
+ {
+     this->closeFile();
+ }
+
+
+}
+}
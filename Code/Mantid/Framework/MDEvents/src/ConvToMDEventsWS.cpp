@@ -1,5 +1,9 @@
 #include "MantidMDEvents/ConvToMDEventsWS.h"
 #include "MantidMDEvents/UnitsConversionHelper.h"
+#include "MantidKernel/FunctionTask.h"
+
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
 
 
 
@@ -7,9 +11,15 @@ namespace Mantid
 {
   namespace MDEvents
   {
-    /**function converts particular list of events of type T into MD workspace and adds these events to the workspace itself  */
+    /**function converts particular list of events of type T into MD space and appends these events to the buffer 
+    @param workspaceIndex -- the index of the spectrum to convert
+    @param qConverter     -- the transformation to use; it keeps the coordinates which depend on the spectrum, so
+                             each thread has to use its own copy
+    @param buffer         -- the buffer to append the converted events to
+    @return the number of events converted
+    */
     template <class T>
-    size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex)
+    size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter, EventsBuffer &buffer)
     {
 
       const Mantid::DataObjects::EventList & el = m_EventWS->getEventList(workspaceIndex);
@@ -26,18 +36,13 @@ namespace Mantid
 
       std::vector<coord_t>locCoord(m_Coord);
       // set up unit conversion and calculate up all coordinates, which depend on spectra index only
-      if(!m_QConverter->calcYDepCoordinates(locCoord,workspaceIndex))return 0;   // skip if any y outsize of the range of interest;
+      if(!qConverter.calcYDepCoordinates(locCoord,workspaceIndex))return 0;   // skip if any y outsize of the range of interest;
       localUnitConv.updateConversion(workspaceIndex);
       //
-      // allocate temporary buffers for MD Events data
-      // MD events coordinates buffer
-      std::vector<coord_t>  allCoord;
-      std::vector<float>    sig_err;       // array for signal and error. 
-      std::vector<uint16_t> run_index;     // Buffer for run index for each event 
-      std::vector<uint32_t> det_ids;       // Buffer of det Id-s for each event
-
-      allCoord.reserve(this->m_NDims*numEvents);     sig_err.reserve(2*numEvents);
-      run_index.reserve(numEvents);                 det_ids.reserve(numEvents);
+      // make room in the buffers for the MD Events data
+      size_t nBufferedEvents = buffer.run_index.size();
+      buffer.allCoord.reserve(this->m_NDims*(nBufferedEvents+numEvents));   buffer.sig_err.reserve(2*(nBufferedEvents+numEvents));
+      buffer.run_index.reserve(nBufferedEvents+numEvents);                 buffer.det_ids.reserve(nBufferedEvents+numEvents);
 
       // This little dance makes the getting vector of events more general (since you can't overload by return type).
       typename std::vector<T>const * events_ptr;
@@ -57,39 +62,75 @@ namespace Mantid
         double val=localUnitConv.convertUnits(it->tof());
         double signal = it->weight();
         double errorSq= it->errorSquared();
-        if(!m_QConverter->calcMatrixCoord(val,locCoord,signal,errorSq))continue; // skip ND outside the range
+        if(!qConverter.calcMatrixCoord(val,locCoord,signal,errorSq))continue; // skip ND outside the range
 
 
-        sig_err.push_back(float(signal));
-        sig_err.push_back(float(errorSq));
-        run_index.push_back(runIndexLoc);
-        det_ids.push_back(detID);
-        allCoord.insert(allCoord.end(),locCoord.begin(),locCoord.end());
+        buffer.sig_err.push_back(float(signal));
+        buffer.sig_err.push_back(float(errorSq));
+        buffer.run_index.push_back(runIndexLoc);
+        buffer.det_ids.push_back(detID);
+        buffer.allCoord.insert(buffer.allCoord.end(),locCoord.begin(),locCoord.end());
       }
 
-      // Add them to the MDEW
-      size_t n_added_events = run_index.size();
-      m_OutWSWrapper->addMDData(sig_err,run_index,det_ids,allCoord,n_added_events);
-      return n_added_events;
+      return buffer.run_index.size()-nBufferedEvents;
     }
 
-    /** The method runs conversion for a single event list, corresponding to a particular workspace index */
-    size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex)
+    /** The method converts the events of a spectrum into the buffer, dispatching on the type of the events */
+    size_t ConvToMDEventsWS::convertEvents(size_t workspaceIndex, MDTransfInterface &qConverter, EventsBuffer &buffer)
     {       
 
       switch (m_EventWS->getEventList(workspaceIndex).getEventType())
       {
       case Mantid::API::TOF:
-        return this->convertEventList<Mantid::DataObjects::TofEvent>(workspaceIndex);
+        return this->convertEventList<Mantid::DataObjects::TofEvent>(workspaceIndex,qConverter,buffer);
       case Mantid::API::WEIGHTED:
-        return  this->convertEventList<Mantid::DataObjects::WeightedEvent>(workspaceIndex);
+        return  this->convertEventList<Mantid::DataObjects::WeightedEvent>(workspaceIndex,qConverter,buffer);
       case Mantid::API::WEIGHTED_NOTIME:
-        return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(workspaceIndex);
+        return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(workspaceIndex,qConverter,buffer);
       default:
         throw std::runtime_error("EventList had an unexpected data type!");
       }
     }
 
+    /** The method adds the buffered events to the MD workspace. Adding events to the boxes is thread-safe, 
+        as long as the boxes are not split at the same time */
+    void ConvToMDEventsWS::addEvents(EventsBuffer &buffer)
+    {
+      size_t nEvents = buffer.run_index.size();
+      if(nEvents == 0) return;
+      m_OutWSWrapper->addMDData(buffer.sig_err,buffer.run_index,buffer.det_ids,buffer.allCoord,nEvents);
+
+      buffer.allCoord.clear();
+      buffer.sig_err.clear();
+      buffer.run_index.clear();
+      buffer.det_ids.clear();
+    }
+
+    /** The method runs conversion for a single event list, corresponding to a particular workspace index */
+    size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex)
+    {       
+      EventsBuffer buffer;
+      size_t nConverted = this->convertEvents(workspaceIndex,*m_QConverter,buffer);
+      this->addEvents(buffer);
+      return nConverted;
+    }
+
+    /** The method converts the spectra with workspace indices from startIndex to endIndex (not included) and adds 
+        their events to the MD workspace in one go. It works with its own copy of the Q-converter, so a number of ranges 
+        can be converted in parallel.
+    */
+    void ConvToMDEventsWS::convertSpectra(size_t startIndex, size_t endIndex)
+    {
+      // the copy keeps the generic variables, calculated by the main converter
+      boost::scoped_ptr<MDTransfInterface> qConverter(m_QConverter->clone());
+      EventsBuffer buffer;
+      for(size_t wi=startIndex; wi<endIndex; wi++)
+      {
+        this->convertEvents(wi,*qConverter,buffer);
+      }
+      this->addEvents(buffer);
+    }
+
 
     /** method sets up all internal variables necessary to convert from Event Workspace to MDEvent workspace 
     @param WSD         -- the class describing the target MD workspace, sorurce Event workspace and the transformations, necessary to perform on these workspaces
@@ -117,8 +158,6 @@ namespace Mantid
       Mantid::API::BoxController_sptr bc = m_OutWSWrapper->pWorkspace()->getBoxController();
       size_t lastNumBoxes = bc->getTotalNumMDBoxes();
       size_t nEventsInWS  = m_OutWSWrapper->pWorkspace()->getNPoints();
-      // Is the access to input events thread-safe?
-      // bool MultiThreadedAdding = m_EventWS->threadSafe();
       // preprocessed detectors insure that each detector has its own spectra
       size_t nValidSpectra  = m_NSpectra;
 
@@ -128,7 +167,8 @@ namespace Mantid
       int nThreads(m_NumThreads);
       if(nThreads<0)nThreads= 0; // negative m_NumThreads correspond to all cores used, 0 no threads and positive number -- nThreads requested;
       bool runMultithreaded = false;
-      if(m_NumThreads!=0)
+      // Adding events to the boxes is thread-safe, so the spectra can be converted in parallel if the events can be read so too 
+      if(m_NumThreads!=0 && m_EventWS->threadSafe())
       {
         runMultithreaded  = true;
         // Create the thread pool that will run all of these. It will be deleted by the threadpool
@@ -143,23 +183,37 @@ namespace Mantid
       // if any property dimension is outside of the data range requested, the job is done;
       if(!m_QConverter->calcGenericVariables(m_Coord,m_NDims))return; 
 
+      // the spectra are given to the threads in ranges holding at least this number of events
+      const size_t eventsPerTask = bc->getAddingEvents_eventsPerTask();
       size_t eventsAdded  = 0;
-      for (size_t wi=0; wi <nValidSpectra; wi++)
+      size_t wi = 0;
+      while (wi <nValidSpectra)
       {     
-
-        size_t nConverted   =  this->conversionChunk(wi);
+        size_t nConverted(0);
+        if(runMultithreaded)
+        {
+          // The range of spectra for a task. The events outside of the target workspace are counted as well, 
+          // so the boxes may be split a bit more often than they have to.
+          size_t startIndex = wi;
+          for(; wi<nValidSpectra && nConverted<eventsPerTask; wi++)
+            nConverted += m_EventWS->getEventList(wi).getNumberEvents();
+
+          // Give this task to the scheduler
+          double cost = double(nConverted);
+          ts->push( new Kernel::FunctionTask(boost::bind(&ConvToMDEventsWS::convertSpectra,this,startIndex,wi), cost) );
+        }else{
+          nConverted = this->conversionChunk(wi);
+          wi++;
+        }
         eventsAdded         += nConverted;
         nEventsInWS         += nConverted;
-        // Give this task to the scheduler
-        //%double cost = double(el.getNumberEvents());
-        //ts->push( new FunctionTask( func, cost) );
 
         // Keep a running total of how many events we've added
         if (bc->shouldSplitBoxes(nEventsInWS,eventsAdded, lastNumBoxes))
         {
           if(runMultithreaded)
           {
-            // Do all the adding tasks
+            // Do all the adding tasks; the boxes can not be split while the events are added to them
             tp.joinAll();    
             // Now do all the splitting tasks
             m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
@@ -259,12 +259,13 @@ namespace MDEvents
           return data;
       else
       {
+          // The data vector is busy - can't release the memory yet.
+          // This waits if the box is being written out right now.
+          this->m_BoxController->getFileIO()->markBusy(m_Saveable);
           if (m_Saveable->wasSaved())
           {  // Load and concatenate the events if needed
               m_Saveable->load();  // this will set isLoaded to true if not already loaded;         
           }
-          // The data vector is busy - can't release the memory yet
-          m_Saveable->setBusy(true);
           // the non-const access to events assumes that the data will be modified;
           m_Saveable->setDataChanged();
 
@@ -291,14 +292,15 @@ namespace MDEvents
           return data;     
       else
       {
+          // The data vector is busy - can't release the memory yet.
+          // This waits if the box is being written out right now.
+          this->m_BoxController->getFileIO()->markBusy(m_Saveable);
           if (m_Saveable->wasSaved())
           {
               // Load and concatenate the events if needed
               m_Saveable->load();  // this will set isLoaded to true if not already loaded;
               // This access to data was const. Don't change the m_dataModified flag.
           }
-          // The data vector is busy - can't release the memory yet
-          m_Saveable->setBusy(true);
 
           // Tell the to-write buffer to discard the object (when no longer busy) as it has not been modified
           this->m_BoxController->getFileIO()->toWrite(m_Saveable);
@@ -603,6 +605,50 @@ namespace MDEvents
     }
   }
 
+  /** Integrate the signal within a number of spheres around the same center, looking at each event once.
+   *
+   * @param radiusTransform :: nd-to-1 coordinate transformation that converts from these
+   *        dimensions to the distance (squared) from the center of the spheres.
+   * @param numRadii :: the number of spheres
+   * @param radiiSquared :: array of size [numRadii] of radius^2 below which to integrate, in increasing order
+   * @param[out] signal :: array of size [numRadii]; the integrated signal in each sphere is added to it
+   * @param[out] errorSquared :: array of size [numRadii]; the integrated squared error in each sphere is added to it
+   */
+  TMDE(
+  void MDBox)::integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const size_t numRadii, const coord_t * radiiSquared, signal_t * signal, signal_t * errorSquared) const
+  {
+    if (numRadii == 0) return;
+    // If the box is cached to disk, you need to retrieve it
+    const std::vector<MDE> & events = this->getConstEvents();
+    typename std::vector<MDE>::const_iterator it = events.begin();
+    typename std::vector<MDE>::const_iterator it_end = events.end();
+
+    // For each MDLeanEvent
+    for (; it != it_end; ++it)
+    {
+      coord_t out[nd];
+      radiusTransform.apply(it->getCenter(), out);
+      // The event is in all the spheres from the smallest one containing it
+      for (size_t i = 0; i < numRadii; ++i)
+      {
+        if (out[0] < radiiSquared[i])
+        {
+          const signal_t eventSignal = static_cast<signal_t>(it->getSignal());
+          const signal_t eventErrorSquared = static_cast<signal_t>(it->getErrorSquared());
+          for (; i < numRadii; ++i)
+          {
+            signal[i] += eventSignal;
+            errorSquared[i] += eventErrorSquared;
+          }
+        }
+      }
+    }
+    if(m_Saveable)
+    {
+        m_Saveable->setBusy(false);  
+    }
+  }
+
   /** Integrate the signal within a sphere; for example, to perform single-crystal
    * peak integration.
    * The CoordTransform object could be used for more complex shapes, e.g. "lentil" integration, as long
@@ -0,0 +1,166 @@
+#include "MantidMDEvents/MDCompactEventBlock.h"
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid
+{
+namespace MDEvents
+{
+  namespace
+  {
+    /// Largest fixed-point coordinate
+    const double MAX_CODE = double(std::numeric_limits<uint16_t>::max());
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Constructor: packs a block of tabled events
+   *
+   * @param table :: the events, one row per event: signal, errorSquared, [runIndex, detectorId], center (each dim.)
+   * @param nDims :: number of dimensions of the events
+   * @param fatEvents :: true if the rows have the runIndex and detectorId columns
+   */
+  template<typename Type>
+  MDCompactEventBlock::MDCompactEventBlock(const std::vector<Type> & table, const size_t nDims, const bool fatEvents)
+    : m_nEvents(0), m_nDims(nDims), m_fatEvents(fatEvents),
+      m_origin(nDims, 0.0), m_step(nDims, 0.0)
+  {
+    const size_t nColumns = nDims + (fatEvents ? 4 : 2);
+    const size_t firstCoord = nColumns - nDims;
+    m_nEvents = table.size() / nColumns;
+    if (m_nEvents * nColumns != table.size())
+      throw std::invalid_argument("MDCompactEventBlock: the size of the table does not match the number of columns of the events.");
+    if (m_nEvents == 0)
+      return;
+
+    // Range of the coordinates
+    std::vector<double> maxCoord(nDims, 0.0);
+    for (size_t d = 0; d < nDims; d++)
+      m_origin[d] = maxCoord[d] = double(table[firstCoord + d]);
+    bool allFinite = true;
+    bool signalIsError = true;
+    bool constantSignal = true;
+    for (size_t i = 0; i < m_nEvents; i++)
+    {
+      const Type * row = &table[i * nColumns];
+      for (size_t d = 0; d < nDims; d++)
+      {
+        const double x = double(row[firstCoord + d]);
+        if (!boost::math::isfinite(x))
+          allFinite = false;
+        else if (x < m_origin[d])
+          m_origin[d] = x;
+        else if (x > maxCoord[d])
+          maxCoord[d] = x;
+      }
+      signalIsError = signalIsError && (row[0] == row[1]);
+      constantSignal = constantSignal && (row[0] == table[0]);
+    }
+
+    if (!allFinite)
+    {
+      // Keep it as it is: the fixed-point steps would be meaningless
+      m_rawTable.assign(table.begin(), table.end());
+      return;
+    }
+
+    for (size_t d = 0; d < nDims; d++)
+      m_step[d] = (maxCoord[d] - m_origin[d]) / MAX_CODE;
+
+    m_coords.resize(m_nEvents * nDims);
+    m_signal.resize(constantSignal ? 1 : m_nEvents);
+    if (!signalIsError)
+      m_errorSquared.resize(m_nEvents);
+    if (fatEvents)
+    {
+      m_runIndex.resize(m_nEvents);
+      m_detectorId.resize(m_nEvents);
+    }
+
+    for (size_t i = 0; i < m_nEvents; i++)
+    {
+      const Type * row = &table[i * nColumns];
+      if (!constantSignal)
+        m_signal[i] = static_cast<float>(row[0]);
+      if (!signalIsError)
+        m_errorSquared[i] = static_cast<float>(row[1]);
+      if (fatEvents)
+      {
+        m_runIndex[i] = static_cast<uint16_t>(row[2]);
+        m_detectorId[i] = static_cast<int32_t>(row[3]);
+      }
+      uint16_t * codes = &m_coords[i * nDims];
+      for (size_t d = 0; d < nDims; d++)
+      {
+        if (m_step[d] > 0)
+          codes[d] = static_cast<uint16_t>((double(row[firstCoord + d]) - m_origin[d]) / m_step[d] + 0.5);
+        else
+          codes[d] = 0;
+      }
+    }
+    m_signal[0] = static_cast<float>(table[0]);
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Unpack the events into the tabled form they were packed from
+   *
+   * @param table :: vector to fill, one row per event. Previous contents are discarded.
+   */
+  template<typename Type>
+  void MDCompactEventBlock::unpack(std::vector<Type> & table) const
+  {
+    if (!m_rawTable.empty())
+    {
+      table.assign(m_rawTable.begin(), m_rawTable.end());
+      return;
+    }
+
+    const size_t nColumns = m_nDims + (m_fatEvents ? 4 : 2);
+    const size_t firstCoord = nColumns - m_nDims;
+    const bool constantSignal = (m_signal.size() == 1);
+    table.resize(m_nEvents * nColumns);
+    for (size_t i = 0; i < m_nEvents; i++)
+    {
+      Type * row = &table[i * nColumns];
+      const float signal = constantSignal ? m_signal[0] : m_signal[i];
+      row[0] = static_cast<Type>(signal);
+      row[1] = static_cast<Type>(m_errorSquared.empty() ? signal : m_errorSquared[i]);
+      if (m_fatEvents)
+      {
+        row[2] = static_cast<Type>(m_runIndex[i]);
+        row[3] = static_cast<Type>(m_detectorId[i]);
+      }
+      const uint16_t * codes = &m_coords[i * m_nDims];
+      for (size_t d = 0; d < m_nDims; d++)
+        row[firstCoord + d] = static_cast<Type>(m_origin[d] + double(codes[d]) * m_step[d]);
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** @return the largest difference between a packed and an unpacked coordinate
+   * @param dim :: index of the dimension */
+  double MDCompactEventBlock::getMaxCoordError(const size_t dim) const
+  {
+    if (dim >= m_nDims)
+      throw std::out_of_range("MDCompactEventBlock::getMaxCoordError(): dimension index out of range.");
+    return 0.5 * m_step[dim];
+  }
+
+  /// @return the number of bytes used by the packed events
+  size_t MDCompactEventBlock::getMemorySize() const
+  {
+    return sizeof(*this)
+        + (m_origin.size() + m_step.size() + m_rawTable.size()) * sizeof(double)
+        + (m_coords.size() + m_runIndex.size()) * sizeof(uint16_t)
+        + (m_signal.size() + m_errorSquared.size()) * sizeof(float)
+        + m_detectorId.size() * sizeof(int32_t);
+  }
+
+
+  template MDCompactEventBlock::MDCompactEventBlock(const std::vector<float> &, const size_t, const bool);
+  template MDCompactEventBlock::MDCompactEventBlock(const std::vector<double> &, const size_t, const bool);
+  template void MDCompactEventBlock::unpack(std::vector<float> &) const;
+  template void MDCompactEventBlock::unpack(std::vector<double> &) const;
+
+} // namespace MDEvents
+} // namespace Mantid
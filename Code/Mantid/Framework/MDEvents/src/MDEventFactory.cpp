@@ -11,6 +11,7 @@
 #include "MantidMDEvents/MDBoxIterator.h"
 #include "MantidMDEvents/MDEvent.h"
 #include "MantidMDEvents/MDLeanEvent.h"
+#include "MantidMDEvents/BoxControllerCompactIO.h"
 
 // We need to include the .cpp files so that the declarations are picked up correctly. Weird, I know. 
 // See http://www.parashift.com/c++-faq-lite/templates.html#faq-35.13 
@@ -203,6 +204,33 @@ namespace Mantid
 
             return boost::shared_ptr<API::IMDEventWorkspace >(pWs);
         }
+        /** Make a workspace keep the events it does not use packed in memory, with 16-bit coordinates
+        relative to the boxes (see BoxControllerCompactIO and MDCompactEventBlock).
+        The boxes are handled as if the workspace was file-backed; the events in the write buffer stay unpacked.
+        @param ws :: the workspace. It can not be file-backed already.
+        @param eventsInMemory :: size of the write buffer, in events.
+        */
+        void MDEventFactory::setCompactStorage(API::IMDEventWorkspace_sptr ws, const uint64_t eventsInMemory)
+        {
+            if(ws->isFileBacked())
+                throw std::invalid_argument("setCompactStorage: the workspace is already file-backed");
+
+            API::BoxController_sptr bc = ws->getBoxController();
+            boost::shared_ptr<API::IBoxControllerIO> compactIO(new BoxControllerCompactIO(bc.get()));
+            compactIO->setDataType(sizeof(coord_t), ws->getEventTypeName());
+            compactIO->setWriteBufferSize(eventsInMemory);
+            bc->setFileBacked(compactIO, "compact events");
+
+            // New boxes become file-backed by themselves; make the existing ones so and pack their events in due course.
+            std::vector<API::IMDNode *> boxes;
+            ws->getBoxes(boxes, 10000, true);
+            for(size_t i=0; i<boxes.size(); i++)
+            {
+                boxes[i]->setFileBacked();
+                if(boxes[i]->getDataInMemorySize()>0)
+                    compactIO->toWrite(boxes[i]->getISaveable());
+            }
+        }
         /** Create a MDBox or MDGridBoxof the given type
         @param nDimensions  :: number of dimensions
         @param Type         :: enum descibing the box (MDBox or MDGridBox) and the event type (MDEvent or MDLeanEvent)
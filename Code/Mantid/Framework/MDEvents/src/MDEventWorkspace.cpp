@@ -382,7 +382,18 @@ namespace MDEvents
 //    }
 //    out.push_back(mess.str()); mess.str("");
 
-    if (m_BoxController->isFileBacked())
+    if (m_BoxController->hasCompactStorage())
+    {
+      mess << "Compact storage: ";
+      double avail = double(m_BoxController->getFileIO()->getWriteBufferSize() * sizeof(MDE)) / (1024*1024);
+      double used = double(m_BoxController->getFileIO()->getWriteBufferUsed() * sizeof(MDE)) / (1024*1024);
+      mess << "Write buffer: " << used << " of " << avail << " MB. ";
+      out.push_back(mess.str()); mess.str("");
+
+      mess << "Packed events: " << double(m_BoxController->getFileIO()->getMemorySize()) / (1024*1024) << " MB";
+      out.push_back(mess.str()); mess.str("");
+    }
+    else if (m_BoxController->isFileBacked())
     {
       mess << "File backed: ";
       double avail = double(m_BoxController->getFileIO()->getWriteBufferSize() * sizeof(MDE)) / (1024*1024);
@@ -504,8 +515,9 @@ namespace MDEvents
     if (this->m_BoxController->isFileBacked())
     {
       // File-backed workspace
-      // How much is in the cache?
-      total = this->m_BoxController->getFileIO()->getWriteBufferUsed() * sizeof(MDE);
+      // How much is in the cache? (and in the IO itself, if it keeps the events in memory)
+      total = this->m_BoxController->getFileIO()->getWriteBufferUsed() * sizeof(MDE)
+            + this->m_BoxController->getFileIO()->getMemorySize();
     }
     else
     {
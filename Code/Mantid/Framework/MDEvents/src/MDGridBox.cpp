@@ -9,6 +9,7 @@
 #include "MantidMDEvents/MDBox.h"
 #include "MantidMDEvents/MDEvent.h"
 #include "MantidMDEvents/MDGridBox.h"
+#include <new>
 #include <ostream>
 #include "MantidKernel/Strings.h"
 
@@ -42,7 +43,8 @@ namespace MDEvents
    */
   TMDE(MDGridBox)::MDGridBox(BoxController *const bc, const uint32_t depth, const std::vector<Mantid::Geometry::MDDimensionExtents<coord_t> > & extentsVector)
    : MDBoxBase<MDE, nd>(bc,depth,UNDEF_SIZET,extentsVector),
-     numBoxes(0), nPoints(0)
+     numBoxes(0), nPoints(0),
+     m_childArena(NULL), m_arenaSize(0)
   {
       initGridBox();
   }
@@ -54,7 +56,8 @@ namespace MDEvents
  */
   TMDE(MDGridBox)::MDGridBox(boost::shared_ptr<API::BoxController> &bc, const uint32_t depth, const std::vector<Mantid::Geometry::MDDimensionExtents<coord_t> > & extentsVector)
    : MDBoxBase<MDE, nd>(bc.get(),depth,UNDEF_SIZET,extentsVector),
-     numBoxes(0), nPoints(0)
+     numBoxes(0), nPoints(0),
+     m_childArena(NULL), m_arenaSize(0)
   {
        initGridBox();
   }
@@ -82,7 +85,8 @@ namespace MDEvents
    */
   TMDE(MDGridBox)::MDGridBox(MDBox<MDE, nd> * box)
    : MDBoxBase<MDE, nd>(*box,box->getBoxController()),
-     nPoints(0)
+     nPoints(0),
+     m_childArena(NULL), m_arenaSize(0)
   {
     if (!this->m_BoxController)
       throw std::runtime_error("MDGridBox::ctor(): constructing from box:: No BoxController specified in box.");
@@ -102,16 +106,24 @@ namespace MDEvents
    for(size_t d=0;d<nd;d++)
      ChildVol*=m_SubBoxSize[d];
      
-    // Splitting an input MDBox requires creating a bunch of children
-    fillBoxShell(tot,coord_t(1./ChildVol));
-
-
     // Prepare to distribute the events that were in the box before, this will load missing events from HDD in file based ws if there are some.
     const std::vector<MDE> & events = box->getConstEvents();   
-    typename std::vector<MDE>::const_iterator it = events.begin();
+    typename std::vector<MDE>::const_iterator it_begin = events.begin();
     typename std::vector<MDE>::const_iterator it_end = events.end();
-   // just add event to the existing internal box
-       for (; it != it_end; ++it)  addEvent(*it);
+
+    // Count the events going to each child first, so every child allocates its events only once
+    std::vector<size_t> childSizes(tot,0);
+    for (auto it = it_begin; it != it_end; ++it)
+    {
+      size_t index = getChildIndex(*it);
+      if (index < tot) childSizes[index]++;
+    }
+
+    // Splitting an input MDBox requires creating a bunch of children
+    fillBoxShell(tot,coord_t(1./ChildVol),&childSizes);
+
+    // Nobody else can see the new children yet, so there is no need to lock them while adding the events
+    for (auto it = it_begin; it != it_end; ++it)  addEventUnsafe(*it);
    
     // Copy the cached numbers from the incoming box. This is quick - don't need to refresh cache
     this->nPoints = box->getNPoints();
@@ -121,14 +133,20 @@ namespace MDEvents
  
 
   }
-  /**Internal function to do main job of filling in a GridBox contents  (part of the constructor) */
+  /**Internal function to do main job of filling in a GridBox contents  (part of the constructor)
+   * The children are built next to each other in one block of memory, in the order of their IDs.
+   * @param tot :: number of children
+   * @param ChildInverseVolume :: inverse volume of each child
+   * @param childSizes :: optional number of events to reserve memory for in each child
+   */
   template<typename MDE,size_t nd>
-  void MDGridBox<MDE,nd>::fillBoxShell(const size_t tot,const coord_t ChildInverseVolume)
+  void MDGridBox<MDE,nd>::fillBoxShell(const size_t tot,const coord_t ChildInverseVolume, const std::vector<size_t> * childSizes)
   {
   // Create the array of MDBox contents.
     this->m_Children.clear();
     this->m_Children.reserve(tot);
     this->numBoxes = tot;
+    this->allocateChildArena(tot);
 
     size_t indices[nd];
     for (size_t d=0; d<nd; d++) indices[d] = 0;
@@ -143,7 +161,8 @@ namespace MDEvents
     {
       // Create the box
       // (Increase the depth of this box to one more than the parent (this))
-       MDBox<MDE,nd> * splitBox = new MDBox<MDE,nd>(this->m_BoxController, this->m_depth + 1,UNDEF_SIZET,size_t(ID0+i));
+       const size_t nBoxEvents = childSizes ? (*childSizes)[i] : UNDEF_SIZET;
+       MDBox<MDE,nd> * splitBox = new (m_childArena + i) MDBox<MDE,nd>(this->m_BoxController, this->m_depth + 1,nBoxEvents,size_t(ID0+i));
       // This MDGridBox is the parent of the new child.
        splitBox->setParent(this);
 
@@ -170,6 +189,32 @@ namespace MDEvents
     } // for each box
   }
 
+  /** Allocate the memory for a given number of MDBox children, to be built in place.
+   * @param tot :: number of children */
+  template<typename MDE,size_t nd>
+  void MDGridBox<MDE,nd>::allocateChildArena(const size_t tot)
+  {
+    if (m_childArena)
+      throw std::runtime_error("MDGridBox::allocateChildArena(): the children of this box have been allocated already.");
+    m_childArena = static_cast<MDBox<MDE,nd> *>(::operator new(tot*sizeof(MDBox<MDE,nd>)));
+    m_arenaSize = tot;
+  }
+
+  /** Delete a child box, which may live in the block of memory allocated for the children
+   * @param child :: the child to delete */
+  template<typename MDE,size_t nd>
+  void MDGridBox<MDE,nd>::deleteChild(API::IMDNode * child)
+  {
+    if (!child) return;
+    const char * address = static_cast<const char *>(dynamic_cast<const void *>(child));
+    const char * arenaBegin = reinterpret_cast<const char *>(m_childArena);
+    if (m_childArena && address >= arenaBegin && address < arenaBegin + m_arenaSize*sizeof(MDBox<MDE,nd>))
+      // Built in place: only destroy it, the memory goes with the arena
+      child->~IMDNode();
+    else
+      delete child;
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Copy constructor
    * @param other :: MDGridBox to copy 
@@ -181,7 +226,8 @@ namespace MDEvents
    : MDBoxBase<MDE, nd>(other,otherBC),
      numBoxes(other.numBoxes),
      diagonalSquared(other.diagonalSquared),
-     nPoints(other.nPoints)
+     nPoints(other.nPoints),
+     m_childArena(NULL), m_arenaSize(0)
   {
     for (size_t d=0; d<nd; d++)
     {
@@ -192,6 +238,7 @@ namespace MDEvents
     // Copy all the boxes
     m_Children.clear();
     m_Children.reserve(numBoxes);
+    this->allocateChildArena(other.m_Children.size());
     for (size_t i=0; i<other.m_Children.size(); i++)
     {
         API::IMDNode* otherBox = other.m_Children[i];
@@ -199,7 +246,7 @@ namespace MDEvents
         const MDGridBox<MDE, nd>* otherMDGridBox = dynamic_cast<const MDGridBox<MDE, nd>* >(otherBox);
         if (otherMDBox)
         {
-            MDBox<MDE, nd> * newBox = new MDBox<MDE, nd>(*otherMDBox,otherBC);
+            MDBox<MDE, nd> * newBox = new (m_childArena + i) MDBox<MDE, nd>(*otherMDBox,otherBC);
             newBox->setParent(this);
             m_Children.push_back( newBox );
       }
@@ -264,8 +311,9 @@ namespace MDEvents
     // Delete all contained boxes (this should fire the MDGridBox destructors recursively).
     auto it = m_Children.begin();
     for ( ; it != m_Children.end(); ++it)
-      delete *it;
+      deleteChild(*it);
     m_Children.clear();
+    ::operator delete(m_childArena);
   }
 
 
@@ -711,7 +759,7 @@ namespace MDEvents
     MDGridBox<MDE, nd> * gridbox = new MDGridBox<MDE, nd>(box);
 
     // Delete the old ungridded box
-    delete m_Children[index];
+    deleteChild(m_Children[index]);
     // And now we have a gridded box instead of a boring old regular box.
     m_Children[index] = gridbox;
 
@@ -773,7 +821,7 @@ namespace MDEvents
             // Replace in the array
             m_Children[i] = gridBox;
             // Delete the old box
-            delete box;
+            deleteChild(box);
             // Now recursively check if this NEW grid box's contents should be split too
             gridBox->splitAllIfNeeded(NULL);
           }
@@ -1272,6 +1320,146 @@ namespace MDEvents
   }
 
 
+  //-----------------------------------------------------------------------------------------------
+  /** Integrate the signal within a number of spheres around the same center; for example,
+   * the peak and background radii of single-crystal peak integration.
+   * This does what integrateSphere() does for each radius, but the vertices of the boxes and the
+   * boxes themselves are visited once for all the spheres.
+   *
+   * @param radiusTransform :: nd-to-1 coordinate transformation that converts from these
+   *        dimensions to the distance (squared) from the center of the spheres.
+   * @param numRadii :: the number of spheres
+   * @param radiiSquared :: array of size [numRadii] of radius^2 below which to integrate, in increasing order
+   * @param signal [out] :: array of size [numRadii]; the integrated signal in each sphere is added to it
+   * @param errorSquared [out] :: array of size [numRadii]; the integrated squared error in each sphere is added to it
+   */
+  TMDE(
+  void MDGridBox)::integrateSpheres(CoordTransform & radiusTransform, const size_t numRadii, const coord_t * radiiSquared, signal_t * signal, signal_t * errorSquared) const
+  {
+    if (numRadii == 0) return;
+
+    // For each box and sphere, the # of vertices of the box which are in that sphere but not in the smaller ones.
+    // The vertices contained in a sphere are then the sum of the ones of that sphere and of all the smaller ones.
+    std::vector<size_t> verticesContained(numBoxes * numRadii, 0);
+
+    // How many vertices does one box have? 2^nd, or bitwise shift left 1 by nd bits
+    size_t maxVertices = 1 << nd;
+
+    // set up caches for box sizes and min box values
+    coord_t boxSize[nd];
+    coord_t minBoxVal[nd];
+
+    // The number of vertices in each dimension is the # split[d] + 1
+    size_t vertices_max[nd]; Utils::NestedForLoop::SetUp(nd, vertices_max, 0);
+    for (size_t d=0; d<nd; ++d)
+    {
+      vertices_max[d] = split[d]+1;
+      boxSize[d]     = static_cast<coord_t>(m_SubBoxSize[d]);
+      minBoxVal[d]   = static_cast<coord_t>(this->extents[d].getMin());
+    }
+
+    // The index to the vertex in each dimension
+    size_t vertexIndex[nd]; Utils::NestedForLoop::SetUp(nd, vertexIndex, 0);
+    size_t boxIndex[nd]; Utils::NestedForLoop::SetUp(nd, boxIndex, 0);
+    size_t indexMaker[nd]; Utils::NestedForLoop::SetUpIndexMaker(nd, indexMaker, split);
+
+    bool allDone = false;
+    while (!allDone)
+    {
+      // Coordinates of this vertex
+      coord_t vertexCoord[nd];
+      for (size_t d=0; d<nd; ++d)      
+        vertexCoord[d] = static_cast<coord_t>(vertexIndex[d])*boxSize[d] +minBoxVal[d];
+
+      // The smallest sphere containing this vertex, if any
+      coord_t out[nd];
+      radiusTransform.apply(vertexCoord, out);
+      size_t sphere = 0;
+      while (sphere < numRadii && out[0] >= radiiSquared[sphere])
+        ++sphere;
+      if (sphere < numRadii)
+      {
+        // This vertex is shared by up to 2^nd adjacent boxes (left-right along each dimension).
+        for (size_t neighb=0; neighb<maxVertices; ++neighb)
+        {
+          bool badIndex = false;
+          for (size_t d=0; d<nd;d++)
+          {
+            boxIndex[d] = vertexIndex[d] - ((neighb & ((size_t)1 << d)) >> d);
+            if (boxIndex[d] >= split[d])
+            {
+              badIndex = true;
+              break;
+            }
+          }
+          if (!badIndex)
+          {
+            size_t linearIndex = Utils::NestedForLoop::GetLinearIndex(nd, boxIndex, indexMaker);
+            verticesContained[linearIndex*numRadii + sphere]++;
+          }
+        }
+      }
+
+      // Increment the counter(s) in the nested for loops.
+      allDone = Utils::NestedForLoop::Increment(nd, vertexIndex, vertices_max);
+    }
+
+    // Now go through each box. As the spheres are nested, a box is outside of the smallest ones, 
+    // then partially contained by some and then fully contained by the biggest ones.
+    for (size_t i=0; i < numBoxes; ++i)
+    {
+      MDBoxBase<MDE,nd> * box = m_Children[i];
+      // The range of the spheres which partially contain the box
+      size_t firstPartial = numRadii;
+      size_t endPartial = 0;
+      // Distance (squared) from the center of the box to the integration center, if needed
+      bool haveCenterDistance = false;
+      coord_t centerDistance = 0;
+
+      size_t contained = 0;
+      for (size_t j=0; j < numRadii; ++j)
+      {
+        contained += verticesContained[i*numRadii + j];
+        if (contained >= maxVertices)
+        {
+          // Use the integrated sum of signal in the box for this sphere and all the bigger ones
+          for (; j < numRadii; ++j)
+          {
+            signal[j] += box->getSignal();
+            errorSquared[j] += box->getErrorSquared();
+          }
+          break;
+        }
+
+        bool partialBox = (contained > 0);
+        if (!partialBox)
+        {
+          // The box might touch the sphere even if no vertex of it is in (see integrateSphere())
+          if (!haveCenterDistance)
+          {
+            coord_t boxCenter[nd];
+            box->getCenter(boxCenter);
+            coord_t out[nd];
+            radiusTransform.apply(boxCenter, out);
+            centerDistance = out[0];
+            haveCenterDistance = true;
+          }
+          partialBox = (centerDistance < diagonalSquared*0.72 + radiiSquared[j]);
+        }
+        if (partialBox)
+        {
+          if (firstPartial == numRadii) firstPartial = j;
+          endPartial = j + 1;
+        }
+      }
+
+      // Use the detailed integration method for all the spheres which might partially contain the box.
+      if (firstPartial < endPartial)
+        box->integrateSpheres(radiusTransform, endPartial - firstPartial, radiiSquared + firstPartial, signal + firstPartial, errorSquared + firstPartial);
+    } // (for each box)
+  }
+
+
   //-----------------------------------------------------------------------------------------------
   /** Find the centroid of all events contained within by doing a weighted average
    * of their coordinates.
@@ -1632,6 +1820,29 @@ GCC_DIAG_ON(array-bounds)
   }
 
 
+  //-----------------------------------------------------------------------------------------------
+  /** Find the child which contains an event.
+   *
+   * NOTE: No bounds checking is done (for performance). The index is numBoxes or more for events
+   * lying beyond the upper limits of the grid box.
+   *
+   * @param event :: the event
+   * @return the index of the child in m_Children
+   */
+  TMDE(
+  inline size_t MDGridBox)::getChildIndex(const MDE & event) const
+  {
+    size_t index = 0;
+    for (size_t d=0; d<nd; d++)
+    {
+      coord_t x = event.getCenter(d);
+      int i = int((x - this->extents[d].getMin()) /m_SubBoxSize[d]);
+      // Accumulate the index
+      index += (i * splitCumul[d]);
+    }
+    return index;
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Add a single MDLeanEvent to the grid box. If the boxes
    * contained within are also gridded, this will recursively push the event
@@ -1647,17 +1858,7 @@ GCC_DIAG_ON(array-bounds)
   TMDE(
   inline void MDGridBox)::addEvent( const MDE & event)
   {
-    size_t index = 0;
-    for (size_t d=0; d<nd; d++)
-    {
-      coord_t x = event.getCenter(d);
-      int i = int((x - this->extents[d].getMin()) /m_SubBoxSize[d]);
-      // NOTE: No bounds checking is done (for performance).
-      //if (i < 0 || i >= int(split[d])) return;
-
-      // Accumulate the index
-      index += (i * splitCumul[d]);
-    }
+    size_t index = getChildIndex(event);
 
     // Add it to the contained box
     if (index < numBoxes) // avoid segfaults for floating point round-off errors.
@@ -1682,15 +1883,7 @@ GCC_DIAG_ON(array-bounds)
   TMDE(
   inline void MDGridBox)::addEventUnsafe(const MDE & event)
   {
-    size_t index = 0;
-    for (size_t d=0; d<nd; d++)
-    {
-
-      coord_t x = event.getCenter(d);
-      int i = int((x - this->extents[d].getMin()) /m_SubBoxSize[d]);
-      // Accumulate the index
-      index += (i * splitCumul[d]);
-    }
+    size_t index = getChildIndex(event);
 
     // Add it to the contained box
     if (index < numBoxes) // avoid segfaults for floating point round-off errors.
@@ -1705,7 +1898,7 @@ GCC_DIAG_ON(array-bounds)
   inline void MDGridBox)::setChild(size_t index,MDGridBox<MDE,nd> * newChild)
     {
       // Delete the old box  (supposetly ungridded);
-      delete this->m_Children[index];
+      deleteChild(this->m_Children[index]);
       // set new box, supposetly gridded
       this->m_Children[index]=newChild;
     }
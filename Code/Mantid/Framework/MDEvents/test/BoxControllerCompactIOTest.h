@@ -0,0 +1,212 @@
+#ifndef BOXCONTROLLER_COMPACT_IO_TEST_H
+#define BOXCONTROLLER_COMPACT_IO_TEST_H
+
+#include <cxxtest/TestSuite.h>
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+#include "MantidMDEvents/BoxControllerCompactIO.h"
+#include "MantidMDEvents/MDEventFactory.h"
+
+using namespace Mantid;
+using namespace Mantid::Geometry;
+using namespace Mantid::Kernel;
+using namespace Mantid::API;
+using namespace Mantid::MDEvents;
+
+class BoxControllerCompactIOTest : public CxxTest::TestSuite
+{
+    BoxController_sptr sc;
+
+    BoxControllerCompactIOTest()
+    {
+        sc = BoxController_sptr(new BoxController(4));
+    }
+
+    /// lean events in 4D: signal, error, 4 coordinates
+    static std::vector<float> makeEvents(size_t nEvents, float shift)
+    {
+        std::vector<float> events;
+        for(size_t i=0;i<nEvents;i++)
+        {
+            events.push_back(1.0f);
+            events.push_back(1.0f);
+            for(size_t d=0;d<4;d++)
+                events.push_back(shift + float(i*(d+1))*0.1f);
+        }
+        return events;
+    }
+
+public:
+static BoxControllerCompactIOTest *createSuite() { return new BoxControllerCompactIOTest(); }
+static void destroySuite(BoxControllerCompactIOTest * suite) { delete suite; }
+
+ void test_contstructor_setters()
+ {
+     BoxControllerCompactIO saver(sc.get());
+
+     size_t CoordSize;
+     std::string typeName;
+     TS_ASSERT_THROWS_NOTHING(saver.getDataType(CoordSize, typeName));
+     // default settings
+     TS_ASSERT_EQUALS(sizeof(coord_t),CoordSize);
+     TS_ASSERT_EQUALS("MDEvent",typeName);
+     TS_ASSERT_EQUALS(8,saver.getNDataColums());
+
+     TS_ASSERT_THROWS(saver.setDataType(9,typeName),std::invalid_argument);
+     TS_ASSERT_THROWS(saver.setDataType(4,"UnknownEvent"),std::invalid_argument);
+     TS_ASSERT_THROWS_NOTHING(saver.setDataType(8, "MDLeanEvent"));
+     TS_ASSERT_THROWS_NOTHING(saver.getDataType(CoordSize, typeName));
+     TS_ASSERT_EQUALS(8,CoordSize);
+     TS_ASSERT_EQUALS("MDLeanEvent",typeName);
+     TS_ASSERT_EQUALS(6,saver.getNDataColums());
+ }
+
+ void test_open_close()
+ {
+     BoxControllerCompactIO saver(sc.get());
+     TS_ASSERT(!saver.isOpened());
+     TS_ASSERT(saver.openFile("compact","w"));
+     TS_ASSERT(saver.isOpened());
+     TS_ASSERT_EQUALS("compact",saver.getFileName());
+     TS_ASSERT(!saver.openFile("other","w"));
+     saver.closeFile();
+     TS_ASSERT(!saver.isOpened());
+ }
+
+ void test_save_load()
+ {
+     BoxControllerCompactIO saver(sc.get());
+     saver.setDataType(4,"MDLeanEvent");
+     saver.openFile("compact","w");
+
+     std::vector<float> events = makeEvents(20,1.0f);
+     TS_ASSERT_THROWS_NOTHING(saver.saveBlock(events,100));
+     TS_ASSERT_EQUALS(saver.getFileLength(),120);
+     TS_ASSERT_EQUALS(saver.getNumBlocks(),1);
+     TS_ASSERT_LESS_THAN(0,saver.getMemorySize());
+
+     std::vector<double> loaded;
+     TS_ASSERT_THROWS_NOTHING(saver.loadBlock(loaded,100,20));
+     TS_ASSERT_EQUALS(loaded.size(),events.size());
+     for(size_t i=0;i<events.size();i++)
+         TS_ASSERT_DELTA(loaded[i],events[i],1.e-3);
+
+     // Part of the block
+     std::vector<float> part;
+     TS_ASSERT_THROWS_NOTHING(saver.loadBlock(part,119,1));
+     TS_ASSERT_EQUALS(part.size(),6);
+     TS_ASSERT_DELTA(part[2],events[19*6+2],1.e-3);
+
+     // Not saved
+     TS_ASSERT_THROWS(saver.loadBlock(part,0,10),Kernel::Exception::FileError);
+     TS_ASSERT_THROWS(saver.loadBlock(part,110,20),Kernel::Exception::FileError);
+     // The type can not be changed any more
+     TS_ASSERT_THROWS(saver.setDataType(4,"MDEvent"),std::runtime_error);
+ }
+
+ void test_saving_over_a_block_replaces_it()
+ {
+     BoxControllerCompactIO saver(sc.get());
+     saver.setDataType(4,"MDLeanEvent");
+     saver.openFile("compact","w");
+
+     saver.saveBlock(makeEvents(10,1.0f),0);
+     saver.saveBlock(makeEvents(10,2.0f),10);
+     saver.saveBlock(makeEvents(10,3.0f),20);
+     TS_ASSERT_EQUALS(saver.getNumBlocks(),3);
+     // Overlaps the end of the first block and the start of the second one
+     saver.saveBlock(makeEvents(8,4.0f),5);
+     TS_ASSERT_EQUALS(saver.getNumBlocks(),2);
+
+     std::vector<float> loaded;
+     TS_ASSERT_THROWS(saver.loadBlock(loaded,0,10),Kernel::Exception::FileError);
+     TS_ASSERT_THROWS_NOTHING(saver.loadBlock(loaded,5,8));
+     TS_ASSERT_DELTA(loaded[2],4.0f,1.e-3);
+     TS_ASSERT_THROWS_NOTHING(saver.loadBlock(loaded,20,10));
+     TS_ASSERT_DELTA(loaded[2],3.0f,1.e-3);
+ }
+
+ void test_freeBlock_drops_the_events()
+ {
+     BoxControllerCompactIO saver(sc.get());
+     saver.setDataType(4,"MDLeanEvent");
+     saver.openFile("compact","w");
+
+     saver.saveBlock(makeEvents(10,1.0f),0);
+     saver.saveBlock(makeEvents(10,2.0f),10);
+     size_t memory = saver.getMemorySize();
+
+     // Nothing to free
+     saver.freeBlock(5,0);
+     TS_ASSERT_EQUALS(saver.getNumBlocks(),2);
+
+     saver.freeBlock(0,10);
+     TS_ASSERT_EQUALS(saver.getNumBlocks(),1);
+     TS_ASSERT_LESS_THAN(saver.getMemorySize(),memory);
+     // The disk buffer knows about it
+     TS_ASSERT_EQUALS(saver.getFreeSpaceMap().size(),1);
+     std::vector<float> loaded;
+     TS_ASSERT_THROWS(saver.loadBlock(loaded,0,10),Kernel::Exception::FileError);
+
+     saver.closeFile();
+     TS_ASSERT_EQUALS(saver.getNumBlocks(),0);
+     TS_ASSERT_EQUALS(saver.getMemorySize(),0);
+ }
+
+ /** The events of a workspace with compact storage are packed when they go out of the write buffer,
+  * and come back when they are used */
+ void test_workspace_with_compact_storage()
+ {
+     // 5x5x5 boxes with 10 events each, 2 different positions per box
+     MDEventWorkspace3Lean::sptr ws = MDEventsTestHelper::makeMDEW<3>(5, 0.0, 5.0, 0);
+     ws->splitBox();
+     for(size_t i=0;i<1250;i++)
+     {
+         coord_t centers[3] = {coord_t(i%5)+0.25f, coord_t((i/5)%5)+0.5f, coord_t((i/25)%5)+((i/125)%2 ? 0.75f : 0.125f)};
+         ws->addEvent(MDLeanEvent<3>(1.0, 1.0, centers));
+     }
+     ws->refreshCache();
+
+     TS_ASSERT_THROWS_NOTHING(MDEventFactory::setCompactStorage(ws,0));
+     TS_ASSERT(ws->isFileBacked());
+     TS_ASSERT_THROWS(MDEventFactory::setCompactStorage(ws,0),std::invalid_argument);
+
+     IBoxControllerIO * io = ws->getBoxController()->getFileIO();
+     io->flushCache();
+     TS_ASSERT_LESS_THAN(0,io->getMemorySize());
+     TS_ASSERT_EQUALS(io->getFileLength(),1250);
+
+     std::vector<IMDNode *> boxes;
+     ws->getBoxes(boxes,10,true);
+     TS_ASSERT_EQUALS(boxes.size(),125);
+     size_t nEvents(0);
+     for(size_t i=0;i<boxes.size();i++)
+     {
+         MDBox<MDLeanEvent<3>,3> * box = dynamic_cast<MDBox<MDLeanEvent<3>,3> *>(boxes[i]);
+         TS_ASSERT(box);
+         if(!box)return;
+         const std::vector<MDLeanEvent<3> > & events = box->getConstEvents();
+         for(size_t j=0;j<events.size();j++)
+         {
+             TS_ASSERT_EQUALS(events[j].getSignal(),1.0);
+             TS_ASSERT_EQUALS(events[j].getErrorSquared(),1.0);
+             for(size_t d=0;d<3;d++)
+             {
+                 coord_t x = events[j].getCenter(d);
+                 TS_ASSERT(box->getExtents(d).getMin() <= x && x <= box->getExtents(d).getMax());
+             }
+             coord_t z = events[j].getCenter(2) - box->getExtents(2).getMin();
+             TS_ASSERT(std::fabs(z-0.125f)<1e-4 || std::fabs(z-0.75f)<1e-4);
+         }
+         nEvents += events.size();
+         box->releaseEvents();
+     }
+     TS_ASSERT_EQUALS(nEvents,1250);
+
+     ws->refreshCache();
+     TS_ASSERT_EQUALS(ws->getNPoints(),1250);
+     TS_ASSERT_DELTA(ws->getBox()->getSignal(),1250.0,1e-6);
+ }
+
+};
+
+#endif
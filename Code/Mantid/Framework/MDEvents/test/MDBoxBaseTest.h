@@ -122,6 +122,7 @@ public:
   virtual void calculateCentroid(coord_t * /*centroid*/) const{};
 
   virtual void integrateSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/, signal_t & /*signal*/, signal_t & /*errorSquared*/) const {};
+  virtual void integrateSpheres(Mantid::API::CoordTransform & /*radiusTransform*/, const size_t /*numRadii*/, const coord_t * /*radiiSquared*/, signal_t * /*signal*/, signal_t * /*errorSquared*/) const {};
   virtual void centroidSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/, coord_t *, signal_t & ) const {};
   virtual void integrateCylinder(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radius*/,const coord_t /*length*/, signal_t & /*signal*/, signal_t & /*errorSquared*/, std::vector<signal_t> & /*signal_fit*/) const {};
   virtual void getBoxes(std::vector<API::IMDNode *>&  /*boxes*/, size_t /*maxDepth*/, bool) {};
@@ -0,0 +1,210 @@
+#ifndef MANTID_MDEVENTS_MDCOMPACTEVENTBLOCKTEST_H_
+#define MANTID_MDEVENTS_MDCOMPACTEVENTBLOCKTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidKernel/Timer.h"
+#include "MantidMDEvents/MDCompactEventBlock.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Mantid::MDEvents;
+
+class MDCompactEventBlockTest : public CxxTest::TestSuite
+{
+  /** Make a table of lean events in 3D: signal, error, x, y, z */
+  static std::vector<float> makeLeanTable(size_t nEvents, bool unitWeight)
+  {
+    std::vector<float> table;
+    for (size_t i = 0; i < nEvents; i++)
+    {
+      const float signal = unitWeight ? 1.0f : float(i % 7) + 0.5f;
+      table.push_back(signal);
+      table.push_back(unitWeight ? signal : signal * 2.0f);
+      table.push_back(2.0f + 0.001f * float(i));
+      table.push_back(-1.0f - 0.37f * float(i % 13));
+      table.push_back(5.0f + std::sin(float(i)));
+    }
+    return table;
+  }
+
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDCompactEventBlockTest *createSuite() { return new MDCompactEventBlockTest(); }
+  static void destroySuite( MDCompactEventBlockTest *suite ) { delete suite; }
+
+  void test_roundTrip_lean()
+  {
+    std::vector<float> table = makeLeanTable(1000, false);
+    MDCompactEventBlock block(table, 3, false);
+    TS_ASSERT_EQUALS( block.getNumEvents(), 1000 );
+    TS_ASSERT( block.isPacked() );
+    TS_ASSERT( block.hasErrors() );
+    TS_ASSERT( !block.hasFatEvents() );
+
+    std::vector<float> out;
+    block.unpack(out);
+    TS_ASSERT_EQUALS( out.size(), table.size() );
+    for (size_t i = 0; i < 1000; i++)
+    {
+      // Signal and error are exact
+      TS_ASSERT_EQUALS( out[i*5], table[i*5] );
+      TS_ASSERT_EQUALS( out[i*5+1], table[i*5+1] );
+      for (size_t d = 0; d < 3; d++)
+        TS_ASSERT_DELTA( out[i*5+2+d], table[i*5+2+d], block.getMaxCoordError(d) + 1e-6 );
+    }
+  }
+
+  void test_coordinates_stay_in_the_range_of_the_block()
+  {
+    std::vector<float> table = makeLeanTable(500, true);
+    MDCompactEventBlock block(table, 3, false);
+    std::vector<double> out;
+    block.unpack(out);
+    for (size_t d = 0; d < 3; d++)
+    {
+      float min = std::numeric_limits<float>::max();
+      float max = -min;
+      for (size_t i = 0; i < 500; i++)
+      {
+        min = std::min(min, table[i*5+2+d]);
+        max = std::max(max, table[i*5+2+d]);
+      }
+      for (size_t i = 0; i < 500; i++)
+      {
+        TS_ASSERT_LESS_THAN_EQUALS( min, float(out[i*5+2+d]) );
+        TS_ASSERT_LESS_THAN_EQUALS( float(out[i*5+2+d]), max );
+      }
+      TS_ASSERT_DELTA( block.getMaxCoordError(d), 0.5 * (max - min) / 65535., 1e-9 );
+    }
+    TS_ASSERT_THROWS( block.getMaxCoordError(3), std::out_of_range );
+  }
+
+  void test_unitWeight_drops_error_and_signal()
+  {
+    std::vector<float> table = makeLeanTable(1000, true);
+    MDCompactEventBlock block(table, 3, false);
+    TS_ASSERT( !block.hasErrors() );
+    // 3 x 16 bits per event, plus a fixed overhead
+    TS_ASSERT_LESS_THAN( block.getMemorySize(), 1000 * 6 + 1000 );
+    TS_ASSERT_LESS_THAN( 3 * block.getMemorySize(), table.size() * sizeof(float) );
+
+    std::vector<float> out;
+    block.unpack(out);
+    for (size_t i = 0; i < 1000; i++)
+    {
+      TS_ASSERT_EQUALS( out[i*5], 1.0f );
+      TS_ASSERT_EQUALS( out[i*5+1], 1.0f );
+    }
+  }
+
+  void test_fatEvents_keep_run_and_detector()
+  {
+    std::vector<double> table;
+    for (size_t i = 0; i < 100; i++)
+    {
+      table.push_back(3.0);
+      table.push_back(3.0);
+      table.push_back(double(i % 3));
+      table.push_back(double(100000 + i));
+      table.push_back(0.25 * double(i));
+      table.push_back(-0.5 * double(i));
+    }
+    MDCompactEventBlock block(table, 2, true);
+    TS_ASSERT( block.hasFatEvents() );
+    TS_ASSERT( !block.hasErrors() );
+
+    std::vector<float> out;
+    block.unpack(out);
+    TS_ASSERT_EQUALS( out.size(), table.size() );
+    for (size_t i = 0; i < 100; i++)
+    {
+      TS_ASSERT_EQUALS( out[i*6], 3.0f );
+      TS_ASSERT_EQUALS( out[i*6+2], float(i % 3) );
+      TS_ASSERT_EQUALS( out[i*6+3], float(100000 + i) );
+      TS_ASSERT_DELTA( out[i*6+4], 0.25 * double(i), block.getMaxCoordError(0) + 1e-5 );
+      TS_ASSERT_DELTA( out[i*6+5], -0.5 * double(i), block.getMaxCoordError(1) + 1e-5 );
+    }
+  }
+
+  void test_same_coordinate_for_all_events_is_exact()
+  {
+    std::vector<float> table;
+    for (size_t i = 0; i < 10; i++)
+    {
+      table.push_back(1.0f);
+      table.push_back(1.0f);
+      table.push_back(0.123f);
+    }
+    MDCompactEventBlock block(table, 1, false);
+    TS_ASSERT_EQUALS( block.getMaxCoordError(0), 0.0 );
+    std::vector<float> out;
+    block.unpack(out);
+    TS_ASSERT_EQUALS( out, table );
+  }
+
+  void test_nonFinite_coordinates_are_kept_unpacked()
+  {
+    std::vector<float> table = makeLeanTable(10, false);
+    table[5*4+3] = std::numeric_limits<float>::quiet_NaN();
+    table[5*6+2] = std::numeric_limits<float>::infinity();
+    MDCompactEventBlock block(table, 3, false);
+    TS_ASSERT( !block.isPacked() );
+    std::vector<float> out;
+    block.unpack(out);
+    TS_ASSERT_EQUALS( out.size(), table.size() );
+    TS_ASSERT( out[5*4+3] != out[5*4+3] );
+    TS_ASSERT_EQUALS( out[5*6+2], std::numeric_limits<float>::infinity() );
+    TS_ASSERT_EQUALS( out[7], table[7] );
+  }
+
+  void test_empty_and_wrong_tables()
+  {
+    std::vector<float> table;
+    MDCompactEventBlock block(table, 4, true);
+    TS_ASSERT_EQUALS( block.getNumEvents(), 0 );
+    std::vector<float> out(3, 1.0f);
+    block.unpack(out);
+    TS_ASSERT( out.empty() );
+
+    table.resize(7);
+    TS_ASSERT_THROWS( MDCompactEventBlock(table, 4, false), std::invalid_argument );
+  }
+
+};
+
+
+class MDCompactEventBlockTestPerformance : public CxxTest::TestSuite
+{
+  std::vector<float> table;
+public:
+  static MDCompactEventBlockTestPerformance *createSuite() { return new MDCompactEventBlockTestPerformance(); }
+  static void destroySuite( MDCompactEventBlockTestPerformance *suite ) { delete suite; }
+
+  MDCompactEventBlockTestPerformance()
+  {
+    // 1e6 lean events in 4D
+    for (size_t i = 0; i < 1000000; i++)
+    {
+      table.push_back(1.0f);
+      table.push_back(1.0f);
+      for (size_t d = 0; d < 4; d++)
+        table.push_back(float((i * (d+3)) % 1000) * 0.01f);
+    }
+  }
+
+  void test_pack_and_unpack()
+  {
+    Mantid::Kernel::Timer tim;
+    MDCompactEventBlock block(table, 4, false);
+    std::vector<float> out;
+    block.unpack(out);
+    std::cout << tim.elapsed() << " sec to pack and unpack 1e6 events; " <<
+        double(block.getMemorySize()) / double(table.size() * sizeof(float)) << " of the memory." << std::endl;
+    TS_ASSERT_EQUALS( out.size(), table.size() );
+  }
+};
+
+
+#endif /* MANTID_MDEVENTS_MDCOMPACTEVENTBLOCKTEST_H_ */
@@ -234,6 +234,45 @@ public:
   }
 
 
+  //-------------------------------------------------------------------------------------
+  /** The children of a split box sit next to each other in memory, in the order of their IDs,
+   * and hold exactly the events that belong to them */
+  void test_MDGridBox_children_are_contiguous()
+  {
+    MDBox<MDLeanEvent<1>,1> * b = MDEventsTestHelper::makeMDBox1();
+    // 3 events in each of the 10 children
+    const std::vector<MDLeanEvent<1> > events = MDEventsTestHelper::makeMDEvents1(10);
+    for (size_t i=0; i<3; i++)
+      b->addEvents( events );
+    MDGridBox<MDLeanEvent<1>,1> * g = new MDGridBox<MDLeanEvent<1>,1>(b);
+
+    std::vector<MDBoxBase<MDLeanEvent<1>,1> *> boxes = g->getBoxes();
+    TS_ASSERT_EQUALS( boxes.size(), 10 );
+    for (size_t i=0; i<boxes.size(); i++)
+    {
+      MDBox<MDLeanEvent<1>,1> * box = dynamic_cast<MDBox<MDLeanEvent<1>,1> *>(boxes[i]);
+      TS_ASSERT( box );
+      if (!box) return;
+      TS_ASSERT_EQUALS( box->getNPoints(), 3 );
+      TS_ASSERT_EQUALS( box->getConstEvents().capacity(), 3 );
+      if (i > 0)
+      {
+        TS_ASSERT_EQUALS( box->getID(), boxes[i-1]->getID()+1 );
+        TS_ASSERT_EQUALS( size_t(reinterpret_cast<char *>(boxes[i]) - reinterpret_cast<char *>(boxes[i-1])), sizeof(MDBox<MDLeanEvent<1>,1>) );
+      }
+    }
+
+    // Replacing a child in the block by a grid box and deleting everything works
+    TS_ASSERT_THROWS_NOTHING( g->splitContents(3) );
+    TS_ASSERT( dynamic_cast<MDGridBox<MDLeanEvent<1>,1> *>(g->getChild(3)) );
+    TS_ASSERT_EQUALS( g->getChild(3)->getNumChildren(), 10 );
+
+    BoxController *const bcc = b->getBoxController();
+    delete b;
+    TS_ASSERT_THROWS_NOTHING( delete g );
+    delete bcc;
+  }
+
   //-------------------------------------------------------------------------------------
   void test_MDGridBox_copy_constructor()
   {
@@ -1355,6 +1394,49 @@ public:
 //    do_check_integrateSphere(box, 0.0,0.5, 0.01,  1.0, "Tiny, but just barely enough to get an event");
   }
 
+  //------------------------------------------------------------------------------------------------
+  /** Integrating several spheres in one go gives the same as integrating them one by one */
+  void test_integrateSpheres()
+  {
+    MDGridBox<MDLeanEvent<2>,2> * box_ptr = MDEventsTestHelper::makeMDGridBox<2>();
+    // 16 events per box, so the boxes are split again
+    MDEventsTestHelper::feedMDBox<2>(box_ptr, 1, 40, 0.125, 0.25);
+    box_ptr->splitAllIfNeeded(NULL);
+    box_ptr->refreshCache(NULL);
+    TS_ASSERT_EQUALS( box_ptr->getNPoints(), 40*40);
+
+    const size_t numRadii = 4;
+    coord_t radii[numRadii] = {0.3f, 1.1f, 2.2f, 3.7f};
+    coord_t radiiSquared[numRadii];
+    for (size_t i=0; i<numRadii; i++)
+      radiiSquared[i] = radii[i]*radii[i];
+
+    coord_t centers[4][2] = {{4.5f, 4.5f}, {5.0f, 5.0f}, {0.1f, 9.3f}, {-1.0f, 2.0f}};
+    for (size_t c=0; c<4; c++)
+    {
+      bool dimensionsUsed[2] = {true,true};
+      CoordTransformDistance sphere(2, centers[c], dimensionsUsed);
+
+      signal_t signal[numRadii] = {0, 0, 0, 0};
+      signal_t errorSquared[numRadii] = {0, 0, 0, 0};
+      box_ptr->integrateSpheres(sphere, numRadii, radiiSquared, signal, errorSquared);
+      for (size_t i=0; i<numRadii; i++)
+      {
+        signal_t expectedSignal = 0;
+        signal_t expectedErrorSquared = 0;
+        box_ptr->integrateSphere(sphere, radiiSquared[i], expectedSignal, expectedErrorSquared);
+        TS_ASSERT_DELTA( signal[i], expectedSignal, 1e-5);
+        TS_ASSERT_DELTA( errorSquared[i], expectedErrorSquared, 1e-5);
+      }
+      TS_ASSERT_LESS_THAN( 0.0, signal[numRadii-1] );
+    }
+
+    // clean up  behind 
+    BoxController *const bcc = box_ptr->getBoxController();
+    delete box_ptr;
+    delete bcc;
+  }
+
 
 
 
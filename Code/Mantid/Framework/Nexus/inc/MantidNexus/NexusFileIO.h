@@ -52,6 +52,9 @@ namespace Mantid
     class DLLExport NexusFileIO
     {
     public:
+      /// The default number of events written at a time by writeNexusProcessedDataEventCombined()
+      static const size_t DEFAULT_EVENT_CHUNK_SIZE = 1 << 20;
+
       /// Default constructor
       NexusFileIO();
 
@@ -81,13 +84,13 @@ namespace Mantid
       int writeNexusProcessedDataEvent( const DataObjects::EventWorkspace_const_sptr& localworkspace);
 
       int writeNexusProcessedDataEventCombined( const DataObjects::EventWorkspace_const_sptr& ws,
-          std::vector<int64_t> & indices, double * tofs, float * weights, float * errorSquareds, int64_t * pulsetimes,
-          bool compress) const;
+          std::vector<int64_t> & indices, bool compress, API::Progress * prog = NULL,
+          size_t maxChunkSize = DEFAULT_EVENT_CHUNK_SIZE) const;
 
       int writeEventList( const DataObjects::EventList & el, std::string group_name) const;
 
       template<class T>
-      void writeEventListData( std::vector<T> events, bool writeTOF, bool writePulsetime, bool writeWeight, bool writeError) const;
+      void writeEventListData( const std::vector<T> & events, bool writeTOF, bool writePulsetime, bool writeWeight, bool writeError) const;
       void NXwritedata( const char * name, int datatype, int rank, int * dims_array, void * data, bool compress = false) const;
 
       /// find size of open entry data section
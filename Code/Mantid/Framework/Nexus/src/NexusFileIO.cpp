@@ -21,6 +21,7 @@
 #include "MantidAPI/NumericAxis.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/TableColumn.h"
@@ -29,6 +30,8 @@
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidAPI/AlgorithmHistory.h"
 
+#include <algorithm>
+
 #include <boost/tokenizer.hpp>
 #include <boost/shared_ptr.hpp>
 #include <Poco/File.h>
@@ -45,6 +48,27 @@ using namespace DataObjects;
   {
     /// static logger
     Logger g_log("NexusFileIO");
+
+    /** Copy some of the events of a list into the buffers of a chunk of the combined event list
+     * @param events :: vector of TofEvent or WeightedEvent, etc.
+     * @param first :: index of the first event to copy
+     * @param last :: index after the last event to copy
+     * @param offset :: index in the buffers of the first event
+     * @param tofs, weights, errorSquareds, pulsetimes :: the buffers, or NULL for the fields not written.
+     */
+    template<class T>
+    void copyEventsToChunk(const std::vector<T> & events, size_t first, size_t last, size_t offset,
+        double * tofs, float * weights, float * errorSquareds, int64_t * pulsetimes)
+    {
+      for (size_t i = first; i < last; ++i, ++offset)
+      {
+        const T & event = events[i];
+        if (tofs) tofs[offset] = event.tof();
+        if (weights) weights[offset] = static_cast<float>(event.weight());
+        if (errorSquareds) errorSquareds[offset] = static_cast<float>(event.errorSquared());
+        if (pulsetimes) pulsetimes[offset] = event.pulseTime().totalNanoseconds();
+      }
+    }
   }
 
   /// Empty default constructor
@@ -580,20 +604,18 @@ using namespace DataObjects;
 
 
   //-------------------------------------------------------------------------------------
-  /** Write out a combined chunk of event data
+  /** Write out the events of all the event lists as one combined list.
+   * The events are copied from the event lists into buffers of a fixed size, which are written
+   * one after the other as slabs of the datasets. The memory used does not depend on the number of events.
    *
    * @param ws :: an EventWorkspace
-   * @param indices :: array of event list indexes
-   * @param tofs :: array of TOFs
-   * @param weights :: array of event weights
-   * @param errorSquareds :: array of event squared errors
-   * @param pulsetimes :: array of pulsetimes
+   * @param indices :: array of event list indexes: the index of the first event of each list, then the number of events
    * @param compress :: if true, compress the entry
+   * @param prog :: if not NULL, incremented by the number of events written
+   * @param maxChunkSize :: the number of events written at a time, i.e. the size of the buffers
    */
   int NexusFileIO::writeNexusProcessedDataEventCombined( const DataObjects::EventWorkspace_const_sptr& ws,
-      std::vector<int64_t> & indices,
-      double * tofs, float * weights, float * errorSquareds, int64_t * pulsetimes,
-      bool compress) const
+      std::vector<int64_t> & indices, bool compress, API::Progress * prog, size_t maxChunkSize) const
   {
     NXopengroup(fileID,"event_workspace","NXdata");
 
@@ -614,17 +636,117 @@ using namespace DataObjects;
       NXclosedata(fileID);
     }
 
-    // Write out each field
-    dims_array[0] = static_cast<int>(indices.back()); // TODO big truncation error! This is the # of events
-    if (tofs)
-      NXwritedata("tof", NX_FLOAT64, 1, dims_array, (void *)(tofs), compress);
-    if (pulsetimes)
-      NXwritedata("pulsetime", NX_INT64, 1, dims_array, (void *)(pulsetimes), compress);
-    if (weights)
-      NXwritedata("weight", NX_FLOAT32, 1, dims_array, (void *)(weights), compress);
-    if (errorSquareds)
-      NXwritedata("error_squared", NX_FLOAT32, 1, dims_array, (void *)(errorSquareds), compress);
+    // The fields to write depend on the overall event type.
+    bool writePulsetime = false;
+    bool writeWeight = false;
+    bool writeError = false;
+    switch (ws->getEventType())
+    {
+    case TOF:
+      writePulsetime = true;
+      break;
+    case WEIGHTED:
+      writePulsetime = true;
+      writeWeight = true;
+      writeError = true;
+      break;
+    case WEIGHTED_NOTIME:
+      writeWeight = true;
+      writeError = true;
+      break;
+    }
+
+    // Make the datasets for all the events, with a chunk of the size of the buffers
+    const size_t numEvents = static_cast<size_t>(indices.back());
+    const size_t chunkSize = std::max(size_t(1), std::min(numEvents, maxChunkSize));
+    dims_array[0] = static_cast<int>(numEvents); // TODO big truncation error! This is the # of events
+    int chunk_array[1] = { static_cast<int>(chunkSize) };
+    std::vector<const char *> names;
+    std::vector<int> types;
+    std::vector<void *> buffers;
+    names.push_back("tof");
+    types.push_back(NX_FLOAT64);
+    std::vector<double> tofs(chunkSize);
+    buffers.push_back(tofs.data());
+    std::vector<int64_t> pulsetimes(writePulsetime ? chunkSize : 0);
+    if (writePulsetime)
+    {
+      names.push_back("pulsetime");
+      types.push_back(NX_INT64);
+      buffers.push_back(pulsetimes.data());
+    }
+    std::vector<float> weights(writeWeight ? chunkSize : 0);
+    if (writeWeight)
+    {
+      names.push_back("weight");
+      types.push_back(NX_FLOAT32);
+      buffers.push_back(weights.data());
+    }
+    std::vector<float> errorSquareds(writeError ? chunkSize : 0);
+    if (writeError)
+    {
+      names.push_back("error_squared");
+      types.push_back(NX_FLOAT32);
+      buffers.push_back(errorSquareds.data());
+    }
+    for (size_t field = 0; field < names.size(); ++field)
+    {
+      if (compress)
+        NXcompmakedata(fileID, names[field], types[field], 1, dims_array, m_nexuscompression, chunk_array);
+      else
+        NXmakedata(fileID, names[field], types[field], 1, dims_array);
+    }
 
+    // Fill the buffers with the events of a chunk and write them out, one chunk after the other
+    size_t firstList = 0;
+    for (size_t chunkStart = 0; chunkStart < numEvents; chunkStart += chunkSize)
+    {
+      const size_t chunkEnd = std::min(numEvents, chunkStart + chunkSize);
+      // The lists which have events in this chunk
+      while (static_cast<size_t>(indices[firstList+1]) <= chunkStart)
+        ++firstList;
+      size_t endList = firstList;
+      while (endList + 1 < indices.size() && static_cast<size_t>(indices[endList]) < chunkEnd)
+        ++endList;
+
+      // It is okay to copy in parallel since the lists go to separate parts of the buffers.
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int wi = static_cast<int>(firstList); wi < static_cast<int>(endList); ++wi)
+      {
+        const DataObjects::EventList & el = ws->getEventList(wi);
+        const size_t listStart = static_cast<size_t>(indices[wi]);
+        // The range of the events of the list which are in this chunk
+        const size_t first = std::max(listStart, chunkStart) - listStart;
+        const size_t last = std::min(static_cast<size_t>(indices[wi+1]), chunkEnd) - listStart;
+        const size_t offset = listStart + first - chunkStart;
+        double * tofBuffer = tofs.data();
+        int64_t * pulsetimeBuffer = writePulsetime ? pulsetimes.data() : NULL;
+        float * weightBuffer = writeWeight ? weights.data() : NULL;
+        float * errorBuffer = writeError ? errorSquareds.data() : NULL;
+        switch (el.getEventType())
+        {
+        case TOF:
+          copyEventsToChunk(el.getEvents(), first, last, offset, tofBuffer, weightBuffer, errorBuffer, pulsetimeBuffer);
+          break;
+        case WEIGHTED:
+          copyEventsToChunk(el.getWeightedEvents(), first, last, offset, tofBuffer, weightBuffer, errorBuffer, pulsetimeBuffer);
+          break;
+        case WEIGHTED_NOTIME:
+          copyEventsToChunk(el.getWeightedEventsNoTime(), first, last, offset, tofBuffer, weightBuffer, errorBuffer, pulsetimeBuffer);
+          break;
+        }
+      }
+
+      int start[1] = { static_cast<int>(chunkStart) };
+      int size[1] = { static_cast<int>(chunkEnd - chunkStart) };
+      for (size_t field = 0; field < names.size(); ++field)
+      {
+        NXopendata(fileID, names[field]);
+        NXputslab(fileID, buffers[field], start, size);
+        NXclosedata(fileID);
+      }
+      if (prog) prog->reportIncrement(chunkEnd - chunkStart, "Writing events");
+    }
 
     // Close up the overall group
     NXstatus status=NXclosegroup(fileID);
@@ -685,7 +807,7 @@ using namespace DataObjects;
    * @param writeError :: if true, write the errors
    */
   template<class T>
-  void NexusFileIO::writeEventListData( std::vector<T> events, bool writeTOF, bool writePulsetime, bool writeWeight, bool writeError) const
+  void NexusFileIO::writeEventListData( const std::vector<T> & events, bool writeTOF, bool writePulsetime, bool writeWeight, bool writeError) const
   {
     // Do nothing if there are no events.
     if (events.empty())